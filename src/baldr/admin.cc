@@ -6,7 +6,8 @@ namespace baldr {
 // Constructor given parameters.
 Admin::Admin(const uint32_t country_offset, const uint32_t state_offset,
              const std::string& country_iso, const std::string& state_iso)
-    : country_offset_(country_offset), state_offset_(state_offset){
+    : country_offset_(country_offset), state_offset_(state_offset),
+      country_iso_{}, state_iso_{}, spare_{} {
 
   std::size_t length = 0;
   // Example:  GB or US
@@ -11,6 +11,7 @@
 
 #include "baldr/datetime.h"
 #include "baldr/graphconstants.h"
+#include "midgard/constants.h"
 
 #include "date_time_zonespec.h"
 
@@ -587,6 +588,12 @@ uint32_t seconds_from_midnight(const std::string& date_time) {
   return static_cast<uint32_t>(td.total_seconds());
 }
 
+//the week starts at midnight on sunday
+uint32_t seconds_from_week_start(const std::string& date_time) {
+  boost::gregorian::date date = get_formatted_date(date_time);
+  return date.day_of_week().as_number() * midgard::kSecondsPerDay + seconds_from_midnight(date_time);
+}
+
 //add x seconds to a date_time and return a ISO date_time string.
 //date_time is in the format of 20150516 or 2015-05-06T08:00
 std::string get_duration(const std::string& date_time, const uint32_t seconds,
@@ -121,6 +121,11 @@ void DirectedEdge::set_laneconnectivity(const bool lc) {
   lane_conn_ = lc;
 }
 
+// Sets the speed profile flag.
+void DirectedEdge::set_speed_profile(const bool profile) {
+  speed_profile_ = profile;
+}
+
 // -------------------------- Routing attributes --------------------------- //
 
 // Set the flag indicating driving is on the right hand side of the road
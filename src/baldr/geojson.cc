@@ -16,11 +16,25 @@ namespace baldr {
 namespace json {
 
 template <class coord_t>
-MapPtr to_geojson(const typename midgard::GriddedData<coord_t>::contours_t& grid_contours, bool polygons, const std::vector<std::string>& colors) {
+void to_geojson(const typename midgard::GriddedData<coord_t>::contours_t& grid_contours, writer_t& writer, bool polygons,
+  const std::vector<std::string>& colors, const boost::optional<std::string>& id) {
+  //the points of a ring or line
+  auto points = [&writer](const typename midgard::GriddedData<coord_t>::contour_t& contour) {
+    for(const auto& coord : contour) {
+      writer.start_array();
+      writer(fp_t{coord.first, 6});
+      writer(fp_t{coord.second, 6});
+      writer.end_array();
+    }
+  };
+
+  //make the collection
+  writer.start_object();
+  writer("type", "FeatureCollection");
+  writer.start_array("features");
   //for each contour interval
   int i = 0;
   auto color_itr = colors.cbegin();
-  auto features = array({});
   for(const auto& interval : grid_contours) {
     //color was supplied
     std::stringstream hex;
@@ -39,54 +53,50 @@ MapPtr to_geojson(const typename midgard::GriddedData<coord_t>::contours_t& grid
                     std::hex << static_cast<int>(std::get<2>(color)*255 + .5f);
     }
     ++i;
+    auto color = hex.str();
 
     //for each feature on that interval
     for(const auto& feature : interval.second) {
-      //for each contour in that feature
-      auto geom = array({});
-      for(const auto& contour : feature) {
-        //make some geometry
-        auto coords = array({});
-        for(const auto& coord : contour)
-          coords->push_back(array({fp_t{coord.first, 6}, fp_t{coord.second, 6}}));
-        //its either a ring
-        if(polygons)
-          geom->emplace_back(coords);
-        //or a single line, if someone has more than one contour per feature they messed up
-        else
-          geom = coords;
-      }
       //add a feature
-      features->emplace_back(
-        map({
-          {"type", std::string("Feature")},
-          {"geometry", map({
-            {"type", std::string(polygons ? "Polygon" : "LineString")},
-            {"coordinates", geom},
-          })},
-          {"properties", map({
-            {"contour", static_cast<uint64_t>(interval.first)},
-            { "color", hex.str()}, //lines
-            { "fill", hex.str()}, //geojson.io polys
-            { "fillColor", hex.str()}, //leaflet polys
-            { "opacity", json::fp_t{.33f, 2}}, //lines
-            { "fill-opacity", json::fp_t{.33f, 2}}, //geojson.io polys
-            { "fillOpacity", json::fp_t{.33f, 2}}, //leaflet polys
-          })},
-        })
-      );
+      writer.start_object();
+      writer("type", "Feature");
+      writer.start_object("geometry");
+      writer("type", polygons ? "Polygon" : "LineString");
+      writer.start_array("coordinates");
+      //its either rings
+      if(polygons) {
+        for(const auto& contour : feature) {
+          writer.start_array();
+          points(contour);
+          writer.end_array();
+        }
+      }//or a single line, if someone has more than one contour per feature they messed up
+      else if(!feature.empty())
+        points(feature.back());
+      writer.end_array();
+      writer.end_object();
+      writer.start_object("properties");
+      writer("contour", static_cast<uint64_t>(interval.first));
+      writer("color", color); //lines
+      writer("fill", color); //geojson.io polys
+      writer("fillColor", color); //leaflet polys
+      writer("opacity", fp_t{.33f, 2}); //lines
+      writer("fill-opacity", fp_t{.33f, 2}); //geojson.io polys
+      writer("fillOpacity", fp_t{.33f, 2}); //leaflet polys
+      writer.end_object();
+      writer.end_object();
     }
   }
-  //make the collection
-  auto feature_collection = map({
-    {"type", std::string("FeatureCollection")},
-    {"features", features},
-  });
-  return feature_collection;
+  writer.end_array();
+  if(id)
+    writer("id", *id);
+  writer.end_object();
 }
 
-template MapPtr to_geojson<midgard::Point2>(const midgard::GriddedData<midgard::Point2>::contours_t&, bool, const std::vector<std::string>&);
-template MapPtr to_geojson<midgard::PointLL>(const midgard::GriddedData<midgard::PointLL>::contours_t&, bool, const std::vector<std::string>&);
+template void to_geojson<midgard::Point2>(const midgard::GriddedData<midgard::Point2>::contours_t&, writer_t&, bool,
+  const std::vector<std::string>&, const boost::optional<std::string>&);
+template void to_geojson<midgard::PointLL>(const midgard::GriddedData<midgard::PointLL>::contours_t&, writer_t&, bool,
+  const std::vector<std::string>&, const boost::optional<std::string>&);
 
 }
 }
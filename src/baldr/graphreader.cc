@@ -17,6 +17,13 @@ namespace {
   constexpr size_t DEFAULT_MAX_CACHE_SIZE = 1073741824; //1 gig
   constexpr size_t AVERAGE_TILE_SIZE = 2097152; //2 megs
   constexpr size_t AVERAGE_MM_TILE_SIZE = 1024; //1k
+
+  // The group of copy forwarding caches that are not given one
+  const std::shared_ptr<CopyForwardingTileCache::group_t>& process_group() {
+    static std::shared_ptr<CopyForwardingTileCache::group_t> group(
+        new CopyForwardingTileCache::group_t);
+    return group;
+  }
 }
 
 namespace valhalla {
@@ -158,38 +165,42 @@ const GraphTile* SynchronizedTileCache::PutNoLock(const GraphId& graphid, const
 
 // Constructor.
 CopyForwardingTileCache::CopyForwardingTileCache(size_t max_size)
-      : SynchronizedTileCache(mutex_, max_size)
+      : CopyForwardingTileCache(max_size, process_group())
+{
+}
+
+// Constructor.
+CopyForwardingTileCache::CopyForwardingTileCache(size_t max_size,
+      const std::shared_ptr<group_t>& group)
+      : SynchronizedTileCache(group->mutex, max_size), group_(group)
 {
-  std::lock_guard<std::mutex> lock(mutex_);
-  members_.insert(this);
-  LOG_DEBUG("CopyForwardingTileCache(): " + std::to_string(members_.size()) + " members");
+  std::lock_guard<std::mutex> lock(group_->mutex);
+  group_->members.insert(this);
+  LOG_DEBUG("CopyForwardingTileCache(): " + std::to_string(group_->members.size()) + " members");
 }
 
 // Destructor.
 CopyForwardingTileCache::~CopyForwardingTileCache()
 {
-  std::lock_guard<std::mutex> lock(mutex_);
-  members_.erase(this);
-  LOG_DEBUG("~CopyForwardingTileCache(): " + std::to_string(members_.size()) + " members");
+  std::lock_guard<std::mutex> lock(group_->mutex);
+  group_->members.erase(this);
+  LOG_DEBUG("~CopyForwardingTileCache(): " + std::to_string(group_->members.size()) + " members");
 }
 
-// Puts a copy of a tile of into all caches.
+// Puts a copy of a tile of into all caches of the group.
 const GraphTile* CopyForwardingTileCache::Put(const GraphId& graphid, const GraphTile& tile, size_t size)
 {
-  std::lock_guard<std::mutex> lock(mutex_);
+  std::lock_guard<std::mutex> lock(group_->mutex);
   // Put into current cache
   const GraphTile* result = PutNoLock(graphid, tile, size);
   // Put into neighbor's caches
-  for (auto * cache : members_)
+  for (auto * cache : group_->members)
     if (cache != this)
         cache->PutNoLock(graphid, tile, size);
 
   return result;
 }
 
-std::mutex CopyForwardingTileCache::mutex_;
-std::unordered_set<CopyForwardingTileCache*> CopyForwardingTileCache::members_;
-
 // Constructs tile cache.
 TileCache* TileCacheFactory::createTileCache(const boost::property_tree::ptree& pt)
 {
@@ -203,6 +214,14 @@ TileCache* TileCacheFactory::createTileCache(const boost::property_tree::ptree&
   return new TileCache(max_cache_size);
 }
 
+// Constructs a copy forwarding tile cache in a group.
+TileCache* TileCacheFactory::createTileCache(const boost::property_tree::ptree& pt,
+      const std::shared_ptr<CopyForwardingTileCache::group_t>& group)
+{
+  size_t max_cache_size = pt.get<size_t>("max_cache_size", DEFAULT_MAX_CACHE_SIZE);
+  return new CopyForwardingTileCache(max_cache_size, group);
+}
+
 // Constructor using separate tile files
 GraphReader::GraphReader(const boost::property_tree::ptree& pt)
     : tile_dir_(pt.get<std::string>("tile_dir")),
@@ -213,6 +232,15 @@ GraphReader::GraphReader(const boost::property_tree::ptree& pt)
   cache_->Reserve(tile_extract_->tiles.empty() ? AVERAGE_TILE_SIZE : AVERAGE_MM_TILE_SIZE);
 }
 
+// Constructor using separate tile files and the given tile cache
+GraphReader::GraphReader(const boost::property_tree::ptree& pt,
+                         std::unique_ptr<TileCache>&& cache)
+    : tile_dir_(pt.get<std::string>("tile_dir")),
+      tile_extract_(get_extract_instance(pt)),
+      cache_(std::move(cache)) {
+  cache_->Reserve(tile_extract_->tiles.empty() ? AVERAGE_TILE_SIZE : AVERAGE_MM_TILE_SIZE);
+}
+
 // Method to test if tile exists
 bool GraphReader::DoesTileExist(const GraphId& graphid) const {
   //if you are using an extract only check that
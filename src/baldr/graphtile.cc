@@ -9,6 +9,7 @@
 #include <ctime>
 #include <string>
 #include <vector>
+#include <algorithm>
 #include <iostream>
 #include <fstream>
 #include <locale>
@@ -65,7 +66,9 @@ GraphTile::GraphTile()
       traffic_chunk_size_(0),
       lane_connectivity_(nullptr),
       lane_connectivity_size_(0),
-      edge_elevation_(nullptr) {
+      edge_elevation_(nullptr),
+      speed_profiles_(nullptr),
+      speed_profile_count_(0) {
 }
 
 // Constructor given a filename. Reads the graph data into memory.
@@ -216,6 +219,12 @@ void GraphTile::Initialize(const GraphId& graphid, char* tile_ptr,
   // is not fixed size and count).
   // example_size_ = header_->end_offset() - header_->example_offset();
 
+  // Start of the speed profiles and their count. Tiles from before speed
+  // profiles have the end offset in this slot so the count is 0.
+  speed_profiles_ = reinterpret_cast<SpeedProfile*>(tile_ptr + header_->speed_profile_offset());
+  speed_profile_count_ = (header_->end_offset() - header_->speed_profile_offset()) /
+                          sizeof(SpeedProfile);
+
   // ANY NEW EXPANSION DATA GOES HERE
 
   // Associate one stop Ids for transit tiles
@@ -584,6 +593,30 @@ std::vector<LaneConnectivity> GraphTile::GetLaneConnectivity(const uint32_t idx)
   return lcs;
 }
 
+// Get the historical speed profile for a directed edge.
+const SpeedProfile* GraphTile::speed_profile(const uint32_t idx) const {
+  // Speed profiles are sorted by edge index
+  auto found = std::lower_bound(speed_profiles_, speed_profiles_ + speed_profile_count_, idx,
+      [](const SpeedProfile& profile, const uint32_t idx) {
+        return profile.edgeindex() < idx;
+      });
+  if (found == speed_profiles_ + speed_profile_count_ || found->edgeindex() != idx) {
+    return nullptr;
+  }
+  return found;
+}
+
+// Get the speed along a directed edge at a time of the week.
+uint32_t GraphTile::GetSpeed(const DirectedEdge* de, const uint32_t seconds_of_week) const {
+  if (de->speed_profile()) {
+    const SpeedProfile* profile = speed_profile(de - directededges_);
+    if (profile != nullptr) {
+      return profile->speed(seconds_of_week);
+    }
+  }
+  return de->speed();
+}
+
 // Get the next departure given the directed line Id and the current
 // time (seconds from midnight).
 const TransitDeparture* GraphTile::GetNextDeparture(const uint32_t lineid,
@@ -79,6 +79,8 @@ rapidjson::Value Location::ToRapidJson(rapidjson::Document::AllocatorType& a) co
     location.AddMember("date_time", *date_time_, a);
   if(heading_)
     location.AddMember("heading", *heading_, a);
+  if(heading_tolerance_)
+    location.AddMember("heading_tolerance", *heading_tolerance_, a);
   if(way_id_)
     location.AddMember("way_id", *way_id_, a);
 
@@ -145,6 +147,7 @@ Location Location::FromRapidJson(const rapidjson::Value& d, unsigned int default
 
   location.date_time_ = GetOptionalFromRapidJson<std::string>(d, "/date_time");
   location.heading_ = GetOptionalFromRapidJson<int>(d, "/heading");
+  location.heading_tolerance_ = GetOptionalFromRapidJson<int>(d, "/heading_tolerance");
   location.way_id_ = GetOptionalFromRapidJson<uint64_t>(d, "/way_id");
 
   location.minimum_reachability_ = GetFromRapidJson<unsigned int>(d, "/minimum_reachability", default_reachability);
@@ -95,5 +95,19 @@ namespace baldr{
     return p;
   }
 
+  PathLocation PathLocation::FromRapidJson(const std::vector<Location>& locations, const rapidjson::Value& path_location){
+    auto index = GetFromRapidJson<size_t>(path_location, "/location_index");
+    PathLocation p(locations.at(index));
+    auto edges = GetFromRapidJson<rapidjson::Value::ConstArray>(path_location, "/edges");
+    p.edges.reserve(edges.Size());
+    for(const auto& edge : edges) {
+      p.edges.emplace_back(GraphId(GetFromRapidJson<uint64_t>(edge, "/id")), GetFromRapidJson<float>(edge, "/dist"),
+        midgard::PointLL(GetFromRapidJson<double>(edge, "/projected/lon"), GetFromRapidJson<double>(edge, "/projected/lat")),
+        GetFromRapidJson<float>(edge, "/score"), static_cast<SideOfStreet>(GetFromRapidJson<int>(edge, "/sos")),
+        GetFromRapidJson<int>(edge, "/minimum_reachability"));
+    }
+    return p;
+  }
+
 }
 }
@@ -0,0 +1,53 @@
+#include <cmath>
+#include <algorithm>
+#include "baldr/speedprofile.h"
+#include "baldr/graphconstants.h"
+
+namespace valhalla {
+namespace baldr {
+
+// Constructor with arguments
+SpeedProfile::SpeedProfile(const uint32_t edgeindex,
+                           const std::vector<uint32_t>& speeds)
+    : edgeindex_(edgeindex),
+      spare_(0),
+      speeds_{},
+      spare2_{} {
+  for (uint32_t i = 0; i < kSpeedBucketCount && i < speeds.size(); i++) {
+    speeds_[i] = std::min(speeds[i], kMaxSpeedKph);
+  }
+}
+
+// Get the internal edge index to which this speed profile applies.
+uint32_t SpeedProfile::edgeindex() const {
+  return edgeindex_;
+}
+
+// Set the directed edge index to which this speed profile applies.
+void SpeedProfile::set_edgeindex(const uint32_t edgeindex) {
+  edgeindex_ = edgeindex;
+}
+
+// Get the average speed for an hour of the week.
+uint32_t SpeedProfile::bucket_speed(const uint32_t bucket) const {
+  return speeds_[bucket % kSpeedBucketCount];
+}
+
+// Get the speed at a time of the week. Each hourly average applies to the
+// middle of its hour, in between two middles the speed changes linearly.
+uint32_t SpeedProfile::speed(const uint32_t seconds_of_week) const {
+  uint32_t s = (seconds_of_week + kSecondsPerWeek - kSpeedBucketSeconds / 2) % kSecondsPerWeek;
+  uint32_t bucket = s / kSpeedBucketSeconds;
+  float f = static_cast<float>(s % kSpeedBucketSeconds) / kSpeedBucketSeconds;
+  float from = speeds_[bucket];
+  float to = speeds_[(bucket + 1) % kSpeedBucketCount];
+  return static_cast<uint32_t>(std::round(from + (to - from) * f));
+}
+
+// Sort by edge index.
+bool SpeedProfile::operator < (const SpeedProfile& other) const {
+  return edgeindex() < other.edgeindex();
+}
+
+}
+}
@@ -1,5 +1,14 @@
 #include <string>
 #include <sstream>
+#include <vector>
+#include <list>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <future>
+#include <functional>
+#include <condition_variable>
 #include <boost/noncopyable.hpp>
 #include <boost/shared_ptr.hpp>
 #include <boost/make_shared.hpp>
@@ -10,14 +19,16 @@
 
 #include "midgard/logging.h"
 #include "meili/traffic_segment_matcher.h"
+#include "tyr/actor.h"
 
 namespace {
 
   //statically set the config file and configure logging, throw if you never configured
   //configuring multiple times is wasteful/ineffectual but not harmful
-  //TODO: make this threadsafe just in case its abused
   const boost::property_tree::ptree& configure(const boost::optional<std::string>& config = boost::none) {
+    static std::mutex config_lock;
     static boost::optional<boost::property_tree::ptree> pt;
+    std::lock_guard<std::mutex> lock(config_lock);
     //if we haven't already loaded one
     if(config && !pt) {
       try {
@@ -46,6 +57,190 @@ namespace {
   void py_configure(const std::string& config_file) {
     configure(config_file);
   }
+
+  //lets other python threads run while we are off doing native work
+  //NOTE: nothing in here may touch python objects
+  struct gil_release_t {
+    gil_release_t(): state(PyEval_SaveThread()) { }
+    ~gil_release_t() { PyEval_RestoreThread(state); }
+    PyThreadState* state;
+  };
+
+  //each thread, python or pool, gets its own actor and its own segment matcher, so one
+  //set of tile caches per thread rather than one per request
+  valhalla::tyr::actor_t& get_actor() {
+    thread_local std::unique_ptr<valhalla::tyr::actor_t> actor;
+    if(!actor)
+      actor.reset(new valhalla::tyr::actor_t(configure()));
+    return *actor;
+  }
+  valhalla::meili::TrafficSegmentMatcher& get_matcher() {
+    thread_local std::unique_ptr<valhalla::meili::TrafficSegmentMatcher> matcher;
+    if(!matcher)
+      matcher.reset(new valhalla::meili::TrafficSegmentMatcher(configure()));
+    return *matcher;
+  }
+
+  //a fixed set of threads that live as long as the module so that their
+  //actors and the tiles cached in them survive from one call to the next
+  class thread_pool_t {
+   public:
+    thread_pool_t(size_t thread_count): done(false) {
+      for(size_t i = 0; i < thread_count; ++i) {
+        threads.emplace_back([this]() {
+          while(true) {
+            std::function<void ()> task;
+            {
+              std::unique_lock<std::mutex> lock(queue_lock);
+              signal.wait(lock, [this]() { return done || !tasks.empty(); });
+              if(done && tasks.empty())
+                return;
+              task = std::move(tasks.front());
+              tasks.pop_front();
+            }
+            task();
+          }
+        });
+      }
+    }
+
+    ~thread_pool_t() {
+      {
+        std::lock_guard<std::mutex> lock(queue_lock);
+        done = true;
+      }
+      signal.notify_all();
+      for(auto& thread : threads)
+        thread.join();
+    }
+
+    template <class result_t>
+    std::future<result_t> submit(const std::function<result_t ()>& function) {
+      auto task = std::make_shared<std::packaged_task<result_t ()> >(function);
+      auto future = task->get_future();
+      {
+        std::lock_guard<std::mutex> lock(queue_lock);
+        tasks.emplace_back([task](){ (*task)(); });
+      }
+      signal.notify_one();
+      return future;
+    }
+
+    size_t size() const { return threads.size(); }
+
+   protected:
+    std::vector<std::thread> threads;
+    std::deque<std::function<void ()> > tasks;
+    std::mutex queue_lock;
+    std::condition_variable signal;
+    bool done;
+  };
+
+  thread_pool_t& get_pool() {
+    static thread_pool_t pool(std::max<size_t>(std::thread::hardware_concurrency(), 1));
+    return pool;
+  }
+
+  //get the strings out of python before we let go of the interpreter
+  std::vector<std::string> to_strings(const boost::python::list& list) {
+    std::vector<std::string> strings;
+    strings.reserve(boost::python::len(list));
+    for(boost::python::ssize_t i = 0; i < boost::python::len(list); ++i)
+      strings.emplace_back(boost::python::extract<std::string>(list[i]));
+    return strings;
+  }
+  boost::python::list to_list(const std::vector<std::string>& strings) {
+    boost::python::list list;
+    for(const auto& string : strings)
+      list.append(string);
+    return list;
+  }
+
+  //a single request is done on the calling thread, a list of them is spread over the pool
+  boost::python::object act(const std::string& path, const boost::python::object& requests) {
+    configure();
+    boost::python::extract<std::string> single(requests);
+    if(single.check()) {
+      std::string request = single();
+      std::string response;
+      {
+        gil_release_t release;
+        response = get_actor().act(path, request);
+      }
+      return boost::python::str(response);
+    }
+
+    auto jsons = to_strings(boost::python::extract<boost::python::list>(requests));
+    std::vector<std::string> responses;
+    {
+      gil_release_t release;
+      std::vector<std::future<std::string> > futures;
+      futures.reserve(jsons.size());
+      for(const auto& json : jsons)
+        futures.emplace_back(get_pool().submit<std::string>([&path, &json]() { return get_actor().act(path, json); }));
+      //any exception is rethrown here, and after this block python gets it
+      for(auto& future : futures)
+        future.wait();
+      for(auto& future : futures)
+        responses.emplace_back(future.get());
+    }
+    return to_list(responses);
+  }
+
+  boost::python::object py_route(const boost::python::object& r) { return act("/route", r); }
+  boost::python::object py_locate(const boost::python::object& r) { return act("/locate", r); }
+  boost::python::object py_matrix(const boost::python::object& r) { return act("/sources_to_targets", r); }
+  boost::python::object py_optimized_route(const boost::python::object& r) { return act("/optimized_route", r); }
+  boost::python::object py_optimized_fleet(const boost::python::object& r) { return act("/optimized_fleet", r); }
+  boost::python::object py_isochrone(const boost::python::object& r) { return act("/isochrone", r); }
+  boost::python::object py_trace_route(const boost::python::object& r) { return act("/trace_route", r); }
+  boost::python::object py_trace_attributes(const boost::python::object& r) { return act("/trace_attributes", r); }
+
+  //the segment matcher python gets to hold. a matcher cant be used by more than one thread at
+  //a time so python threads that share one take turns with it
+  struct segment_matcher_t {
+    segment_matcher_t(): matcher(configure()) { }
+    valhalla::meili::TrafficSegmentMatcher matcher;
+    std::mutex lock;
+  };
+
+  std::string py_match(segment_matcher_t& matcher, const std::string& trace) {
+    //let go of the interpreter before waiting on another python thread to finish with it
+    gil_release_t release;
+    std::lock_guard<std::mutex> lock(matcher.lock);
+    return matcher.matcher.match(trace);
+  }
+
+  //match a whole list of traces in one call. the list is cut into one chunk per pool thread
+  //plus one for the calling thread, which matches the first chunk with the matcher it was
+  //called on while each pool thread runs another chunk through its own matcher
+  boost::python::list py_match_many(segment_matcher_t& matcher, const boost::python::list& traces) {
+    configure();
+    auto jsons = to_strings(traces);
+    std::vector<std::string> segments;
+    {
+      gil_release_t release;
+      auto chunk_size = std::max<size_t>((jsons.size() + get_pool().size()) / (get_pool().size() + 1), 1);
+      std::vector<std::future<std::vector<std::string> > > futures;
+      for(size_t i = chunk_size; i < jsons.size(); i += chunk_size) {
+        std::vector<std::string> chunk(jsons.begin() + i, jsons.begin() + std::min(i + chunk_size, jsons.size()));
+        futures.emplace_back(get_pool().submit<std::vector<std::string> >([chunk]() { return get_matcher().match(chunk); }));
+      }
+      std::vector<std::string> first(jsons.begin(), jsons.begin() + std::min(chunk_size, jsons.size()));
+      {
+        std::lock_guard<std::mutex> lock(matcher.lock);
+        segments = matcher.matcher.match(first);
+      }
+      for(auto& future : futures)
+        future.wait();
+      segments.reserve(jsons.size());
+      for(auto& future : futures) {
+        auto chunk = future.get();
+        std::move(chunk.begin(), chunk.end(), std::back_inserter(segments));
+      }
+    }
+    return to_list(segments);
+  }
 }
 
 BOOST_PYTHON_MODULE(valhalla) {
@@ -53,10 +248,22 @@ BOOST_PYTHON_MODULE(valhalla) {
   //python interface for configuring the system, always call this first in your python program
   boost::python::def("Configure", py_configure);
 
+  //the service actions, each takes a json request string and returns the json response
+  //string or takes a list of them and returns a list of responses in the same order
+  boost::python::def("Route", py_route);
+  boost::python::def("Locate", py_locate);
+  boost::python::def("Matrix", py_matrix);
+  boost::python::def("OptimizedRoute", py_optimized_route);
+  boost::python::def("OptimizedFleet", py_optimized_fleet);
+  boost::python::def("Isochrone", py_isochrone);
+  boost::python::def("TraceRoute", py_trace_route);
+  boost::python::def("TraceAttributes", py_trace_attributes);
+
   //class for doing matching to traffic segments. Pass in the config to the constructor
-  boost::python::class_<valhalla::meili::TrafficSegmentMatcher, boost::noncopyable,
-                       boost::shared_ptr<valhalla::meili::TrafficSegmentMatcher> >
+  boost::python::class_<segment_matcher_t, boost::noncopyable,
+                       boost::shared_ptr<segment_matcher_t> >
         ("SegmentMatcher", boost::python::no_init)
-      .def("__init__", boost::python::make_constructor(+[](){ return boost::make_shared<valhalla::meili::TrafficSegmentMatcher>(configure()); }))
-      .def("Match", &valhalla::meili::TrafficSegmentMatcher::match);
+      .def("__init__", boost::python::make_constructor(+[](){ return boost::make_shared<segment_matcher_t>(); }))
+      .def("Match", py_match)
+      .def("MatchMany", py_match_many);
 }
@@ -7,10 +7,6 @@
 using namespace prime_server;
 using namespace valhalla::baldr;
 
-namespace {
-const headers_t::value_type CORS{"Access-Control-Allow-Origin", "*"};
-}
-
 namespace valhalla {
   namespace loki {
 
@@ -40,7 +36,7 @@ namespace valhalla {
       }
       parse_costing(request);
     }
-    worker_t::result_t loki_worker_t::isochrones(rapidjson::Document& request, http_request_info_t& request_info) {
+    void loki_worker_t::isochrones(rapidjson::Document& request) {
       init_isochrones(request);
       //check that location size does not exceed max
       if (locations.size() > max_locations.find("isochrone")->second)
@@ -60,9 +56,8 @@ namespace valhalla {
       auto date_time_value = GetOptionalFromRapidJson<std::string>(request, "/date_time/value");
       if (date_type) {
         //not yet on this
-        if(! date_type || *date_type == 2) {
-          jsonify_error({501, 142}, request_info);
-        }
+        if(! date_type || *date_type == 2)
+          throw valhalla_exception_t{501, 142};
         //what kind
         switch(*date_type) {
         case 0: //current
@@ -91,12 +86,6 @@ namespace valhalla {
       catch(const std::exception&) {
         throw valhalla_exception_t{400, 171};
       }
-
-      //pass it on
-      worker_t::result_t result{true};
-      result.messages.emplace_back(rapidjson::to_string(request));
-
-      return result;
     }
 
   }
@@ -3,6 +3,7 @@
 #include "loki/search.h"
 
 #include "baldr/json.h"
+#include "baldr/json_writer.h"
 #include "baldr/pathlocation.h"
 #include "baldr/rapidjson_utils.h"
 #include "midgard/logging.h"
@@ -11,12 +12,12 @@ using namespace prime_server;
 using namespace valhalla::baldr;
 
 namespace {
-  const headers_t::value_type CORS{"Access-Control-Allow-Origin", "*"};
-  const headers_t::value_type JSON_MIME{"Content-type", "application/json;charset=utf-8"};
-  const headers_t::value_type JS_MIME{"Content-type", "application/javascript;charset=utf-8"};
+  const char* side_of_street(const PathLocation::PathEdge& edge) {
+    return edge.sos == PathLocation::LEFT ? "left" : (edge.sos == PathLocation::RIGHT ? "right" : "neither");
+  }
 
-  json::ArrayPtr serialize_edges(const PathLocation& location, GraphReader& reader, bool verbose) {
-    auto array = json::array({});
+  void serialize_edges(const PathLocation& location, GraphReader& reader, bool verbose, json::writer_t& writer) {
+    writer.start_array("edges");
     for(const auto& edge : location.edges) {
       try {
         //get the osm way id
@@ -26,38 +27,30 @@ namespace {
         //they want MOAR!
         if(verbose) {
           auto segments = tile->GetTrafficSegments(edge.id);
-          auto segments_array = json::array({});
+          writer.start_object();
+          writer("correlated_lat", json::fp_t{edge.projected.lat(), 6});
+          writer("correlated_lon", json::fp_t{edge.projected.lng(), 6});
+          writer("side_of_street", side_of_street(edge));
+          writer("percent_along", json::fp_t{edge.dist, 5});
+          writer("score", json::fp_t{edge.score, 1});
+          writer("minimum_reachability", static_cast<int64_t>(edge.minimum_reachability));
+          writer("edge_id", edge.id.json());
+          writer("edge", directed_edge->json());
+          writer("edge_info", edge_info.json());
+          writer.start_array("traffic_segments");
           for(const auto& segment : segments)
-            segments_array->emplace_back(segment.json());
-          array->emplace_back(json::map({
-            {"correlated_lat", json::fp_t{edge.projected.lat(), 6}},
-            {"correlated_lon", json::fp_t{edge.projected.lng(), 6}},
-            {"side_of_street",
-              edge.sos == PathLocation::LEFT ? std::string("left") :
-                (edge.sos == PathLocation::RIGHT ? std::string("right") : std::string("neither"))
-            },
-            {"percent_along", json::fp_t{edge.dist, 5} },
-            {"score", json::fp_t{edge.score, 1}},
-            {"minimum_reachability", static_cast<int64_t>(edge.minimum_reachability)},
-            {"edge_id", edge.id.json()},
-            {"edge", directed_edge->json()},
-            {"edge_info", edge_info.json()},
-            {"traffic_segments", segments_array},
-          }));
+            writer(segment.json());
+          writer.end_array();
+          writer.end_object();
         }//they want it lean and mean
         else {
-          array->emplace_back(
-            json::map({
-              {"way_id", edge_info.wayid()},
-              {"correlated_lat", json::fp_t{edge.projected.lat(), 6}},
-              {"correlated_lon", json::fp_t{edge.projected.lng(), 6}},
-              {"side_of_street",
-                edge.sos == PathLocation::LEFT ? std::string("left") :
-                  (edge.sos == PathLocation::RIGHT ? std::string("right") : std::string("neither"))
-              },
-              {"percent_along", json::fp_t{edge.dist, 5} },
-            })
-          );
+          writer.start_object();
+          writer("way_id", edge_info.wayid());
+          writer("correlated_lat", json::fp_t{edge.projected.lat(), 6});
+          writer("correlated_lon", json::fp_t{edge.projected.lng(), 6});
+          writer("side_of_street", side_of_street(edge));
+          writer("percent_along", json::fp_t{edge.dist, 5});
+          writer.end_object();
         }
       }
       catch(...) {
@@ -65,64 +58,60 @@ namespace {
         LOG_WARN("Expected edge not found in graph but found by loki::search!");
       }
     }
-    return array;
+    writer.end_array();
   }
 
-  json::ArrayPtr serialize_nodes(const PathLocation& location, GraphReader& reader, bool verbose) {
+  void serialize_nodes(const PathLocation& location, GraphReader& reader, bool verbose, json::writer_t& writer) {
     //get the nodes we need
     std::unordered_set<uint64_t> nodes;
     for(const auto& e : location.edges)
       if(e.end_node())
         nodes.emplace(reader.GetGraphTile(e.id)->directededge(e.id)->endnode());
-    //ad them into an array of json
-    auto array = json::array({});
+    //write them into an array of json
+    writer.start_array("nodes");
     for(auto node_id : nodes) {
       GraphId n(node_id);
       const GraphTile* tile = reader.GetGraphTile(n);
       auto* node_info = tile->node(n);
-      json::MapPtr node;
       if(verbose) {
-        node = node_info->json(tile);
+        auto node = node_info->json(tile);
         node->emplace("node_id", n.json());
+        writer(node);
       }
       else {
-        node = json::map({
-          {"lon", json::fp_t{node_info->latlng().first, 6}},
-          {"lat", json::fp_t{node_info->latlng().second, 6}},
-          //TODO: osm_id
-        });
+        writer.start_object();
+        writer("lon", json::fp_t{node_info->latlng().first, 6});
+        writer("lat", json::fp_t{node_info->latlng().second, 6});
+        //TODO: osm_id
+        writer.end_object();
       }
-      array->emplace_back(node);
     }
-    //give them back
-    return array;
+    writer.end_array();
   }
 
-  json::MapPtr serialize(const boost::optional<std::string>& id, const PathLocation& location, GraphReader& reader, bool verbose) {
+  void serialize(const boost::optional<std::string>& id, const PathLocation& location, GraphReader& reader, bool verbose,
+    json::writer_t& writer) {
     //serialze all the edges
-    auto m = json::map
-    ({
-      {"edges", serialize_edges(location, reader, verbose)},
-      {"nodes", serialize_nodes(location, reader, verbose)},
-      {"input_lat", json::fp_t{location.latlng_.lat(), 6}},
-      {"input_lon", json::fp_t{location.latlng_.lng(), 6}},
-    });
-    return m;
+    writer.start_object();
+    serialize_edges(location, reader, verbose, writer);
+    serialize_nodes(location, reader, verbose, writer);
+    writer("input_lat", json::fp_t{location.latlng_.lat(), 6});
+    writer("input_lon", json::fp_t{location.latlng_.lng(), 6});
+    writer.end_object();
   }
 
-  json::MapPtr serialize(const boost::optional<std::string>& id, const PointLL& ll, const std::string& reason, bool verbose) {
-    auto m = json::map({
-      {"edges", static_cast<std::nullptr_t>(nullptr)},
-      {"nodes", static_cast<std::nullptr_t>(nullptr)},
-      {"input_lat", json::fp_t{ll.lat(), 6}},
-      {"input_lon", json::fp_t{ll.lng(), 6}},
-    });
+  void serialize(const boost::optional<std::string>& id, const PointLL& ll, const std::string& reason, bool verbose,
+    json::writer_t& writer) {
+    writer.start_object();
+    writer("edges", nullptr);
+    writer("nodes", nullptr);
+    writer("input_lat", json::fp_t{ll.lat(), 6});
+    writer("input_lon", json::fp_t{ll.lng(), 6});
     if(verbose)
-      m->emplace("reason", reason);
+      writer("reason", reason);
     /*if(id)
-      m->emplace("id", *id);*/
-
-    return m;
+      writer("id", *id);*/
+    writer.end_object();
   }
 }
 
@@ -141,36 +130,30 @@ namespace valhalla {
       }
     }
 
-    worker_t::result_t loki_worker_t::locate(rapidjson::Document& request, http_request_info_t& request_info) {
+    std::string loki_worker_t::locate(rapidjson::Document& request) {
       init_locate(request);
       //correlate the various locations to the underlying graph
-      auto json = json::array({});
       bool verbose = GetOptionalFromRapidJson<bool>(request, "/verbose").get_value_or(false);
       const auto projections = loki::Search(locations, reader, edge_filter, node_filter);
       auto id = GetOptionalFromRapidJson<std::string>(request, "/id");
-      for(const auto& location : locations) {
-        try {
-          json->emplace_back(serialize(id, projections.at(location), reader, verbose));
-        }
-        catch(const std::exception& e) {
-          json->emplace_back(serialize(id, location.latlng_, "No data found for location", verbose));
-        }
-      }
 
-      std::ostringstream stream;
       //jsonp callback if need be
+      writer.clear();
       auto jsonp = GetOptionalFromRapidJson<std::string>(request, "/jsonp");
       if(jsonp)
-        stream << *jsonp << '(';
-      stream << *json;
+        writer.raw(*jsonp + '(');
+      writer.start_array();
+      for(const auto& location : locations) {
+        auto projection = projections.find(location);
+        if(projection != projections.cend())
+          serialize(id, projection->second, reader, verbose, writer);
+        else
+          serialize(id, location.latlng_, "No data found for location", verbose, writer);
+      }
+      writer.end_array();
       if(jsonp)
-        stream << ')';
-
-      worker_t::result_t result{false};
-      http_response_t response(200, "OK", stream.str(), headers_t{CORS, jsonp ? JS_MIME : JSON_MIME});
-      response.from_info(request_info);
-      result.messages.emplace_back(response.to_string());
-      return result;
+        writer.raw(")");
+      return writer.str();
     }
 
   }
@@ -10,6 +10,7 @@
 #include "midgard/logging.h"
 
 using namespace prime_server;
+using namespace valhalla;
 using namespace valhalla::baldr;
 using namespace valhalla::loki;
 
@@ -31,13 +32,10 @@ namespace {
      {loki_worker_t::MANY_TO_ONE, "many_to_one"},
      {loki_worker_t::MANY_TO_MANY, "many_to_many"},
      {loki_worker_t::SOURCES_TO_TARGETS, "sources_to_targets"},
-     {loki_worker_t::OPTIMIZED_ROUTE, "optimized_route"}
+     {loki_worker_t::OPTIMIZED_ROUTE, "optimized_route"},
+     {loki_worker_t::OPTIMIZED_FLEET, "optimized_fleet"}
    };
 
-  const headers_t::value_type CORS{"Access-Control-Allow-Origin", "*"};
-  const headers_t::value_type JSON_MIME{"Content-type", "application/json;charset=utf-8"};
-  const headers_t::value_type JS_MIME{"Content-type", "application/javascript;charset=utf-8"};
-
   void check_distance(const std::vector<Location>& sources, const std::vector<Location>& targets, float matrix_max_distance, float& max_location_distance) {
 
     //see if any locations pairs are unreachable or too far apart
@@ -58,6 +56,23 @@ namespace {
         }
      }
   }
+
+  //the fleet goes between all of the locations so it cant use sources and targets
+  void check_vehicles(const rapidjson::Document& request) {
+    auto request_locations = GetOptionalFromRapidJson<rapidjson::Value::ConstArray>(request, "/locations");
+    if (!request_locations)
+      throw valhalla_exception_t{400, 110};
+    auto request_vehicles = GetOptionalFromRapidJson<rapidjson::Value::ConstArray>(request, "/vehicles");
+    if (!request_vehicles || request_vehicles->Empty())
+      throw valhalla_exception_t{400, 115};
+    //vehicles start and optionally end at one of the locations
+    for(const auto& vehicle : *request_vehicles) {
+      auto start = GetOptionalFromRapidJson<uint32_t>(vehicle, "/start");
+      auto end = GetOptionalFromRapidJson<uint32_t>(vehicle, "/end");
+      if (!start || *start >= request_locations->Size() || (end && *end >= request_locations->Size()))
+        throw valhalla_exception_t{400, 134};
+    }
+  }
 }
 
 namespace valhalla {
@@ -97,6 +112,7 @@ namespace valhalla {
             break;
           case MANY_TO_MANY:
           case OPTIMIZED_ROUTE:
+          case OPTIMIZED_FLEET:
             request.AddMember("targets", rapidjson::Value{request["locations"], allocator}, allocator);
             request.AddMember("sources", *request_locations, allocator);
             targets = locations;
@@ -118,11 +134,13 @@ namespace valhalla {
       parse_costing(request);
     }
 
-    worker_t::result_t loki_worker_t::matrix(ACTION_TYPE action, rapidjson::Document& request, http_request_info_t& request_info) {
+    void loki_worker_t::matrix(ACTION_TYPE action, rapidjson::Document& request) {
+      if (action == OPTIMIZED_FLEET)
+        check_vehicles(request);
       init_matrix(action, request);
       std::string costing = request["costing"].GetString();
       if (costing == "multimodal")
-        return jsonify_error({400, 140, ACTION_TO_STRING.find(action)->second}, request_info);
+        throw valhalla_exception_t{400, 140, ACTION_TO_STRING.find(action)->second};
 
       //check that location size does not exceed max.
       auto max = max_locations.find("sources_to_targets")->second;
@@ -175,11 +193,6 @@ namespace valhalla {
         throw valhalla_exception_t{400, 170};
       if (!healthcheck)
         valhalla::midgard::logging::Log("max_location_distance::" + std::to_string(max_location_distance * kKmPerMeter) + "km", " [ANALYTICS] ");
-
-      worker_t::result_t result{true};
-      result.messages.emplace_back(rapidjson::to_string(request));
-
-      return result;
     }
   }
 }
@@ -12,10 +12,6 @@ using namespace prime_server;
 using namespace valhalla::baldr;
 
 namespace {
-  const headers_t::value_type CORS{"Access-Control-Allow-Origin", "*"};
-  const headers_t::value_type JSON_MIME{"Content-type", "application/json;charset=utf-8"};
-  const headers_t::value_type JS_MIME{"Content-type", "application/javascript;charset=utf-8"};
-
   void check_locations(const size_t location_count, const size_t max_locations) {
     //check that location size does not exceed max.
     if (location_count > max_locations)
@@ -48,11 +44,14 @@ namespace valhalla {
       parse_costing(request);
     }
 
-    worker_t::result_t loki_worker_t::route(rapidjson::Document& request, http_request_info_t& request_info) {
+    void loki_worker_t::route(rapidjson::Document& request) {
       init_route(request);
       auto costing = GetOptionalFromRapidJson<std::string>(request, "/costing");
       check_locations(locations.size(), max_locations.find(*costing)->second);
       check_distance(reader, locations, max_distance.find(*costing)->second);
+      auto alternates = GetOptionalFromRapidJson<unsigned int>(request, "/alternates");
+      if (alternates && *alternates > max_alternates)
+        throw valhalla_exception_t{400, 159, std::to_string(max_alternates)};
       auto& allocator = request.GetAllocator();
 
       // Validate walking distances (make sure they are in the accepted range)
@@ -82,7 +81,7 @@ namespace valhalla {
       if (boost::optional<int> date_type = GetOptionalFromRapidJson<int>(request, "/date_time/type")) {
         //not yet on this
         if(*date_type == 2 && (*costing == "multimodal" || *costing == "transit"))
-          return jsonify_error({501, 141}, request_info);
+          throw valhalla_exception_t{501, 141};
 
         //what kind
         switch(*date_type) {
@@ -101,7 +100,7 @@ namespace valhalla {
             throw valhalla_exception_t{400, 161};
           if (!DateTime::is_iso_local(*date_time_value))
             throw valhalla_exception_t{400, 162};
-          locations_array.End()->AddMember("date_time", *date_time_value, allocator);
+          (locations_array.End() - 1)->AddMember("date_time", *date_time_value, allocator);
           break;
         default:
           throw valhalla_exception_t{400, 163};
@@ -143,16 +142,6 @@ namespace valhalla {
       }
       if(!connected)
         throw valhalla_exception_t{400, 170};
-
-      //ok send on the request with correlated origin and destination filled out
-      //using the boost ptree info format
-      //TODO: make a protobuf request object and pass that along, can become
-      //part of thors path proto object and then get copied into odins trip object
-      //in fact just do this for all request types
-      worker_t::result_t result{true};
-      result.messages.emplace_back(rapidjson::to_string(request));
-
-      return result;
     }
   }
 }
@@ -39,12 +39,20 @@ namespace {
     {"/optimized_route", loki_worker_t::OPTIMIZED_ROUTE},
     {"/isochrone", loki_worker_t::ISOCHRONE},
     {"/trace_route", loki_worker_t::TRACE_ROUTE},
-    {"/trace_attributes", loki_worker_t::TRACE_ATTRIBUTES}
+    {"/trace_attributes", loki_worker_t::TRACE_ATTRIBUTES},
+    {"/optimized_fleet", loki_worker_t::OPTIMIZED_FLEET}
   };
 
   const headers_t::value_type CORS{"Access-Control-Allow-Origin", "*"};
   const headers_t::value_type JSON_MIME{"Content-type", "application/json;charset=utf-8"};
   const headers_t::value_type JS_MIME{"Content-type", "application/javascript;charset=utf-8"};
+  const std::string PROTOBUF_MIME{"application/x-protobuf"};
+
+  //a binary body means the json part of the request has to come in the query string
+  bool has_protobuf_body(const http_request_t& request) {
+    auto content_type = request.headers.find("Content-Type");
+    return content_type != request.headers.cend() && content_type->second == PROTOBUF_MIME;
+  }
 
   rapidjson::Document from_request(const loki_worker_t::ACTION_TYPE& action, const http_request_t& request) {
     rapidjson::Document d;
@@ -54,7 +62,7 @@ namespace {
     if (json != request.query.end() && json->second.size() && json->second.front().size())
       d.Parse(json->second.front().c_str());
     //no json parameter, check the body
-    else if(!request.body.empty())
+    else if(!request.body.empty() && !has_protobuf_body(request))
       d.Parse(request.body.c_str());
     //no json at all
     else
@@ -237,7 +245,7 @@ namespace valhalla {
 
       //Build max_locations and max_distance maps
       for (const auto& kv : config.get_child("service_limits")) {
-        if(kv.first == "max_avoid_locations" || kv.first == "max_reachability" || kv.first == "max_radius")
+        if(kv.first == "max_avoid_locations" || kv.first == "max_reachability" || kv.first == "max_radius" || kv.first == "max_alternates")
           continue;
         if (kv.first != "skadi" && kv.first != "trace")
           max_locations.emplace(kv.first, config.get<size_t>("service_limits." + kv.first + ".max_locations"));
@@ -260,6 +268,7 @@ namespace valhalla {
       max_reachability = config.get<unsigned int>("service_limits.max_reachability");
       default_reachability = config.get<unsigned int>("loki.service_defaults.minimum_reachability");
       max_radius = config.get<unsigned long>("service_limits.max_radius");
+      max_alternates = config.get<unsigned int>("service_limits.max_alternates", 2);
       default_radius = config.get<unsigned long>("loki.service_defaults.radius");
       max_gps_accuracy = config.get<float>("service_limits.trace.max_gps_accuracy");
       max_search_radius = config.get<float>("service_limits.trace.max_search_radius");
@@ -278,8 +287,6 @@ namespace valhalla {
     }
 
     worker_t::result_t loki_worker_t::work(const std::list<zmq::message_t>& job, void* request_info, const worker_t::interrupt_function_t&) {
-      //get time for start of request
-      auto s = std::chrono::system_clock::now();
       auto& info = *static_cast<http_request_info_t*>(request_info);
       LOG_INFO("Got Loki Request " + std::to_string(info.id));
 
@@ -287,65 +294,26 @@ namespace valhalla {
         //request parsing
         auto request = http_request_t::from_string(static_cast<const char*>(job.front().data()), job.front().size());
 
-        //block all but get and post
-        if(request.method != method_t::POST && request.method != method_t::GET)
-          return jsonify_error({405, 101}, info);
-
-        //is the request path action in the action set?
-        auto action = PATH_TO_ACTION.find(request.path);
-        if (action == PATH_TO_ACTION.cend() || actions.find(request.path) == actions.cend())
-          return jsonify_error({404, 106, action_str}, info);
-
-        //parse the query's json
-        auto request_rj = from_request(action->second, request);
-        jsonp = GetOptionalFromRapidJson<std::string>(request_rj, "/jsonp");
-        //let further processes more easily know what kind of request it was
-        rapidjson::SetValueByPointer(request_rj, "/action", action->second);
-        //flag healthcheck requests; do not send to logstash
-        healthcheck = GetOptionalFromRapidJson<bool>(request_rj, "/healthcheck").get_value_or(false);
-        //let further processes know about tracking
-        auto do_not_track = request.headers.find("DNT");
-        info.spare = do_not_track != request.headers.cend() && do_not_track->second == "1";
-
-        worker_t::result_t result{false};
-        //do request specific processing
-        switch (action->second) {
-          case ROUTE:
-          case VIAROUTE:
-            result = route(request_rj, info);
-            break;
-          case LOCATE:
-            result = locate(request_rj, info);
-            break;
-          case ONE_TO_MANY:
-          case MANY_TO_ONE:
-          case MANY_TO_MANY:
-          case SOURCES_TO_TARGETS:
-          case OPTIMIZED_ROUTE:
-            result = matrix(action->second, request_rj, info);
-            break;
-          case ISOCHRONE:
-            result = isochrones(request_rj, info);
-            break;
-          case TRACE_ATTRIBUTES:
-          case TRACE_ROUTE:
-            result = trace_route(action->second, request_rj, info);
-            break;
-          default:
-            //apparently you wanted something that we figured we'd support but havent written yet
-            return jsonify_error({501, 107}, info);
-        }
-        //get processing time for loki
-        auto e = std::chrono::system_clock::now();
-        std::chrono::duration<float, std::milli> elapsed_time = e - s;
-        //log request if greater than X (ms)
-        auto work_units = locations.size() ? locations.size() : 1;
-        if (!healthcheck && !info.spare && elapsed_time.count() / work_units > long_request) {
-          LOG_WARN("loki::request elapsed time (ms)::"+ std::to_string(elapsed_time.count()));
-          LOG_WARN("loki::request exceeded threshold::"+ rapidjson::to_string(request_rj));
-          midgard::logging::Log("valhalla_loki_long_request", " [ANALYTICS] ");
+        //do our part of it
+        rapidjson::Document request_rj;
+        odin::Trace request_trace;
+        auto response = act(request, info, request_rj, request_trace);
+
+        //we answered it ourselves
+        if(response) {
+          worker_t::result_t result{false};
+          http_response_t http_response(200, "OK", *response, headers_t{CORS, jsonp ? JS_MIME : JSON_MIME});
+          http_response.from_info(info);
+          result.messages.emplace_back(http_response.to_string());
+          return result;
         }
 
+        //send on the request with correlated locations filled out, trace requests
+        //also get their shape in binary as the next message
+        worker_t::result_t result{true};
+        result.messages.emplace_back(rapidjson::to_string(request_rj));
+        if(request_trace.lat_size())
+          result.messages.emplace_back(request_trace.SerializeAsString());
         return result;
       }
       catch(const valhalla_exception_t& e) {
@@ -358,12 +326,84 @@ namespace valhalla {
       }
     }
 
+    boost::optional<std::string> loki_worker_t::act(const http_request_t& request, http_request_info_t& info,
+      rapidjson::Document& request_rj, odin::Trace& request_trace) {
+      //get time for start of request
+      auto s = std::chrono::system_clock::now();
+
+      //block all but get and post
+      if(request.method != method_t::POST && request.method != method_t::GET)
+        throw valhalla_exception_t{405, 101};
+
+      //is the request path action in the action set?
+      auto action = PATH_TO_ACTION.find(request.path);
+      if (action == PATH_TO_ACTION.cend() || actions.find(request.path) == actions.cend())
+        throw valhalla_exception_t{404, 106, action_str};
+
+      //parse the query's json
+      request_rj = from_request(action->second, request);
+      jsonp = GetOptionalFromRapidJson<std::string>(request_rj, "/jsonp");
+      //let further processes more easily know what kind of request it was
+      rapidjson::SetValueByPointer(request_rj, "/action", action->second);
+      //flag healthcheck requests; do not send to logstash
+      healthcheck = GetOptionalFromRapidJson<bool>(request_rj, "/healthcheck").get_value_or(false);
+      //let further processes know about tracking
+      auto do_not_track = request.headers.find("DNT");
+      info.spare = do_not_track != request.headers.cend() && do_not_track->second == "1";
+
+      //do request specific processing
+      boost::optional<std::string> response;
+      switch (action->second) {
+        case ROUTE:
+        case VIAROUTE:
+          route(request_rj);
+          break;
+        case LOCATE:
+          response = locate(request_rj);
+          break;
+        case ONE_TO_MANY:
+        case MANY_TO_ONE:
+        case MANY_TO_MANY:
+        case SOURCES_TO_TARGETS:
+        case OPTIMIZED_ROUTE:
+        case OPTIMIZED_FLEET:
+          matrix(action->second, request_rj);
+          break;
+        case ISOCHRONE:
+          isochrones(request_rj);
+          break;
+        case TRACE_ATTRIBUTES:
+        case TRACE_ROUTE:
+          if(has_protobuf_body(request) && !trace.ParseFromString(request.body))
+            throw valhalla_exception_t{400, 102};
+          trace_route(action->second, request_rj);
+          request_trace.Swap(&trace);
+          break;
+        default:
+          //apparently you wanted something that we figured we'd support but havent written yet
+          throw valhalla_exception_t{501, 107};
+      }
+      //get processing time for loki
+      auto e = std::chrono::system_clock::now();
+      std::chrono::duration<float, std::milli> elapsed_time = e - s;
+      //log request if greater than X (ms)
+      auto work_units = locations.size() ? locations.size() : 1;
+      if (!healthcheck && !info.spare && elapsed_time.count() / work_units > long_request) {
+        LOG_WARN("loki::request elapsed time (ms)::"+ std::to_string(elapsed_time.count()));
+        LOG_WARN("loki::request exceeded threshold::"+ rapidjson::to_string(request_rj));
+        midgard::logging::Log("valhalla_loki_long_request", " [ANALYTICS] ");
+      }
+
+      return response;
+    }
+
     void loki_worker_t::cleanup() {
       jsonp = boost::none;
       locations.clear();
       sources.clear();
       targets.clear();
       shape.clear();
+      trace.Clear();
       if(reader.OverCommitted())
         reader.Clear();
     }
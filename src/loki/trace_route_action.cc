@@ -4,6 +4,7 @@
 #include "midgard/pointll.h"
 #include "midgard/logging.h"
 #include "midgard/encoded.h"
+#include "midgard/util.h"
 #include "baldr/rapidjson_utils.h"
 
 #include <boost/property_tree/json_parser.hpp>
@@ -120,42 +121,44 @@ namespace valhalla {
       locations_from_shape(request);
     }
 
-    worker_t::result_t loki_worker_t::trace_route(ACTION_TYPE action, rapidjson::Document& request, http_request_info_t& request_info) {
+    void loki_worker_t::trace_route(ACTION_TYPE action, rapidjson::Document& request) {
       init_trace(request);
       std::string costing = request["costing"].GetString();
       if (costing == "multimodal")
-        return jsonify_error({400, 140, ACTION_TO_STRING.find(action)->second}, request_info);
-
-      //pass it on to thor
-      worker_t::result_t result{true};
-      result.messages.emplace_back(rapidjson::to_string(request));
-      return result;
+        throw valhalla_exception_t{400, 140, ACTION_TO_STRING.find(action)->second};
     }
 
     void loki_worker_t::parse_trace(rapidjson::Document& request) {
-      auto& allocator = request.GetAllocator();
-      //we require uncompressed shape or encoded polyline
+      //we require a binary trace, uncompressed shape or encoded polyline
       auto input_shape = GetOptionalFromRapidJson<rapidjson::Value::Array>(request, "/shape");
       auto encoded_polyline = GetOptionalFromRapidJson<std::string>(request, "/encoded_polyline");
-      //we require shape or encoded polyline but we dont know which at first
+      //we require one of them but we dont know which at first
       try {
-        //uncompressed shape
-        if (input_shape) {
+        //binary trace, which we already decoded from the request body
+        if (trace.lat_size()) {
+          if (trace.lng_size() != trace.lat_size() || (trace.time_size() && trace.time_size() != trace.lat_size()))
+            throw std::runtime_error("Trace columns must all be the same length");
+          shape.reserve(trace.lat_size());
+          for (int i = 0; i < trace.lat_size(); ++i) {
+            if (trace.lat(i) < -90.0f || trace.lat(i) > 90.0f)
+              throw std::runtime_error("Latitude must be in the range [-90, 90] degrees");
+            shape.emplace_back(midgard::circular_range_clamp<float>(trace.lng(i), -180, 180), trace.lat(i));
+          }
+        }//uncompressed shape
+        else if (input_shape) {
+          shape.reserve(input_shape->Size());
           for (const auto& latlng : *input_shape) {
             shape.push_back(Location::FromRapidJson(latlng).latlng_);
+            auto time = GetOptionalFromRapidJson<double>(latlng, "/time");
+            if (time)
+              trace.add_time(*time);
           }
+          //times are all or nothing
+          if (trace.time_size() != static_cast<int>(shape.size()))
+            trace.clear_time();
         }//compressed shape
-        //if we receive as encoded then we need to add as shape to request
         else if (encoded_polyline) {
           shape = midgard::decode<std::vector<midgard::PointLL> >(*encoded_polyline);
-          rapidjson::Value shape_array{rapidjson::kArrayType};
-          for(const auto& pt : shape) {
-            rapidjson::Value point_child{rapidjson::kObjectType};
-            point_child.AddMember("lon", static_cast<double>(pt.first), allocator).
-                AddMember("lat", static_cast<double>(pt.second), allocator);
-            shape_array.PushBack(point_child, allocator);
-          }
-          request.AddMember("shape", shape_array, allocator);
         }/* else if (gpx) {
           //TODO:Add support
         } else if (geojson){
@@ -169,6 +172,17 @@ namespace valhalla {
         throw valhalla_exception_t{400, 114};
       }
 
+      //thor gets the validated shape in binary so it never has to pull shape out of the json
+      //nor see a point that was not clamped the way json input would have been
+      trace.clear_lat();
+      trace.clear_lng();
+      trace.mutable_lat()->Reserve(shape.size());
+      trace.mutable_lng()->Reserve(shape.size());
+      for (const auto& pt : shape) {
+        trace.add_lat(pt.second);
+        trace.add_lng(pt.first);
+      }
+      request.RemoveMember("shape");
     }
 
     void loki_worker_t::locations_from_shape(rapidjson::Document& request) {
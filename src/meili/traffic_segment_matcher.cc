@@ -24,30 +24,6 @@ namespace {
     edges.erase(edge_itr, edges.end());
   }
 
-  bool is_connected(const valhalla::baldr::GraphId& a, const valhalla::baldr::GraphId& b, valhalla::baldr::GraphReader& reader) {
-    //we have to find this node
-    const valhalla::baldr::GraphTile* tile;
-    auto node_b = reader.GetOpposingEdge(b, tile)->endnode();
-    //from edges that leave this node
-    //NOTE: whats the effect if we cant check if its connected
-    if(!reader.GetGraphTile(a, tile))
-      return false;
-    auto node_a = tile->directededge(a)->endnode();
-    if(node_a == node_b)
-      return true;
-    //check the transition edges from the end node
-    //NOTE: whats the effect if we cant check if its connected
-    if(!reader.GetGraphTile(node_a, tile))
-      return false;
-    for(const auto& edge : tile->GetDirectedEdges(node_a)) {
-      if((edge.trans_down() || edge.trans_up()) && edge.endnode() == node_b) {
-        return true;
-      }
-    }
-    //not connected
-    return false;
-  }
-
   //is this edge considered an internal type, an edge that can be ignored for the purposes of ots's
   bool is_internal(const valhalla::baldr::DirectedEdge* edge) {
     return edge->trans_up() || edge->trans_down() || edge->roundabout() ||
@@ -62,37 +38,73 @@ namespace {
     const valhalla::baldr::TrafficSegment* operator->() const { return &segment; }
     valhalla::baldr::TrafficSegment* operator->() { return &segment; }
   };
-  std::vector<merged_traffic_segment_t> merge_segments(const std::vector<valhalla::meili::interpolation_t>& markers, valhalla::baldr::GraphReader& reader) {
+  template <class lookup_t>
+  std::vector<merged_traffic_segment_t> merge_segments(const std::vector<valhalla::meili::interpolation_t>& markers, const lookup_t& lookup) {
     std::vector<merged_traffic_segment_t> merged;
-    const valhalla::baldr::GraphTile* tile = nullptr;
     valhalla::baldr::GraphId edge;
     for(const auto& marker : markers) {
       //skip if its a repeat or we cant get the tile
-      if(marker.edge == edge || !reader.GetGraphTile(marker.edge, tile))
+      const valhalla::meili::tile_associations_t* tile_associations;
+      if(marker.edge == edge || !(tile_associations = lookup(marker.edge)))
         continue;
       //get segments for this edge
       edge = marker.edge;
-      const auto* directed_edge = tile->directededge(edge);
-      auto segments = tile->GetTrafficSegments(edge);
+      const auto& association = tile_associations->edges[edge.id()];
       //if there were no segments we'll start an invalid one to serve
       //as a placeholder for the section of the path that has no ots's
-      if(segments.empty())
-        segments = { valhalla::baldr::TrafficSegment{{}, marker.edge_distance, marker.edge_distance, true, true} };
+      valhalla::baldr::TrafficSegment placeholder{{}, marker.edge_distance, marker.edge_distance, true, true};
+      const auto* begin = &placeholder, *end = &placeholder + 1;
+      if(association.segments_begin != association.segments_end) {
+        begin = tile_associations->segments.data() + association.segments_begin;
+        end = tile_associations->segments.data() + association.segments_end;
+      }
       //merge them into single entries per segment id
-      for(const auto& segment : segments) {
+      for(const auto* segment = begin; segment != end; ++segment) {
         //continue one
-        if(!merged.empty() && merged.back()->segment_id_ == segment.segment_id_){
+        if(!merged.empty() && merged.back()->segment_id_ == segment->segment_id_){
           merged.back().end_edge = edge;
-          merged.back()->end_percent_ = segment.end_percent_;
-          merged.back()->ends_segment_ = segment.ends_segment_;
-          merged.back().internal = merged.back().internal && is_internal(directed_edge);
+          merged.back()->end_percent_ = segment->end_percent_;
+          merged.back()->ends_segment_ = segment->ends_segment_;
+          merged.back().internal = merged.back().internal && association.internal;
         }//new one
         else
-          merged.emplace_back(merged_traffic_segment_t{segment, edge, edge, is_internal(directed_edge)});
+          merged.emplace_back(merged_traffic_segment_t{*segment, edge, edge, association.internal});
       }
     }
     return merged;
   }
+
+  //builds the flattened view of a tile that the matcher needs
+  void build_associations(const valhalla::baldr::GraphTile* tile, valhalla::meili::tile_associations_t& associations) {
+    const auto* header = tile->header();
+    auto base = header->graphid();
+    associations.edges.resize(header->directededgecount());
+    associations.nodes.resize(header->nodecount());
+    for(uint32_t n = 0; n < header->nodecount(); ++n) {
+      const auto* node = tile->node(n);
+      valhalla::baldr::GraphId node_id(base.tileid(), base.level(), n);
+      auto& node_association = associations.nodes[n];
+      node_association.transitions_begin = associations.transitions.size();
+      //the edges leaving this node are stored contiguously
+      for(uint32_t e = node->edge_index(); e < node->edge_index() + node->edge_count(); ++e) {
+        const auto* edge = tile->directededge(e);
+        auto& edge_association = associations.edges[e];
+        edge_association.begin_node = node_id;
+        edge_association.end_node = edge->endnode();
+        edge_association.length = edge->length();
+        edge_association.internal = is_internal(edge);
+        edge_association.segments_begin = associations.segments.size();
+        if(e < header->traffic_id_count()) {
+          auto segments = tile->GetTrafficSegments(e);
+          associations.segments.insert(associations.segments.end(), segments.begin(), segments.end());
+        }
+        edge_association.segments_end = associations.segments.size();
+        if(edge->trans_up() || edge->trans_down())
+          associations.transitions.push_back(edge->endnode());
+      }
+      node_association.transitions_end = associations.transitions.size();
+    }
+  }
   
 /*
   //TODO: remove this when debugging phase is finally over
@@ -119,16 +131,41 @@ TrafficSegmentMatcher::TrafficSegmentMatcher(const boost::property_tree::ptree&
 }
 
 std::string TrafficSegmentMatcher::match(const std::string& json) {
-  // Create a matcher
-  std::shared_ptr<MapMatcher> matcher;
   float default_accuracy, default_search_radius;
+  auto matcher = create_matcher(default_accuracy, default_search_radius);
+  auto segments = match(matcher, json, default_accuracy, default_search_radius);
+
+  // Check if we are overcommitted on either cache and and clear if needed
+  trim_cache();
+  return segments;
+}
+
+std::vector<std::string> TrafficSegmentMatcher::match(const std::vector<std::string>& jsons) {
+  float default_accuracy, default_search_radius;
+  auto matcher = create_matcher(default_accuracy, default_search_radius);
+  std::vector<std::string> segments;
+  segments.reserve(jsons.size());
+  for(const auto& json : jsons) {
+    segments.emplace_back(match(matcher, json, default_accuracy, default_search_radius));
+    // The matcher only holds ids so we can safely trim between traces
+    trim_cache();
+  }
+  return segments;
+}
+
+std::shared_ptr<MapMatcher> TrafficSegmentMatcher::create_matcher(float& default_accuracy, float& default_search_radius) {
+  std::shared_ptr<MapMatcher> matcher;
   try {
     matcher.reset(matcher_factory.Create("auto")); //TODO: get the mode from the request
     default_accuracy = matcher->config().get<float>("gps_accuracy");
     default_search_radius = matcher->config().get<float>("search_radius");
   }
   catch (...) { throw std::runtime_error("Couldn't create traffic matcher using configuration."); }
+  return matcher;
+}
 
+std::string TrafficSegmentMatcher::match(const std::shared_ptr<MapMatcher>& matcher, const std::string& json,
+  float default_accuracy, float default_search_radius) {
   // Populate a measurement measurements to pass to the map matcher
   auto measurements = parse_measurements(json, default_accuracy, default_search_radius);
   if(measurements.empty())
@@ -145,13 +182,60 @@ std::string TrafficSegmentMatcher::match(const std::string& json) {
   // Get the segments along the measurements
   auto traffic_segments = form_segments(interpolations, matcher->graphreader());
 
-  // Check if we are overcommitted on either cache and and clear if needed
-  matcher_factory.ClearFullCache();
-
   //give back json
   return serialize(traffic_segments);
 }
 
+const tile_associations_t* TrafficSegmentMatcher::associations(const baldr::GraphId& id, baldr::GraphReader& reader) const {
+  // Already have it
+  auto base = id.Tile_Base();
+  auto found = association_cache.find(base.value);
+  if(found != association_cache.cend())
+    return &found->second;
+
+  // Cant get it
+  const auto* tile = reader.GetGraphTile(base);
+  if(tile == nullptr)
+    return nullptr;
+
+  // Flatten the tile once, every edge pair after this is just array lookups
+  auto& tile_associations = association_cache[base.value];
+  build_associations(tile, tile_associations);
+  return &tile_associations;
+}
+
+bool TrafficSegmentMatcher::is_connected(const baldr::GraphId& a, const baldr::GraphId& b, baldr::GraphReader& reader) const {
+  //we have to find the node b starts at
+  //NOTE: whats the effect if we cant check if its connected
+  const auto* b_associations = associations(b, reader);
+  if(!b_associations)
+    return false;
+  auto node_b = b_associations->edges[b.id()].begin_node;
+  //from the node a ends at
+  const auto* a_associations = associations(a, reader);
+  if(!a_associations)
+    return false;
+  auto node_a = a_associations->edges[a.id()].end_node;
+  if(node_a == node_b)
+    return true;
+  //check the transition edges from the end node
+  //NOTE: whats the effect if we cant check if its connected
+  const auto* node_associations = associations(node_a, reader);
+  if(!node_associations)
+    return false;
+  const auto& node = node_associations->nodes[node_a.id()];
+  auto begin = node_associations->transitions.cbegin() + node.transitions_begin;
+  auto end = node_associations->transitions.cbegin() + node.transitions_end;
+  return std::find(begin, end, node_b) != end;
+}
+
+void TrafficSegmentMatcher::trim_cache() {
+  // Associations are a fraction of the size of the tiles so we let them go together
+  if(matcher_factory.graphreader().OverCommitted())
+    association_cache.clear();
+  matcher_factory.ClearFullCache();
+}
+
 std::list<std::vector<interpolation_t> > TrafficSegmentMatcher::interpolate_matches(const std::vector<MatchResult>& matches,
   const std::shared_ptr<meili::MapMatcher>& matcher) const {
 
@@ -178,7 +262,7 @@ std::list<std::vector<interpolation_t> > TrafficSegmentMatcher::interpolate_matc
     std::vector<interpolation_t> interpolated;
     size_t last_idx = idx;
     for(auto segment = begin_edge; segment != end_edge; ++segment) {
-      float edge_length = matcher->graphreader().GetGraphTile(segment->edgeid)->directededge(segment->edgeid)->length();
+      float edge_length = associations(segment->edgeid, matcher->graphreader())->edges[segment->edgeid.id()].length;
       float total_length = segment == begin_edge ? -edges.front().source * edge_length : interpolated.back().total_distance;
       //get the distance and match result for the begin node of the edge
       interpolated.emplace_back(interpolation_t{segment->edgeid, total_length, 0.f, last_idx, -1});
@@ -253,7 +337,9 @@ std::vector<traffic_segment_t> TrafficSegmentMatcher::form_segments(const std::l
       print(marker);*/
 
     //get all the segments for this matched path merging them into single entries
-    auto merged_segments = merge_segments(markers, reader);
+    auto merged_segments = merge_segments(markers, [this, &reader](const baldr::GraphId& edge) {
+      return associations(edge, reader);
+    });
 
     /*printf("\nMerged Segments:\n");
     for(const auto& segment : merged_segments)
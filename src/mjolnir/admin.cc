@@ -3,9 +3,103 @@
 #include "midgard/logging.h"
 #include <boost/filesystem/operations.hpp>
 
+#include <algorithm>
+#include <iterator>
+
+namespace {
+
+using namespace valhalla::mjolnir;
+
+// Read the names, codes, drive on right flag and wkt geometry of an admin
+// from a row selecting them in that order
+AdminArea ReadAdmin(sqlite3_stmt* stmt, std::string& geom) {
+  AdminArea admin{"", "", "", "", true};
+  if (sqlite3_column_type(stmt, 0) == SQLITE_TEXT)
+    admin.country_name = (char*)sqlite3_column_text(stmt, 0);
+
+  if (sqlite3_column_type(stmt, 1) == SQLITE_TEXT)
+    admin.state_name = (char*)sqlite3_column_text(stmt, 1);
+
+  if (sqlite3_column_type(stmt, 2) == SQLITE_TEXT)
+    admin.country_iso = (char*)sqlite3_column_text(stmt, 2);
+
+  if (sqlite3_column_type(stmt, 3) == SQLITE_TEXT)
+    admin.state_iso = (char*)sqlite3_column_text(stmt, 3);
+
+  if (sqlite3_column_type(stmt, 4) == SQLITE_INTEGER)
+    admin.drive_on_right = sqlite3_column_int(stmt, 4);
+
+  geom = "";
+  if (sqlite3_column_type(stmt, 5) == SQLITE_TEXT)
+    geom = (char*)sqlite3_column_text(stmt, 5);
+  return admin;
+}
+
+// Add the admins a query returns to the index
+void AddAdmins(sqlite3 *db_handle, const std::string& sql, AdminIndex& index, PolygonIndex& polys) {
+  sqlite3_stmt *stmt = 0;
+  uint32_t ret = sqlite3_prepare_v2(db_handle, sql.c_str(), sql.length(), &stmt, 0);
+  if (ret == SQLITE_OK) {
+    std::string geom;
+    uint32_t result = sqlite3_step(stmt);
+    while (result == SQLITE_ROW) {
+      index.admins.emplace_back(ReadAdmin(stmt, geom));
+      multi_polygon_type multi_poly;
+      boost::geometry::read_wkt(geom, multi_poly);
+      polys.Add(index.admins.size() - 1, std::move(multi_poly));
+      result = sqlite3_step(stmt);
+    }
+  }
+  if (stmt) {
+    sqlite3_finalize(stmt);
+    stmt = 0;
+  }
+  polys.Pack();
+}
+
+}
+
 namespace valhalla {
 namespace mjolnir {
 
+// Add a polygon, the r-tree is built when they have all been added
+void PolygonIndex::Add(const uint32_t id, multi_polygon_type&& polygon) {
+  polygons_.emplace_back(id, std::move(polygon));
+}
+
+// Build a packed r-tree over the bounding boxes of all the polygons
+void PolygonIndex::Pack() {
+  std::vector<value_type> boxes;
+  boxes.reserve(polygons_.size());
+  for (size_t i = 0; i < polygons_.size(); ++i) {
+    boxes.emplace_back(boost::geometry::return_envelope<box_type>(polygons_[i].second), i);
+  }
+  rtree_ = decltype(rtree_)(boxes.begin(), boxes.end());
+}
+
+// Get the polygons that intersect a bounding box
+tile_polygons_type PolygonIndex::Intersecting(const AABB2<PointLL>& aabb) const {
+  box_type box(point_type(aabb.minx(), aabb.miny()), point_type(aabb.maxx(), aabb.maxy()));
+  std::vector<value_type> candidates;
+  rtree_.query(boost::geometry::index::intersects(box), std::back_inserter(candidates));
+
+  // Keep the order they were read in so tiles come out the same every time
+  std::sort(candidates.begin(), candidates.end(),
+            [](const value_type& a, const value_type& b) { return a.second < b.second; });
+  tile_polygons_type polys;
+  for (const auto& candidate : candidates) {
+    const auto& polygon = polygons_[candidate.second];
+    if (boost::geometry::intersects(box, polygon.second)) {
+      polys.emplace_back(polygon.first, &polygon.second);
+    }
+  }
+  return polys;
+}
+
+size_t PolygonIndex::size() const {
+  return polygons_.size();
+}
+
 // Get the dbhandle of a sqlite db.  Used for timezones and admins DBs.
 sqlite3 * GetDBHandle(const std::string& database) {
 
@@ -53,6 +147,96 @@ uint32_t GetMultiPolyId(const std::unordered_map<uint32_t,multi_polygon_type>& p
   return index;
 }
 
+// Get the polygon index.  Used by tz and admin areas.  Checks if the pointLL is covered_by the poly.
+uint32_t GetMultiPolyId(const tile_polygons_type& polys, const PointLL& ll) {
+  point_type p(ll.lng(), ll.lat());
+  for (const auto& poly : polys) {
+    if (boost::geometry::covered_by(p, *poly.second))
+      return poly.first;
+  }
+  return 0;
+}
+
+// Read all of the timezone polys from the db into an index
+PolygonIndex LoadTimeZones(sqlite3 *db_handle) {
+  PolygonIndex index;
+  if (!db_handle)
+    return index;
+
+  sqlite3_stmt *stmt = 0;
+  std::string sql = "select TZID, st_astext(geom) from tz_world;";
+  uint32_t ret = sqlite3_prepare_v2(db_handle, sql.c_str(), sql.length(), &stmt, 0);
+  if (ret == SQLITE_OK) {
+    uint32_t result = sqlite3_step(stmt);
+    while (result == SQLITE_ROW) {
+      std::string tz_id;
+      std::string geom;
+
+      if (sqlite3_column_type(stmt, 0) == SQLITE_TEXT)
+        tz_id = (char*)sqlite3_column_text(stmt, 0);
+      if (sqlite3_column_type(stmt, 1) == SQLITE_TEXT)
+        geom = (char*)sqlite3_column_text(stmt, 1);
+
+      uint32_t idx = DateTime::get_tz_db().to_index(tz_id);
+      if (idx != 0) {
+        multi_polygon_type multi_poly;
+        boost::geometry::read_wkt(geom, multi_poly);
+        index.Add(idx, std::move(multi_poly));
+      }
+      result = sqlite3_step(stmt);
+    }
+  }
+  if (stmt) {
+    sqlite3_finalize(stmt);
+    stmt = 0;
+  }
+  index.Pack();
+  return index;
+}
+
+// Get the timezone polys that intersect with the tile bounding box.
+tile_polygons_type GetTimeZones(const PolygonIndex& index, const AABB2<PointLL>& aabb) {
+  return index.Intersecting(aabb);
+}
+
+// Read all of the state and country polys from the db into an index
+AdminIndex LoadAdmins(sqlite3 *db_handle) {
+  AdminIndex index;
+  if (!db_handle)
+    return index;
+
+  std::string sql = "SELECT country.name, state.name, country.iso_code, ";
+  sql += "state.iso_code, state.drive_on_right, st_astext(state.geom) ";
+  sql += "from admins state, admins country where ";
+  sql += "country.rowid = state.parent_admin and state.admin_level=4;";
+  AddAdmins(db_handle, sql, index, index.states);
+
+  sql = "SELECT name, \"\", iso_code, \"\", drive_on_right, st_astext(geom) from ";
+  sql += " admins where admin_level=2;";
+  AddAdmins(db_handle, sql, index, index.countries);
+  return index;
+}
+
+// Get the admin polys that intersect with the tile bounding box.
+tile_polygons_type GetAdminInfo(const AdminIndex& index,
+                                std::unordered_map<uint32_t,bool>& drive_on_right,
+                                const AABB2<PointLL>& aabb, GraphTileBuilder& tilebuilder) {
+  // State/prov not found, try to find country
+  auto polys = index.states.Intersecting(aabb);
+  if (polys.empty()) {
+    polys = index.countries.Intersecting(aabb);
+  }
+
+  // Add the admins to the tile and switch to their index within it
+  for (auto& poly : polys) {
+    const auto& admin = index.admins[poly.first];
+    poly.first = tilebuilder.AddAdmin(admin.country_name,admin.state_name,
+                                      admin.country_iso,admin.state_iso);
+    drive_on_right.emplace(poly.first, admin.drive_on_right);
+  }
+  return polys;
+}
+
 // Get the timezone polys from the db
 std::unordered_map<uint32_t,multi_polygon_type> GetTimeZones(sqlite3 *db_handle,
                                                              const AABB2<PointLL>& aabb) {
@@ -121,9 +305,7 @@ std::unordered_map<uint32_t,multi_polygon_type> GetAdminInfo(sqlite3 *db_handle,
   uint32_t ret;
   char *err_msg = nullptr;
   uint32_t result = 0;
-  bool dor = true;
   std::string geom;
-  std::string country_name, state_name, country_iso, state_iso;
 
   std::string sql = "SELECT country.name, state.name, country.iso_code, ";
   sql += "state.iso_code, state.drive_on_right, st_astext(state.geom) ";
@@ -162,38 +344,13 @@ std::unordered_map<uint32_t,multi_polygon_type> GetAdminInfo(sqlite3 *db_handle,
       }
     }
     while (result == SQLITE_ROW) {
-
-      country_name = "";
-      state_name = "";
-      country_iso = "";
-      state_iso = "";
-
-      if (sqlite3_column_type(stmt, 0) == SQLITE_TEXT)
-        country_name = (char*)sqlite3_column_text(stmt, 0);
-
-      if (sqlite3_column_type(stmt, 1) == SQLITE_TEXT)
-        state_name = (char*)sqlite3_column_text(stmt, 1);
-
-      if (sqlite3_column_type(stmt, 2) == SQLITE_TEXT)
-        country_iso = (char*)sqlite3_column_text(stmt, 2);
-
-      if (sqlite3_column_type(stmt, 3) == SQLITE_TEXT)
-        state_iso = (char*)sqlite3_column_text(stmt, 3);
-
-      dor = true;
-      if (sqlite3_column_type(stmt, 4) == SQLITE_INTEGER)
-        dor = sqlite3_column_int(stmt, 4);
-
-      geom = "";
-      if (sqlite3_column_type(stmt, 5) == SQLITE_TEXT)
-        geom = (char*)sqlite3_column_text(stmt, 5);
-
-      uint32_t index = tilebuilder.AddAdmin(country_name,state_name,
-                                            country_iso,state_iso);
+      auto admin = ReadAdmin(stmt, geom);
+      uint32_t index = tilebuilder.AddAdmin(admin.country_name,admin.state_name,
+                                            admin.country_iso,admin.state_iso);
       multi_polygon_type multi_poly;
       boost::geometry::read_wkt(geom, multi_poly);
       polys.emplace(index, multi_poly);
-      drive_on_right.emplace(index, dor);
+      drive_on_right.emplace(index, admin.drive_on_right);
 
       result = sqlite3_step(stmt);
     }
@@ -4,6 +4,7 @@
 #include "mjolnir/node_expander.h"
 #include "mjolnir/ferry_connections.h"
 #include "mjolnir/linkclassification.h"
+#include "mjolnir/tilescheduler.h"
 
 #include <future>
 #include <utility>
@@ -50,7 +51,9 @@ constexpr double kMinimumInterval = 10.0f;
  */
 std::map<GraphId, size_t> SortGraph(const std::string& nodes_file,
                                     const std::string& edges_file,
-                                    const uint8_t level) {
+                                    const uint8_t level,
+                                    const size_t sort_buffer_size,
+                                    const size_t threads) {
   LOG_INFO("Sorting graph...");
 
   // Sort nodes by graphid then by osmid, so its basically a set of tiles
@@ -60,7 +63,7 @@ std::map<GraphId, size_t> SortGraph(const std::string& nodes_file,
       if(a.graph_id == b.graph_id)
         return a.node.osmid < b.node.osmid;
       return a.graph_id < b.graph_id;
-    }
+    }, sort_buffer_size / sizeof(Node), threads
   );
   //run through the sorted nodes, going back to the edges they reference and updating each edge
   //to point to the first (out of the duplicates) nodes index. at the end of this there will be
@@ -362,10 +365,11 @@ void BuildTileSet(const std::string& ways_file, const std::string& way_nodes_fil
     const std::string& complex_restriction_file,
     const std::string tile_dir, const OSMData& osmdata,
     const std::unique_ptr<const valhalla::skadi::sample>& sample,
-    std::map<GraphId, size_t>::const_iterator tile_start,
+    const std::vector<std::map<GraphId, size_t>::const_iterator>& tiles,
     std::map<GraphId, size_t>::const_iterator tile_end,
+    TileScheduler& scheduler, size_t worker,
     const uint32_t tile_creation_date,
-    const boost::property_tree::ptree& pt,
+    const AdminIndex* admins, const PolygonIndex* timezones,
     std::promise<DataQuality>& result) {
 
   sequence<OSMWay> ways(ways_file, false);
@@ -374,18 +378,6 @@ void BuildTileSet(const std::string& ways_file, const std::string& way_nodes_fil
   sequence<Node> nodes(nodes_file, false);
   sequence<OSMRestriction> complex_restrictions(complex_restriction_file, false);
 
-  auto database = pt.get_optional<std::string>("admin");
-  // Initialize the admin DB (if it exists)
-  sqlite3 *admin_db_handle = GetDBHandle(*database);
-  if (!admin_db_handle)
-    LOG_WARN("Admin db " + *database + " not found.  Not saving admin information.");
-
-  database = pt.get_optional<std::string>("timezone");
-  // Initialize the tz DB (if it exists)
-  sqlite3 *tz_db_handle = GetDBHandle(*database);
-  if (!tz_db_handle)
-    LOG_WARN("Time zone db " + *database + " not found.  Not saving time zone information.");
-
   const auto& tl = TileHierarchy::levels().rbegin();
   Tiles<PointLL> tiling = tl->second.tiles;
 
@@ -411,7 +403,9 @@ void BuildTileSet(const std::string& ways_file, const std::string& way_nodes_fil
 
   ////////////////////////////////////////////////////////////////////////////
   // Iterate over tiles
-  for(; tile_start != tile_end; ++tile_start) {
+  size_t index;
+  while (scheduler.next(worker, index)) {
+    auto tile_start = tiles[index];
     try {
       // What actually writes the tile
       GraphId tile_id = tile_start->first.Tile_Base();
@@ -429,10 +423,10 @@ void BuildTileSet(const std::string& ways_file, const std::string& way_nodes_fil
       // tile is entirely inside the polygon
       bool tile_within_one_admin = false;
       uint32_t id  = tile_id.tileid();
-      std::unordered_map<uint32_t,multi_polygon_type> admin_polys;
+      tile_polygons_type admin_polys;
       std::unordered_map<uint32_t,bool> drive_on_right;
-      if (admin_db_handle) {
-        admin_polys = GetAdminInfo(admin_db_handle, drive_on_right,
+      if (admins) {
+        admin_polys = GetAdminInfo(*admins, drive_on_right,
                                    tiling.TileBounds(id), graphtile);
         if (admin_polys.size() == 1) {
           // TODO - check if tile bounding box is entirely inside the polygon...
@@ -441,9 +435,9 @@ void BuildTileSet(const std::string& ways_file, const std::string& way_nodes_fil
       }
 
       bool tile_within_one_tz = false;
-      std::unordered_map<uint32_t,multi_polygon_type> tz_polys;
-      if (tz_db_handle) {
-        tz_polys = GetTimeZones(tz_db_handle, tiling.TileBounds(id));
+      tile_polygons_type tz_polys;
+      if (timezones) {
+        tz_polys = GetTimeZones(*timezones, tiling.TileBounds(id));
         if (tz_polys.size() == 1) {
           tile_within_one_tz = true;
         }
@@ -854,19 +848,12 @@ void BuildTileSet(const std::string& ways_file, const std::string& way_nodes_fil
       LOG_DEBUG((boost::format("Wrote tile %1%: %2% bytes") % tile_start->first % graphtile.header_builder().end_offset()).str());
     }// Whatever happens in Vegas..
     catch(std::exception& e) {
-      // ..gets sent back to the main thread
-      result.set_exception(std::current_exception());
+      // ..gets sent back to the main thread, which stops the other threads
       LOG_ERROR((boost::format("Failed tile %1%: %2%") % tile_start->first % e.what()).str());
-      return;
+      throw;
     }
   }
 
-  if (admin_db_handle)
-    sqlite3_close (admin_db_handle);
-
-  if (tz_db_handle)
-    sqlite3_close (tz_db_handle);
-
   // Let the main thread see how this thread faired
   result.set_value(stats);
 }
@@ -882,42 +869,56 @@ void BuildLocalTiles(const unsigned int thread_count, const OSMData& osmdata,
   auto tz = DateTime::get_tz_db().from_index(DateTime::get_tz_db().to_index("America/New_York"));
   uint32_t tile_creation_date = DateTime::days_from_pivot_date(DateTime::get_formatted_date(DateTime::iso_date_time(tz)));
 
-  LOG_INFO("Building " + std::to_string(tiles.size()) + " tiles with " + std::to_string(thread_count) + " threads...");
-
-  // A place to hold worker threads and their results, be they exceptions or otherwise
-  std::vector<std::shared_ptr<std::thread> > threads(thread_count);
 
-  // Hold the results (DataQuality/stats) for the threads
-  std::vector<std::promise<DataQuality> > results(threads.size());
-
-  // Divvy up the work
-  size_t floor = tiles.size() / threads.size();
-  size_t at_ceiling = tiles.size() - (threads.size() * floor);
-  std::map<GraphId, size_t>::const_iterator tile_start, tile_end = tiles.begin();
-
-  // Atomically pass around stats info
-  for (size_t i = 0; i < threads.size(); ++i) {
-    // Figure out how many this thread will work on (either ceiling or floor)
-    size_t tile_count = (i < at_ceiling ? floor + 1 : floor);
-    // Where the range begins
-    tile_start = tile_end;
-    // Where the range ends
-    std::advance(tile_end, tile_count);
-    // Make the thread
-    threads[i].reset(
-      new std::thread(BuildTileSet,  std::cref(ways_file), std::cref(way_nodes_file),
-                      std::cref(nodes_file), std::cref(edges_file),
-                      std::cref(complex_restriction_file), std::cref(tile_dir),
-                      std::cref(osmdata), std::cref(sample), tile_start, tile_end, tile_creation_date,
-                      std::cref(pt.get_child("mjolnir")), std::ref(results[i]))
-    );
+  // Weigh each tile by how many nodes it has so the dense ones go first
+  std::vector<std::map<GraphId, size_t>::const_iterator> tile_itrs;
+  std::vector<size_t> weights;
+  sequence<Node> nodes(nodes_file, false);
+  for (auto tile = tiles.cbegin(); tile != tiles.cend(); ++tile) {
+    auto next = std::next(tile);
+    tile_itrs.push_back(tile);
+    weights.push_back((next == tiles.cend() ? nodes.size() : next->second) - tile->second);
+  }
+  // Read the admin and time zone polygons once for all of the threads
+  std::unique_ptr<AdminIndex> admins;
+  auto database = pt.get_optional<std::string>("mjolnir.admin");
+  // Initialize the admin DB (if it exists)
+  sqlite3 *admin_db_handle = database ? GetDBHandle(*database) : nullptr;
+  if (!admin_db_handle) {
+    LOG_WARN("Admin db " + (database ? *database : "") + " not found.  Not saving admin information.");
+  } else {
+    admins.reset(new AdminIndex(LoadAdmins(admin_db_handle)));
+    sqlite3_close(admin_db_handle);
+    LOG_INFO("Loaded " + std::to_string(admins->states.size()) + " states and " +
+             std::to_string(admins->countries.size()) + " countries");
   }
 
-  // Join all the threads to wait for them to finish up their work
-  for (auto& thread : threads) {
-    thread->join();
+  std::unique_ptr<PolygonIndex> timezones;
+  database = pt.get_optional<std::string>("mjolnir.timezone");
+  // Initialize the tz DB (if it exists)
+  sqlite3 *tz_db_handle = database ? GetDBHandle(*database) : nullptr;
+  if (!tz_db_handle) {
+    LOG_WARN("Time zone db " + (database ? *database : "") + " not found.  Not saving time zone information.");
+  } else {
+    timezones.reset(new PolygonIndex(LoadTimeZones(tz_db_handle)));
+    sqlite3_close(tz_db_handle);
+    LOG_INFO("Loaded " + std::to_string(timezones->size()) + " time zones");
   }
 
+  LOG_INFO("Building " + std::to_string(tile_itrs.size()) + " tiles with " + std::to_string(thread_count) + " threads...");
+  TileScheduler scheduler("Building tiles", weights, thread_count);
+
+  // Hold the results (DataQuality/stats) for the threads
+  std::vector<std::promise<DataQuality> > results(scheduler.threads());
+
+  // Run the threads to wait for them to finish up their work
+  scheduler.run([&](size_t worker) {
+    BuildTileSet(ways_file, way_nodes_file, nodes_file, edges_file,
+                 complex_restriction_file, tile_dir, osmdata, sample,
+                 tile_itrs, tiles.cend(), scheduler, worker, tile_creation_date,
+                 admins.get(), timezones.get(), results[worker]);
+  });
+
   LOG_INFO("Finished");
 
   // Check all of the outcomes and accumulate stats
@@ -960,7 +961,8 @@ void GraphBuilder::Build(const boost::property_tree::ptree& pt, const OSMData& o
   );
 
   // Line up the nodes and then re-map the edges that the edges to them
-  auto tiles = SortGraph(nodes_file, edges_file, level);
+  auto tiles = SortGraph(nodes_file, edges_file, level,
+    pt.get<size_t>("mjolnir.sort_buffer_size", 1024 * 1024 * 512), threads);
 
   // Reclassify links (ramps). Cannot do this when building tiles since the
   // edge list needs to be modified
@@ -1,5 +1,6 @@
 #include "mjolnir/admin.h"
 #include "mjolnir/graphenhancer.h"
+#include "mjolnir/tilescheduler.h"
 #include "mjolnir/graphtilebuilder.h"
 #include "mjolnir/countryaccess.h"
 
@@ -884,7 +885,8 @@ bool ConsistentNames(const std::string& country_code,
 void enhance(const boost::property_tree::ptree& pt,
              const std::string& access_file,
              const boost::property_tree::ptree& hierarchy_properties,
-             std::queue<GraphId>& tilequeue, std::mutex& lock,
+             const std::vector<GraphId>& tile_ids, TileScheduler& scheduler,
+             size_t worker, std::mutex& lock,
              std::promise<enhancer_stats>& result) {
 
   auto less_than = [](const OSMAccess& a, const OSMAccess& b){return a.way_id() < b.way_id();};
@@ -906,17 +908,13 @@ void enhance(const boost::property_tree::ptree& pt,
   const auto& local_level = TileHierarchy::levels().rbegin()->second.level;
   const auto& tiles = TileHierarchy::levels().rbegin()->second.tiles;
 
-  // Iterate through the tiles in the queue and perform enhancements
-  while (true) {
-    // Get the next tile Id from the queue and get writeable and readable
-    // tile. Lock while we access the tile queue and get the tile.
+  // Iterate through the tiles the scheduler hands us and perform enhancements
+  size_t index;
+  while (scheduler.next(worker, index)) {
+    // Get the next tile Id and get writeable and readable tile. Lock while
+    // we get the tile.
+    GraphId tile_id = tile_ids[index];
     lock.lock();
-    if (tilequeue.empty()) {
-      lock.unlock();
-      break;
-    }
-    GraphId tile_id = tilequeue.front();
-    tilequeue.pop();
 
     // Get a readable tile.If the tile is empty, skip it. Empty tiles are
     // added where ways go through a tile but no end not is within the tile.
@@ -1201,16 +1199,8 @@ namespace mjolnir {
 // Enhance the local level of the graph
 void GraphEnhancer::Enhance(const boost::property_tree::ptree& pt,
                             const std::string& access_file) {
-  // A place to hold worker threads and their results, exceptions or otherwise
-  std::vector<std::shared_ptr<std::thread> > threads(
-    std::max(static_cast<unsigned int>(1),
-    pt.get<unsigned int>("concurrency", std::thread::hardware_concurrency())));
-
-  // A place to hold the results of those threads, exceptions or otherwise
-  std::list<std::promise<enhancer_stats> > results;
-
-  // Create a randomized queue of tiles to work from
-  std::deque<GraphId> tempqueue;
+  // Tiles to work from
+  std::vector<GraphId> tile_ids;
   boost::property_tree::ptree hierarchy_properties = pt.get_child("mjolnir");
   GraphReader reader(hierarchy_properties);
   auto local_level = TileHierarchy::levels().rbegin()->second.level;
@@ -1219,30 +1209,28 @@ void GraphEnhancer::Enhance(const boost::property_tree::ptree& pt,
     // If tile exists add it to the queue
     GraphId tile_id(id, local_level, 0);
     if (GraphReader::DoesTileExist(hierarchy_properties, tile_id)) {
-      tempqueue.push_back(tile_id);
+      tile_ids.push_back(tile_id);
     }
   }
-  std::random_shuffle(tempqueue.begin(), tempqueue.end());
-  std::queue<GraphId> tilequeue(tempqueue);
+
+  // Schedule the biggest tiles first across the threads
+  TileScheduler scheduler("Enhancing local graph",
+    TileScheduler::TileSizes(reader.tile_dir(), tile_ids),
+    std::max(static_cast<unsigned int>(1),
+    pt.get<unsigned int>("concurrency", std::thread::hardware_concurrency())));
+
+  // A place to hold the results of those threads, exceptions or otherwise
+  std::vector<std::promise<enhancer_stats> > results(scheduler.threads());
 
   // An atomic object we can use to do the synchronization
   std::mutex lock;
 
-  // Start the threads
+  // Run the threads
   LOG_INFO("Enhancing local graph...");
-  for (auto& thread : threads) {
-    results.emplace_back();
-    thread.reset(new std::thread(enhance,
-                 std::cref(hierarchy_properties),
-                 std::cref(access_file),
-                 std::ref(hierarchy_properties), std::ref(tilequeue),
-                 std::ref(lock), std::ref(results.back())));
-  }
-
-  // Wait for them to finish up their work
-  for (auto& thread : threads) {
-    thread->join();
-  }
+  scheduler.run([&](size_t worker) {
+    enhance(hierarchy_properties, access_file, hierarchy_properties, tile_ids,
+            scheduler, worker, lock, results[worker]);
+  });
 
   // Check all of the outcomes, to see about maximum density (km/km2)
   enhancer_stats stats{std::numeric_limits<float>::min(), 0};
@@ -222,6 +222,11 @@ GraphTileBuilder::GraphTileBuilder(const std::string& tile_dir,
     std::copy(edge_elevation_, edge_elevation_ + n,
         std::back_inserter(edge_elevation_builder_));
   }
+
+  // Speed profiles
+  speed_profile_builder_.reserve(speed_profile_count_);
+  std::copy(speed_profiles_, speed_profiles_ + speed_profile_count_,
+      std::back_inserter(speed_profile_builder_));
 }
 
 // Output the tile to file. Stores as binary data.
@@ -360,9 +365,21 @@ void GraphTileBuilder::StoreTileData() {
                          edge_elevation_builder_.size() * sizeof(EdgeElevation));
     }
 
-    // Set the end offset
-    header_builder_.set_end_offset(header_builder_.edge_elevation_offset() +
+    // Write the speed profiles
+    header_builder_.set_speed_profile_offset(header_builder_.edge_elevation_offset() +
       (edge_elevation_builder_.size() * sizeof(EdgeElevation)));
+    // Sort by edge index keeping only the last profile added for an edge
+    std::reverse(speed_profile_builder_.begin(), speed_profile_builder_.end());
+    std::stable_sort(speed_profile_builder_.begin(), speed_profile_builder_.end());
+    speed_profile_builder_.erase(std::unique(speed_profile_builder_.begin(), speed_profile_builder_.end(),
+        [](const SpeedProfile& a, const SpeedProfile& b) { return a.edgeindex() == b.edgeindex(); }),
+        speed_profile_builder_.end());
+    in_mem.write(reinterpret_cast<const char*>(speed_profile_builder_.data()),
+                 speed_profile_builder_.size() * sizeof(SpeedProfile));
+
+    // Set the end offset
+    header_builder_.set_end_offset(header_builder_.speed_profile_offset() +
+      (speed_profile_builder_.size() * sizeof(SpeedProfile)));
 
     // Sanity check for the end offset
     uint32_t curr = static_cast<uint32_t>(in_mem.tellp()) +
@@ -497,6 +514,15 @@ void GraphTileBuilder::AddLaneConnectivity(const std::vector<baldr::LaneConnecti
   lane_connectivity_offset_ += sizeof(baldr::LaneConnectivity) * lc.size();
 }
 
+// Add a speed profile
+void GraphTileBuilder::AddSpeedProfile(const baldr::SpeedProfile& profile) {
+  // A new tile has no header yet so check against the edges being built
+  if (profile.edgeindex() >= directededges_builder_.size())
+    throw std::runtime_error("GraphTile DirectedEdge id out of bounds");
+  directededges_builder_[profile.edgeindex()].set_speed_profile(true);
+  speed_profile_builder_.push_back(profile);
+}
+
 bool GraphTileBuilder::HasEdgeInfo(const uint32_t edgeindex, const baldr::GraphId& nodea,
                      const baldr::GraphId& nodeb, uint32_t& edge_info_offset) {
   auto edge_tuple_item = EdgeTuple(edgeindex, nodea, nodeb);
@@ -870,6 +896,7 @@ void GraphTileBuilder::AddBins(const std::string& tile_dir,
   header.set_traffic_chunk_offset(header.traffic_chunk_offset() + shift);
   header.set_lane_connectivity_offset(header.lane_connectivity_offset() + shift);
   header.set_edge_elevation_offset(header.edge_elevation_offset() + shift);
+  header.set_speed_profile_offset(header.speed_profile_offset() + shift);
   header.set_end_offset(header.end_offset() + shift);
   //rewrite the tile
   boost::filesystem::path filename = tile_dir + '/' + GraphTile::FileSuffix(header.graphid());
@@ -984,6 +1011,7 @@ void GraphTileBuilder::UpdateTrafficSegments() {
                    traffic_chunk_builder_.size() * sizeof(TrafficChunk);
   header_builder_.set_lane_connectivity_offset(header_builder_.lane_connectivity_offset() + shift);
   header_builder_.set_edge_elevation_offset(header_builder_.edge_elevation_offset() + shift);
+  header_builder_.set_speed_profile_offset(header_builder_.speed_profile_offset() + shift);
   header_builder_.set_end_offset(header_builder_.end_offset() + shift);
 
   // Get the name of the file
@@ -1013,8 +1041,8 @@ void GraphTileBuilder::UpdateTrafficSegments() {
     file.write(reinterpret_cast<const char*>(&traffic_chunk_builder_[0]),
                traffic_chunk_builder_.size() * sizeof(TrafficChunk));
 
-    // Write rest of the stuff after traffic chunks (includes lane connectivity
-    // and edge elevation...so far).
+    // Write rest of the stuff after traffic chunks (includes lane connectivity,
+    // edge elevation and speed profiles...so far).
     const auto* begin = reinterpret_cast<const char*>(header_) +
                 header_->lane_connectivity_offset();
     const auto* end = reinterpret_cast<const char*>(header_) +
@@ -1,5 +1,6 @@
 
 #include "mjolnir/graphvalidator.h"
+#include "mjolnir/tilescheduler.h"
 #include "mjolnir/graphtilebuilder.h"
 
 #include "midgard/logging.h"
@@ -284,7 +285,8 @@ uint32_t GetOpposingEdgeIndex(const GraphId& startnode, DirectedEdge& edge,
 
 using tweeners_t = GraphTileBuilder::tweeners_t;
 void validate(const boost::property_tree::ptree& pt,
-              std::deque<GraphId>& tilequeue, std::mutex& lock,
+              const std::vector<GraphId>& tile_ids, TileScheduler& scheduler,
+              size_t worker, std::mutex& lock,
               std::promise<std::tuple<std::vector<uint32_t>, std::vector<std::vector<float> >, tweeners_t> >& result) {
     // Our local copy of edges binned to tiles that they pass through (dont start or end in)
     tweeners_t tweeners;
@@ -304,16 +306,10 @@ void validate(const boost::property_tree::ptree& pt,
     std::set<uint64_t> problem_ways;
 
     // Check for more tiles
-    while (true) {
-      lock.lock();
-      if (tilequeue.empty()) {
-        lock.unlock();
-        break;
-      }
+    size_t index;
+    while (scheduler.next(worker, index)) {
       // Get the next tile Id
-      GraphId tile_id = tilequeue.front();
-      tilequeue.pop_front();
-      lock.unlock();
+      GraphId tile_id = tile_ids[index];
 
       // Point tiles to the set we need for current level
       auto level = tile_id.level();
@@ -529,20 +525,15 @@ void validate(const boost::property_tree::ptree& pt,
   }
 
   //crack open tiles and bin edges that pass through them but dont end or begin in them
-  void bin_tweeners(const std::string& tile_dir, tweeners_t::iterator& start,
-                    const tweeners_t::iterator& end,
-                    uint64_t dataset_id, std::mutex& lock) {
+  void bin_tweeners(const std::string& tile_dir,
+                    const std::vector<tweeners_t::const_iterator>& tile_bins,
+                    TileScheduler& scheduler, size_t worker,
+                    uint64_t dataset_id) {
     //go while we have tiles to update
-    while(true) {
-      lock.lock();
-      if(start == end) {
-        lock.unlock();
-        break;
-      }
+    size_t index;
+    while(scheduler.next(worker, index)) {
       //grab this tile and its extra bin edges
-      const auto& tile_bin = *start;
-      ++start;
-      lock.unlock();
+      const auto& tile_bin = *tile_bins[index];
 
       //if there is nothing there we need to make something
       GraphTile tile(tile_dir, tile_bin.first);
@@ -566,8 +557,8 @@ namespace mjolnir {
     auto hierarchy_properties = pt.get_child("mjolnir");
     std::string tile_dir = hierarchy_properties.get<std::string>("tile_dir");
 
-    // Create a randomized queue of tiles to work from
-    std::deque<GraphId> tilequeue;
+    // Tiles to work from
+    std::vector<GraphId> tilequeue;
     for (auto tier : TileHierarchy::levels()) {
       auto level = tier.second.level;
       auto tiles = tier.second.tiles;
@@ -591,7 +582,6 @@ namespace mjolnir {
         }
       }
     }
-    std::random_shuffle(tilequeue.begin(), tilequeue.end());
 
     // Remember what the dataset id is in case we have to make some tiles
     auto dataset_id = GraphTile(tile_dir, *tilequeue.begin()).header()->dataset_id();
@@ -601,24 +591,19 @@ namespace mjolnir {
 
     LOG_INFO("Validating, finishing and binning tiles...");
 
-    // Setup threads
-    std::vector<std::shared_ptr<std::thread> > threads(
-        std::max(static_cast<unsigned int>(1),
-                 pt.get<unsigned int>("concurrency",std::thread::hardware_concurrency())));
+    // Schedule the biggest tiles first across the threads
+    unsigned int thread_count = std::max(static_cast<unsigned int>(1),
+                 pt.get<unsigned int>("concurrency",std::thread::hardware_concurrency()));
+    TileScheduler scheduler("Validating tiles", TileScheduler::TileSizes(tile_dir, tilequeue), thread_count);
 
     // Setup promises
-    std::list<std::promise<std::tuple<std::vector<uint32_t>, std::vector<std::vector<float>>, tweeners_t> > > results;
+    std::vector<std::promise<std::tuple<std::vector<uint32_t>, std::vector<std::vector<float>>, tweeners_t> > > results(scheduler.threads());
 
-    // Spawn the threads
-    for (auto& thread : threads) {
-      results.emplace_back();
-      thread.reset(new std::thread(validate, std::cref(pt), std::ref(tilequeue),
-                                   std::ref(lock), std::ref(results.back())));
-    }
+    // Run the threads
+    scheduler.run([&](size_t worker) {
+      validate(pt, tilequeue, scheduler, worker, lock, results[worker]);
+    });
 
-    // Wait for threads to finish
-    for (auto& thread : threads)
-      thread->join();
     // Get the promise from the future
     std::vector<uint32_t> duplicates(TileHierarchy::levels().size(), 0);
     std::vector<std::vector<float>> densities(3);
@@ -638,14 +623,18 @@ namespace mjolnir {
 
     //run a pass to add the edges that binned to tweener tiles
     LOG_INFO("Binning inter-tile edges...");
-    auto start = tweeners.begin();
-    auto end = tweeners.end();
-    for (auto& thread : threads)
-      thread.reset(new std::thread(bin_tweeners, std::cref(tile_dir),
-                        std::ref(start), std::cref(end),
-                        dataset_id, std::ref(lock)));
-    for (auto& thread : threads)
-      thread->join();
+    std::vector<tweeners_t::const_iterator> tile_bins;
+    std::vector<size_t> bin_sizes;
+    for (auto tile_bin = tweeners.cbegin(); tile_bin != tweeners.cend(); ++tile_bin) {
+      tile_bins.push_back(tile_bin);
+      bin_sizes.push_back(0);
+      for (const auto& bin : tile_bin->second)
+        bin_sizes.back() += bin.size();
+    }
+    TileScheduler bin_scheduler("Binning inter-tile edges", bin_sizes, thread_count);
+    bin_scheduler.run([&](size_t worker) {
+      bin_tweeners(tile_dir, tile_bins, bin_scheduler, worker, dataset_id);
+    });
     LOG_INFO("Finished");
 
     // print dupcount and find densities
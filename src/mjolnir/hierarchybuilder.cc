@@ -1,5 +1,6 @@
 #include "mjolnir/hierarchybuilder.h"
 #include "mjolnir/graphtilebuilder.h"
+#include "mjolnir/tilescheduler.h"
 
 #include <sstream>
 #include <iostream>
@@ -7,6 +8,9 @@
 #include <vector>
 #include <map>
 #include <utility>
+#include <thread>
+#include <future>
+#include <unordered_map>
 #include <boost/property_tree/ptree.hpp>
 
 #include "midgard/pointll.h"
@@ -91,7 +95,7 @@ bool AddUpwardTransition(const GraphId& node, GraphTileBuilder* tilebuilder,
   }
 }
 
-void SortSequences() {
+void SortSequences(const size_t sort_buffer_size, const size_t threads) {
   // Sort the new nodes. Sort so highway level is first
   sequence<std::pair<GraphId, GraphId>> new_to_old(new_to_old_file, false);
   new_to_old.sort(
@@ -103,13 +107,14 @@ void SortSequences() {
         return a.first.tileid() < b.first.tileid();
       }
       return a.first.level() < b.first.level();
-    }
+    }, sort_buffer_size / sizeof(std::pair<GraphId, GraphId>), threads
   );
 
   // Sort old to new by node Id
   sequence<OldToNewNodes> old_to_new(old_to_new_file, false);
   old_to_new.sort([](const OldToNewNodes& a, const OldToNewNodes& b)
-                  {return a.node_id < b.node_id;});
+                  {return a.node_id < b.node_id;},
+                  sort_buffer_size / sizeof(OldToNewNodes), threads);
 }
 
 // Convencience method to find the node association.
@@ -125,14 +130,12 @@ OldToNewNodes find_nodes(sequence<OldToNewNodes>& old_to_new, const GraphId& nod
   }
 }
 
-// Form tiles in the new level.
-void FormTilesInNewLevel(GraphReader& reader, bool has_elevation) {
-  // Use the sequence that associate new nodes to old nodes
-  sequence<std::pair<GraphId, GraphId>> new_to_old(new_to_old_file, false);
-
-  // Use the sorted sequence that associates old nodes to new nodes
-  sequence<OldToNewNodes> old_to_new(old_to_new_file, false);
-
+// Form a tile in the new level from a range of the new nodes (sorted by tile)
+void FormTileInNewLevel(GraphReader& reader,
+                        sequence<std::pair<GraphId, GraphId>>& new_to_old,
+                        sequence<OldToNewNodes>& old_to_new,
+                        const std::pair<size_t, size_t>& range,
+                        bool has_elevation) {
   // lambda to indicate whether a directed edge should be included
   auto include_edge = [&old_to_new](const DirectedEdge* directededge,
         const GraphId& base_node, const uint8_t current_level) {
@@ -154,37 +157,21 @@ void FormTilesInNewLevel(GraphReader& reader, bool has_elevation) {
     }
   };
 
-  // Iterate through the new nodes. They have been sorted by level so that
-  // highway level is done first.
-  reader.Clear();
+  // New tilebuilder for the tile. Update current level.
   bool added = false;
-  uint8_t current_level;
-  GraphId tile_id;
   std::hash<std::string> hasher;
-  GraphTileBuilder* tilebuilder = nullptr;
-  for (auto new_node = new_to_old.begin(); new_node != new_to_old.end(); new_node++) {
-    // Get the node - check if a new tile
-    GraphId nodea = (*new_node).first;
-    if (nodea.Tile_Base() != tile_id) {
-      // Store the prior tile
-      if (tilebuilder != nullptr) {
-        tilebuilder->StoreTileData();
-        delete tilebuilder;
-      }
+  GraphId tile_id = (*new_to_old[range.first]).first.Tile_Base();
+  std::unique_ptr<GraphTileBuilder> tilebuilder(
+      new GraphTileBuilder(reader.tile_dir(), tile_id, false));
+  uint8_t current_level = tile_id.level();
 
-      // New tilebuilder for the next tile. Update current level.
-      tile_id = nodea.Tile_Base();
-      tilebuilder = new GraphTileBuilder(reader.tile_dir(), tile_id, false);
-      current_level = nodea.level();
+  // Create a dummy admin at index 0. Used if admins are not used/created.
+  tilebuilder->AddAdmin("None", "None", "", "");
 
-      // Create a dummy admin at index 0. Used if admins are not used/created.
-      tilebuilder->AddAdmin("None", "None", "", "");
-
-      // Check if we need to clear the base/local tile cache
-      if (reader.OverCommitted()) {
-        reader.Clear();
-      }
-    }
+  // Iterate through the new nodes in the tile
+  for (auto new_node = new_to_old[range.first]; new_node.position() < range.second; new_node++) {
+    // Get the node
+    GraphId nodea = (*new_node).first;
 
     // Get the node in the base level
     GraphId base_node = (*new_node).second;
@@ -321,124 +308,168 @@ void FormTilesInNewLevel(GraphReader& reader, bool has_elevation) {
     // Add transition edges
     auto new_nodes = find_nodes(old_to_new, base_node);
     if (current_level == 0) {
-      AddDownwardTransition(new_nodes.arterial_node, tilebuilder, has_elevation);
-      AddDownwardTransition(new_nodes.local_node, tilebuilder, has_elevation);
+      AddDownwardTransition(new_nodes.arterial_node, tilebuilder.get(), has_elevation);
+      AddDownwardTransition(new_nodes.local_node, tilebuilder.get(), has_elevation);
     } else if (current_level == 1) {
-      AddDownwardTransition(new_nodes.local_node, tilebuilder, has_elevation);
-      AddUpwardTransition(new_nodes.highway_node, tilebuilder, has_elevation);
+      AddDownwardTransition(new_nodes.local_node, tilebuilder.get(), has_elevation);
+      AddUpwardTransition(new_nodes.highway_node, tilebuilder.get(), has_elevation);
     }
     if (current_level == 2) {
-      AddUpwardTransition(new_nodes.arterial_node, tilebuilder, has_elevation);
-      AddUpwardTransition(new_nodes.highway_node, tilebuilder, has_elevation);
+      AddUpwardTransition(new_nodes.arterial_node, tilebuilder.get(), has_elevation);
+      AddUpwardTransition(new_nodes.highway_node, tilebuilder.get(), has_elevation);
     }
 
     // Set the edge count for the new node
     node.set_edge_count(tilebuilder->directededges().size() - edge_count);
   }
 
-  // Delete the tile builder
-  if (tilebuilder != nullptr) {
-    tilebuilder->StoreTileData();
-    delete tilebuilder;
-  }
+  // Store the tile
+  tilebuilder->StoreTileData();
 }
 
-/**
- * Create node associations between "new" nodes placed into respective
- * hierarchy levels and the existing nodes on the base/local level. The
- * associations go both ways: from the "old" nodes on the base/local level
- * to new nodes (using a mapping in memory) and from new nodes to old nodes
- * using a sequence (file).
- * @return  Returns true if any base tiles have edge elevation data.
- */
-bool CreateNodeAssociations(GraphReader& reader) {
-  // Map of tiles vs. count of nodes. Used to construct new node Ids.
-  std::unordered_map<GraphId, uint32_t> new_nodes;
-
-  // lambda to get the next "new" node Id given a tile
-  auto get_new_node = [&new_nodes](const GraphId& tile) {
-    auto itr = new_nodes.find(tile);
-    if (itr == new_nodes.end()) {
-      GraphId new_node(tile.tileid(), tile.level(), 0);
-      new_nodes[tile] = 1;
-      return new_node;
-    } else {
-      GraphId new_node(tile.tileid(), tile.level(), itr->second);
-      itr->second++;
-      return new_node;
+// Form tiles in the new level. Each thread takes the next new tile from the
+// scheduler and builds it on its own.
+void FormTilesInNewLevel(const boost::property_tree::ptree& hierarchy_properties,
+                         bool has_elevation,
+                         const std::vector<std::pair<size_t, size_t> >& ranges,
+                         TileScheduler& scheduler, size_t worker,
+                         std::promise<void>& result) {
+  // Local graphreader
+  GraphReader reader(hierarchy_properties);
+
+  // Use the sequence that associate new nodes to old nodes
+  sequence<std::pair<GraphId, GraphId>> new_to_old(new_to_old_file, false);
+
+  // Use the sorted sequence that associates old nodes to new nodes
+  sequence<OldToNewNodes> old_to_new(old_to_new_file, false);
+
+  // Iterate through the new tiles handed to this thread
+  size_t index;
+  while (scheduler.next(worker, index)) {
+    // Get the range of new nodes in the next tile
+    const auto& range = ranges[index];
+
+    try {
+      FormTileInNewLevel(reader, new_to_old, old_to_new, range, has_elevation);
+    }// Whatever happens in Vegas..
+    catch(std::exception& e) {
+      // ..gets sent back to the main thread, which stops the other threads
+      LOG_ERROR("Failed to form tile: " + std::string(e.what()));
+      throw;
     }
-  };
 
-  // Create a sequence to associate new nodes to old nodes
-  sequence<std::pair<GraphId, GraphId>> new_to_old(new_to_old_file, true);
+    // Check if we need to clear the base/local tile cache
+    if (reader.OverCommitted()) {
+      reader.Clear();
+    }
+  }
 
-  // Create a sequence to associate new nodes to old nodes
-  sequence<OldToNewNodes> old_to_new(old_to_new_file, true);
+  // Let the main thread know this thread is done
+  result.set_value();
+}
 
-  // Hierarchy level information
+// Get the levels a base node exists on from the classification of its
+// edges (skipping transit connection edges) and the tile it goes to on each
+void GetNodeLevels(const GraphTile* tile, const NodeInfo* nodeinfo,
+                   const GraphId& basenode, bool levels[3], GraphId new_tiles[3]) {
+  levels[0] = levels[1] = levels[2] = false;
+  GraphId edgeid(basenode.tileid(), basenode.level(), nodeinfo->edge_index());
+  for (uint32_t j = 0; j < nodeinfo->edge_count(); j++, ++edgeid) {
+    const DirectedEdge* directededge = tile->directededge(edgeid);
+    if (directededge->use() != Use::kTransitConnection) {
+      levels[TileHierarchy::get_level(directededge->classification())] = true;
+    }
+  }
+
+  // New nodes on the local level stay in the base tile
   auto tile_level = TileHierarchy::levels().rbegin();
-  auto& base_level = tile_level->second;
+  new_tiles[2] = GraphId(basenode.tileid(), basenode.level(), 0);
   tile_level++;
-  auto& arterial_level = tile_level->second;
+  new_tiles[1] = GraphId(tile_level->second.tiles.TileId(nodeinfo->latlng()), tile_level->second.level, 0);
   tile_level++;
-  auto& highway_level = tile_level->second;
+  new_tiles[0] = GraphId(tile_level->second.tiles.TileId(nodeinfo->latlng()), tile_level->second.level, 0);
+}
 
-  // Iterate through all tiles in the local level
+/**
+ * Count the new nodes each base tile adds to the tiles of each new level.
+ * The counts are replaced by the id of the first new node the base tile
+ * adds once all base tiles are counted.
+ */
+void CountNewNodes(const boost::property_tree::ptree& hierarchy_properties,
+                   const std::vector<GraphId>& base_tiles,
+                   std::vector<std::unordered_map<GraphId, uint32_t> >& new_node_counts,
+                   TileScheduler& scheduler, size_t worker,
+                   std::promise<bool>& result) {
+  GraphReader reader(hierarchy_properties);
   bool has_elevation = false;
-  uint32_t ntiles = base_level.tiles.TileCount();
-  uint32_t bl = static_cast<uint32_t>(base_level.level);
-  uint32_t al = static_cast<uint32_t>(arterial_level.level);
-  uint32_t hl = static_cast<uint32_t>(highway_level.level);
-  for (uint32_t basetileid = 0; basetileid < ntiles; basetileid++) {
-    // Get the graph tile. Skip if no tile exists (common case)
-    const GraphTile* tile = reader.GetGraphTile(GraphId(basetileid, bl, 0));
-    if (tile == nullptr || tile->header()->nodecount() == 0) {
-      continue;
-    }
+  size_t index;
+  while (scheduler.next(worker, index)) {
 
-    // Update the has_elevation flag
+    // Only this thread writes the counts for this base tile
+    const GraphTile* tile = reader.GetGraphTile(base_tiles[index]);
     if (tile->header()->has_edge_elevation()) {
       has_elevation = true;
     }
-
-    // Iterate through the nodes. Add nodes to the new level when
-    // best road class <= the new level classification cutoff
     bool levels[3];
-    uint32_t nodecount = tile->header()->nodecount();
-    GraphId basenode(basetileid, bl, 0);
-    GraphId edgeid(basetileid, bl, 0);
+    GraphId new_tiles[3];
+    GraphId basenode = base_tiles[index];
     const NodeInfo* nodeinfo = tile->node(basenode);
-    for (uint32_t i = 0; i < nodecount; i++, nodeinfo++, ++basenode) {
-      // Iterate through the edges to see which levels this node exists.
-      levels[0] = levels[1] = levels[2] = false;
-      for (uint32_t j = 0; j < nodeinfo->edge_count(); j++, ++edgeid) {
-        // Update the flag for the level of this edge (skip transit
-        // connection edges)
-        const DirectedEdge* directededge = tile->directededge(edgeid);
-        if (directededge->use() != Use::kTransitConnection) {
-          levels[TileHierarchy::get_level(directededge->classification())] = true;
+    for (uint32_t i = 0; i < tile->header()->nodecount(); i++, nodeinfo++, ++basenode) {
+      GetNodeLevels(tile, nodeinfo, basenode, levels, new_tiles);
+      for (uint32_t level = 0; level < 3; level++) {
+        if (levels[level]) {
+          new_node_counts[index][new_tiles[level]]++;
         }
       }
+    }
 
+    // Check if we need to clear the tile cache
+    if (reader.OverCommitted()) {
+      reader.Clear();
+    }
+  }
+  result.set_value(has_elevation);
+}
+
+/**
+ * Associate the nodes of base tiles to their new nodes. The new node Ids in
+ * each new tile start at the first Id given for the base tile so they come
+ * out the same regardless of which thread does which base tile. Each thread
+ * writes its own sequences, they are merged when all threads are done.
+ */
+void AssociateNodes(const boost::property_tree::ptree& hierarchy_properties,
+                    const std::vector<GraphId>& base_tiles,
+                    const std::vector<std::unordered_map<GraphId, uint32_t> >& first_new_nodes,
+                    const std::string& thread_new_to_old_file,
+                    const std::string& thread_old_to_new_file,
+                    TileScheduler& scheduler, size_t worker,
+                    std::promise<void>& result) {
+  GraphReader reader(hierarchy_properties);
+  sequence<std::pair<GraphId, GraphId>> new_to_old(thread_new_to_old_file, true);
+  sequence<OldToNewNodes> old_to_new(thread_old_to_new_file, true);
+  size_t index;
+  while (scheduler.next(worker, index)) {
+
+    // Next new node Id in each of the new tiles
+    std::unordered_map<GraphId, uint32_t> new_nodes = first_new_nodes[index];
+
+    // Iterate through the nodes. Add nodes to the new level when
+    // best road class <= the new level classification cutoff
+    const GraphTile* tile = reader.GetGraphTile(base_tiles[index]);
+    bool levels[3];
+    GraphId new_tiles[3];
+    GraphId basenode = base_tiles[index];
+    const NodeInfo* nodeinfo = tile->node(basenode);
+    for (uint32_t i = 0; i < tile->header()->nodecount(); i++, nodeinfo++, ++basenode) {
       // Associate new nodes to base nodes and base node to new nodes
-      GraphId highway_node, arterial_node, local_node;
-      if (levels[0]) {
-        // New node is on the highway level. Associate back to base/local node
-        GraphId new_tile(highway_level.tiles.TileId(nodeinfo->latlng()), hl, 0);
-        highway_node = get_new_node(new_tile);
-        new_to_old.push_back(std::make_pair(highway_node, basenode));
-      }
-      if (levels[1]) {
-        // New node is on the arterial level. Associate back to base/local node
-        GraphId new_tile(arterial_level.tiles.TileId(nodeinfo->latlng()), al, 0);
-        arterial_node = get_new_node(new_tile);
-        new_to_old.push_back(std::make_pair(arterial_node, basenode));
-      }
-      if (levels[2]) {
-        // New node is on the local level. Associate back to base/local node
-        GraphId new_tile(basetileid, bl, 0);
-        local_node = get_new_node(new_tile);
-        new_to_old.push_back(std::make_pair(local_node, basenode));
+      GetNodeLevels(tile, nodeinfo, basenode, levels, new_tiles);
+      GraphId new_nodes_by_level[3];
+      for (uint32_t level = 0; level < 3; level++) {
+        if (levels[level]) {
+          const GraphId& new_tile = new_tiles[level];
+          new_nodes_by_level[level] = GraphId(new_tile.tileid(), new_tile.level(), new_nodes[new_tile]++);
+          new_to_old.push_back(std::make_pair(new_nodes_by_level[level], basenode));
+        }
       }
 
       if (!levels[0] && !levels[1] && !levels[2]) {
@@ -447,16 +478,110 @@ bool CreateNodeAssociations(GraphReader& reader) {
 
       // Associate the old node to the new node(s). Entries in the tuple
       // that are invalid nodes indicate no node exists in the new level.
-      OldToNewNodes assoc(basenode, highway_node, arterial_node,
-                           local_node, nodeinfo->density());
+      OldToNewNodes assoc(basenode, new_nodes_by_level[0], new_nodes_by_level[1],
+                          new_nodes_by_level[2], nodeinfo->density());
       old_to_new.push_back(assoc);
     }
 
     // Check if we need to clear the tile cache
-    if(reader.OverCommitted()) {
+    if (reader.OverCommitted()) {
       reader.Clear();
     }
   }
+  result.set_value();
+}
+
+/**
+ * Create node associations between "new" nodes placed into respective
+ * hierarchy levels and the existing nodes on the base/local level. The
+ * associations go both ways: from the "old" nodes on the base/local level
+ * to new nodes and from new nodes to old nodes using sequences (files).
+ * @return  Returns true if any base tiles have edge elevation data.
+ */
+bool CreateNodeAssociations(const boost::property_tree::ptree& hierarchy_properties,
+                            const unsigned int thread_count) {
+  // Base tiles that have nodes, in tile id order
+  std::vector<GraphId> base_tiles;
+  {
+    GraphReader reader(hierarchy_properties);
+    const auto& base_level = TileHierarchy::levels().rbegin()->second;
+    for (uint32_t basetileid = 0; basetileid < base_level.tiles.TileCount(); basetileid++) {
+      // Get the graph tile. Skip if no tile exists (common case)
+      GraphId tile_id(basetileid, base_level.level, 0);
+      if (!GraphReader::DoesTileExist(hierarchy_properties, tile_id)) {
+        continue;
+      }
+      const GraphTile* tile = reader.GetGraphTile(tile_id);
+      if (tile != nullptr && tile->header()->nodecount() > 0) {
+        base_tiles.push_back(tile_id);
+      }
+      if (reader.OverCommitted()) {
+        reader.Clear();
+      }
+    }
+  }
+
+  // Count the new nodes each base tile adds to each new tile
+  std::vector<std::unordered_map<GraphId, uint32_t> > new_nodes(base_tiles.size());
+  TileScheduler counter("Counting new nodes",
+                        TileScheduler::TileSizes(hierarchy_properties.get<std::string>("tile_dir"), base_tiles),
+                        thread_count);
+  std::vector<std::promise<bool> > counted(counter.threads());
+  counter.run([&](size_t worker) {
+    CountNewNodes(hierarchy_properties, base_tiles, new_nodes, counter, worker, counted[worker]);
+  });
+  bool has_elevation = false;
+  for (auto& result : counted) {
+    has_elevation = result.get_future().get() || has_elevation;
+  }
+
+  // Turn the counts into the first new node Id of each base tile. Base tiles
+  // are taken in order so the Ids are the same as a serial build
+  std::unordered_map<GraphId, uint32_t> next_new_node;
+  for (auto& counts : new_nodes) {
+    for (auto& count : counts) {
+      auto& next = next_new_node[count.first];
+      uint32_t first = next;
+      next += count.second;
+      count.second = first;
+    }
+  }
+
+  // Associate the nodes into sequences per thread
+  TileScheduler associator("Associating nodes",
+                           TileScheduler::TileSizes(hierarchy_properties.get<std::string>("tile_dir"), base_tiles),
+                           thread_count);
+  std::vector<std::promise<void> > associated(associator.threads());
+  std::vector<std::string> thread_files;
+  for (size_t i = 0; i < associator.threads(); ++i) {
+    thread_files.push_back(new_to_old_file + "." + std::to_string(i));
+    thread_files.push_back(old_to_new_file + "." + std::to_string(i));
+  }
+  associator.run([&](size_t worker) {
+    AssociateNodes(hierarchy_properties, base_tiles, new_nodes, thread_files[worker * 2],
+                   thread_files[worker * 2 + 1], associator, worker, associated[worker]);
+  });
+  for (auto& result : associated) {
+    result.get_future().get();
+  }
+
+  // Merge the sequences of each thread, they get sorted later
+  sequence<std::pair<GraphId, GraphId>> new_to_old(new_to_old_file, true);
+  sequence<OldToNewNodes> old_to_new(old_to_new_file, true);
+  for (size_t i = 0; i < thread_files.size(); i += 2) {
+    {
+      sequence<std::pair<GraphId, GraphId>> thread_new_to_old(thread_files[i], false);
+      thread_new_to_old.enumerate([&new_to_old](const std::pair<GraphId, GraphId>& n) {
+        new_to_old.push_back(n);
+      });
+      sequence<OldToNewNodes> thread_old_to_new(thread_files[i + 1], false);
+      thread_old_to_new.enumerate([&old_to_new](const OldToNewNodes& n) {
+        old_to_new.push_back(n);
+      });
+    }
+    remove(thread_files[i].c_str());
+    remove(thread_files[i + 1].c_str());
+  }
   return has_elevation;
 }
 
@@ -556,26 +681,69 @@ namespace mjolnir {
 // base level. Each successive level of the hierarchy is based on
 // and connected to the next.
 void HierarchyBuilder::Build(const boost::property_tree::ptree& pt) {
-
-  // TODO: thread this. Might be more possible now that we don't create
-  // shortcuts in the HierarchyBuilder
+  unsigned int thread_count = std::max(static_cast<unsigned int>(1),
+                                       pt.get<unsigned int>("mjolnir.concurrency", std::thread::hardware_concurrency()));
 
   // Construct GraphReader
-  LOG_INFO("HierarchyBuilder");
-  GraphReader reader(pt.get_child("mjolnir"));
+  LOG_INFO("HierarchyBuilder with " + std::to_string(thread_count) + " threads");
+  const auto& hierarchy_properties = pt.get_child("mjolnir");
+  GraphReader reader(hierarchy_properties);
 
   // Association of old nodes to new nodes
-  bool has_elevation = CreateNodeAssociations(reader);
+  bool has_elevation = CreateNodeAssociations(hierarchy_properties, thread_count);
   if (has_elevation) {
     LOG_INFO("Base tiles have edge elevation information");
   }
 
-  // Sort the sequences
-  SortSequences();
+  // Sort the sequences within the configured memory budget
+  SortSequences(pt.get<size_t>("mjolnir.sort_buffer_size", 1024 * 1024 * 512), thread_count);
+
+  // Find the range of new nodes in each new tile, weighed by how many there
+  // are, and keep them apart by level (sorted highway first)
+  std::map<uint8_t, std::vector<std::pair<size_t, size_t> > > ranges;
+  std::map<uint8_t, std::vector<size_t> > weights;
+  {
+    sequence<std::pair<GraphId, GraphId>> new_to_old(new_to_old_file, false);
+    GraphId tile_id;
+    size_t start = 0;
+    for (auto new_node = new_to_old.begin(); new_node != new_to_old.end(); new_node++) {
+      GraphId nodea = (*new_node).first;
+      if (nodea.Tile_Base() != tile_id) {
+        if (new_node.position() > start) {
+          ranges[tile_id.level()].emplace_back(start, new_node.position());
+          weights[tile_id.level()].push_back(new_node.position() - start);
+        }
+        tile_id = nodea.Tile_Base();
+        start = new_node.position();
+      }
+    }
+    if (new_to_old.size() > start) {
+      ranges[tile_id.level()].emplace_back(start, new_to_old.size());
+      weights[tile_id.level()].push_back(new_to_old.size() - start);
+    }
+  }
 
-  // Iterate through the hierarchy (from highway down to local) and build
-  // new tiles
-  FormTilesInNewLevel(reader, has_elevation);
+  // Iterate through the hierarchy (from highway down to local) and build the
+  // new tiles of each level, each one on whichever thread gets to it first.
+  // A level has to be finished before the next one starts: the local tiles
+  // are written over the base tiles that the levels above are read from
+  for (const auto& level : ranges) {
+    const auto& level_ranges = level.second;
+    LOG_INFO("Forming " + std::to_string(level_ranges.size()) +
+             " tiles on level " + std::to_string(level.first));
+    TileScheduler scheduler("Forming tiles on level " + std::to_string(level.first),
+                            weights[level.first], thread_count);
+    std::vector<std::promise<void> > results(scheduler.threads());
+    scheduler.run([&](size_t worker) {
+      FormTilesInNewLevel(hierarchy_properties, has_elevation, level_ranges,
+                          scheduler, worker, results[worker]);
+    });
+
+    // If something bad went down this will rethrow it
+    for (auto& result : results) {
+      result.get_future().get();
+    }
+  }
 
   // Remove any base tiles that no longer have any data (nodes and edges
   // only exist on arterial and highway levels)
@@ -1,13 +1,35 @@
 #include "mjolnir/idtable.h"
 #include <stdexcept>
 
+namespace {
+
+// Ids per chunk and how many a chunk keeps in its sorted array
+constexpr uint64_t kChunkBits = 16;
+constexpr uint64_t kChunkMask = (static_cast<uint64_t>(1) << kChunkBits) - 1;
+constexpr size_t kMaxArrayIds = 4096;
+
+// Words in the bitset of a dense chunk and words per block of its ranks
+constexpr size_t kBitsetWords = (kChunkMask + 1) / 64;
+constexpr size_t kBlockWords = 8;
+
+uint64_t count_bits(const uint64_t* words, size_t count) {
+  uint64_t bits = 0;
+  for (size_t i = 0; i < count; ++i) {
+    bits += __builtin_popcountll(words[i]);
+  }
+  return bits;
+}
+
+}
+
 namespace valhalla {
 namespace mjolnir {
 
 // Constructor to create table of OSM Node IDs being used
-IdTable::IdTable(const uint64_t maxosmid): maxosmid_(maxosmid) {
-  // Create a vector to mark bits. Initialize to 0.
-  bitmarkers_.resize((maxosmid / 64) + 1, 0);
+IdTable::IdTable(const uint64_t maxosmid): maxosmid_(maxosmid), count_(0), ranked_(true) {
+  // Only the index of the chunks is sized up front, chunks come as they are set
+  chunk_index_.resize((maxosmid >> kChunkBits) + 1, 0);
+  chunk_ranks_.resize(chunk_index_.size(), 0);
 }
 
 // Destructor for NodeId table
@@ -20,12 +42,125 @@ void IdTable::set(const uint64_t id) {
   if (id > maxosmid_) {
     throw std::runtime_error("NodeIDTable - OSM Id exceeds max specified");
   }
-  bitmarkers_[id / 64] |= static_cast<uint64_t>(1) << (id % static_cast<uint64_t>(64));
+
+  // Get the chunk, making it if its the first Id in it
+  auto& index = chunk_index_[id >> kChunkBits];
+  if (index == 0) {
+    chunks_.emplace_back();
+    index = static_cast<uint32_t>(chunks_.size());
+  }
+  auto& chunk = chunks_[index - 1];
+  uint16_t low = static_cast<uint16_t>(id & kChunkMask);
+
+  if (chunk.bits.empty()) {
+    // Keep the array sorted
+    auto found = std::lower_bound(chunk.ids.begin(), chunk.ids.end(), low);
+    if (found != chunk.ids.end() && *found == low) {
+      return;
+    }
+    if (chunk.ids.size() < kMaxArrayIds) {
+      chunk.ids.insert(found, low);
+      ++count_;
+      ranked_ = false;
+      return;
+    }
+
+    // Too many Ids for the array, switch to a bitset
+    chunk.bits.resize(kBitsetWords, 0);
+    for (auto i : chunk.ids) {
+      chunk.bits[i / 64] |= static_cast<uint64_t>(1) << (i % 64);
+    }
+    std::vector<uint16_t>().swap(chunk.ids);
+  }
+
+  uint64_t bit = static_cast<uint64_t>(1) << (low % 64);
+  if (!(chunk.bits[low / 64] & bit)) {
+    chunk.bits[low / 64] |= bit;
+    ++count_;
+    ranked_ = false;
+  }
 }
 
 // Check if an OSM Id is used (in the Node table)
 const bool IdTable::IsUsed(const uint64_t id) const {
-  return bitmarkers_[id / 64] & (static_cast<uint64_t>(1) << (id % static_cast<uint64_t>(64)));
+  uint64_t c = id >> kChunkBits;
+  if (c >= chunk_index_.size() || chunk_index_[c] == 0) {
+    return false;
+  }
+  const auto& chunk = chunks_[chunk_index_[c] - 1];
+  uint16_t low = static_cast<uint16_t>(id & kChunkMask);
+  if (chunk.bits.empty()) {
+    return std::binary_search(chunk.ids.begin(), chunk.ids.end(), low);
+  }
+  return chunk.bits[low / 64] & (static_cast<uint64_t>(1) << (low % 64));
+}
+
+// Get the number of set Ids less than the given one
+uint64_t IdTable::rank(const uint64_t id) const {
+  if (!ranked_) {
+    UpdateRanks();
+  }
+
+  uint64_t c = id >> kChunkBits;
+  if (c >= chunk_index_.size()) {
+    return count_;
+  }
+  uint64_t rank = chunk_ranks_[c];
+  if (chunk_index_[c] == 0) {
+    return rank;
+  }
+
+  // Count within the chunk
+  const auto& chunk = chunks_[chunk_index_[c] - 1];
+  uint16_t low = static_cast<uint16_t>(id & kChunkMask);
+  if (chunk.bits.empty()) {
+    return rank + (std::lower_bound(chunk.ids.begin(), chunk.ids.end(), low) - chunk.ids.begin());
+  }
+  size_t word = low / 64;
+  size_t block = word / kBlockWords;
+  rank += chunk.block_ranks[block];
+  rank += count_bits(&chunk.bits[block * kBlockWords], word - block * kBlockWords);
+  return rank + __builtin_popcountll(chunk.bits[word] & ((static_cast<uint64_t>(1) << (low % 64)) - 1));
+}
+
+// Get the number of set Ids
+uint64_t IdTable::size() const {
+  return count_;
+}
+
+// Get the memory used by the index and the chunks
+size_t IdTable::memory() const {
+  size_t bytes = chunk_index_.capacity() * sizeof(uint32_t) + chunk_ranks_.capacity() * sizeof(uint64_t) +
+                 chunks_.capacity() * sizeof(Chunk);
+  for (const auto& chunk : chunks_) {
+    bytes += chunk.ids.capacity() * sizeof(uint16_t) + chunk.bits.capacity() * sizeof(uint64_t) +
+             chunk.block_ranks.capacity() * sizeof(uint16_t);
+  }
+  return bytes;
+}
+
+// Count the set Ids before each chunk and each block of the dense chunks
+void IdTable::UpdateRanks() const {
+  uint64_t rank = 0;
+  for (size_t c = 0; c < chunk_index_.size(); ++c) {
+    chunk_ranks_[c] = rank;
+    if (chunk_index_[c] == 0) {
+      continue;
+    }
+    const auto& chunk = chunks_[chunk_index_[c] - 1];
+    if (chunk.bits.empty()) {
+      rank += chunk.ids.size();
+      continue;
+    }
+    chunk.block_ranks.resize(kBitsetWords / kBlockWords);
+    uint64_t block_rank = 0;
+    for (size_t block = 0; block < chunk.block_ranks.size(); ++block) {
+      chunk.block_ranks[block] = static_cast<uint16_t>(block_rank);
+      block_rank += count_bits(&chunk.bits[block * kBlockWords], kBlockWords);
+    }
+    rank += block_rank;
+  }
+  ranked_ = true;
 }
 
 }
@@ -80,6 +80,8 @@ Tags LuaTagTransform::Transform(OSMType type, const Tags &maptags) {
   const std::string& lua_func = type == OSMType::kNode ? LUA_NODE_PROC :
                                 (type == OSMType::kWay ? LUA_WAY_PROC : LUA_REL_PROC);
 
+  //where the stack starts so we can put it back if lua fails
+  int top = lua_gettop(state_);
   try {
     //grab the function
     lua_getglobal(state_, lua_func.c_str());
@@ -97,9 +99,12 @@ Tags LuaTagTransform::Transform(OSMType type, const Tags &maptags) {
     //tell lua how many items are in the map
     lua_pushinteger(state_, count);
 
-    //call lua
+    //call lua, on failure the only thing on the stack is the error message
     if (lua_pcall(state_, 2, type == OSMType::kWay ? 4 : 2, 0)) {
-      LOG_ERROR("Failed to execute lua function for basic tag processing.");
+      const char* error = lua_tostring(state_, -1);
+      LOG_ERROR((boost::format("Failed to execute lua function %1%: %2%") % lua_func % (error ? error : "unknown error")).str());
+      lua_settop(state_, top);
+      return result;
     }
 
     //TODO:  if we dont care about it we stop looking.  Look for filter = 1
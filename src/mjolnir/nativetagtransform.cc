@@ -0,0 +1,1057 @@
+#include "mjolnir/nativetagtransform.h"
+
+extern "C" {
+#include <lua.h>
+#include <lualib.h>
+#include <lauxlib.h>
+}
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <initializer_list>
+#include <stdexcept>
+#include <boost/format.hpp>
+#include "midgard/logging.h"
+
+using namespace valhalla::mjolnir;
+
+namespace {
+
+const std::string kTrue = "true";
+const std::string kFalse = "false";
+
+// Lua turns numbers into strings with %.14g
+std::string to_string(double number) {
+  char buffer[32];
+  snprintf(buffer, sizeof(buffer), "%.14g", number);
+  return buffer;
+}
+
+// Get the global lua table of the given name off the top of the stack
+void GetLuaTable(lua_State* state, const std::string& name) {
+  lua_getglobal(state, name.c_str());
+  if (!lua_istable(state, -1)) {
+    throw std::runtime_error((boost::format("Lua script does not contain a table %1%.")
+    % name).str());
+  }
+}
+
+// Key of the current entry while iterating a table, copied so that numeric
+// keys are not turned into strings in place which would break lua_next
+std::string LuaKey(lua_State* state) {
+  lua_pushvalue(state, -2);
+  std::string key = lua_tostring(state, -1);
+  lua_pop(state, 1);
+  return key;
+}
+
+template <class value_t>
+void LoadLuaTable(lua_State* state, const std::string& name,
+                  std::unordered_map<std::string, value_t>& table);
+
+template <>
+void LoadLuaTable(lua_State* state, const std::string& name,
+                  std::unordered_map<std::string, std::string>& table) {
+  GetLuaTable(state, name);
+  lua_pushnil(state);
+  while (lua_next(state, -2) != 0) {
+    table[LuaKey(state)] = lua_tostring(state, -1);
+    lua_pop(state, 1);
+  }
+  lua_pop(state, 1);
+}
+
+template <>
+void LoadLuaTable(lua_State* state, const std::string& name,
+                  std::unordered_map<std::string, double>& table) {
+  GetLuaTable(state, name);
+  lua_pushnil(state);
+  while (lua_next(state, -2) != 0) {
+    table[LuaKey(state)] = lua_tonumber(state, -1);
+    lua_pop(state, 1);
+  }
+  lua_pop(state, 1);
+}
+
+// The value of a tag, nullptr if the tag is not there (nil in lua)
+const std::string* get(const Tags& kv, const std::string& key) {
+  auto tag = kv.find(key);
+  return tag == kv.end() ? nullptr : &tag->second;
+}
+
+bool is(const std::string* value, const char* other) {
+  return value && *value == other;
+}
+
+bool is(const Tags& kv, const std::string& key, const char* value) {
+  return is(get(kv, key), value);
+}
+
+// Look up a value in a table, like table[value] in lua
+template <class value_t>
+const value_t* lookup(const std::unordered_map<std::string, value_t>& table, const std::string* key) {
+  if (!key) {
+    return nullptr;
+  }
+  auto found = table.find(*key);
+  return found == table.end() ? nullptr : &found->second;
+}
+
+// The first value that is not nil, like a or b or c in lua
+const std::string* first(std::initializer_list<const std::string*> values) {
+  for (const auto* value : values) {
+    if (value) {
+      return value;
+    }
+  }
+  return nullptr;
+}
+
+// Set or remove (when nil) a tag, like kv[key] = value in lua
+void set(Tags& kv, const std::string& key, const std::string* value) {
+  if (value) {
+    kv[key] = *value;
+  } else {
+    kv.erase(key);
+  }
+}
+
+void set(Tags& kv, const std::string& key, const double* value) {
+  if (value) {
+    kv[key] = to_string(*value);
+  } else {
+    kv.erase(key);
+  }
+}
+
+void swap(Tags& kv, const std::string& a, const std::string& b) {
+  auto first = kv.find(a);
+  auto second = kv.find(b);
+  if (first != kv.end() && second != kv.end()) {
+    std::swap(first->second, second->second);
+  } else if (first != kv.end()) {
+    kv[b] = std::move(first->second);
+    kv.erase(a);
+  } else if (second != kv.end()) {
+    kv[a] = std::move(second->second);
+    kv.erase(b);
+  }
+}
+
+double round(double value) {
+  return std::floor(value + 0.5);
+}
+
+double round(double value, int digits) {
+  double scale = std::pow(10.0, digits);
+  return std::floor((value * scale) + 0.5) / scale;
+}
+
+std::string remove_spaces(const std::string& value) {
+  std::string stripped;
+  for (char c : value) {
+    if (!isspace(static_cast<unsigned char>(c))) {
+      stripped.push_back(c);
+    }
+  }
+  return stripped;
+}
+
+bool ends_with(const std::string& value, const char* suffix) {
+  size_t length = strlen(suffix);
+  return value.size() >= length && value.compare(value.size() - length, length, suffix) == 0;
+}
+
+bool is_digit(char c) {
+  return c >= '0' && c <= '9';
+}
+
+// Convert the numeric (non negative) number portion at the beginning of the string
+const double* numeric_prefix(const std::string* num_str, bool allow_decimals, double& num) {
+  if (!num_str) {
+    return nullptr;
+  }
+
+  // Find where the numbers stop
+  size_t index = 0;
+  for (; index < num_str->size(); ++index) {
+    char c = (*num_str)[index];
+    if (!is_digit(c) && (c != '.' || !allow_decimals)) {
+      break;
+    }
+  }
+  if (index == 0) {
+    return nullptr;
+  }
+
+  // Lua's tonumber wants the whole string to be a number
+  std::string prefix = num_str->substr(0, index);
+  char* end;
+  num = strtod(prefix.c_str(), &end);
+  return end == prefix.c_str() + prefix.size() ? &num : nullptr;
+}
+
+// Skip to the first digit
+std::string digits_onward(const std::string& value) {
+  size_t index = 0;
+  while (index < value.size() && !is_digit(value[index])) {
+    ++index;
+  }
+  return value.substr(index);
+}
+
+// Like string.sub(value, start) in lua
+std::string sub(const std::string& value, size_t start) {
+  return value.substr(std::min(value.size(), start - 1));
+}
+
+// Normalize a speed value
+const double* normalize_speed(const std::string* speed, double& num) {
+  if (!numeric_prefix(speed, false, num)) {
+    return nullptr;
+  }
+
+  // Check if the rest of the string ends in "mph" convert to kph
+  if (ends_with(*speed, "mph")) {
+    num = round(num * 1.609344);
+  }
+
+  // If num > 150kph or num < 10kph....toss
+  if (num > 150 || num < 10) {
+    return nullptr;
+  }
+  return &num;
+}
+
+const double* normalize_weight(const std::string* weight, double& num) {
+  if (!weight) {
+    return nullptr;
+  }
+  std::string w = remove_spaces(*weight);
+  if (!numeric_prefix(&w, true, num)) {
+    return nullptr;
+  }
+
+  // Tons are taken as they are, pounds and kilograms are converted
+  std::string number = to_string(num);
+  if (w == number + "lb" || w == number + "lbs") {
+    num = round(num / 2000, 2);
+  } else if (w == number + "kg") {
+    num = round(num / 1000, 2);
+  } else {
+    num = round(num, 2);
+  }
+  return &num;
+}
+
+const double* normalize_measurement(const std::string* measurement, double& num) {
+  if (!measurement) {
+    return nullptr;
+  }
+
+  // 7'6" or 7ft6in
+  // 7m
+  // 7
+  std::string m = remove_spaces(*measurement);
+  if (!numeric_prefix(&m, true, num)) {
+    return nullptr;
+  }
+  std::string number = to_string(num);
+  if (m == number + "m" || m == number + "meter" || m == number + "meters") {
+    num = round(num, 2);
+    return &num;
+  }
+
+  double feet, inches;
+  if (ends_with(m, "in") || ends_with(m, "\"") || ends_with(m, "inches") || ends_with(m, "inch")) {
+    // Have to check for inches only
+    if (m == number + "in" || m == number + "\"" || m == number + "inches" || m == number + "inch") {
+      num = round(num * 0.0254, 2);
+      return &num;
+    }
+
+    feet = num;
+    m = digits_onward(sub(*measurement, to_string(feet).size() + 1));
+    if (!numeric_prefix(&m, true, inches)) {
+      throw std::runtime_error("Invalid measurement: " + *measurement);
+    }
+    num = round((feet * 0.3048) + (inches * 0.0254), 2);
+  } else if (ends_with(m, "ft") || ends_with(m, "'") || ends_with(m, "feet")) {
+    feet = num;
+    num = round(feet * 0.3048, 2);
+  } else {
+    feet = num;
+    m = sub(*measurement, to_string(feet).size() + 1);
+    std::string rest = digits_onward(m);
+    // Crappy data case.  7'6 or 7ft6
+    if (rest.size() != m.size()) {
+      if (numeric_prefix(&rest, true, inches)) {
+        num = round((feet * 0.3048) + (inches * 0.0254), 2);
+      } else {
+        num = round(feet * 0.3048, 2);
+      }
+    }
+  }
+  num = round(num, 2);
+  return &num;
+}
+
+// Lane counts are capped at 10
+const double* lane_count(const std::string* lanes, double& num) {
+  if (!numeric_prefix(lanes, false, num)) {
+    return nullptr;
+  }
+  if (num > 10) {
+    num = 10;
+  }
+  return &num;
+}
+
+}
+
+namespace valhalla {
+namespace mjolnir {
+
+NativeTagTransform::NativeTagTransform(const std::string& lua) {
+  // Run the script once to get at its tables
+  lua_State* state = luaL_newstate();
+  luaL_openlibs(state);
+  luaL_dostring(state, lua.c_str());
+
+  try {
+    GetLuaTable(state, "highway");
+    lua_pushnil(state);
+    while (lua_next(state, -2) != 0) {
+      auto& modes = highway_[LuaKey(state)];
+      lua_pushnil(state);
+      while (lua_next(state, -2) != 0) {
+        modes.emplace_back(LuaKey(state), lua_tostring(state, -1));
+        lua_pop(state, 1);
+      }
+      lua_pop(state, 1);
+    }
+    lua_pop(state, 1);
+
+    LoadLuaTable(state, "road_class", road_class_);
+    LoadLuaTable(state, "restriction", restriction_);
+    LoadLuaTable(state, "dow", dow_);
+    LoadLuaTable(state, "default_speed", default_speed_);
+    LoadLuaTable(state, "access", access_);
+    LoadLuaTable(state, "private", private_);
+    LoadLuaTable(state, "no_thru_traffic", no_thru_traffic_);
+    LoadLuaTable(state, "use", use_);
+    LoadLuaTable(state, "motor_vehicle", motor_vehicle_);
+    LoadLuaTable(state, "foot", foot_);
+    LoadLuaTable(state, "wheelchair", wheelchair_);
+    LoadLuaTable(state, "bus", bus_);
+    LoadLuaTable(state, "psv", psv_);
+    LoadLuaTable(state, "truck", truck_);
+    LoadLuaTable(state, "hazmat", hazmat_);
+    LoadLuaTable(state, "bicycle", bicycle_);
+    LoadLuaTable(state, "cycleway", cycleway_);
+    LoadLuaTable(state, "bike_reverse", bike_reverse_);
+    LoadLuaTable(state, "bus_reverse", bus_reverse_);
+    LoadLuaTable(state, "shared", shared_);
+    LoadLuaTable(state, "dedicated", dedicated_);
+    LoadLuaTable(state, "separated", separated_);
+    LoadLuaTable(state, "oneway", oneway_);
+    LoadLuaTable(state, "bridge", bridge_);
+    LoadLuaTable(state, "tunnel", tunnel_);
+    LoadLuaTable(state, "toll", toll_);
+    LoadLuaTable(state, "motor_vehicle_node", motor_vehicle_node_);
+    LoadLuaTable(state, "bicycle_node", bicycle_node_);
+    LoadLuaTable(state, "foot_node", foot_node_);
+    LoadLuaTable(state, "wheelchair_node", wheelchair_node_);
+    LoadLuaTable(state, "bus_node", bus_node_);
+    LoadLuaTable(state, "truck_node", truck_node_);
+    LoadLuaTable(state, "psv_node", psv_node_);
+  }
+  catch(...) {
+    lua_close(state);
+    throw;
+  }
+  lua_close(state);
+}
+
+Tags NativeTagTransform::Transform(OSMType type, const Tags &tags) {
+  Tags result(tags);
+  try {
+    bool filter = type == OSMType::kNode ? FilterNode(result) :
+                  (type == OSMType::kWay ? FilterWay(result) : FilterRelation(result));
+    if (filter)
+      result.clear();
+  }
+  catch(std::exception& e) {
+    LOG_ERROR((boost::format("Exception in native tag transform: %1%") % e.what()).str());
+    result.clear();
+  }
+  return result;
+}
+
+bool NativeTagTransform::FilterNode(Tags& kv) const {
+  // Normalize a few tags that we care about
+  const std::string* access = first({lookup(access_, get(kv, "access")), &kTrue});
+  if (is(kv, "impassable", "yes") || (is(kv, "access", "private") &&
+      (is(kv, "emergency", "yes") || is(kv, "service", "emergency_access")))) {
+    access = &kFalse;
+  }
+
+  // Masks of the modes tagged at this node, -1 when not tagged
+  auto mask = [](const double* value) { return value ? static_cast<int64_t>(*value) : -1; };
+  int64_t hov_tag = -1;
+  if ((get(kv, "hov") && !is(kv, "hov", "no")) || get(kv, "hov:lanes") || get(kv, "hov:minimum")) {
+    hov_tag = 128;
+  }
+  int64_t foot_tag = mask(lookup(foot_node_, get(kv, "foot")));
+  int64_t wheelchair_tag = mask(lookup(wheelchair_node_, get(kv, "wheelchair")));
+  int64_t bike_tag = mask(lookup(bicycle_node_, get(kv, "bicycle")));
+  int64_t truck_tag = mask(lookup(truck_node_, get(kv, "hgv")));
+  int64_t auto_tag = mask(lookup(motor_vehicle_node_, get(kv, "motorcar")));
+  int64_t motor_vehicle_tag = mask(lookup(motor_vehicle_node_, get(kv, "motor_vehicle")));
+  if (auto_tag == -1) {
+    auto_tag = motor_vehicle_tag;
+  }
+  int64_t bus_tag = mask(lookup(bus_node_, get(kv, "bus")));
+  if (bus_tag == -1) {
+    bus_tag = mask(lookup(psv_node_, get(kv, "psv")));
+  }
+  // If bus was not set and car is
+  if (bus_tag == -1 && auto_tag == 1) {
+    bus_tag = 64;
+  }
+  // If wheelchair was not set and foot is
+  if (wheelchair_tag == -1 && foot_tag == 2) {
+    wheelchair_tag = 256;
+  }
+  // If hov was not set and car is
+  if (hov_tag == -1 && auto_tag == 1) {
+    hov_tag = 128;
+  }
+  // If truck was not set and car is
+  if (truck_tag == -1 && auto_tag == 1) {
+    truck_tag = 8;
+  }
+  // Must shut these off if motor_vehicle = 0
+  if (motor_vehicle_tag == 0) {
+    bus_tag = 0;
+    truck_tag = 0;
+  }
+  int64_t emergency_tag = -1;
+  if (is(kv, "access", "emergency") || is(kv, "emergency", "yes") || is(kv, "service", "emergency_access")) {
+    emergency_tag = 16;
+  }
+  // Do not shut off bike access if there is a highway crossing.
+  if (bike_tag == 0 && is(kv, "highway", "crossing")) {
+    bike_tag = 4;
+  }
+
+  // If tag exists use it, otherwise access allowed for all modes unless
+  // access = false or hov = designated
+  auto tag_or = [](int64_t tag, int64_t value) { return tag == -1 ? value : tag; };
+  auto allow_all = [&]() {
+    return std::vector<int64_t>{ tag_or(auto_tag, 1), tag_or(truck_tag, 8), tag_or(bus_tag, 64),
+      tag_or(foot_tag, 2), tag_or(wheelchair_tag, 256), tag_or(bike_tag, 4),
+      tag_or(emergency_tag, 16), tag_or(hov_tag, 128) };
+  };
+  std::vector<int64_t> modes = allow_all();
+
+  // If access = false use tag if exists, otherwise no access for that mode.
+  if (is(access, "false") || is(kv, "hov", "designated")) {
+    modes = { tag_or(auto_tag, 0), tag_or(truck_tag, 0), tag_or(bus_tag, 0), tag_or(foot_tag, 0),
+      tag_or(wheelchair_tag, 0), tag_or(bike_tag, 0), tag_or(emergency_tag, 0), tag_or(hov_tag, 0) };
+  }
+
+  // Check for gates and bollards
+  bool gate = is(kv, "barrier", "gate") || is(kv, "barrier", "lift_gate");
+  bool bollard = false;
+  if (!gate) {
+    // If there was a bollard cars can't get through it
+    bollard = is(kv, "barrier", "bollard") || is(kv, "barrier", "block") || is(kv, "bollard", "removable");
+
+    // Save the following as gates.
+    if (bollard && is(kv, "bollard", "rising")) {
+      gate = true;
+      bollard = false;
+    }
+
+    // Bollard = true shuts off access unless the tag exists.
+    if (bollard) {
+      modes = { tag_or(auto_tag, 0), tag_or(truck_tag, 0), tag_or(bus_tag, 0), tag_or(foot_tag, 2),
+        tag_or(wheelchair_tag, 256), tag_or(bike_tag, 4), tag_or(emergency_tag, 0), tag_or(hov_tag, 0) };
+    }
+  }
+
+  // If nothing blocks access at this node assume access is allowed.
+  if (!gate && !bollard && is(access, "true")) {
+    if (is(kv, "highway", "crossing") || is(kv, "railway", "crossing") ||
+        is(kv, "footway", "crossing") || is(kv, "cycleway", "crossing") ||
+        is(kv, "foot", "crossing") || is(kv, "bicycle", "crossing") ||
+        is(kv, "pedestrian", "crossing") || get(kv, "crossing")) {
+      modes = allow_all();
+    }
+  }
+
+  // Store the gate and bollard info
+  kv["gate"] = gate ? kTrue : kFalse;
+  kv["bollard"] = bollard ? kTrue : kFalse;
+
+  if (is(kv, "barrier", "border_control")) {
+    kv["border_control"] = kTrue;
+  } else if (is(kv, "barrier", "toll_booth")) {
+    kv["toll_booth"] = kTrue;
+  }
+
+  const std::string* coins = first({lookup(toll_, get(kv, "payment:coins")), &kFalse});
+  const std::string* notes = first({lookup(toll_, get(kv, "payment:notes")), &kFalse});
+
+  // Assume cash for toll, toll:*, and fee
+  const std::string* cash = first({lookup(toll_, get(kv, "toll")), lookup(toll_, get(kv, "toll:hgv")),
+    lookup(toll_, get(kv, "toll:bicycle")), lookup(toll_, get(kv, "toll:hov")),
+    lookup(toll_, get(kv, "toll:motorcar")), lookup(toll_, get(kv, "toll:motor_vehicle")),
+    lookup(toll_, get(kv, "toll:bus")), lookup(toll_, get(kv, "toll:motorcycle")),
+    lookup(toll_, get(kv, "payment:cash")), lookup(toll_, get(kv, "fee")), &kFalse});
+
+  const std::string* etc = first({lookup(toll_, get(kv, "payment:e_zpass")),
+    lookup(toll_, get(kv, "payment:e_zpass:name")), lookup(toll_, get(kv, "payment:pikepass")),
+    lookup(toll_, get(kv, "payment:via_verde")), &kFalse});
+
+  uint32_t cash_payment = 0;
+  if (is(cash, "true") || (is(coins, "true") && is(notes, "true"))) {
+    cash_payment = 3;
+  } else if (is(coins, "true")) {
+    cash_payment = 1;
+  } else if (is(notes, "true")) {
+    cash_payment = 2;
+  }
+  uint32_t etc_payment = is(etc, "true") ? 4 : 0;
+
+  // Store a mask denoting payment type
+  kv["payment_mask"] = std::to_string(cash_payment | etc_payment);
+
+  if (is(kv, "amenity", "bicycle_rental") || (is(kv, "shop", "bicycle") &&
+      is(kv, "service:bicycle:rental", "yes"))) {
+    kv["bicycle_rental"] = kTrue;
+  }
+
+  if (is(kv, "traffic_signals:direction", "forward")) {
+    kv["forward_signal"] = kTrue;
+  }
+
+  if (is(kv, "traffic_signals:direction", "backward")) {
+    kv["backward_signal"] = kTrue;
+  }
+
+  // Store a mask denoting access
+  uint32_t access_mask = 0;
+  for (auto mode : modes) {
+    access_mask |= static_cast<uint32_t>(mode);
+  }
+  kv["access_mask"] = std::to_string(access_mask);
+  return false;
+}
+
+bool NativeTagTransform::FilterWay(Tags& kv) const {
+  // If there were no tags passed in there is nothing to keep
+  if (kv.empty()) {
+    return true;
+  }
+
+  if (is(kv, "highway", "construction") || is(kv, "highway", "proposed")) {
+    return true;
+  }
+
+  // Figure out what basic type of road it is
+  const auto* forward = lookup(highway_, get(kv, "highway"));
+  bool ferry = is(kv, "route", "ferry");
+  bool rail = is(kv, "route", "shuttle_train");
+  const std::string* access = lookup(access_, get(kv, "access"));
+
+  kv["emergency_forward"] = kFalse;
+  kv["emergency_backward"] = kFalse;
+
+  if (ferry || rail || get(kv, "highway")) {
+    if (is(kv, "access", "emergency") || is(kv, "emergency", "yes") || is(kv, "service", "emergency_access")) {
+      kv["emergency_forward"] = kTrue;
+      kv["emergency_tag"] = kTrue;
+    }
+    if (is(kv, "emergency", "no")) {
+      kv["emergency_tag"] = kFalse;
+    }
+  }
+
+  bool no_access = is(kv, "impassable", "yes") || is(access, "false") || (is(kv, "access", "private") &&
+                   (is(kv, "emergency", "yes") || is(kv, "service", "emergency_access")));
+  auto shut_off = [&kv]() {
+    for (const auto* key : { "auto_forward", "truck_forward", "bus_forward", "pedestrian", "bike_forward",
+                             "auto_backward", "truck_backward", "bus_backward", "bike_backward" }) {
+      kv[key] = kFalse;
+    }
+  };
+
+  // Overrides of the defaults for each mode
+  auto auto_tag = [&]() {
+    return first({lookup(motor_vehicle_, get(kv, "motorcar")), lookup(motor_vehicle_, get(kv, "motor_vehicle"))});
+  };
+  auto truck_tag = [&]() {
+    return first({lookup(truck_, get(kv, "hgv")), lookup(motor_vehicle_, get(kv, "motor_vehicle"))});
+  };
+  auto bus_tag = [&]() {
+    return first({lookup(bus_, get(kv, "bus")), lookup(psv_, get(kv, "psv")),
+                  lookup(psv_, get(kv, "lanes:psv:forward")), lookup(motor_vehicle_, get(kv, "motor_vehicle"))});
+  };
+  auto foot_tag = [&]() {
+    return first({lookup(foot_, get(kv, "foot")), lookup(foot_, get(kv, "pedestrian"))});
+  };
+  auto bike_tag = [&]() {
+    return first({lookup(bicycle_, get(kv, "bicycle")), lookup(cycleway_, get(kv, "cycleway")),
+                  lookup(bicycle_, get(kv, "bicycle_road")), lookup(bicycle_, get(kv, "cyclestreet"))});
+  };
+
+  if (forward) {
+    for (const auto& mode : *forward) {
+      kv[mode.first] = mode.second;
+    }
+    if (no_access) {
+      shut_off();
+    }
+    set(kv, "auto_forward", first({auto_tag(), get(kv, "auto_forward")}));
+    set(kv, "auto_tag", auto_tag());
+    set(kv, "truck_forward", first({truck_tag(), get(kv, "truck_forward")}));
+    set(kv, "truck_tag", truck_tag());
+    set(kv, "bus_forward", first({bus_tag(), get(kv, "bus_forward")}));
+    set(kv, "bus_tag", bus_tag());
+    set(kv, "pedestrian", first({foot_tag(), get(kv, "pedestrian")}));
+    set(kv, "foot_tag", foot_tag());
+    set(kv, "bike_forward", first({bike_tag(), get(kv, "bike_forward")}));
+    set(kv, "bike_tag", bike_tag());
+  } else {
+    // If its a ferry and these tags dont show up we want to set them to true
+    const std::string* default_val = (ferry || rail) ? &kTrue : &kFalse;
+    if ((!ferry && !rail) || no_access) {
+      shut_off();
+    } else {
+      set(kv, "auto_forward", first({auto_tag(), default_val}));
+      set(kv, "auto_tag", auto_tag());
+      set(kv, "truck_forward", first({lookup(truck_, get(kv, "hgv")), get(kv, "truck_forward"),
+                                      lookup(motor_vehicle_, get(kv, "motor_vehicle")), default_val}));
+      set(kv, "truck_tag", truck_tag());
+      set(kv, "bus_forward", first({bus_tag(), default_val}));
+      set(kv, "bus_tag", bus_tag());
+      set(kv, "pedestrian", first({foot_tag(), default_val}));
+      set(kv, "foot_tag", foot_tag());
+      set(kv, "bike_forward", first({bike_tag(), default_val}));
+      set(kv, "bike_tag", bike_tag());
+    }
+  }
+
+  // TODO: handle Time conditional restrictions if available for HOVs with oneway = reversible
+  if ((is(kv, "access", "permissive") || is(kv, "access", "hov")) && is(kv, "oneway", "reversible")) {
+    // For now enable only for buses if the tag exists and they are allowed.
+    if (is(kv, "bus_forward", "true")) {
+      kv["auto_forward"] = kFalse;
+      kv["truck_forward"] = kFalse;
+      kv["pedestrian"] = kFalse;
+      kv["bike_forward"] = kFalse;
+    } else {
+      return true;
+    }
+  }
+
+  // Service=driveway means all are routable
+  if (is(kv, "service", "driveway") && !get(kv, "access")) {
+    for (const auto* key : { "auto_forward", "truck_forward", "bus_forward", "pedestrian", "bike_forward" }) {
+      kv[key] = kTrue;
+    }
+  }
+
+  // Check the oneway-ness and traversability against the direction of the geom
+  if ((is(kv, "oneway", "yes") && is(kv, "oneway:bicycle", "no")) ||
+      is(kv, "bicycle:backward", "yes") || is(kv, "bicycle:backward", "no")) {
+    kv["bike_backward"] = kTrue;
+  }
+  if (!get(kv, "bike_backward") || is(kv, "bike_backward", "false")) {
+    set(kv, "bike_backward", first({lookup(bike_reverse_, get(kv, "cycleway")),
+      lookup(bike_reverse_, get(kv, "cycleway:left")), lookup(bike_reverse_, get(kv, "cycleway:right")), &kFalse}));
+  }
+  const std::string* oneway_bike = nullptr;
+  if (is(kv, "bike_backward", "true")) {
+    oneway_bike = lookup(oneway_, get(kv, "oneway:bicycle"));
+    if (is(oneway_bike, "false") && is(kv, "bicycle:backward", "yes")) {
+      oneway_bike = &kTrue;
+    }
+  }
+
+  if ((is(kv, "oneway", "yes") && is(kv, "oneway:bus", "no")) ||
+      is(kv, "bus:backward", "yes") || is(kv, "bus:backward", "designated")) {
+    kv["bus_backward"] = kTrue;
+  }
+  if (!get(kv, "bus_backward") || is(kv, "bus_backward", "false")) {
+    set(kv, "bus_backward", first({lookup(bus_reverse_, get(kv, "busway")),
+      lookup(bus_reverse_, get(kv, "busway:left")), lookup(bus_reverse_, get(kv, "busway:right")),
+      lookup(psv_, get(kv, "lanes:psv:backward")), &kFalse}));
+  }
+  const std::string* oneway_bus = nullptr;
+  if (is(kv, "bus_backward", "true")) {
+    oneway_bus = lookup(oneway_, get(kv, "oneway:bus"));
+    if (is(oneway_bus, "false") && is(kv, "bus:backward", "yes")) {
+      oneway_bus = &kTrue;
+    }
+  }
+
+  bool oneway_reverse = is(kv, "oneway", "-1");
+  const std::string* oneway_norm = lookup(oneway_, get(kv, "oneway"));
+  if (is(kv, "junction", "roundabout")) {
+    oneway_norm = &kTrue;
+    kv["roundabout"] = kTrue;
+  } else {
+    kv["roundabout"] = kFalse;
+  }
+  set(kv, "oneway", oneway_norm);
+  if (is(oneway_norm, "true")) {
+    kv["auto_backward"] = kFalse;
+    kv["truck_backward"] = kFalse;
+    kv["emergency_backward"] = kFalse;
+
+    if (is(kv, "bike_backward", "true")) {
+      if (is(oneway_bike, "true")) {         // Bike only in reverse on a bike path.
+        kv["bike_forward"] = kFalse;
+      } else if (is(oneway_bike, "false")) { // Bike in both directions on a bike path.
+        kv["bike_forward"] = kTrue;
+      }
+    }
+    if (is(kv, "bus_backward", "true")) {
+      if (is(oneway_bus, "true")) {          // Bus only in reverse on a bus path.
+        kv["bus_forward"] = kFalse;
+      } else if (is(oneway_bus, "false")) {  // Bus in both directions on a bus path.
+        kv["bus_forward"] = kTrue;
+      }
+    }
+  } else if (!oneway_norm || is(oneway_norm, "false")) {
+    set(kv, "auto_backward", get(kv, "auto_forward"));
+    set(kv, "truck_backward", get(kv, "truck_forward"));
+    set(kv, "emergency_backward", get(kv, "emergency_forward"));
+
+    // The script also compares oneway[oneway:bicycle] with false, which
+    // never holds since the table has strings
+    if (is(kv, "bike_backward", "false") && !get(kv, "oneway:bicycle")) {
+      set(kv, "bike_backward", get(kv, "bike_forward"));
+    }
+    if (is(kv, "bus_backward", "false") && !get(kv, "oneway:bus")) {
+      set(kv, "bus_backward", get(kv, "bus_forward"));
+    }
+  }
+
+  // Bike forward / backward overrides.
+  auto cycle_lane = [&](const std::string& key) {
+    const std::string* value = get(kv, key);
+    const double* lane = lookup(shared_, value);
+    lane = lane ? lane : lookup(separated_, value);
+    return lane ? lane : lookup(dedicated_, value);
+  };
+  if (cycle_lane("cycleway:both") || (cycle_lane("cycleway:right") && cycle_lane("cycleway:left"))) {
+    kv["bike_forward"] = kTrue;
+    kv["bike_backward"] = kTrue;
+  }
+
+  if (is(kv, "busway", "lane") || (is(kv, "busway:left", "lane") && is(kv, "busway:right", "lane"))) {
+    kv["bus_forward"] = kTrue;
+    kv["bus_backward"] = kTrue;
+  }
+
+  // Flip the onewayness
+  if (oneway_reverse) {
+    swap(kv, "auto_forward", "auto_backward");
+    swap(kv, "truck_forward", "truck_backward");
+    swap(kv, "emergency_forward", "emergency_backward");
+    swap(kv, "bus_forward", "bus_backward");
+    swap(kv, "bike_forward", "bike_backward");
+  }
+  if (is(kv, "oneway:bicycle", "-1")) {
+    swap(kv, "bike_forward", "bike_backward");
+  }
+  if (is(kv, "oneway:bus", "-1")) {
+    swap(kv, "bus_forward", "bus_backward");
+  }
+
+  // Bus only logic
+  if (is(kv, "lanes:bus", "1")) {
+    kv["bus_forward"] = kTrue;
+    kv["bus_backward"] = kFalse;
+  } else if (is(kv, "lanes:bus", "2")) {
+    kv["bus_forward"] = kTrue;
+    kv["bus_backward"] = kTrue;
+  }
+
+  // If none of the modes were set we are done looking at this
+  bool no_modes = true;
+  for (const auto* key : { "auto_forward", "truck_forward", "bus_forward", "bike_forward", "emergency_forward",
+                           "auto_backward", "truck_backward", "bus_backward", "bike_backward",
+                           "emergency_backward", "pedestrian" }) {
+    no_modes = no_modes && is(kv, key, "false");
+  }
+  // Save bridleways for country access logic.
+  if (no_modes && !is(kv, "highway", "bridleway")) {
+    return true;
+  }
+
+  // Toss actual areas
+  if (is(kv, "area", "yes")) {
+    return true;
+  }
+
+  for (const auto* key : { "FIXME", "note", "source" }) {
+    kv.erase(key);
+  }
+
+  // Set a few flags
+  const std::string* highway = get(kv, "highway");
+  const double* road_class_value = lookup(road_class_, highway);
+  double road_class;
+  if (!highway && ferry) {
+    road_class = 2; // TODO:  can we weight based on ferry types?
+  } else if (!highway && (get(kv, "railway") || is(kv, "route", "shuttle_train"))) {
+    road_class = 2; // TODO:  can we weight based on rail types?
+  } else if (!road_class_value) { // Service and other = 7
+    road_class = 7;
+  } else {
+    road_class = *road_class_value;
+  }
+  kv["road_class"] = to_string(road_class);
+
+  double default_speed;
+  const double* speed = lookup(default_speed_, &kv["road_class"]);
+  // Lower the default speed for driveways
+  if (is(kv, "service", "driveway")) {
+    if (!speed) {
+      throw std::runtime_error("No default speed for road class " + kv["road_class"]);
+    }
+    default_speed = std::floor(*speed * 0.5);
+    speed = &default_speed;
+  }
+
+  const double* use_value = lookup(use_, get(kv, "service"));
+  double use = use_value ? *use_value : -1;
+  if (highway) {
+    if (*highway == "track") {
+      use = 3;
+    } else if (*highway == "cycleway") {
+      use = 20;
+    } else if (is(kv, "pedestrian", "false") && is(kv, "auto_forward", "false") && is(kv, "auto_backward", "false") &&
+               (is(kv, "bike_forward", "true") || is(kv, "bike_backward", "true"))) {
+      use = 20;
+    } else if (*highway == "footway" && is(kv, "footway", "sidewalk")) {
+      use = 24;
+    } else if (*highway == "footway") {
+      use = 25;
+    } else if (*highway == "steps") {
+      use = 26; // Steps/stairs
+    } else if (*highway == "path") {
+      use = 27;
+    } else if (*highway == "pedestrian") {
+      use = 28;
+    } else if (is(kv, "pedestrian", "true") &&
+               is(kv, "auto_forward", "false") && is(kv, "auto_backward", "false") &&
+               is(kv, "truck_forward", "false") && is(kv, "truck_backward", "false") &&
+               is(kv, "bus_forward", "false") && is(kv, "bus_backward", "false") &&
+               is(kv, "bike_forward", "false") && is(kv, "bike_backward", "false")) {
+      use = 28;
+    } else if (*highway == "bridleway") {
+      use = 29;
+    }
+  }
+  if (use == -1 && get(kv, "service")) {
+    use = 40; // Other
+  } else if (use == -1) {
+    use = 0;  // General road, no special use
+  }
+  if (is(kv, "access", "emergency") || is(kv, "emergency", "yes")) {
+    use = 7;
+  }
+  kv["use"] = to_string(use);
+
+  const double* lane = cycle_lane("cycleway");
+  lane = lane ? lane : cycle_lane("cycleway:right");
+  lane = lane ? lane : cycle_lane("cycleway:left");
+  kv["cycle_lane"] = to_string(lane ? *lane : 0);
+
+  if (highway && highway->find("_link") != std::string::npos) {
+    kv["link"] = kTrue;  // Do we need to add more?  turnlane?
+  }
+
+  set(kv, "private", first({lookup(private_, get(kv, "access")), lookup(private_, get(kv, "motor_vehicle")), &kFalse}));
+  set(kv, "no_thru_traffic", first({lookup(no_thru_traffic_, get(kv, "access")), &kFalse}));
+  kv["ferry"] = ferry ? kTrue : kFalse;
+  kv["rail"] = (is(kv, "auto_forward", "true") && (is(kv, "railway", "rail") ||
+                is(kv, "route", "shuttle_train"))) ? kTrue : kFalse;
+  double number;
+  set(kv, "max_speed", normalize_speed(get(kv, "maxspeed"), number));
+  set(kv, "advisory_speed", normalize_speed(get(kv, "maxspeed:advisory"), number));
+  set(kv, "average_speed", normalize_speed(get(kv, "maxspeed:practical"), number));
+  set(kv, "backward_speed", normalize_speed(get(kv, "maxspeed:backward"), number));
+  set(kv, "forward_speed", normalize_speed(get(kv, "maxspeed:forward"), number));
+  set(kv, "wheelchair", lookup(wheelchair_, get(kv, "wheelchair")));
+
+  // Lower the default speed for tracks
+  if (is(highway, "track")) {
+    default_speed = 5;
+    if (is(kv, "tracktype", "grade1")) {
+      default_speed = 20;
+    } else if (is(kv, "tracktype", "grade2")) {
+      default_speed = 15;
+    } else if (is(kv, "tracktype", "grade3")) {
+      default_speed = 12;
+    } else if (is(kv, "tracktype", "grade4")) {
+      default_speed = 10;
+    }
+    speed = &default_speed;
+  }
+  set(kv, "default_speed", speed);
+
+  // Use unsigned_ref if all the conditions are met.
+  if (!get(kv, "name") && !get(kv, "name:en") && !get(kv, "alt_name") && !get(kv, "official_name") &&
+      !get(kv, "ref") && !get(kv, "int_ref") &&
+      (is(highway, "motorway") || is(highway, "trunk") || is(highway, "primary")) && get(kv, "unsigned_ref")) {
+    kv["ref"] = kv["unsigned_ref"];
+  }
+
+  set(kv, "lanes", lane_count(get(kv, "lanes"), number));
+  set(kv, "forward_lanes", lane_count(get(kv, "lanes:forward"), number));
+  set(kv, "backward_lanes", lane_count(get(kv, "lanes:backward"), number));
+
+  set(kv, "bridge", first({lookup(bridge_, get(kv, "bridge")), &kFalse}));
+
+  // TODO access:conditional
+  if (get(kv, "seasonal") && !is(kv, "seasonal", "no")) {
+    kv["seasonal"] = kTrue;
+  }
+
+  if (is(kv, "hov", "no")) {
+    kv["hov_tag"] = kFalse;
+    kv["hov_forward"] = kFalse;
+    kv["hov_backward"] = kFalse;
+  } else {
+    set(kv, "hov_forward", get(kv, "auto_forward"));
+    set(kv, "hov_backward", get(kv, "auto_backward"));
+  }
+
+  if ((get(kv, "hov") && !is(kv, "hov", "no")) || get(kv, "hov:lanes") || get(kv, "hov:minimum")) {
+    kv["hov_tag"] = kTrue;
+    if (is(kv, "hov", "designated")) {
+      if (!get(kv, "auto_tag")) {
+        kv["auto_forward"] = kFalse;
+        kv["auto_backward"] = kFalse;
+      }
+      if (!get(kv, "truck_tag")) {
+        kv["truck_forward"] = kFalse;
+        kv["truck_backward"] = kFalse;
+      }
+      if (!get(kv, "bus_tag")) {
+        kv["bus_forward"] = kFalse;
+        kv["bus_backward"] = kFalse;
+      }
+      if (!get(kv, "foot_tag")) {
+        kv["pedestrian"] = kFalse;
+      }
+      if (!get(kv, "bike_tag")) {
+        kv["bike_forward"] = kFalse;
+        kv["bike_backward"] = kFalse;
+      }
+    }
+  }
+
+  set(kv, "tunnel", first({lookup(tunnel_, get(kv, "tunnel")), &kFalse}));
+  set(kv, "toll", first({lookup(toll_, get(kv, "toll")), &kFalse}));
+
+  // Truck goodies
+  double physical;
+  const double* maxheight = normalize_measurement(get(kv, "maxheight"), number);
+  set(kv, "maxheight", maxheight ? maxheight : normalize_measurement(get(kv, "maxheight:physical"), physical));
+  const double* maxwidth = normalize_measurement(get(kv, "maxwidth"), number);
+  set(kv, "maxwidth", maxwidth ? maxwidth : normalize_measurement(get(kv, "maxwidth:physical"), physical));
+  set(kv, "maxlength", normalize_measurement(get(kv, "maxlength"), number));
+
+  set(kv, "maxweight", normalize_weight(get(kv, "maxweight"), number));
+  set(kv, "maxaxleload", normalize_weight(get(kv, "maxaxleload"), number));
+
+  // TODO: hazmat really should have subcategories
+  set(kv, "hazmat", first({lookup(hazmat_, get(kv, "hazmat")), lookup(hazmat_, get(kv, "hazmat:water")),
+    lookup(hazmat_, get(kv, "hazmat:A")), lookup(hazmat_, get(kv, "hazmat:B")), lookup(hazmat_, get(kv, "hazmat:C")),
+    lookup(hazmat_, get(kv, "hazmat:D")), lookup(hazmat_, get(kv, "hazmat:E"))}));
+  set(kv, "maxspeed:hgv", normalize_speed(get(kv, "maxspeed:hgv"), number));
+
+  if (get(kv, "hgv:national_network") || get(kv, "hgv:state_network") ||
+      is(kv, "hgv", "local") || is(kv, "hgv", "designated")) {
+    kv["truck_route"] = kTrue;
+  }
+
+  const std::string* nref = get(kv, "ncn_ref");
+  const std::string* rref = get(kv, "rcn_ref");
+  const std::string* lref = get(kv, "lcn_ref");
+  uint32_t bike_mask = 0;
+  if (nref || is(kv, "ncn", "yes")) {
+    bike_mask = 1;
+  }
+  if (rref || is(kv, "rcn", "yes")) {
+    bike_mask |= 2;
+  }
+  if (lref || is(kv, "lcn", "yes")) {
+    bike_mask |= 4;
+  }
+  if (is(kv, "mtb", "yes")) {
+    bike_mask |= 8;
+  }
+  set(kv, "bike_national_ref", nref);
+  set(kv, "bike_regional_ref", rref);
+  set(kv, "bike_local_ref", lref);
+  kv["bike_network_mask"] = std::to_string(bike_mask);
+  return false;
+}
+
+bool NativeTagTransform::FilterRelation(Tags& kv) const {
+  if (is(kv, "type", "connectivity")) {
+    return false;
+  }
+  if (!is(kv, "type", "route") && !is(kv, "type", "restriction")) {
+    return true;
+  }
+
+  const double* restrict = lookup(restriction_, get(kv, "restriction"));
+  if (is(kv, "type", "restriction")) {
+    if (!restrict) {
+      return true;
+    }
+    kv["restriction"] = to_string(*restrict);
+    if (get(kv, "day_on") || get(kv, "day_off")) {
+      const double* day_on = lookup(dow_, get(kv, "day_on"));
+      kv["day_on"] = to_string(day_on ? *day_on : 0);
+      const double* day_off = lookup(dow_, get(kv, "day_off"));
+      kv["day_off"] = to_string(day_off ? *day_off : 0);
+    }
+    return false;
+  } else if (is(kv, "route", "bicycle") || is(kv, "route", "mtb")) {
+    uint32_t bike_mask = 0;
+    if (is(kv, "network", "mtb") || is(kv, "route", "mtb")) {
+      bike_mask = 8;
+    }
+    if (is(kv, "network", "ncn")) {
+      bike_mask |= 1;
+    } else if (is(kv, "network", "rcn")) {
+      bike_mask |= 2;
+    } else if (is(kv, "network", "lcn")) {
+      bike_mask |= 4;
+    }
+    kv["bike_network_mask"] = std::to_string(bike_mask);
+  } else if (restrict) {
+    // Has a restiction but type is not restriction...ignore
+    return true;
+  }
+  kv.erase("day_on");
+  kv.erase("day_off");
+  kv.erase("restriction");
+  return false;
+}
+
+}
+}
@@ -32,6 +32,13 @@
 #include <zlib.h>
 #include <vector>
 #include <unordered_map>
+#include <deque>
+#include <list>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
 
 #include "mjolnir/osmpbfparser.h"
 #include "midgard/logging.h"
@@ -73,37 +80,44 @@ BlobHeader read_header(char* buffer, std::ifstream& file, bool& finished) {
   return result;
 }
 
-int32_t read_blob(char* buffer, char* unpack_buffer, std::ifstream& file, const BlobHeader & header) {
-  Blob blob;
-
+//the raw bytes of a blob read from the file
+std::string read_blob_bytes(std::ifstream& file, const BlobHeader & header) {
   //is the size of the following blob sane
   int32_t sz = header.datasize();
   if (sz > MAX_UNCOMPRESSED_BLOB_SIZE)
     throw std::runtime_error("blob-size is bigger than allowed");
 
   //pull out the bytes
-  if (!file.read(buffer, sz))
+  std::string bytes(sz, '\0');
+  if (!file.read(&bytes[0], sz))
     throw std::runtime_error("unable to read blob from file");
+  return bytes;
+}
 
+//turn the raw bytes of a blob into its uncompressed contents
+int32_t unpack_blob(const std::string& bytes, std::vector<char>& unpack_buffer) {
   //turn it into a protobuf object
-  if (!blob.ParseFromArray(buffer, sz))
+  Blob blob;
+  if (!blob.ParseFromString(bytes))
     throw std::runtime_error("unable to parse blob");
 
   //if the blob was uncompressed
   if (blob.has_raw()) {
     //check that raw_size is set correctly and move it to the final buffer
-    sz = blob.raw().size();
+    int32_t sz = blob.raw().size();
     if (sz != blob.raw_size())
       LOG_WARN("blob reports wrong raw_size: " + std::to_string(blob.raw_size()) + " bytes");
-    memcpy(unpack_buffer, buffer, sz);
+    unpack_buffer.assign(blob.raw().begin(), blob.raw().end());
     return sz;
   }//if the blob was zlib compressed
   else if (blob.has_zlib_data()) {
-    sz = blob.zlib_data().size();
+    if (blob.raw_size() > MAX_UNCOMPRESSED_BLOB_SIZE)
+      throw std::runtime_error("blob-size is bigger than allowed");
+    unpack_buffer.resize(blob.raw_size());
     z_stream z;
     z.next_in = (unsigned char*) blob.zlib_data().c_str();
-    z.avail_in = sz;
-    z.next_out = (unsigned char*) unpack_buffer;
+    z.avail_in = blob.zlib_data().size();
+    z.next_out = (unsigned char*) unpack_buffer.data();
     z.avail_out = blob.raw_size();
     z.zalloc = Z_NULL;
     z.zfree = Z_NULL;
@@ -137,12 +151,7 @@ OSMPBF::Tags get_tags(const T& object, const OSMPBF::PrimitiveBlock &primblock)
   return result;
 }
 
-void parse_primitive_block(char* unpack_buffer, int32_t sz, const Interest interest, Callback& callback) {
-  //turn the blob bytes into a protobuf object
-  PrimitiveBlock primblock;
-  if (!primblock.ParseFromArray(unpack_buffer, sz))
-    throw std::runtime_error("unable to parse primitive block");
-
+void parse_primitive_block(const PrimitiveBlock& primblock, const Interest interest, Callback& callback) {
   //for each primitive group
   for (const auto& primitive_group : primblock.primitivegroup()) {
 
@@ -232,15 +241,153 @@ void parse_primitive_block(char* unpack_buffer, int32_t sz, const Interest inter
   }
 }
 
-void parse_header_block(char* unpack_buffer, int32_t sz) {
+void parse_header_block(const std::vector<char>& unpack_buffer, int32_t sz) {
   //turn the blob bytes into a protobuf object
   HeaderBlock header_block;
-  if (!header_block.ParseFromArray(unpack_buffer, sz))
+  if (!header_block.ParseFromArray(unpack_buffer.data(), sz))
     throw std::runtime_error("unable to parse header block");
 
   //TODO: do something with replication information?
 }
 
+//a blob on its way from the file to the callbacks
+struct block_t {
+  BlobHeader header;
+  std::string bytes;
+  PrimitiveBlock primblock;
+};
+
+//inflate and decode the blob into a primitive block, headers are checked here too
+void decode_block(block_t& block) {
+  std::vector<char> unpack_buffer;
+  int32_t sz = unpack_blob(block.bytes, unpack_buffer);
+  std::string().swap(block.bytes);
+  //if its data decode it
+  if (block.header.type() == "OSMData") {
+    if (!block.primblock.ParseFromArray(unpack_buffer.data(), sz))
+      throw std::runtime_error("unable to parse primitive block");
+  }//if its something other than a header
+  else if (block.header.type() == "OSMHeader")
+    parse_header_block(unpack_buffer, sz);
+  else
+    LOG_WARN("Unknown blob type: " + block.header.type());
+}
+
+//reads blobs on one thread, decodes them on many and hands them back in file order
+class block_pipeline {
+ public:
+  block_pipeline(std::ifstream& file, const unsigned int decoders)
+    : file(file), read_count(0), delivered(0), reading(true),
+      window(decoders * 4) {
+    threads.emplace_back(&block_pipeline::read, this);
+    for (unsigned int i = 0; i < decoders; ++i)
+      threads.emplace_back(&block_pipeline::decode, this);
+  }
+
+  ~block_pipeline() {
+    stop(nullptr);
+    for (auto& thread : threads)
+      thread.join();
+  }
+
+  //the next block in file order, nullptr when the file is done
+  std::unique_ptr<block_t> next() {
+    std::unique_lock<std::mutex> lock(mutex);
+    changed.wait(lock, [this]() {
+      return error || decoded.find(delivered) != decoded.cend() ||
+             (!reading && delivered == read_count);
+    });
+    if (error)
+      std::rethrow_exception(error);
+    auto found = decoded.find(delivered);
+    if (found == decoded.cend())
+      return nullptr;
+    auto block = std::move(found->second);
+    decoded.erase(found);
+    ++delivered;
+    changed.notify_all();
+    return block;
+  }
+
+  //stop all the threads, passing on the error if there was one
+  void stop(const std::exception_ptr& e) {
+    std::unique_lock<std::mutex> lock(mutex);
+    if (!error)
+      error = e ? e : std::make_exception_ptr(std::runtime_error("pbf parsing stopped"));
+    changed.notify_all();
+  }
+
+ protected:
+  void read() {
+    try {
+      std::vector<char> buffer(MAX_BLOB_HEADER_SIZE);
+      while (!file.eof()) {
+        //grab the blob header and the blob that goes with it
+        bool finished = false;
+        std::unique_ptr<block_t> block(new block_t);
+        block->header = read_header(buffer.data(), file, finished);
+        if (finished)
+          break;
+        block->bytes = read_blob_bytes(file, block->header);
+
+        //dont get too far ahead of the callbacks
+        std::unique_lock<std::mutex> lock(mutex);
+        changed.wait(lock, [this]() { return error || read_count - delivered < window; });
+        if (error)
+          return;
+        undecoded.emplace_back(read_count++, std::move(block));
+        changed.notify_all();
+      }
+    }
+    catch (...) {
+      stop(std::current_exception());
+      return;
+    }
+    std::unique_lock<std::mutex> lock(mutex);
+    reading = false;
+    changed.notify_all();
+  }
+
+  void decode() {
+    try {
+      while (true) {
+        //take the next blob that needs decoding
+        std::pair<size_t, std::unique_ptr<block_t> > block;
+        {
+          std::unique_lock<std::mutex> lock(mutex);
+          changed.wait(lock, [this]() { return error || !undecoded.empty() || !reading; });
+          if (error || undecoded.empty())
+            return;
+          block = std::move(undecoded.front());
+          undecoded.pop_front();
+        }
+
+        //do the expensive part without the lock
+        decode_block(*block.second);
+
+        std::unique_lock<std::mutex> lock(mutex);
+        decoded.emplace(block.first, std::move(block.second));
+        changed.notify_all();
+      }
+    }
+    catch (...) {
+      stop(std::current_exception());
+    }
+  }
+
+  std::ifstream& file;
+  std::mutex mutex;
+  std::condition_variable changed;
+  std::deque<std::pair<size_t, std::unique_ptr<block_t> > > undecoded;
+  std::unordered_map<size_t, std::unique_ptr<block_t> > decoded;
+  size_t read_count;
+  size_t delivered;
+  bool reading;
+  size_t window;
+  std::exception_ptr error;
+  std::list<std::thread> threads;
+};
+
 }
 
 // extend the protobuf osmpbf namespace
@@ -252,37 +399,45 @@ Member::Member(const Relation::MemberType type, const uint64_t id, const std::st
 Member::Member(Member&& other): member_type(other.member_type), member_id(other.member_id), role(std::move(other.role)) {
 }
 
-void Parser::parse(std::ifstream& file, const Interest interest, Callback& callback) {
-  char* buffer = new char[MAX_UNCOMPRESSED_BLOB_SIZE];
-  char* unpack_buffer = new char[MAX_UNCOMPRESSED_BLOB_SIZE];
-
+void Parser::parse(std::ifstream& file, const Interest interest, Callback& callback,
+                   const unsigned int threads) {
   //start from the top
   file.clear();
   file.seekg(0, std::ios::beg);
 
-  //while there is more to read
-  while (!file.eof()) {
-    //grab the blob header
-    bool finished = false;
-    BlobHeader header = read_header(buffer, file, finished);
-    //if we didnt hit the end
-    if (!finished) {
-      //grab the blob that goes with the blob header
-      int32_t sz = read_blob(buffer, unpack_buffer, file, header);
-      //if its data parse it
-      if (header.type() == "OSMData")
-        parse_primitive_block(unpack_buffer, sz, interest, callback);
-      //if its something other than a header
-      else if (header.type() == "OSMHeader")
-        parse_header_block(unpack_buffer, sz);
-      else
-        LOG_WARN("Unknown blob type: " + header.type());
+  //do it all on this thread
+  if (threads < 2) {
+    std::vector<char> buffer(MAX_BLOB_HEADER_SIZE);
+    //while there is more to read
+    while (!file.eof()) {
+      //grab the blob header
+      bool finished = false;
+      block_t block;
+      block.header = read_header(buffer.data(), file, finished);
+      //if we didnt hit the end
+      if (!finished) {
+        //grab the blob that goes with the blob header and decode it
+        block.bytes = read_blob_bytes(file, block.header);
+        decode_block(block);
+        if (block.header.type() == "OSMData")
+          parse_primitive_block(block.primblock, interest, callback);
+      }
     }
+    return;
   }
 
-  //done with protobuf and buffers
-  delete [] buffer;
-  delete [] unpack_buffer;
+  //one thread reads, the rest decode and this one calls back in file order
+  block_pipeline pipeline(file, threads - 1);
+  try {
+    while (auto block = pipeline.next()) {
+      if (block->header.type() == "OSMData")
+        parse_primitive_block(block->primblock, interest, callback);
+    }
+  }
+  catch (...) {
+    pipeline.stop(std::current_exception());
+    throw;
+  }
 }
 
 void Parser::free() {
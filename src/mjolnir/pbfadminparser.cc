@@ -21,8 +21,9 @@ using namespace valhalla::baldr;
 using namespace valhalla::mjolnir;
 
 namespace {
-// Will throw an error if this is exceeded. Then we can increase.
-constexpr uint64_t kMaxOSMNodeId = 5000000000;
+// Will throw an error if this is exceeded. Then we can increase, the id
+// tables only take memory for the ids that are set
+constexpr uint64_t kMaxOSMNodeId = 20000000000;
 
 // Node equality
 const auto WayNodeEquals = [](const OSMWayNode& a, const OSMWayNode& b) {
@@ -135,6 +136,7 @@ OSMData PBFAdminParser::Parse(const boost::property_tree::ptree& pt, const std::
   // methods can use it.
   OSMData osmdata{};
   admin_callback callback(pt, osmdata);
+  unsigned int threads = std::max(static_cast<unsigned int>(1), pt.get<unsigned int>("concurrency", std::thread::hardware_concurrency()));
 
   LOG_INFO("Parsing files: " + boost::algorithm::join(input_files, ", "));
 
@@ -150,20 +152,20 @@ OSMData PBFAdminParser::Parse(const boost::property_tree::ptree& pt, const std::
   // Parse each input file for relations
   LOG_INFO("Parsing relations...")
   for (auto& file_handle : file_handles)
-    OSMPBF::Parser::parse(file_handle, static_cast<OSMPBF::Interest>(OSMPBF::Interest::RELATIONS | OSMPBF::Interest::CHANGESETS), callback);
+    OSMPBF::Parser::parse(file_handle, static_cast<OSMPBF::Interest>(OSMPBF::Interest::RELATIONS | OSMPBF::Interest::CHANGESETS), callback, threads);
   LOG_INFO("Finished with " + std::to_string(osmdata.admins_.size()) + " admin polygons comprised of " + std::to_string(osmdata.osm_way_count) + " ways");
 
   // Parse the ways.
   LOG_INFO("Parsing ways...");
   for (auto& file_handle : file_handles)
-    OSMPBF::Parser::parse(file_handle, static_cast<OSMPBF::Interest>(OSMPBF::Interest::WAYS | OSMPBF::Interest::CHANGESETS), callback);
+    OSMPBF::Parser::parse(file_handle, static_cast<OSMPBF::Interest>(OSMPBF::Interest::WAYS | OSMPBF::Interest::CHANGESETS), callback, threads);
   LOG_INFO("Finished with " + std::to_string(osmdata.way_map.size()) + " ways comprised of " + std::to_string(osmdata.node_count) + " nodes");
 
   // Parse node in all the input files. Skip any that are not marked from
   // being used in a way.
   LOG_INFO("Parsing nodes...");
   for (auto& file_handle : file_handles)
-    OSMPBF::Parser::parse(file_handle, static_cast<OSMPBF::Interest>(OSMPBF::Interest::NODES | OSMPBF::Interest::CHANGESETS), callback);
+    OSMPBF::Parser::parse(file_handle, static_cast<OSMPBF::Interest>(OSMPBF::Interest::NODES | OSMPBF::Interest::CHANGESETS), callback, threads);
   LOG_INFO("Finished with " + std::to_string(osmdata.osm_node_count) + " nodes");
 
   //done with pbf
@@ -4,9 +4,12 @@
 
 #include "mjolnir/osmaccess.h"
 #include "mjolnir/luatagtransform.h"
+#include "mjolnir/nativetagtransform.h"
 #include "mjolnir/idtable.h"
 #include "graph_lua_proc.h"
 
+#include <chrono>
+#include <cstdio>
 #include <future>
 #include <utility>
 #include <thread>
@@ -29,8 +32,9 @@ using namespace valhalla::mjolnir;
 
 namespace {
 
-// Will throw an error if this is exceeded. Then we can increase.
-constexpr uint64_t kMaxOSMNodeId = 5000000000;
+// Will throw an error if this is exceeded. Then we can increase, the id
+// tables only take memory for the ids that are set
+constexpr uint64_t kMaxOSMNodeId = 20000000000;
 
 // Absurd classification.
 constexpr uint32_t kAbsurdRoadClass = 777777;
@@ -44,7 +48,7 @@ struct graph_callback : public OSMPBF::Callback {
 
   graph_callback(const boost::property_tree::ptree& pt, OSMData& osmdata) :
     shape_(kMaxOSMNodeId), intersection_(kMaxOSMNodeId),
-    osmdata_(osmdata), lua_(get_lua(pt)){
+    osmdata_(osmdata), tag_transform_(get_tag_transform(pt)){
 
     current_way_node_index_ = last_node_ = last_way_ = last_relation_ = 0;
 
@@ -70,14 +74,32 @@ struct graph_callback : public OSMPBF::Callback {
     return std::string(lua_graph_lua, lua_graph_lua + lua_graph_lua_len);
   }
 
+  // The native transform reads its tables from the lua, a custom script may
+  // change more than its tables so it is run through lua unless told otherwise
+  static TagTransform* get_tag_transform(const boost::property_tree::ptree& pt) {
+    if (pt.get<bool>("native_tag_transform", !pt.get_optional<std::string>("graph_lua_name"))) {
+      LOG_INFO("Using native tag transform");
+      return new NativeTagTransform(get_lua(pt));
+    }
+    return new LuaTagTransform(get_lua(pt));
+  }
+
   virtual void node_callback(uint64_t osmid, double lng, double lat, const OSMPBF::Tags &tags) override {
-    // Check if it is in the list of nodes used by ways
-    if (!shape_.IsUsed(osmid)) {
+    // Check if it is in the list of nodes used by ways. In a single pass the
+    // ways come after the nodes so we dont know yet and keep all of them
+    if (!single_pass_ && !shape_.IsUsed(osmid)) {
       return;
     }
 
-    // Get tags
-    Tags results = lua_.Transform(OSMType::kNode, tags);
+    //unsorted extracts are just plain nasty, so they can bugger off!
+    if (single_pass_ && (last_way_ || last_relation_))
+      throw std::runtime_error("Detected unsorted input data");
+
+    // Get tags. Most nodes have none so that transform is only done once
+    if (tags.empty() && !untagged_node_results_) {
+      untagged_node_results_.reset(new Tags(tag_transform_->Transform(OSMType::kNode, tags)));
+    }
+    Tags results = tags.empty() ? *untagged_node_results_ : tag_transform_->Transform(OSMType::kNode, tags);
     if (results.size() == 0)
       return;
 
@@ -127,37 +149,21 @@ struct graph_callback : public OSMPBF::Callback {
       }
       else if (tag.first == "gate") {
         if (tag.second == "true") {
-          if (!intersection_.IsUsed(osmid)) {
-            intersection_.set(osmid);
-            ++osmdata_.edge_count;
-          }
           n.set_type(NodeType::kGate);
         }
       }
       else if (tag.first == "bollard") {
         if (tag.second == "true") {
-          if (!intersection_.IsUsed(osmid)) {
-            intersection_.set(osmid);
-            ++osmdata_.edge_count;
-          }
           n.set_type(NodeType::kBollard);
         }
       }
       else if (tag.first == "toll_booth") {
         if (tag.second == "true") {
-          if (!intersection_.IsUsed(osmid)) {
-            intersection_.set(osmid);
-            ++osmdata_.edge_count;
-          }
           n.set_type(NodeType::kTollBooth);
         }
       }
       else if (tag.first == "border_control") {
         if (tag.second == "true") {
-          if (!intersection_.IsUsed(osmid)) {
-            intersection_.set(osmid);
-            ++osmdata_.edge_count;
-          }
           n.set_type(NodeType::kBorderControl);
         }
       }
@@ -170,6 +176,28 @@ struct graph_callback : public OSMPBF::Callback {
       */
     }
 
+    // In a single pass the node is kept until the ways have been seen
+    if (single_pass_) {
+      nodes_->push_back(n);
+      return;
+    }
+    add_node(n);
+  }
+
+  // Update the way nodes that use this node
+  void add_node(OSMNode& n) {
+    const uint64_t osmid = n.osmid;
+
+    // Gates, bollards, toll booths and border controls split the edges
+    // they are on
+    if (n.type() == NodeType::kGate || n.type() == NodeType::kBollard ||
+        n.type() == NodeType::kTollBooth || n.type() == NodeType::kBorderControl) {
+      if (!intersection_.IsUsed(osmid)) {
+        intersection_.set(osmid);
+        ++osmdata_.edge_count;
+      }
+    }
+
     // Set the intersection flag (relies on ways being processed first to set
     // the intersection Id markers).
     if (intersection_.IsUsed(osmid)) {
@@ -202,6 +230,9 @@ struct graph_callback : public OSMPBF::Callback {
   }
 
   virtual void way_callback(uint64_t osmid, const OSMPBF::Tags &tags, const std::vector<uint64_t> &nodes) override {
+    //unsorted extracts are just plain nasty, so they can bugger off!
+    if (single_pass_ && last_relation_)
+      throw std::runtime_error("Detected unsorted input data");
 
     // Do not add ways with < 2 nodes. Log error or add to a problem list
     // TODO - find out if we do need these, why they exist...
@@ -211,7 +242,7 @@ struct graph_callback : public OSMPBF::Callback {
 
     // Transform tags. If no results that means the way does not have tags
     // suitable for use in routing.
-    Tags results = lua_.Transform(OSMType::kWay, tags);
+    Tags results = tag_transform_->Transform(OSMType::kWay, tags);
     if (results.size() == 0) {
       return;
     }
@@ -820,7 +851,7 @@ struct graph_callback : public OSMPBF::Callback {
 
   virtual void relation_callback(const uint64_t osmid, const OSMPBF::Tags &tags, const std::vector<OSMPBF::Member> &members) override {
     // Get tags
-    Tags results = lua_.Transform(OSMType::kRelation, tags);
+    Tags results = tag_transform_->Transform(OSMType::kRelation, tags);
     if (results.size() == 0)
       return;
 
@@ -1097,12 +1128,39 @@ struct graph_callback : public OSMPBF::Callback {
 
   //lets the sequences be set and reset
   void reset(sequence<OSMWay>* ways, sequence<OSMWayNode>* way_nodes,
-             sequence<OSMAccess>* access, sequence<OSMRestriction>* complex_restrictions){
+             sequence<OSMAccess>* access, sequence<OSMRestriction>* complex_restrictions,
+             sequence<OSMNode>* nodes = nullptr){
     //reset the pointers (either null them out or set them to something valid)
     ways_.reset(ways);
     way_nodes_.reset(way_nodes);
     access_.reset(access);
     complex_restrictions_.reset(complex_restrictions);
+    nodes_.reset(nodes);
+    single_pass_ = nodes != nullptr;
+  }
+
+  // Update the way nodes with the nodes kept during a single pass. The
+  // nodes must be sorted by id
+  void add_nodes(sequence<OSMNode>& nodes) {
+    current_way_node_index_ = last_node_ = 0;
+    nodes.enumerate([this](const OSMNode& node) {
+      // Skip the nodes no way uses and those repeated in more than one file
+      if (!shape_.IsUsed(node.osmid) || node.osmid == last_node_)
+        return;
+      last_node_ = node.osmid;
+      OSMNode n = node;
+      add_node(n);
+    });
+
+    // Drop the junction names of nodes that are not on ways
+    for (auto* names : {&osmdata_.node_exit_to, &osmdata_.node_ref, &osmdata_.node_name}) {
+      for (auto name = names->begin(); name != names->end(); ) {
+        if (shape_.IsUsed(name->first))
+          ++name;
+        else
+          name = names->erase(name);
+      }
+    }
   }
 
   // Output list of wayids that have loops
@@ -1120,8 +1178,8 @@ struct graph_callback : public OSMPBF::Callback {
   //Road class assignment needs to be set to the highway cutoff for ferries and auto trains.
   RoadClass highway_cutoff_rc_;
 
-  // Lua Tag Transformation class
-  LuaTagTransform lua_;
+  // Tag Transformation class, native or lua
+  std::unique_ptr<TagTransform> tag_transform_;
 
   // Pointer to all the OSM data (for use by callbacks)
   OSMData& osmdata_;
@@ -1148,6 +1206,13 @@ struct graph_callback : public OSMPBF::Callback {
   // complex restrictions
   std::unique_ptr<sequence<OSMRestriction> > complex_restrictions_;
 
+  // nodes kept until the ways are known when parsing in a single pass
+  std::unique_ptr<sequence<OSMNode> > nodes_;
+  bool single_pass_ = false;
+
+  // transform of a node without tags
+  std::unique_ptr<Tags> untagged_node_results_;
+
 };
 
 }
@@ -1162,6 +1227,22 @@ OSMData PBFGraphParser::Parse(const boost::property_tree::ptree& pt, const std::
   //option 2: synchronize around adding things to a single osmdata. will have to test to see
   //which is the least expensive (memory and speed). leaning towards option 2
   unsigned int threads = std::max(static_cast<unsigned int>(1), pt.get<unsigned int>("concurrency", std::thread::hardware_concurrency()));
+  // How much memory the external sorts of the intermediate files may use
+  size_t sort_buffer_size = pt.get<size_t>("sort_buffer_size", 1024 * 1024 * 512);
+
+  // In a single pass the nodes, ways and relations are read in one go relying on
+  // the pbf being sorted by type. The nodes are kept on disk until the ways are known
+  bool single_pass = pt.get<bool>("single_pass", false);
+  std::string nodes_file = way_nodes_file + ".nodes";
+
+  // Time each phase of the parsing
+  auto phase_start = std::chrono::high_resolution_clock::now();
+  auto log_phase = [&phase_start](const std::string& phase) {
+    auto now = std::chrono::high_resolution_clock::now();
+    uint32_t secs = std::chrono::duration_cast<std::chrono::seconds>(now - phase_start).count();
+    LOG_INFO(phase + " took " + std::to_string(secs) + " secs");
+    phase_start = now;
+  };
 
   // Create OSM data. Set the member pointer so that the parsing callback methods can use it.
   OSMData osmdata{};
@@ -1169,7 +1250,8 @@ OSMData PBFGraphParser::Parse(const boost::property_tree::ptree& pt, const std::
   callback.reset(new sequence<OSMWay>(ways_file, true),
     new sequence<OSMWayNode>(way_nodes_file, true),
     new sequence<OSMAccess>(access_file, true),
-    new sequence<OSMRestriction>(complex_restriction_file, true));
+    new sequence<OSMRestriction>(complex_restriction_file, true),
+    single_pass ? new sequence<OSMNode>(nodes_file, true) : nullptr);
   LOG_INFO("Parsing files: " + boost::algorithm::join(input_files, ", "));
 
   //hold open all the files so that if something else (like diff application)
@@ -1182,14 +1264,27 @@ OSMData PBFGraphParser::Parse(const boost::property_tree::ptree& pt, const std::
   }
 
   // Parse the ways and find all node Ids needed (those that are part of a
-  // way's node list. Iterate through each pbf input file.
-  LOG_INFO("Parsing ways...")
-  for (auto& file_handle : file_handles) {
-    callback.current_way_node_index_ = callback.last_node_ = callback.last_way_ = callback.last_relation_ = 0;
-    OSMPBF::Parser::parse(file_handle, static_cast<OSMPBF::Interest>(OSMPBF::Interest::WAYS | OSMPBF::Interest::CHANGESETS), callback);
+  // way's node list. Iterate through each pbf input file. In a single pass the
+  // nodes and relations are parsed along with them
+  if (single_pass) {
+    LOG_INFO("Parsing nodes, ways and relations...")
+    for (auto& file_handle : file_handles) {
+      callback.current_way_node_index_ = callback.last_node_ = callback.last_way_ = callback.last_relation_ = 0;
+      OSMPBF::Parser::parse(file_handle, static_cast<OSMPBF::Interest>(OSMPBF::Interest::NODES | OSMPBF::Interest::WAYS |
+        OSMPBF::Interest::RELATIONS | OSMPBF::Interest::CHANGESETS), callback, threads);
+    }
+  }
+  else {
+    LOG_INFO("Parsing ways...")
+    for (auto& file_handle : file_handles) {
+      callback.current_way_node_index_ = callback.last_node_ = callback.last_way_ = callback.last_relation_ = 0;
+      OSMPBF::Parser::parse(file_handle, static_cast<OSMPBF::Interest>(OSMPBF::Interest::WAYS | OSMPBF::Interest::CHANGESETS), callback, threads);
+    }
   }
   callback.output_loops();
   LOG_INFO("Finished with " + std::to_string(osmdata.osm_way_count) + " routable ways containing " + std::to_string(osmdata.osm_way_node_count) + " nodes");
+  LOG_INFO("Node id tables use " + std::to_string((callback.shape_.memory() + callback.intersection_.memory()) / (1024 * 1024)) + " MB");
+  log_phase(single_pass ? "Parsing nodes, ways and relations" : "Parsing ways");
 
   //we need to sort the access tags so that we can easily find them.
   LOG_INFO("Sorting osm access tags by way id...");
@@ -1198,15 +1293,19 @@ OSMData PBFGraphParser::Parse(const boost::property_tree::ptree& pt, const std::
     access.sort(
         [](const OSMAccess& a, const OSMAccess& b){
       return a.way_id() < b.way_id();
-    }
+    }, sort_buffer_size / sizeof(OSMAccess), threads
     );
   }
+  log_phase("Sorting access tags");
 
   // Parse relations.
-  LOG_INFO("Parsing relations...")
-  for (auto& file_handle : file_handles) {
-    callback.current_way_node_index_ = callback.last_node_ = callback.last_way_ = callback.last_relation_ = 0;
-    OSMPBF::Parser::parse(file_handle, static_cast<OSMPBF::Interest>(OSMPBF::Interest::RELATIONS | OSMPBF::Interest::CHANGESETS), callback);
+  if (!single_pass) {
+    LOG_INFO("Parsing relations...")
+    for (auto& file_handle : file_handles) {
+      callback.current_way_node_index_ = callback.last_node_ = callback.last_way_ = callback.last_relation_ = 0;
+      OSMPBF::Parser::parse(file_handle, static_cast<OSMPBF::Interest>(OSMPBF::Interest::RELATIONS | OSMPBF::Interest::CHANGESETS), callback, threads);
+    }
+    log_phase("Parsing relations");
   }
   LOG_INFO("Finished with " + std::to_string(osmdata.restrictions.size()) + " simple restrictions");
   LOG_INFO("Finished with " + std::to_string(osmdata.lane_connectivity_map.size()) + " lane connections");
@@ -1216,8 +1315,10 @@ OSMData PBFGraphParser::Parse(const boost::property_tree::ptree& pt, const std::
   LOG_INFO("Sorting complex restrictions by from id...");
   {
     sequence<OSMRestriction> complex_restrictions(complex_restriction_file, false);
-    complex_restrictions.sort([](const OSMRestriction& a, const OSMRestriction& b){return a < b;});
+    complex_restrictions.sort([](const OSMRestriction& a, const OSMRestriction& b){return a < b;},
+      sort_buffer_size / sizeof(OSMRestriction), threads);
   }
+  log_phase("Sorting complex restrictions");
 
   //we need to sort the refs so that we can easily (sequentially) update them
   //during node processing, we use memory mapping here because otherwise we aren't
@@ -1228,21 +1329,42 @@ OSMData PBFGraphParser::Parse(const boost::property_tree::ptree& pt, const std::
     way_nodes.sort(
       [](const OSMWayNode& a, const OSMWayNode& b){
         return a.node.osmid < b.node.osmid;
-      }
+      }, sort_buffer_size / sizeof(OSMWayNode), threads
     );
   }
   LOG_INFO("Finished");
+  log_phase("Sorting way node references");
 
+  // In a single pass the nodes were kept on disk so we go through them once
+  // instead of parsing the input files again
+  if (single_pass) {
+    LOG_INFO("Updating way nodes...");
+    {
+      sequence<OSMNode> nodes(nodes_file, false);
+      //osm node ids are only sorted at the single pbf file level
+      if (file_handles.size() > 1) {
+        nodes.sort([](const OSMNode& a, const OSMNode& b) { return a.osmid < b.osmid; },
+          sort_buffer_size / sizeof(OSMNode), threads);
+      }
+      callback.reset(nullptr, new sequence<OSMWayNode>(way_nodes_file, false), nullptr, nullptr);
+      callback.add_nodes(nodes);
+    }
+    std::remove(nodes_file.c_str());
+    log_phase("Updating way nodes");
+  }
   // Parse node in all the input files. Skip any that are not marked from
   // being used in a way.
   // TODO: we know how many knows we expect, stop early once we have that many
-  LOG_INFO("Parsing nodes...");
-  for (auto& file_handle : file_handles) {
-    //each time we parse nodes we have to run through the way nodes file from the beginning because
-    //because osm node ids are only sorted at the single pbf file level
-    callback.reset(nullptr, new sequence<OSMWayNode>(way_nodes_file, false), nullptr, nullptr);
-    callback.current_way_node_index_ = callback.last_node_ = callback.last_way_ = callback.last_relation_ = 0;
-    OSMPBF::Parser::parse(file_handle, static_cast<OSMPBF::Interest>(OSMPBF::Interest::NODES | OSMPBF::Interest::CHANGESETS), callback);
+  else {
+    LOG_INFO("Parsing nodes...");
+    for (auto& file_handle : file_handles) {
+      //each time we parse nodes we have to run through the way nodes file from the beginning because
+      //because osm node ids are only sorted at the single pbf file level
+      callback.reset(nullptr, new sequence<OSMWayNode>(way_nodes_file, false), nullptr, nullptr);
+      callback.current_way_node_index_ = callback.last_node_ = callback.last_way_ = callback.last_relation_ = 0;
+      OSMPBF::Parser::parse(file_handle, static_cast<OSMPBF::Interest>(OSMPBF::Interest::NODES | OSMPBF::Interest::CHANGESETS), callback, threads);
+    }
+    log_phase("Parsing nodes");
   }
   callback.reset(nullptr, nullptr, nullptr, nullptr);
   LOG_INFO("Finished with " + std::to_string(osmdata.osm_node_count) + " nodes contained in routable ways");
@@ -1262,9 +1384,10 @@ OSMData PBFGraphParser::Parse(const boost::property_tree::ptree& pt, const std::
           return a.way_shape_node_index < b.way_shape_node_index;
         }
         return a.way_index < b.way_index;
-      }
+      }, sort_buffer_size / sizeof(OSMWayNode), threads
     );
   }
+  log_phase("Sorting way node references by way");
 
   LOG_INFO("Finished at changeset id " + std::to_string(osmdata.max_changeset_id_));
 
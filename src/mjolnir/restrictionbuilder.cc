@@ -3,10 +3,10 @@
 #include "mjolnir/dataquality.h"
 #include "mjolnir/osmrestriction.h"
 #include "mjolnir/complexrestrictionbuilder.h"
+#include "mjolnir/tilescheduler.h"
 
 #include <future>
 #include <thread>
-#include <queue>
 
 #include <boost/filesystem/operations.hpp>
 
@@ -213,23 +213,20 @@ std::deque<GraphId> GetGraphIds(GraphId& n_graphId, GraphReader& reader, GraphId
 void build(const std::string& complex_restriction_file,
            const std::unordered_multimap<uint64_t, uint64_t>& end_map,
            const boost::property_tree::ptree& hierarchy_properties,
-           std::queue<GraphId>& tilequeue, std::mutex& lock,
+           const std::vector<GraphId>& tile_ids, TileScheduler& scheduler,
+           size_t worker, std::mutex& lock,
            std::promise<DataQuality>& result) {
   sequence<OSMRestriction> complex_restrictions(complex_restriction_file, false);
   GraphReader reader(hierarchy_properties);
   DataQuality stats;
 
   // Iterate through the tiles in the queue and perform enhancements
-  while (true) {
-    // Get the next tile Id from the queue and get writeable and readable
-    // tile. Lock while we access the tile queue and get the tile.
+  size_t index;
+  while (scheduler.next(worker, index)) {
+    // Get the next tile Id from the scheduler and get writeable and readable
+    // tile. Lock while we access the tile.
+    GraphId tile_id = tile_ids[index];
     lock.lock();
-    if (tilequeue.empty()) {
-      lock.unlock();
-      break;
-    }
-    GraphId tile_id = tilequeue.front();
-    tilequeue.pop();
 
     // Get a readable tile.If the tile is empty, skip it. Empty tiles are
     // added where ways go through a tile but no end not is within the tile.
@@ -512,41 +509,33 @@ void RestrictionBuilder::Build(const boost::property_tree::ptree& pt,
   for ( ; level != TileHierarchy::levels().rend(); ++level) {
 
     auto tile_level = level->second;
-    // Create a randomized queue of tiles to work from
-    std::deque<GraphId> tempqueue;
+    // Tiles to work from
+    std::vector<GraphId> tile_ids;
 
     for (uint32_t id = 0; id < tile_level.tiles.TileCount(); id++) {
       // If tile exists add it to the queue
       GraphId tile_id(id, tile_level.level, 0);
       if (GraphReader::DoesTileExist(hierarchy_properties, tile_id)) {
-        tempqueue.push_back(tile_id);
+        tile_ids.push_back(tile_id);
       }
     }
-    std::random_shuffle(tempqueue.begin(), tempqueue.end());
-    std::queue<GraphId> tilequeue(tempqueue);
 
     // An atomic object we can use to do the synchronization
     std::mutex lock;
-    // A place to hold worker threads and their results, exceptions or otherwise
 
-    std::vector<std::shared_ptr<std::thread> > threads(std::max(static_cast<unsigned int>(1),
+    // Schedule the biggest tiles first across the threads
+    TileScheduler scheduler("Adding restrictions at level " + std::to_string(tile_level.level),
+      TileScheduler::TileSizes(reader.tile_dir(), tile_ids), std::max(static_cast<unsigned int>(1),
       pt.get<unsigned int>("concurrency", std::thread::hardware_concurrency())));
     // Hold the results (DataQuality/stats) for the threads
-    std::vector<std::promise<DataQuality> > results(threads.size());
+    std::vector<std::promise<DataQuality> > results(scheduler.threads());
 
-    // Start the threads
+    // Start the threads and wait for them to finish up their work
     LOG_INFO("Adding Restrictions at level " + std::to_string(tile_level.level));
-    for (size_t i = 0; i < threads.size(); ++i) {
-      threads[i].reset(new std::thread(build,
-                   std::cref(complex_restrictions_file), std::cref(end_map),
-                   std::ref(hierarchy_properties), std::ref(tilequeue),
-                   std::ref(lock), std::ref(std::ref(results[i]))));
-    }
-
-    // Wait for them to finish up their work
-    for (auto& thread : threads) {
-      thread->join();
-    }
+    scheduler.run([&](size_t worker) {
+      build(complex_restrictions_file, end_map, hierarchy_properties, tile_ids,
+            scheduler, worker, lock, results[worker]);
+    });
 
     uint32_t forward_restrictions_count = 0;
     uint32_t reverse_restrictions_count = 0;
@@ -1,5 +1,6 @@
 #include "mjolnir/shortcutbuilder.h"
 #include "mjolnir/graphtilebuilder.h"
+#include "mjolnir/tilescheduler.h"
 
 #include <ostream>
 #include <sstream>
@@ -9,6 +10,9 @@
 #include <vector>
 #include <map>
 #include <utility>
+#include <list>
+#include <thread>
+#include <future>
 #include <boost/property_tree/ptree.hpp>
 #include <boost/format.hpp>
 #include <boost/filesystem/operations.hpp>
@@ -537,146 +541,167 @@ uint32_t AddShortcutEdges(GraphReader& reader, const GraphTile* tile,
   return shortcut_count;
 }
 
-// Form shortcuts for tiles in this level.
-uint32_t FormShortcuts(GraphReader& reader,
-            const TileLevel& level,
+// Form shortcuts for a tile. Shortcuts belong to the tile of their start
+// node so the new tile is all this writes. It is stored under the staging
+// directory so the tiles other threads read stay as they were.
+uint32_t FormShortcutsInTile(GraphReader& reader, const GraphId& new_tile,
+            const std::string& staging_dir,
             const std::unique_ptr<const valhalla::skadi::sample>& sample) {
-  // Iterate through the tiles at this level (TODO - can we mark the tiles
-  // the tiles that shortcuts end within?)
-  reader.Clear();
+  // Get the graph tile
   bool added = false;
   uint32_t shortcut_count = 0;
-  uint32_t ntiles = level.tiles.TileCount();
-  uint32_t tile_level = (uint32_t)level.level;
-  const GraphTile* tile = nullptr;
-  for (uint32_t tileid = 0; tileid < ntiles; tileid++) {
-    // Get the graph tile. Skip if no tile exists (common case)
-    tile = reader.GetGraphTile(GraphId(tileid, tile_level, 0));
-    if (tile == nullptr || tile->header()->nodecount() == 0) {
-      continue;
-    }
+  uint32_t tileid = new_tile.tileid();
+  uint32_t tile_level = new_tile.level();
+  const GraphTile* tile = reader.GetGraphTile(new_tile);
+  if (tile == nullptr || tile->header()->nodecount() == 0) {
+    return 0;
+  }
 
-    // Create GraphTileBuilder for the new tile
-    GraphId new_tile(tileid, tile_level, 0);
-    GraphTileBuilder tilebuilder(reader.tile_dir(), new_tile, false);
-
-    // Create a dummy admin at index 0.  Used if admins are not used/created.
-    tilebuilder.AddAdmin("None", "None", "", "");
-
-    // Iterate through the nodes in the tile
-    GraphId node_id(tileid, tile_level, 0);
-    for (uint32_t n = 0; n < tile->header()->nodecount(); n++, ++node_id) {
-      // Get the node info, copy node index and count from old tile
-      NodeInfo nodeinfo = *(tile->node(node_id));
-      uint32_t old_edge_index = nodeinfo.edge_index();
-      uint32_t old_edge_count = nodeinfo.edge_count();
-
-      // Update node information
-      const auto& admin = tile->admininfo(nodeinfo.admin_index());
-      nodeinfo.set_edge_index(tilebuilder.directededges().size());
-      nodeinfo.set_timezone(nodeinfo.timezone());
-      nodeinfo.set_admin_index(tilebuilder.AddAdmin(admin.country_text(),
-                admin.state_text(), admin.country_iso(), admin.state_iso()));
-
-      // Current edge count
-      size_t edge_count = tilebuilder.directededges().size();
-
-      // Add shortcut edges first.
-      std::unordered_map<uint32_t, uint32_t> shortcuts;
-      shortcut_count += AddShortcutEdges(reader, tile, tilebuilder, node_id,
-                   old_edge_index, old_edge_count, shortcuts, sample);
-
-      // Copy the rest of the directed edges from this node
-      GraphId edgeid(tileid, tile_level, old_edge_index);
-      for (uint32_t i = 0; i < old_edge_count; i++, ++edgeid) {
-        // Copy the directed edge information and update end node,
-        // edge data offset, and opp_index
-        const DirectedEdge* directededge = tile->directededge(edgeid);
-        DirectedEdge newedge = *directededge;
-
-        // Transition edges are stored as is (no need for EdgeInfo, signs,
-        // or restrictions).
-        if (!directededge->trans_down() && !directededge->trans_up()) {
-          // Get signs from the base directed edge
-          if (directededge->exitsign()) {
-            std::vector<SignInfo> signs = tile->GetSigns(edgeid.id());
-            if (signs.size() == 0) {
-              LOG_ERROR("Base edge should have signs, but none found");
-            }
-            tilebuilder.AddSigns(tilebuilder.directededges().size(), signs);
-          }
+  // Create GraphTileBuilder for the new tile. Keep the header of the old one
+  GraphTileBuilder tilebuilder(staging_dir, new_tile, false);
+  tilebuilder.header_builder() = *tile->header();
+
+  // Create a dummy admin at index 0.  Used if admins are not used/created.
+  tilebuilder.AddAdmin("None", "None", "", "");
+
+  // Iterate through the nodes in the tile
+  GraphId node_id(tileid, tile_level, 0);
+  for (uint32_t n = 0; n < tile->header()->nodecount(); n++, ++node_id) {
+    // Get the node info, copy node index and count from old tile
+    NodeInfo nodeinfo = *(tile->node(node_id));
+    uint32_t old_edge_index = nodeinfo.edge_index();
+    uint32_t old_edge_count = nodeinfo.edge_count();
+
+    // Update node information
+    const auto& admin = tile->admininfo(nodeinfo.admin_index());
+    nodeinfo.set_edge_index(tilebuilder.directededges().size());
+    nodeinfo.set_timezone(nodeinfo.timezone());
+    nodeinfo.set_admin_index(tilebuilder.AddAdmin(admin.country_text(),
+              admin.state_text(), admin.country_iso(), admin.state_iso()));
+
+    // Current edge count
+    size_t edge_count = tilebuilder.directededges().size();
+
+    // Add shortcut edges first.
+    std::unordered_map<uint32_t, uint32_t> shortcuts;
+    shortcut_count += AddShortcutEdges(reader, tile, tilebuilder, node_id,
+                 old_edge_index, old_edge_count, shortcuts, sample);
+
+    // Copy the rest of the directed edges from this node
+    GraphId edgeid(tileid, tile_level, old_edge_index);
+    for (uint32_t i = 0; i < old_edge_count; i++, ++edgeid) {
+      // Copy the directed edge information and update end node,
+      // edge data offset, and opp_index
+      const DirectedEdge* directededge = tile->directededge(edgeid);
+      DirectedEdge newedge = *directededge;
 
-          // Get access restrictions from the base directed edge. Add these to
-          // the list of access restrictions in the new tile. Update the
-          // edge index in the restriction to be the current directed edge Id
-          if (directededge->access_restriction()) {
-            auto restrictions = tile->GetAccessRestrictions(edgeid.id(), kAllAccess);
-            for (const auto& res : restrictions) {
-              tilebuilder.AddAccessRestriction(
-                  AccessRestriction(tilebuilder.directededges().size(),
-                     res.type(), res.modes(), res.value()));
-            }
+      // Transition edges are stored as is (no need for EdgeInfo, signs,
+      // or restrictions).
+      if (!directededge->trans_down() && !directededge->trans_up()) {
+        // Get signs from the base directed edge
+        if (directededge->exitsign()) {
+          std::vector<SignInfo> signs = tile->GetSigns(edgeid.id());
+          if (signs.size() == 0) {
+            LOG_ERROR("Base edge should have signs, but none found");
           }
+          tilebuilder.AddSigns(tilebuilder.directededges().size(), signs);
+        }
 
-          // Copy lane connectivity
-          if (directededge->laneconnectivity()) {
-            auto laneconnectivity = tile->GetLaneConnectivity(edgeid.id());
-            if (laneconnectivity.size() == 0) {
-              LOG_ERROR("Base edge should have lane connectivity, but none found");
-            }
-            for (auto& lc : laneconnectivity) {
-              lc.set_to(tilebuilder.directededges().size());
-            }
-            tilebuilder.AddLaneConnectivity(laneconnectivity);
+        // Get access restrictions from the base directed edge. Add these to
+        // the list of access restrictions in the new tile. Update the
+        // edge index in the restriction to be the current directed edge Id
+        if (directededge->access_restriction()) {
+          auto restrictions = tile->GetAccessRestrictions(edgeid.id(), kAllAccess);
+          for (const auto& res : restrictions) {
+            tilebuilder.AddAccessRestriction(
+                AccessRestriction(tilebuilder.directededges().size(),
+                   res.type(), res.modes(), res.value()));
           }
-
-          // Get edge info, shape, and names from the old tile and add
-          // to the new. Use prior edgeinfo offset as the key to make sure
-          // edges that have the same end nodes are differentiated (this
-          // should be a valid key since tile sizes aren't changed)
-          auto edgeinfo = tile->edgeinfo(directededge->edgeinfo_offset());
-          uint32_t edge_info_offset = tilebuilder.AddEdgeInfo(directededge->edgeinfo_offset(),
-                         node_id, directededge->endnode(), edgeinfo.wayid(), edgeinfo.encoded_shape(),
-                         tile->GetNames(directededge->edgeinfo_offset()), added);
-          newedge.set_edgeinfo_offset(edge_info_offset);
-
-          // Set the superseded mask - this is the shortcut mask that
-          // supersedes this edge (outbound from the node)
-          auto s = shortcuts.find(i);
-          uint32_t supersed_idx = (s != shortcuts.end()) ? s->second : 0;
-          newedge.set_superseded(supersed_idx);
         }
 
-        // Add directed edge
-        tilebuilder.directededges().emplace_back(std::move(newedge));
-
-        // Add existing edge elevation (if the tile has elevation information)
-        if (tile->header()->has_edge_elevation()) {
-          const EdgeElevation* elev = tile->edge_elevation(edgeid);
-          if (elev == nullptr) {
-            tilebuilder.edge_elevations().emplace_back(0.0f, 0.0f, 0.0f);
-          } else {
-            tilebuilder.edge_elevations().emplace_back(std::move(*elev));
+        // Copy lane connectivity
+        if (directededge->laneconnectivity()) {
+          auto laneconnectivity = tile->GetLaneConnectivity(edgeid.id());
+          if (laneconnectivity.size() == 0) {
+            LOG_ERROR("Base edge should have lane connectivity, but none found");
           }
+          for (auto& lc : laneconnectivity) {
+            lc.set_to(tilebuilder.directededges().size());
+          }
+          tilebuilder.AddLaneConnectivity(laneconnectivity);
         }
+
+        // Get edge info, shape, and names from the old tile and add
+        // to the new. Use prior edgeinfo offset as the key to make sure
+        // edges that have the same end nodes are differentiated (this
+        // should be a valid key since tile sizes aren't changed)
+        auto edgeinfo = tile->edgeinfo(directededge->edgeinfo_offset());
+        uint32_t edge_info_offset = tilebuilder.AddEdgeInfo(directededge->edgeinfo_offset(),
+                       node_id, directededge->endnode(), edgeinfo.wayid(), edgeinfo.encoded_shape(),
+                       tile->GetNames(directededge->edgeinfo_offset()), added);
+        newedge.set_edgeinfo_offset(edge_info_offset);
+
+        // Set the superseded mask - this is the shortcut mask that
+        // supersedes this edge (outbound from the node)
+        auto s = shortcuts.find(i);
+        uint32_t supersed_idx = (s != shortcuts.end()) ? s->second : 0;
+        newedge.set_superseded(supersed_idx);
       }
 
-      // Set the edge count for the new node
-      nodeinfo.set_edge_count(tilebuilder.directededges().size() - edge_count);
-      tilebuilder.nodes().emplace_back(std::move(nodeinfo));
+      // Add directed edge
+      tilebuilder.directededges().emplace_back(std::move(newedge));
+
+      // Add existing edge elevation (if the tile has elevation information)
+      if (tile->header()->has_edge_elevation()) {
+        const EdgeElevation* elev = tile->edge_elevation(edgeid);
+        if (elev == nullptr) {
+          tilebuilder.edge_elevations().emplace_back(0.0f, 0.0f, 0.0f);
+        } else {
+          tilebuilder.edge_elevations().emplace_back(std::move(*elev));
+        }
+      }
     }
 
-    // Store the new tile
-    tilebuilder.StoreTileData();
-    LOG_DEBUG((boost::format("ShortcutBuilder created tile %1%: %2% bytes") %
-         tile % tilebuilder.header_builder().end_offset()).str());
+    // Set the edge count for the new node
+    nodeinfo.set_edge_count(tilebuilder.directededges().size() - edge_count);
+    tilebuilder.nodes().emplace_back(std::move(nodeinfo));
+  }
+
+  // Store the new tile
+  tilebuilder.StoreTileData();
+  LOG_DEBUG((boost::format("ShortcutBuilder created tile %1%: %2% bytes") %
+       new_tile % tilebuilder.header_builder().end_offset()).str());
+  return shortcut_count;
+}
+
+// Form shortcuts for the tiles the scheduler hands this thread
+void FormShortcuts(const boost::property_tree::ptree& hierarchy_properties,
+            const std::string& staging_dir,
+            const std::unique_ptr<const valhalla::skadi::sample>& sample,
+            const std::vector<GraphId>& tiles, TileScheduler& scheduler,
+            size_t worker, std::promise<uint32_t>& result) {
+  GraphReader reader(hierarchy_properties);
+  uint32_t shortcut_count = 0;
+  size_t index;
+  while (scheduler.next(worker, index)) {
+    // Get the next tile
+    GraphId tile_id = tiles[index];
+
+    try {
+      shortcut_count += FormShortcutsInTile(reader, tile_id, staging_dir, sample);
+    }// Whatever happens in Vegas..
+    catch(std::exception& e) {
+      // ..gets sent back to the main thread, which stops the other threads
+      LOG_ERROR((boost::format("Failed tile %1%: %2%") % tile_id % e.what()).str());
+      throw;
+    }
 
     // Check if we need to clear the tile cache.
     if (reader.OverCommitted()) {
       reader.Clear();
     }
   }
-  return shortcut_count;
+  result.set_value(shortcut_count);
 }
 
 }
@@ -689,12 +714,14 @@ namespace mjolnir {
 // attributes. Shortcut edges are inserted before regular edges.
 void ShortcutBuilder::Build(const boost::property_tree::ptree& pt) {
 
-  //TODO: thread this. would need to make sure we dont make shortcuts
-  //across tile boundaries so that we are only messing with one tile
-  //in one thread at a time
-
-  // Get GraphReader
-  GraphReader reader(pt.get_child("mjolnir"));
+  // Shortcuts belong to the tile of their start node so each tile can be
+  // done on its own. The new tiles are staged until all tiles of a level are
+  // done so that no thread reads a tile another has already rewritten
+  unsigned int thread_count = std::max(static_cast<unsigned int>(1),
+                                       pt.get<unsigned int>("mjolnir.concurrency", std::thread::hardware_concurrency()));
+  const auto& hierarchy_properties = pt.get_child("mjolnir");
+  GraphReader reader(hierarchy_properties);
+  std::string staging_dir = (boost::filesystem::path(reader.tile_dir()) / ".shortcuts").string();
 
   // Crack open some elevation data if its there
   boost::optional<std::string> elevation = pt.get_optional<std::string>("additional_data.elevation");
@@ -706,10 +733,41 @@ void ShortcutBuilder::Build(const boost::property_tree::ptree& pt) {
   auto level = TileHierarchy::levels().rbegin();
   level++;
   for ( ; level != TileHierarchy::levels().rend(); ++level) {
-    // Create shortcuts on this level
+    // Queue up the tiles on this level
     auto tile_level = level->second;
-    LOG_INFO("Creating shortcuts on level " + std::to_string(tile_level.level));
-    uint32_t count = FormShortcuts(reader, tile_level, sample);
+    std::vector<GraphId> tiles;
+    for (uint32_t id = 0; id < tile_level.tiles.TileCount(); id++) {
+      GraphId tile_id(id, tile_level.level, 0);
+      if (GraphReader::DoesTileExist(hierarchy_properties, tile_id)) {
+        tiles.push_back(tile_id);
+      }
+    }
+    // Create shortcuts on this level
+    LOG_INFO("Creating shortcuts on level " + std::to_string(tile_level.level) +
+             " with " + std::to_string(thread_count) + " threads");
+    TileScheduler scheduler("Creating shortcuts on level " + std::to_string(tile_level.level),
+                            TileScheduler::TileSizes(reader.tile_dir(), tiles), thread_count);
+    std::vector<std::promise<uint32_t> > results(scheduler.threads());
+    scheduler.run([&](size_t worker) {
+      FormShortcuts(hierarchy_properties, staging_dir, sample, tiles, scheduler,
+                    worker, results[worker]);
+    });
+
+    // If something bad went down this will rethrow it
+    uint32_t count = 0;
+    for (auto& result : results) {
+      count += result.get_future().get();
+    }
+
+    // Move the new tiles over the old ones now that nothing reads them
+    for (const auto& tile_id : tiles) {
+      auto suffix = GraphTile::FileSuffix(tile_id);
+      boost::filesystem::path staged = boost::filesystem::path(staging_dir) / suffix;
+      if (boost::filesystem::exists(staged)) {
+        boost::filesystem::rename(staged, boost::filesystem::path(reader.tile_dir()) / suffix);
+      }
+    }
+    boost::filesystem::remove_all(staging_dir);
     LOG_INFO("Finished with " + std::to_string(count) + " shortcuts");
   }
 }
@@ -0,0 +1,147 @@
+#include "mjolnir/tilescheduler.h"
+
+#include <algorithm>
+#include <exception>
+#include <numeric>
+#include <thread>
+#include <boost/filesystem/operations.hpp>
+
+#include "midgard/logging.h"
+#include "baldr/graphtile.h"
+
+using namespace valhalla::baldr;
+
+namespace {
+
+// How often to log progress, in tenths of the total work
+constexpr size_t kReportSteps = 10;
+
+}
+
+namespace valhalla {
+namespace mjolnir {
+
+TileScheduler::TileScheduler(const std::string& stage, const std::vector<size_t>& weights,
+                             unsigned int threads)
+  : stage_(stage), weights_(weights), total_weight_(0), stopped_(false), finished_weight_(0),
+    finished_count_(0), next_report_(1), start_(std::chrono::steady_clock::now()) {
+  // Every item counts for something so empty tiles still show progress
+  for (auto& weight : weights_) {
+    weight = std::max(weight, static_cast<size_t>(1));
+    total_weight_ += weight;
+  }
+
+  // Deal the items out largest first so each thread starts on big ones
+  std::vector<size_t> order(weights_.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [this](size_t a, size_t b) {
+    return weights_[a] > weights_[b];
+  });
+  for (unsigned int i = 0; i < std::max(threads, 1u); ++i) {
+    queues_.emplace_back(new worker_queue());
+  }
+  for (size_t i = 0; i < order.size(); ++i) {
+    queues_[i % queues_.size()]->items.push_back(order[i]);
+  }
+}
+
+bool TileScheduler::next(size_t worker, size_t& item) {
+  finish(worker);
+  if (stopped_) {
+    return false;
+  }
+
+  // Take the largest item left in our own queue, otherwise steal the
+  // smallest from the back of someone else's
+  for (size_t i = 0; i < queues_.size(); ++i) {
+    auto& queue = *queues_[(worker + i) % queues_.size()];
+    std::lock_guard<std::mutex> lock(queue.lock);
+    if (queue.items.empty()) {
+      continue;
+    }
+    if (i == 0) {
+      item = queue.items.front();
+      queue.items.pop_front();
+    } else {
+      item = queue.items.back();
+      queue.items.pop_back();
+    }
+    queues_[worker]->working = item;
+    return true;
+  }
+  return false;
+}
+
+void TileScheduler::finish(size_t worker) {
+  // Only this thread touches what it is working on
+  auto& working = queues_[worker]->working;
+  if (working == static_cast<size_t>(-1)) {
+    return;
+  }
+  size_t finished = finished_weight_ += weights_[working];
+  size_t count = ++finished_count_;
+  working = -1;
+
+  // Log every so often with an estimate of how long is left
+  std::lock_guard<std::mutex> lock(progress_lock_);
+  if (finished * kReportSteps < next_report_ * total_weight_) {
+    return;
+  }
+  next_report_ = finished * kReportSteps / total_weight_ + 1;
+  auto elapsed = std::chrono::duration_cast<std::chrono::seconds>(
+      std::chrono::steady_clock::now() - start_).count();
+  auto left = static_cast<uint64_t>(elapsed * static_cast<double>(total_weight_ - finished) / finished);
+  LOG_INFO(stage_ + ": " + std::to_string(count) + " of " + std::to_string(weights_.size()) +
+           " tiles (" + std::to_string(finished * 100 / total_weight_) + "%) after " +
+           std::to_string(elapsed) + " secs, about " + std::to_string(left) + " secs left");
+}
+
+void TileScheduler::run(const std::function<void (size_t worker)>& work) {
+  std::vector<std::shared_ptr<std::thread> > threads(queues_.size());
+  std::exception_ptr error;
+  std::mutex error_lock;
+  for (size_t i = 0; i < threads.size(); ++i) {
+    threads[i].reset(new std::thread([this, i, &work, &error, &error_lock]() {
+      try {
+        work(i);
+        finish(i);
+      }
+      catch(...) {
+        stopped_ = true;
+        std::lock_guard<std::mutex> lock(error_lock);
+        if (!error) {
+          error = std::current_exception();
+        }
+      }
+    }));
+  }
+  for (auto& thread : threads) {
+    thread->join();
+  }
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+
+size_t TileScheduler::threads() const {
+  return queues_.size();
+}
+
+size_t TileScheduler::size() const {
+  return weights_.size();
+}
+
+std::vector<size_t> TileScheduler::TileSizes(const std::string& tile_dir,
+                                             const std::vector<GraphId>& tiles) {
+  std::vector<size_t> sizes;
+  sizes.reserve(tiles.size());
+  for (const auto& tile : tiles) {
+    boost::system::error_code ec;
+    auto size = boost::filesystem::file_size(tile_dir + "/" + GraphTile::FileSuffix(tile), ec);
+    sizes.push_back(ec ? 0 : size);
+  }
+  return sizes;
+}
+
+}
+}
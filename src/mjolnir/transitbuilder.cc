@@ -1,5 +1,6 @@
 #include "mjolnir/transitbuilder.h"
 #include "mjolnir/graphtilebuilder.h"
+#include "mjolnir/tilescheduler.h"
 
 #include <list>
 #include <future>
@@ -561,15 +562,15 @@ void AddOSMConnection(const GraphId& transit_stop_node,
 void build(const std::string& transit_dir,
            const boost::property_tree::ptree& pt, std::mutex& lock,
            const std::unordered_set<GraphId>& tiles,
-           std::unordered_set<GraphId>::const_iterator tile_start,
-           std::unordered_set<GraphId>::const_iterator tile_end,
-           std::promise<builder_stats>& results) {
+           const std::vector<GraphId>& tile_ids, TileScheduler& scheduler,
+           size_t worker, std::promise<builder_stats>& results) {
   // GraphReader for local level and for transit level.
   GraphReader reader_local_level(pt);
   GraphReader reader_transit_level(pt);
 
-  // Iterate through the tiles in the queue and find any that include stops
-  for(; tile_start != tile_end; ++tile_start) {
+  // Iterate through the tiles the scheduler hands us and find any that include stops
+  size_t index;
+  while (scheduler.next(worker, index)) {
     // Get the next tile Id from the queue and get a tile builder
     if(reader_local_level.OverCommitted())
       reader_local_level.Clear();
@@ -577,7 +578,7 @@ void build(const std::string& transit_dir,
     if (reader_transit_level.OverCommitted())
       reader_transit_level.Clear();
 
-    GraphId tile_id = tile_start->Tile_Base();
+    GraphId tile_id = tile_ids[index].Tile_Base();
 
     // Get Valhalla tile - get a read only instance for reference and
     // a writeable instance (deserialize it so we can add to it)
@@ -699,46 +700,29 @@ void TransitBuilder::Build(const boost::property_tree::ptree& pt) {
   // Second pass - for all tiles with transit stops get all transit information
   // and populate tiles
 
-  // A place to hold worker threads and their results
-  // (Change threads to 1 if running DEBUG to get more info)
-  //std::vector<std::shared_ptr<std::thread> > threads(1);
-  std::vector<std::shared_ptr<std::thread> > threads(
-     std::max(static_cast<uint32_t>(1),
-       pt.get<uint32_t>("mjolnir.concurrency",
-       std::thread::hardware_concurrency())));
+  // Schedule the tiles with the most transit first across the threads
+  std::vector<GraphId> tile_ids(tiles.begin(), tiles.end());
+  std::vector<GraphId> transit_ids;
+  for (const auto& tile_id : tile_ids) {
+    transit_ids.emplace_back(tile_id.tileid(), tile_id.level() + 1, tile_id.id());
+  }
+  TileScheduler scheduler("Adding transit",
+    TileScheduler::TileSizes(reader.tile_dir(), transit_ids),
+    std::max(static_cast<uint32_t>(1),
+      pt.get<uint32_t>("mjolnir.concurrency", std::thread::hardware_concurrency())));
 
   // An atomic object we can use to do the synchronization
   std::mutex lock;
 
   // A place to hold the results of those threads (exceptions, stats)
-  std::list<std::promise<builder_stats> > results;
+  std::vector<std::promise<builder_stats> > results(scheduler.threads());
 
-  // Start the threads, divvy up the work
+  // Run the threads
   LOG_INFO("Adding " + std::to_string(tiles.size()) + " transit tiles to the local graph...");
-  size_t floor = tiles.size() / threads.size();
-  size_t at_ceiling = tiles.size() - (threads.size() * floor);
-  std::unordered_set<GraphId>::const_iterator tile_start, tile_end = tiles.begin();
-
-  // Atomically pass around stats info
-  for (size_t i = 0; i < threads.size(); ++i) {
-    // Figure out how many this thread will work on (either ceiling or floor)
-    size_t tile_count = (i < at_ceiling ? floor + 1 : floor);
-    // Where the range begins
-    tile_start = tile_end;
-    // Where the range ends
-    std::advance(tile_end, tile_count);
-    // Make the thread
-    results.emplace_back();
-    threads[i].reset(
-      new std::thread(build, *transit_dir, std::cref(pt.get_child("mjolnir")),
-                      std::ref(lock), std::cref(tiles), tile_start, tile_end,
-                      std::ref(results.back())));
-  }
-
-  // Wait for them to finish up their work
-  for (auto& thread : threads) {
-    thread->join();
-  }
+  scheduler.run([&](size_t worker) {
+    build(*transit_dir, pt.get_child("mjolnir"), lock, tiles, tile_ids,
+          scheduler, worker, results[worker]);
+  });
 
   // Check all of the outcomes, to see about maximum density (km/km2)
   builder_stats stats{};
@@ -22,11 +22,14 @@
 #include "baldr/tilehierarchy.h"
 #include "baldr/directededge.h"
 #include "baldr/edgeinfo.h"
+#include "baldr/speedprofile.h"
+#include "mjolnir/graphtilebuilder.h"
 
 namespace bpo = boost::program_options;
 
 using namespace valhalla::baldr;
 using namespace valhalla::midgard;
+using namespace valhalla::mjolnir;
 
 boost::filesystem::path config_file_path;
 std::vector<std::string> input_files;
@@ -61,7 +64,8 @@ bool ParseArguments(int argc, char *argv[]) {
     " Usage: valhalla_build_speeds [options]\n"
     "\n"
     "valhalla_build_speeds is a program that reads speed data associated to OSM ways "
-    "and creates a speed table on the local level tiles."
+    "and creates a speed table on the local level tiles. Historical speed profiles "
+    "(traffic/way_speed_profiles.csv) are stored in the tiles themselves."
     "\n"
     "\n");
 
@@ -189,6 +193,111 @@ LOG_INFO("Read Way Speeds file: " + way_speeds_file);
   return way_speeds;
 }
 
+/**
+ * Read way speed profiles CSV file and return a mapping of ways to the
+ * speeds for each hour of the week in each direction. Each line holds the
+ * wayid, a forward flag (1 if along the way, 0 if against it) followed by
+ * the speed (kph) for each hour of the week starting at midnight Sunday.
+ * Blank speeds are left as 0 and use the speed on the edge.
+ */
+std::unordered_map<uint64_t, std::pair<std::vector<uint32_t>, std::vector<uint32_t>>>
+ReadWaySpeedProfiles(const std::string& tile_dir) {
+  std::string profiles_file = tile_dir + "/traffic/way_speed_profiles.csv";
+  std::unordered_map<uint64_t, std::pair<std::vector<uint32_t>,
+                     std::vector<uint32_t>>> way_profiles;
+  std::ifstream ways_file;
+  ways_file.open(profiles_file);
+  if (!ways_file.is_open()) {
+    return way_profiles;
+  }
+  LOG_INFO("Read Way Speed Profiles file: " + profiles_file);
+
+  // Get the first line (format)
+  std::string line;
+  std::getline(ways_file, line);
+
+  // Get way speed profile: wayid, forward, 168 hourly speeds (kph)
+  while (std::getline(ways_file, line)) {
+    uint32_t n = 0;
+    uint64_t wayid = 0;
+    bool forward = true;
+    std::vector<uint32_t> speeds;
+    std::string num;
+    std::stringstream line_stream(line);
+    while (std::getline(line_stream, num, ',')) {
+      if (n == 0) {
+        wayid = std::stoll(num);
+      } else if (n == 1) {
+        forward = std::stoi(num) != 0;
+      } else if (speeds.size() < kSpeedBucketCount) {
+        speeds.push_back(num.empty() ? 0 : std::stoi(num));
+      }
+      n++;
+    }
+    if (speeds.size() != kSpeedBucketCount) {
+      LOG_WARN("Skipping incomplete speed profile for way " + std::to_string(wayid));
+      continue;
+    }
+
+    auto& profiles = way_profiles[wayid];
+    (forward ? profiles.first : profiles.second) = std::move(speeds);
+  }
+  return way_profiles;
+}
+
+/**
+ * Add the speed profiles to the directed edges of the ways and store them
+ * in the local level tiles.
+ */
+void StoreSpeedProfiles(const std::string& tile_dir, GraphReader& reader,
+       const std::unordered_map<uint64_t, std::pair<std::vector<uint32_t>,
+                                std::vector<uint32_t>>>& way_profiles,
+       const std::unordered_map<uint64_t, std::vector<EdgeAndDirection>>& way_edges) {
+  // Group the profiles by tile
+  std::unordered_map<GraphId, std::vector<SpeedProfile>> tile_profiles;
+  for (const auto& way : way_profiles) {
+    auto itr = way_edges.find(way.first);
+    if (itr == way_edges.end()) {
+      continue;
+    }
+    for (const auto& edge : itr->second) {
+      const auto& speeds = edge.forward ? way.second.first : way.second.second;
+      if (speeds.empty()) {
+        continue;
+      }
+
+      // Fill in missing hours with the speed on the edge
+      const GraphTile* tile = reader.GetGraphTile(edge.edgeid);
+      if (tile == nullptr) {
+        LOG_ERROR("No tile found for " + std::to_string(edge.edgeid.tileid()) +
+                          "," + std::to_string(edge.edgeid.level()));
+        continue;
+      }
+      std::vector<uint32_t> edge_speeds(speeds);
+      uint32_t speed = tile->directededge(edge.edgeid)->speed();
+      for (auto& s : edge_speeds) {
+        if (s == 0) {
+          s = speed;
+        }
+      }
+      tile_profiles[edge.edgeid.Tile_Base()].emplace_back(edge.edgeid.id(), edge_speeds);
+    }
+  }
+
+  // Rewrite the tiles with their speed profiles
+  uint32_t stored_profiles = 0;
+  for (const auto& profiles : tile_profiles) {
+    GraphTileBuilder tilebuilder(tile_dir, profiles.first, true);
+    for (const auto& profile : profiles.second) {
+      tilebuilder.AddSpeedProfile(profile);
+    }
+    tilebuilder.StoreTileData();
+    stored_profiles += profiles.second.size();
+  }
+  LOG_INFO("Number of speed profile tiles = " + std::to_string(tile_profiles.size()));
+  LOG_INFO("Stored speed profiles = " + std::to_string(stored_profiles));
+}
+
 uint8_t GetSpeed(const bool forward, const uint8_t fwd, const uint8_t rev) {
   return (forward) ? fwd : rev;
 }
@@ -208,7 +317,8 @@ int main(int argc, char** argv) {
 
   // Read the way speed CSV file
   auto way_speeds = ReadWaySpeeds(tile_dir);
-  if (way_speeds.size() == 0) {
+  auto way_profiles = ReadWaySpeedProfiles(tile_dir);
+  if (way_speeds.size() == 0 && way_profiles.size() == 0) {
     LOG_ERROR("No speeds in the way speeds csv file");
     return 0;
   }
@@ -229,6 +339,12 @@ int main(int argc, char** argv) {
   way_edges = ReadWaysToEdges(way_edges_file);
   LOG_INFO("Done reading ways to edges file");
 
+  // Store the historical speed profiles in the tiles
+  GraphReader reader(pt.get_child("mjolnir"));
+  if (way_profiles.size() > 0) {
+    StoreSpeedProfiles(tile_dir, reader, way_profiles, way_edges);
+  }
+
   // Get Valhalla tiles
   auto local_level = TileHierarchy::levels().rbegin()->second.level;
   auto tiles = TileHierarchy::levels().rbegin()->second.tiles;
@@ -239,7 +355,6 @@ int main(int argc, char** argv) {
   // Iterate through the way Ids
   uint8_t speed;
   uint32_t stored_speeds = 0;
-  GraphReader reader(pt.get_child("mjolnir"));
   for (auto way : way_speeds) {
     uint32_t wayid   = way.first;
     const WaySpeed& speeds = way.second;
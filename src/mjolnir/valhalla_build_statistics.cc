@@ -28,6 +28,7 @@
 #include "baldr/graphconstants.h"
 #include "baldr/graphreader.h"
 #include "baldr/nodeinfo.h"
+#include "mjolnir/tilescheduler.h"
 
 using namespace valhalla::midgard;
 using namespace valhalla::baldr;
@@ -342,7 +343,8 @@ void AddStatistics(statistics& stats, const DirectedEdge& directededge,
 }
 
 void build(const boost::property_tree::ptree& pt,
-              std::deque<GraphId>& tilequeue, std::mutex& lock,
+              const std::vector<GraphId>& tile_ids, TileScheduler& scheduler,
+              size_t worker, std::mutex& lock,
               std::promise<statistics>& result) {
     // Our local class for gathering the stats
     statistics stats;
@@ -350,16 +352,10 @@ void build(const boost::property_tree::ptree& pt,
     GraphReader graph_reader(pt.get_child("mjolnir"));
 
     // Check for more tiles
-    while (true) {
-      lock.lock();
-      if (tilequeue.empty()) {
-        lock.unlock();
-        break;
-      }
+    size_t index;
+    while (scheduler.next(worker, index)) {
       // Get the next tile Id
-      GraphId tile_id = tilequeue.front();
-      tilequeue.pop_front();
-      lock.unlock();
+      GraphId tile_id = tile_ids[index];
 
       // Point tiles to the set we need for current level
       auto level = tile_id.level();
@@ -480,8 +476,8 @@ void BuildStatistics(const boost::property_tree::ptree& pt) {
   // Graph tile properties
   auto tile_properties = pt.get_child("mjolnir");
 
-  // Create a randomized queue of tiles to work from
-  std::deque<GraphId> tilequeue;
+  // Gather up the tiles to work from
+  std::vector<GraphId> tilequeue;
   for (auto tier : TileHierarchy::levels()) {
     auto level = tier.second.level;
     auto tiles = tier.second.tiles;
@@ -505,31 +501,26 @@ void BuildStatistics(const boost::property_tree::ptree& pt) {
       }
     }
   }
-  std::random_shuffle(tilequeue.begin(), tilequeue.end());
 
   // A mutex we can use to do the synchronization
   std::mutex lock;
 
   LOG_INFO("Gathering information about the tiles in " + pt.get<std::string>("mjolnir.tile_dir"));
 
-  // Setup threads
-  std::vector<std::shared_ptr<std::thread> > threads(
+  // Schedule the biggest tiles first across the threads
+  TileScheduler scheduler("Gathering statistics",
+      TileScheduler::TileSizes(pt.get<std::string>("mjolnir.tile_dir"), tilequeue),
       std::max(static_cast<unsigned int>(1),
                pt.get<unsigned int>("concurrency",std::thread::hardware_concurrency())));
 
   // Setup promises
-  std::list<std::promise<statistics> > results;
+  std::vector<std::promise<statistics> > results(scheduler.threads());
 
-  // Spawn the threads
-  for (auto& thread : threads) {
-    results.emplace_back();
-    thread.reset(new std::thread(build, std::cref(pt), std::ref(tilequeue),
-                                 std::ref(lock), std::ref(results.back())));
-  }
+  // Run the threads and wait for them to finish
+  scheduler.run([&](size_t worker) {
+    build(pt, tilequeue, scheduler, worker, lock, results[worker]);
+  });
 
-  // Wait for threads to finish
-  for (auto& thread : threads)
-    thread->join();
   // Get the promise from the future
   statistics stats;
   for (auto& result : results) {
@@ -67,6 +67,16 @@ DirectionsBuilder::DirectionsBuilder() {
 // trip directions.
 TripDirections DirectionsBuilder::Build(
     const DirectionsOptions& directions_options, TripPath& trip_path) {
+  TripDirections trip_directions;
+  Build(directions_options, trip_path, trip_directions);
+  return trip_directions;
+}
+
+// Fills in the trip directions supplied by the caller based on the specified
+// directions options and trip path.
+void DirectionsBuilder::Build(const DirectionsOptions& directions_options,
+                              TripPath& trip_path,
+                              TripDirections& trip_directions) {
   // Validate trip path node list
   if (trip_path.node_size() < 1) {
     throw valhalla_exception_t{400, 210};
@@ -90,8 +100,8 @@ TripDirections DirectionsBuilder::Build(
     narrative_builder->Build(directions_options, etp, maneuvers);
   }
 
-  // Return trip directions
-  return PopulateTripDirections(directions_options, etp, maneuvers);
+  // Fill in the trip directions
+  PopulateTripDirections(directions_options, etp, maneuvers, trip_directions);
 }
 
 // Update the heading of ~0 length edges.
@@ -119,13 +129,11 @@ void DirectionsBuilder::UpdateHeading(EnhancedTripPath* etp) {
   }
 }
 
-// Returns the trip directions based on the specified directions options,
+// Populates the trip directions based on the specified directions options,
 // trip path, and maneuver list.
-TripDirections DirectionsBuilder::PopulateTripDirections(
+void DirectionsBuilder::PopulateTripDirections(
     const DirectionsOptions& directions_options, EnhancedTripPath* etp,
-    std::list<Maneuver>& maneuvers) {
-  TripDirections trip_directions;
-
+    std::list<Maneuver>& maneuvers, TripDirections& trip_directions) {
   // Populate trip and leg IDs
   trip_directions.set_trip_id(etp->trip_id());
   trip_directions.set_leg_id(etp->leg_id());
@@ -162,7 +170,10 @@ TripDirections DirectionsBuilder::PopulateTripDirections(
     if (maneuver.portions_unpaved())
       trip_maneuver->set_portions_unpaved(maneuver.portions_unpaved());
 
-    if (maneuver.HasVerbalTransitionAlertInstruction()) {
+    // Alerts may have been formed only for the verbal multi-cue
+    if ((directions_options.narrative_fields()
+        & DirectionsOptions::kVerbalTransitionAlert)
+        && maneuver.HasVerbalTransitionAlertInstruction()) {
       trip_maneuver->set_verbal_transition_alert_instruction(
           maneuver.verbal_transition_alert_instruction());
     }
@@ -361,7 +372,6 @@ TripDirections DirectionsBuilder::PopulateTripDirections(
   // Populate shape
   trip_directions.set_shape(etp->shape());
 
-  return trip_directions;
 }
 
 }
@@ -32,6 +32,10 @@ using namespace valhalla::baldr;
 using namespace valhalla::odin;
 
 namespace {
+// The narrative fields that are spoken
+constexpr uint32_t kVerbalNarrativeFields = DirectionsOptions::kVerbalTransitionAlert
+    | DirectionsOptions::kVerbalPreTransition | DirectionsOptions::kVerbalPostTransition;
+
 void SortExitSignList(std::vector<Sign>* signs) {
   // Sort signs by descending consecutive count order
   std::sort(signs->begin(), signs->end(), [](Sign a, Sign b) {
@@ -745,10 +749,12 @@ void ManeuversBuilder::CreateDestinationManeuver(Maneuver& maneuver) {
     maneuver.set_transit_type(prev_edge->transit_type());
   }
 
-  // Set the verbal text formatter
-  maneuver.set_verbal_formatter(
-      VerbalTextFormatterFactory::Create(trip_path_->GetCountryCode(node_index),
-                                         trip_path_->GetStateCode(node_index)));
+  // Set the verbal text formatter, only the verbal narrative needs it
+  if (directions_options_.narrative_fields() & kVerbalNarrativeFields) {
+    maneuver.set_verbal_formatter(
+        VerbalTextFormatterFactory::Create(trip_path_->GetCountryCode(node_index),
+                                           trip_path_->GetStateCode(node_index)));
+  }
 
 }
 
@@ -1117,10 +1123,12 @@ void ManeuversBuilder::FinalizeManeuver(Maneuver& maneuver, int node_index) {
     }
   }
 
-  // Set the verbal text formatter
-  maneuver.set_verbal_formatter(
-      VerbalTextFormatterFactory::Create(trip_path_->GetCountryCode(node_index),
-                                         trip_path_->GetStateCode(node_index)));
+  // Set the verbal text formatter, only the verbal narrative needs it
+  if (directions_options_.narrative_fields() & kVerbalNarrativeFields) {
+    maneuver.set_verbal_formatter(
+        VerbalTextFormatterFactory::Create(trip_path_->GetCountryCode(node_index),
+                                           trip_path_->GetStateCode(node_index)));
+  }
 
   // Set the maneuver type
   SetManeuverType(maneuver);
@@ -1,4 +1,6 @@
 #include <stdexcept>
+#include <array>
+#include <cstring>
 
 #include <boost/property_tree/ptree.hpp>
 
@@ -36,6 +38,70 @@ std::unordered_map<K, V> as_unordered_map(
 namespace valhalla {
 namespace odin {
 
+PhraseTemplate::PhraseTemplate(const std::string& phrase)
+    : phrase_(phrase), compiled_(true) {
+  size_t literal = 0;
+  size_t open = phrase_.find('<');
+  while (open != std::string::npos) {
+    size_t close = phrase_.find('>', open);
+    if (close == std::string::npos) {
+      break;
+    }
+
+    // Only known tags become slots, anything else stays literal text
+    size_t length = close - open + 1;
+    uint8_t tag = 0;
+    for (; tag < kPhraseTagCount; ++tag) {
+      if (std::strlen(kPhraseTags[tag]) == length
+          && phrase_.compare(open, length, kPhraseTags[tag]) == 0) {
+        break;
+      }
+    }
+
+    if (tag < kPhraseTagCount) {
+      if (open > literal) {
+        segments_.push_back({static_cast<uint32_t>(literal),
+          static_cast<uint32_t>(open - literal), static_cast<uint8_t>(kPhraseTagCount)});
+      }
+      segments_.push_back({static_cast<uint32_t>(open),
+        static_cast<uint32_t>(length), tag});
+      literal = close + 1;
+      open = phrase_.find('<', literal);
+    } else {
+      open = phrase_.find('<', open + 1);
+    }
+  }
+  if (phrase_.size() > literal) {
+    segments_.push_back({static_cast<uint32_t>(literal),
+      static_cast<uint32_t>(phrase_.size() - literal), static_cast<uint8_t>(kPhraseTagCount)});
+  }
+}
+
+void PhraseTemplate::Render(std::string& instruction, Values values) const {
+  if (!compiled_) {
+    throw std::runtime_error("No phrase was loaded for this phrase id");
+  }
+
+  std::array<const std::string*, kPhraseTagCount + 1> slots{};
+  for (const auto& value : values) {
+    slots[static_cast<size_t>(value.tag)] = &value.value;
+  }
+
+  instruction.clear();
+  for (const auto& segment : segments_) {
+    const auto* value = slots[segment.tag];
+    if (value) {
+      instruction.append(*value);
+    } else {
+      instruction.append(phrase_, segment.offset, segment.length);
+    }
+  }
+}
+
+const std::string& PhraseTemplate::phrase() const {
+  return phrase_;
+}
+
 NarrativeDictionary::NarrativeDictionary(
     const std::string language_tag,
     const boost::property_tree::ptree& narrative_pt) {
@@ -330,6 +396,20 @@ void NarrativeDictionary::Load(PhraseSet& phrase_handle,
 
   phrase_handle.phrases = as_unordered_map<std::string, std::string>(
       phrase_pt, kPhrasesKey);
+
+  // Compile the phrases so the narrative builder doesn't have to search them
+  phrase_handle.templates.clear();
+  for (const auto& phrase : phrase_handle.phrases) {
+    if (phrase.first.empty()
+        || phrase.first.find_first_not_of("0123456789") != std::string::npos) {
+      throw std::runtime_error("Phrase ids must be numeric: " + phrase.first);
+    }
+    size_t id = std::stoul(phrase.first);
+    if (id >= phrase_handle.templates.size()) {
+      phrase_handle.templates.resize(id + 1);
+    }
+    phrase_handle.templates[id] = PhraseTemplate(phrase.second);
+  }
 }
 
 void NarrativeDictionary::Load(
@@ -53,6 +53,16 @@ NarrativeBuilder::NarrativeBuilder(
 void NarrativeBuilder::Build(const DirectionsOptions& directions_options,
                              const EnhancedTripPath* etp,
                              std::list<Maneuver>& maneuvers) {
+  // Only form the narrative that was requested. A verbal multi-cue uses the
+  // next maneuver's alert when it has one, so the alerts are also formed
+  // whenever the pre transition instructions are requested
+  uint32_t narrative_fields = directions_options.narrative_fields();
+  bool form_instruction = narrative_fields & DirectionsOptions::kInstruction;
+  bool form_verbal_pre = narrative_fields & DirectionsOptions::kVerbalPreTransition;
+  bool form_verbal_alert = form_verbal_pre
+      || (narrative_fields & DirectionsOptions::kVerbalTransitionAlert);
+  bool form_verbal_post = narrative_fields & DirectionsOptions::kVerbalPostTransition;
+
   Maneuver* prev_maneuver = nullptr;
   for (auto& maneuver : maneuvers) {
     switch (maneuver.type()) {
@@ -60,16 +70,20 @@ void NarrativeBuilder::Build(const DirectionsOptions& directions_options,
       case TripDirections_Maneuver_Type_kStart:
       case TripDirections_Maneuver_Type_kStartLeft: {
         // Set instruction
-        maneuver.set_instruction(std::move(FormStartInstruction(maneuver)));
+        if (form_instruction) {
+          maneuver.set_instruction(std::move(FormStartInstruction(maneuver)));
+        }
 
         // Set verbal pre transition instruction
-        maneuver.set_verbal_pre_transition_instruction(
-            std::move(
-                FormVerbalStartInstruction(maneuver)));
+        if (form_verbal_pre) {
+          maneuver.set_verbal_pre_transition_instruction(
+              std::move(
+                  FormVerbalStartInstruction(maneuver)));
+        }
 
         // Set verbal post transition instruction only if there are
         // begin street names
-        if (maneuver.HasBeginStreetNames()) {
+        if (form_verbal_post && maneuver.HasBeginStreetNames()) {
           maneuver.set_verbal_post_transition_instruction(
               std::move(
                   FormVerbalPostTransitionInstruction(
@@ -81,32 +95,44 @@ void NarrativeBuilder::Build(const DirectionsOptions& directions_options,
       case TripDirections_Maneuver_Type_kDestination:
       case TripDirections_Maneuver_Type_kDestinationLeft: {
         // Set instruction
-        maneuver.set_instruction(
-            std::move(FormDestinationInstruction(maneuver)));
+        if (form_instruction) {
+          maneuver.set_instruction(
+              std::move(FormDestinationInstruction(maneuver)));
+        }
 
         // Set verbal transition alert instruction
-        maneuver.set_verbal_transition_alert_instruction(
-            std::move(FormVerbalAlertDestinationInstruction(maneuver)));
+        if (form_verbal_alert) {
+          maneuver.set_verbal_transition_alert_instruction(
+              std::move(FormVerbalAlertDestinationInstruction(maneuver)));
+        }
 
         // Set verbal pre transition instruction
-        maneuver.set_verbal_pre_transition_instruction(
-            std::move(FormVerbalDestinationInstruction(maneuver)));
+        if (form_verbal_pre) {
+          maneuver.set_verbal_pre_transition_instruction(
+              std::move(FormVerbalDestinationInstruction(maneuver)));
+        }
         break;
       }
       case TripDirections_Maneuver_Type_kBecomes: {
         // Set instruction
-        maneuver.set_instruction(
-            std::move(FormBecomesInstruction(maneuver, prev_maneuver)));
+        if (form_instruction) {
+          maneuver.set_instruction(
+              std::move(FormBecomesInstruction(maneuver, prev_maneuver)));
+        }
 
         // Set verbal pre transition instruction
-        maneuver.set_verbal_pre_transition_instruction(
-            std::move(FormVerbalBecomesInstruction(maneuver, prev_maneuver)));
+        if (form_verbal_pre) {
+          maneuver.set_verbal_pre_transition_instruction(
+              std::move(FormVerbalBecomesInstruction(maneuver, prev_maneuver)));
+        }
 
         // Set verbal post transition instruction
-        maneuver.set_verbal_post_transition_instruction(
-            std::move(
-                FormVerbalPostTransitionInstruction(
-                    maneuver, maneuver.HasBeginStreetNames())));
+        if (form_verbal_post) {
+          maneuver.set_verbal_post_transition_instruction(
+              std::move(
+                  FormVerbalPostTransitionInstruction(
+                      maneuver, maneuver.HasBeginStreetNames())));
+        }
         break;
       }
       case TripDirections_Maneuver_Type_kSlightRight:
@@ -116,58 +142,80 @@ void NarrativeBuilder::Build(const DirectionsOptions& directions_options,
       case TripDirections_Maneuver_Type_kSharpLeft:
       case TripDirections_Maneuver_Type_kLeft: {
         // Set instruction
-        maneuver.set_instruction(
-            std::move(FormTurnInstruction(maneuver, prev_maneuver)));
+        if (form_instruction) {
+          maneuver.set_instruction(
+              std::move(FormTurnInstruction(maneuver, prev_maneuver)));
+        }
 
         // Set verbal transition alert instruction
-        maneuver.set_verbal_transition_alert_instruction(
-            std::move(FormVerbalAlertTurnInstruction(maneuver, prev_maneuver)));
+        if (form_verbal_alert) {
+          maneuver.set_verbal_transition_alert_instruction(
+              std::move(FormVerbalAlertTurnInstruction(maneuver, prev_maneuver)));
+        }
 
         // Set verbal pre transition instruction
-        maneuver.set_verbal_pre_transition_instruction(
-            std::move(FormVerbalTurnInstruction(maneuver, prev_maneuver)));
+        if (form_verbal_pre) {
+          maneuver.set_verbal_pre_transition_instruction(
+              std::move(FormVerbalTurnInstruction(maneuver, prev_maneuver)));
+        }
 
         // Set verbal post transition instruction
-        maneuver.set_verbal_post_transition_instruction(
-            std::move(
-                FormVerbalPostTransitionInstruction(
-                    maneuver, maneuver.HasBeginStreetNames())));
+        if (form_verbal_post) {
+          maneuver.set_verbal_post_transition_instruction(
+              std::move(
+                  FormVerbalPostTransitionInstruction(
+                      maneuver, maneuver.HasBeginStreetNames())));
+        }
         break;
       }
       case TripDirections_Maneuver_Type_kUturnRight:
       case TripDirections_Maneuver_Type_kUturnLeft: {
         // Set instruction
-        maneuver.set_instruction(
-            std::move(FormUturnInstruction(maneuver, prev_maneuver)));
+        if (form_instruction) {
+          maneuver.set_instruction(
+              std::move(FormUturnInstruction(maneuver, prev_maneuver)));
+        }
 
         // Set verbal transition alert instruction
-        maneuver.set_verbal_transition_alert_instruction(
-            std::move(FormVerbalAlertUturnInstruction(maneuver, prev_maneuver)));
+        if (form_verbal_alert) {
+          maneuver.set_verbal_transition_alert_instruction(
+              std::move(FormVerbalAlertUturnInstruction(maneuver, prev_maneuver)));
+        }
 
         // Set verbal pre transition instruction
-        maneuver.set_verbal_pre_transition_instruction(
-            std::move(FormVerbalUturnInstruction(maneuver, prev_maneuver)));
+        if (form_verbal_pre) {
+          maneuver.set_verbal_pre_transition_instruction(
+              std::move(FormVerbalUturnInstruction(maneuver, prev_maneuver)));
+        }
 
         // Set verbal post transition instruction
-        maneuver.set_verbal_post_transition_instruction(
-            std::move(FormVerbalPostTransitionInstruction(maneuver)));
+        if (form_verbal_post) {
+          maneuver.set_verbal_post_transition_instruction(
+              std::move(FormVerbalPostTransitionInstruction(maneuver)));
+        }
         break;
       }
       case TripDirections_Maneuver_Type_kRampStraight: {
         // Set instruction
-        maneuver.set_instruction(
-            std::move(FormRampStraightInstruction(maneuver)));
+        if (form_instruction) {
+          maneuver.set_instruction(
+              std::move(FormRampStraightInstruction(maneuver)));
+        }
 
         // Set verbal transition alert instruction
-        maneuver.set_verbal_transition_alert_instruction(
-            std::move(FormVerbalAlertRampStraightInstruction(maneuver)));
+        if (form_verbal_alert) {
+          maneuver.set_verbal_transition_alert_instruction(
+              std::move(FormVerbalAlertRampStraightInstruction(maneuver)));
+        }
 
         // Set verbal pre transition instruction
-        maneuver.set_verbal_pre_transition_instruction(
-            std::move(FormVerbalRampStraightInstruction(maneuver)));
+        if (form_verbal_pre) {
+          maneuver.set_verbal_pre_transition_instruction(
+              std::move(FormVerbalRampStraightInstruction(maneuver)));
+        }
 
         // Only set verbal post if > min ramp length
-        if (maneuver.length() > kVerbalPostMinimumRampLength) {
+        if (form_verbal_post && maneuver.length() > kVerbalPostMinimumRampLength) {
           // Set verbal post transition instruction
           maneuver.set_verbal_post_transition_instruction(
               std::move(FormVerbalPostTransitionInstruction(maneuver)));
@@ -177,18 +225,24 @@ void NarrativeBuilder::Build(const DirectionsOptions& directions_options,
       case TripDirections_Maneuver_Type_kRampRight:
       case TripDirections_Maneuver_Type_kRampLeft: {
         // Set instruction
-        maneuver.set_instruction(std::move(FormRampInstruction(maneuver)));
+        if (form_instruction) {
+          maneuver.set_instruction(std::move(FormRampInstruction(maneuver)));
+        }
 
         // Set verbal transition alert instruction
-        maneuver.set_verbal_transition_alert_instruction(
-            std::move(FormVerbalAlertRampInstruction(maneuver)));
+        if (form_verbal_alert) {
+          maneuver.set_verbal_transition_alert_instruction(
+              std::move(FormVerbalAlertRampInstruction(maneuver)));
+        }
 
         // Set verbal pre transition instruction
-        maneuver.set_verbal_pre_transition_instruction(
-            std::move(FormVerbalRampInstruction(maneuver)));
+        if (form_verbal_pre) {
+          maneuver.set_verbal_pre_transition_instruction(
+              std::move(FormVerbalRampInstruction(maneuver)));
+        }
 
         // Only set verbal post if > min ramp length
-        if (maneuver.length() > kVerbalPostMinimumRampLength) {
+        if (form_verbal_post && maneuver.length() > kVerbalPostMinimumRampLength) {
           // Set verbal post transition instruction
           maneuver.set_verbal_post_transition_instruction(
               std::move(FormVerbalPostTransitionInstruction(maneuver)));
@@ -198,18 +252,24 @@ void NarrativeBuilder::Build(const DirectionsOptions& directions_options,
       case TripDirections_Maneuver_Type_kExitRight:
       case TripDirections_Maneuver_Type_kExitLeft: {
         // Set instruction
-        maneuver.set_instruction(std::move(FormExitInstruction(maneuver)));
+        if (form_instruction) {
+          maneuver.set_instruction(std::move(FormExitInstruction(maneuver)));
+        }
 
         // Set verbal transition alert instruction
-        maneuver.set_verbal_transition_alert_instruction(
-            std::move(FormVerbalAlertExitInstruction(maneuver)));
+        if (form_verbal_alert) {
+          maneuver.set_verbal_transition_alert_instruction(
+              std::move(FormVerbalAlertExitInstruction(maneuver)));
+        }
 
         // Set verbal pre transition instruction
-        maneuver.set_verbal_pre_transition_instruction(
-            std::move(FormVerbalExitInstruction(maneuver)));
+        if (form_verbal_pre) {
+          maneuver.set_verbal_pre_transition_instruction(
+              std::move(FormVerbalExitInstruction(maneuver)));
+        }
 
         // Only set verbal post if > min ramp length
-        if (maneuver.length() > kVerbalPostMinimumRampLength) {
+        if (form_verbal_post && maneuver.length() > kVerbalPostMinimumRampLength) {
           // Set verbal post transition instruction
           maneuver.set_verbal_post_transition_instruction(
               std::move(FormVerbalPostTransitionInstruction(maneuver)));
@@ -221,37 +281,49 @@ void NarrativeBuilder::Build(const DirectionsOptions& directions_options,
       case TripDirections_Maneuver_Type_kStayLeft: {
         if (maneuver.HasSimilarNames(prev_maneuver)) {
           // Set stay on instruction
-          maneuver.set_instruction(
-              std::move(FormKeepToStayOnInstruction(maneuver)));
+          if (form_instruction) {
+            maneuver.set_instruction(
+                std::move(FormKeepToStayOnInstruction(maneuver)));
+          }
 
           // Set verbal transition alert instruction
-          maneuver.set_verbal_transition_alert_instruction(
-              std::move(FormVerbalAlertKeepToStayOnInstruction(maneuver)));
+          if (form_verbal_alert) {
+            maneuver.set_verbal_transition_alert_instruction(
+                std::move(FormVerbalAlertKeepToStayOnInstruction(maneuver)));
+          }
 
           // Set verbal pre transition instruction
-          maneuver.set_verbal_pre_transition_instruction(
-              std::move(FormVerbalKeepToStayOnInstruction(maneuver)));
+          if (form_verbal_pre) {
+            maneuver.set_verbal_pre_transition_instruction(
+                std::move(FormVerbalKeepToStayOnInstruction(maneuver)));
+          }
 
           // Only set verbal post if > min ramp length
-          if (maneuver.length() > kVerbalPostMinimumRampLength) {
+          if (form_verbal_post && maneuver.length() > kVerbalPostMinimumRampLength) {
             // Set verbal post transition instruction
             maneuver.set_verbal_post_transition_instruction(
                 std::move(FormVerbalPostTransitionInstruction(maneuver)));
           }
         } else {
           // Set instruction
-          maneuver.set_instruction(std::move(FormKeepInstruction(maneuver)));
+          if (form_instruction) {
+            maneuver.set_instruction(std::move(FormKeepInstruction(maneuver)));
+          }
 
           // Set verbal transition alert instruction
-          maneuver.set_verbal_transition_alert_instruction(
-              std::move(FormVerbalAlertKeepInstruction(maneuver)));
+          if (form_verbal_alert) {
+            maneuver.set_verbal_transition_alert_instruction(
+                std::move(FormVerbalAlertKeepInstruction(maneuver)));
+          }
 
           // Set verbal pre transition instruction
-          maneuver.set_verbal_pre_transition_instruction(
-              std::move(FormVerbalKeepInstruction(maneuver)));
+          if (form_verbal_pre) {
+            maneuver.set_verbal_pre_transition_instruction(
+                std::move(FormVerbalKeepInstruction(maneuver)));
+          }
 
           // Only set verbal post if > min ramp length
-          if (maneuver.length() > kVerbalPostMinimumRampLength) {
+          if (form_verbal_post && maneuver.length() > kVerbalPostMinimumRampLength) {
             // Set verbal post transition instruction
             maneuver.set_verbal_post_transition_instruction(
                 std::move(FormVerbalPostTransitionInstruction(maneuver)));
@@ -261,11 +333,13 @@ void NarrativeBuilder::Build(const DirectionsOptions& directions_options,
       }
       case TripDirections_Maneuver_Type_kMerge: {
         // Set instruction
-        maneuver.set_instruction(std::move(FormMergeInstruction(maneuver)));
+        if (form_instruction) {
+          maneuver.set_instruction(std::move(FormMergeInstruction(maneuver)));
+        }
 
         // Set verbal transition alert instruction if previous maneuver
         // is greater than 2 km
-        if (prev_maneuver
+        if (form_verbal_alert && prev_maneuver
             && (prev_maneuver->length(DirectionsOptions_Units_kKilometers)
                 > kVerbalAlertMergePriorManeuverMinimumLength)) {
           maneuver.set_verbal_transition_alert_instruction(
@@ -273,247 +347,351 @@ void NarrativeBuilder::Build(const DirectionsOptions& directions_options,
         }
 
         // Set verbal pre transition instruction
-        maneuver.set_verbal_pre_transition_instruction(
-            std::move(FormVerbalMergeInstruction(maneuver)));
+        if (form_verbal_pre) {
+          maneuver.set_verbal_pre_transition_instruction(
+              std::move(FormVerbalMergeInstruction(maneuver)));
+        }
 
         // Set verbal post transition instruction
-        maneuver.set_verbal_post_transition_instruction(
-            std::move(FormVerbalPostTransitionInstruction(maneuver)));
+        if (form_verbal_post) {
+          maneuver.set_verbal_post_transition_instruction(
+              std::move(FormVerbalPostTransitionInstruction(maneuver)));
+        }
         break;
       }
       case TripDirections_Maneuver_Type_kRoundaboutEnter: {
         // Set instruction
-        maneuver.set_instruction(
-            std::move(FormEnterRoundaboutInstruction(maneuver)));
+        if (form_instruction) {
+          maneuver.set_instruction(
+              std::move(FormEnterRoundaboutInstruction(maneuver)));
+        }
 
         // Set verbal transition alert instruction
-        maneuver.set_verbal_transition_alert_instruction(
-            std::move(FormVerbalAlertEnterRoundaboutInstruction(maneuver)));
+        if (form_verbal_alert) {
+          maneuver.set_verbal_transition_alert_instruction(
+              std::move(FormVerbalAlertEnterRoundaboutInstruction(maneuver)));
+        }
 
         // Set verbal pre transition instruction
-        maneuver.set_verbal_pre_transition_instruction(
-            std::move(FormVerbalEnterRoundaboutInstruction(maneuver)));
+        if (form_verbal_pre) {
+          maneuver.set_verbal_pre_transition_instruction(
+              std::move(FormVerbalEnterRoundaboutInstruction(maneuver)));
+        }
         break;
       }
       case TripDirections_Maneuver_Type_kRoundaboutExit: {
         // Set instruction
-        maneuver.set_instruction(
-            std::move(FormExitRoundaboutInstruction(maneuver)));
+        if (form_instruction) {
+          maneuver.set_instruction(
+              std::move(FormExitRoundaboutInstruction(maneuver)));
+        }
 
         // Set verbal pre transition instruction
-        maneuver.set_verbal_pre_transition_instruction(
-            std::move(FormVerbalExitRoundaboutInstruction(maneuver)));
+        if (form_verbal_pre) {
+          maneuver.set_verbal_pre_transition_instruction(
+              std::move(FormVerbalExitRoundaboutInstruction(maneuver)));
+        }
 
         // Set verbal post transition instruction
-        maneuver.set_verbal_post_transition_instruction(
-            std::move(
-                FormVerbalPostTransitionInstruction(
-                    maneuver, maneuver.HasBeginStreetNames())));
+        if (form_verbal_post) {
+          maneuver.set_verbal_post_transition_instruction(
+              std::move(
+                  FormVerbalPostTransitionInstruction(
+                      maneuver, maneuver.HasBeginStreetNames())));
+        }
         break;
       }
       case TripDirections_Maneuver_Type_kFerryEnter: {
         // Set instruction
-        maneuver.set_instruction(
-            std::move(FormEnterFerryInstruction(maneuver)));
+        if (form_instruction) {
+          maneuver.set_instruction(
+              std::move(FormEnterFerryInstruction(maneuver)));
+        }
 
         // Set verbal transition alert instruction
-        maneuver.set_verbal_transition_alert_instruction(
-            std::move(FormVerbalAlertEnterFerryInstruction(maneuver)));
+        if (form_verbal_alert) {
+          maneuver.set_verbal_transition_alert_instruction(
+              std::move(FormVerbalAlertEnterFerryInstruction(maneuver)));
+        }
 
         // Set verbal pre transition instruction
-        maneuver.set_verbal_pre_transition_instruction(
-            std::move(FormVerbalEnterFerryInstruction(maneuver)));
+        if (form_verbal_pre) {
+          maneuver.set_verbal_pre_transition_instruction(
+              std::move(FormVerbalEnterFerryInstruction(maneuver)));
+        }
 
         // Set verbal post transition instruction
-        maneuver.set_verbal_post_transition_instruction(
-            std::move(FormVerbalPostTransitionInstruction(maneuver)));
+        if (form_verbal_post) {
+          maneuver.set_verbal_post_transition_instruction(
+              std::move(FormVerbalPostTransitionInstruction(maneuver)));
+        }
         break;
       }
       case TripDirections_Maneuver_Type_kFerryExit: {
         // Set instruction
-        maneuver.set_instruction(std::move(FormExitFerryInstruction(maneuver)));
+        if (form_instruction) {
+          maneuver.set_instruction(std::move(FormExitFerryInstruction(maneuver)));
+        }
 
         // Set verbal transition alert instruction
-        maneuver.set_verbal_transition_alert_instruction(
-            std::move(FormVerbalAlertExitFerryInstruction(maneuver)));
+        if (form_verbal_alert) {
+          maneuver.set_verbal_transition_alert_instruction(
+              std::move(FormVerbalAlertExitFerryInstruction(maneuver)));
+        }
 
         // Set verbal pre transition instruction
-        maneuver.set_verbal_pre_transition_instruction(
-            std::move(FormVerbalExitFerryInstruction(maneuver)));
+        if (form_verbal_pre) {
+          maneuver.set_verbal_pre_transition_instruction(
+              std::move(FormVerbalExitFerryInstruction(maneuver)));
+        }
 
         // Set verbal post transition instruction
-        maneuver.set_verbal_post_transition_instruction(
-            std::move(
-                FormVerbalPostTransitionInstruction(
-                    maneuver, maneuver.HasBeginStreetNames())));
+        if (form_verbal_post) {
+          maneuver.set_verbal_post_transition_instruction(
+              std::move(
+                  FormVerbalPostTransitionInstruction(
+                      maneuver, maneuver.HasBeginStreetNames())));
+        }
         break;
       }
       case TripDirections_Maneuver_Type_kTransitConnectionStart: {
         // Set instruction
-        maneuver.set_instruction(
-            std::move(FormTransitConnectionStartInstruction(maneuver)));
+        if (form_instruction) {
+          maneuver.set_instruction(
+              std::move(FormTransitConnectionStartInstruction(maneuver)));
+        }
 
         // Set verbal pre transition instruction
-        maneuver.set_verbal_pre_transition_instruction(
-            std::move(FormVerbalTransitConnectionStartInstruction(maneuver)));
+        if (form_verbal_pre) {
+          maneuver.set_verbal_pre_transition_instruction(
+              std::move(FormVerbalTransitConnectionStartInstruction(maneuver)));
+        }
 
         // Set verbal post transition instruction
-        maneuver.set_verbal_post_transition_instruction(
-            std::move(FormVerbalPostTransitionInstruction(maneuver)));
+        if (form_verbal_post) {
+          maneuver.set_verbal_post_transition_instruction(
+              std::move(FormVerbalPostTransitionInstruction(maneuver)));
+        }
         break;
       }
       case TripDirections_Maneuver_Type_kTransitConnectionTransfer: {
         // Set instruction
-        maneuver.set_instruction(
-            std::move(FormTransitConnectionTransferInstruction(maneuver)));
+        if (form_instruction) {
+          maneuver.set_instruction(
+              std::move(FormTransitConnectionTransferInstruction(maneuver)));
+        }
 
         // Set verbal pre transition instruction
-        maneuver.set_verbal_pre_transition_instruction(
-            std::move(
-                FormVerbalTransitConnectionTransferInstruction(maneuver)));
+        if (form_verbal_pre) {
+          maneuver.set_verbal_pre_transition_instruction(
+              std::move(
+                  FormVerbalTransitConnectionTransferInstruction(maneuver)));
+        }
 
         // Set verbal post transition instruction
-        maneuver.set_verbal_post_transition_instruction(
-            std::move(FormVerbalPostTransitionInstruction(maneuver)));
+        if (form_verbal_post) {
+          maneuver.set_verbal_post_transition_instruction(
+              std::move(FormVerbalPostTransitionInstruction(maneuver)));
+        }
         break;
       }
       case TripDirections_Maneuver_Type_kTransitConnectionDestination: {
         // Set instruction
-        maneuver.set_instruction(
-            std::move(FormTransitConnectionDestinationInstruction(maneuver)));
+        if (form_instruction) {
+          maneuver.set_instruction(
+              std::move(FormTransitConnectionDestinationInstruction(maneuver)));
+        }
 
         // Set verbal pre transition instruction
-        maneuver.set_verbal_pre_transition_instruction(
-            std::move(
-                FormVerbalTransitConnectionDestinationInstruction(maneuver)));
+        if (form_verbal_pre) {
+          maneuver.set_verbal_pre_transition_instruction(
+              std::move(
+                  FormVerbalTransitConnectionDestinationInstruction(maneuver)));
+        }
 
         // Set verbal post transition instruction
-        maneuver.set_verbal_post_transition_instruction(
-            std::move(FormVerbalPostTransitionInstruction(maneuver)));
+        if (form_verbal_post) {
+          maneuver.set_verbal_post_transition_instruction(
+              std::move(FormVerbalPostTransitionInstruction(maneuver)));
+        }
         break;
       }
       case TripDirections_Maneuver_Type_kTransit: {
         // Set depart instruction
-        maneuver.set_depart_instruction(
-            std::move(FormDepartInstruction(maneuver)));
+        if (form_instruction) {
+          maneuver.set_depart_instruction(
+              std::move(FormDepartInstruction(maneuver)));
+        }
 
         // Set verbal depart instruction
-        maneuver.set_verbal_depart_instruction(
-            std::move(FormVerbalDepartInstruction(maneuver)));
+        if (form_verbal_pre) {
+          maneuver.set_verbal_depart_instruction(
+              std::move(FormVerbalDepartInstruction(maneuver)));
+        }
 
         // Set instruction
-        maneuver.set_instruction(std::move(FormTransitInstruction(maneuver)));
+        if (form_instruction) {
+          maneuver.set_instruction(std::move(FormTransitInstruction(maneuver)));
+        }
 
         // Set verbal pre transition instruction
-        maneuver.set_verbal_pre_transition_instruction(
-            std::move(FormVerbalTransitInstruction(maneuver)));
+        if (form_verbal_pre) {
+          maneuver.set_verbal_pre_transition_instruction(
+              std::move(FormVerbalTransitInstruction(maneuver)));
+        }
 
         // Set verbal post transition instruction
-        maneuver.set_verbal_post_transition_instruction(
-            std::move(FormVerbalPostTransitionTransitInstruction(maneuver)));
+        if (form_verbal_post) {
+          maneuver.set_verbal_post_transition_instruction(
+              std::move(FormVerbalPostTransitionTransitInstruction(maneuver)));
+        }
 
         // Set arrive instruction
-        maneuver.set_arrive_instruction(
-            std::move(FormArriveInstruction(maneuver)));
+        if (form_instruction) {
+          maneuver.set_arrive_instruction(
+              std::move(FormArriveInstruction(maneuver)));
+        }
 
         // Set verbal arrive instruction
-        maneuver.set_verbal_arrive_instruction(
-            std::move(FormVerbalArriveInstruction(maneuver)));
+        if (form_verbal_pre) {
+          maneuver.set_verbal_arrive_instruction(
+              std::move(FormVerbalArriveInstruction(maneuver)));
+        }
 
         break;
       }
       case TripDirections_Maneuver_Type_kTransitRemainOn: {
         // Set depart instruction
-        maneuver.set_depart_instruction(
-            std::move(FormDepartInstruction(maneuver)));
+        if (form_instruction) {
+          maneuver.set_depart_instruction(
+              std::move(FormDepartInstruction(maneuver)));
+        }
 
         // Set verbal depart instruction
-        maneuver.set_verbal_depart_instruction(
-            std::move(FormVerbalDepartInstruction(maneuver)));
+        if (form_verbal_pre) {
+          maneuver.set_verbal_depart_instruction(
+              std::move(FormVerbalDepartInstruction(maneuver)));
+        }
 
         // Set instruction
-        maneuver.set_instruction(
-            std::move(FormTransitRemainOnInstruction(maneuver)));
+        if (form_instruction) {
+          maneuver.set_instruction(
+              std::move(FormTransitRemainOnInstruction(maneuver)));
+        }
 
         // Set verbal pre transition instruction
-        maneuver.set_verbal_pre_transition_instruction(
-            std::move(FormVerbalTransitRemainOnInstruction(maneuver)));
+        if (form_verbal_pre) {
+          maneuver.set_verbal_pre_transition_instruction(
+              std::move(FormVerbalTransitRemainOnInstruction(maneuver)));
+        }
 
         // Set verbal post transition instruction
-        maneuver.set_verbal_post_transition_instruction(
-            std::move(FormVerbalPostTransitionTransitInstruction(maneuver)));
+        if (form_verbal_post) {
+          maneuver.set_verbal_post_transition_instruction(
+              std::move(FormVerbalPostTransitionTransitInstruction(maneuver)));
+        }
 
         // Set arrive instruction
-        maneuver.set_arrive_instruction(
-            std::move(FormArriveInstruction(maneuver)));
+        if (form_instruction) {
+          maneuver.set_arrive_instruction(
+              std::move(FormArriveInstruction(maneuver)));
+        }
 
         // Set verbal arrive instruction
-        maneuver.set_verbal_arrive_instruction(
-            std::move(FormVerbalArriveInstruction(maneuver)));
+        if (form_verbal_pre) {
+          maneuver.set_verbal_arrive_instruction(
+              std::move(FormVerbalArriveInstruction(maneuver)));
+        }
 
         break;
       }
       case TripDirections_Maneuver_Type_kTransitTransfer: {
         // Set depart instruction
-        maneuver.set_depart_instruction(
-            std::move(FormDepartInstruction(maneuver)));
+        if (form_instruction) {
+          maneuver.set_depart_instruction(
+              std::move(FormDepartInstruction(maneuver)));
+        }
 
         // Set verbal depart instruction
-        maneuver.set_verbal_depart_instruction(
-            std::move(FormVerbalDepartInstruction(maneuver)));
+        if (form_verbal_pre) {
+          maneuver.set_verbal_depart_instruction(
+              std::move(FormVerbalDepartInstruction(maneuver)));
+        }
 
         // Set instruction
-        maneuver.set_instruction(
-            std::move(FormTransitTransferInstruction(maneuver)));
+        if (form_instruction) {
+          maneuver.set_instruction(
+              std::move(FormTransitTransferInstruction(maneuver)));
+        }
 
         // Set verbal pre transition instruction
-        maneuver.set_verbal_pre_transition_instruction(
-            std::move(FormVerbalTransitTransferInstruction(maneuver)));
+        if (form_verbal_pre) {
+          maneuver.set_verbal_pre_transition_instruction(
+              std::move(FormVerbalTransitTransferInstruction(maneuver)));
+        }
 
         // Set verbal post transition instruction
-        maneuver.set_verbal_post_transition_instruction(
-            std::move(FormVerbalPostTransitionTransitInstruction(maneuver)));
+        if (form_verbal_post) {
+          maneuver.set_verbal_post_transition_instruction(
+              std::move(FormVerbalPostTransitionTransitInstruction(maneuver)));
+        }
 
         // Set arrive instruction
-        maneuver.set_arrive_instruction(
-            std::move(FormArriveInstruction(maneuver)));
+        if (form_instruction) {
+          maneuver.set_arrive_instruction(
+              std::move(FormArriveInstruction(maneuver)));
+        }
 
         // Set verbal arrive instruction
-        maneuver.set_verbal_arrive_instruction(
-            std::move(FormVerbalArriveInstruction(maneuver)));
+        if (form_verbal_pre) {
+          maneuver.set_verbal_arrive_instruction(
+              std::move(FormVerbalArriveInstruction(maneuver)));
+        }
         break;
       }
       case TripDirections_Maneuver_Type_kPostTransitConnectionDestination: {
         // Set instruction
-        maneuver.set_instruction(
-            std::move(
-                FormPostTransitConnectionDestinationInstruction(maneuver)));
+        if (form_instruction) {
+          maneuver.set_instruction(
+              std::move(
+                  FormPostTransitConnectionDestinationInstruction(maneuver)));
+        }
 
         // Set verbal pre transition instruction
-        maneuver.set_verbal_pre_transition_instruction(
-            std::move(
-                FormVerbalPostTransitConnectionDestinationInstruction(
-                    maneuver)));
+        if (form_verbal_pre) {
+          maneuver.set_verbal_pre_transition_instruction(
+              std::move(
+                  FormVerbalPostTransitConnectionDestinationInstruction(
+                      maneuver)));
+        }
 
         // Set verbal post transition instruction
-        maneuver.set_verbal_post_transition_instruction(
-            std::move(FormVerbalPostTransitionInstruction(maneuver)));
+        if (form_verbal_post) {
+          maneuver.set_verbal_post_transition_instruction(
+              std::move(FormVerbalPostTransitionInstruction(maneuver)));
+        }
         break;
       }
       case TripDirections_Maneuver_Type_kContinue:
       default: {
         // Set instruction
-        maneuver.set_instruction(std::move(FormContinueInstruction(maneuver)));
+        if (form_instruction) {
+          maneuver.set_instruction(std::move(FormContinueInstruction(maneuver)));
+        }
 
         // Set verbal transition alert instruction
-        maneuver.set_verbal_transition_alert_instruction(
-            std::move(FormVerbalAlertContinueInstruction(maneuver)));
+        if (form_verbal_alert) {
+          maneuver.set_verbal_transition_alert_instruction(
+              std::move(FormVerbalAlertContinueInstruction(maneuver)));
+        }
 
         // Set verbal pre transition instruction
-        maneuver.set_verbal_pre_transition_instruction(
-            std::move(
-                FormVerbalContinueInstruction(maneuver,
-                                              directions_options.units())));
+        if (form_verbal_pre) {
+          maneuver.set_verbal_pre_transition_instruction(
+              std::move(
+                  FormVerbalContinueInstruction(maneuver,
+                                                directions_options.units())));
+        }
 
         // NOTE: No verbal post transition instruction
         break;
@@ -526,7 +704,9 @@ void NarrativeBuilder::Build(const DirectionsOptions& directions_options,
   }
 
   // Iterate over maneuvers to form verbal multi-cue instructions
-  FormVerbalMultiCue(maneuvers);
+  if (form_verbal_pre) {
+    FormVerbalMultiCue(maneuvers);
+  }
 
 }
 
@@ -576,13 +756,11 @@ std::string NarrativeBuilder::FormStartInstruction(Maneuver& maneuver) {
     phrase_id += 16;
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.start_subset.phrases.at(std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kCardinalDirectionTag, cardinal_direction);
-  boost::replace_all(instruction, kStreetNamesTag, street_names);
-  boost::replace_all(instruction, kBeginStreetNamesTag, begin_street_names);
+  // Set instruction to the determined tagged phrase with its tags replaced
+  dictionary_.start_subset.templates.at(phrase_id).Render(instruction, {
+      {PhraseTag::kCardinalDirection, cardinal_direction},
+      {PhraseTag::kStreetNames, street_names},
+      {PhraseTag::kBeginStreetNames, begin_street_names}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -634,17 +812,14 @@ std::string NarrativeBuilder::FormVerbalStartInstruction(
     phrase_id += 16;
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.start_verbal_subset.phrases.at(
-      std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kCardinalDirectionTag, cardinal_direction);
-  boost::replace_all(instruction, kStreetNamesTag, street_names);
-  boost::replace_all(instruction, kBeginStreetNamesTag, begin_street_names);
-  boost::replace_all(instruction, kLengthTag,
-      FormLength(maneuver, dictionary_.start_verbal_subset.metric_lengths,
-                 dictionary_.start_verbal_subset.us_customary_lengths));
+  // Set instruction to the determined tagged phrase with its tags replaced
+  dictionary_.start_verbal_subset.templates.at(phrase_id).Render(instruction, {
+      {PhraseTag::kCardinalDirection, cardinal_direction},
+      {PhraseTag::kStreetNames, street_names},
+      {PhraseTag::kBeginStreetNames, begin_street_names},
+      {PhraseTag::kLength, FormLength(maneuver,
+          dictionary_.start_verbal_subset.metric_lengths,
+          dictionary_.start_verbal_subset.us_customary_lengths)}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -688,15 +863,10 @@ std::string NarrativeBuilder::FormDestinationInstruction(Maneuver& maneuver) {
     relative_direction = dictionary_.destination_subset.relative_directions.at(1);
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.destination_subset.phrases.at(
-      std::to_string(phrase_id));
-
-  if (phrase_id > 0) {
-    // Replace phrase tags with values
-    boost::replace_all(instruction, kRelativeDirectionTag, relative_direction);
-    boost::replace_all(instruction, kDestinationTag, destination);
-  }
+  // Set instruction to the determined tagged phrase with its tags replaced
+  dictionary_.destination_subset.templates.at(phrase_id).Render(instruction, {
+      {PhraseTag::kRelativeDirection, relative_direction},
+      {PhraseTag::kDestination, destination}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -745,15 +915,10 @@ std::string NarrativeBuilder::FormVerbalAlertDestinationInstruction(
     relative_direction = dictionary_.destination_subset.relative_directions.at(1);
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.destination_verbal_alert_subset.phrases.at(
-      std::to_string(phrase_id));
-
-  if (phrase_id > 0) {
-    // Replace phrase tags with values
-    boost::replace_all(instruction, kRelativeDirectionTag, relative_direction);
-    boost::replace_all(instruction, kDestinationTag, destination);
-  }
+  // Set instruction to the determined tagged phrase with its tags replaced
+  dictionary_.destination_verbal_alert_subset.templates.at(phrase_id).Render(instruction, {
+      {PhraseTag::kRelativeDirection, relative_direction},
+      {PhraseTag::kDestination, destination}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -802,15 +967,10 @@ std::string NarrativeBuilder::FormVerbalDestinationInstruction(
     relative_direction = dictionary_.destination_subset.relative_directions.at(1);
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.destination_verbal_subset.phrases.at(
-      std::to_string(phrase_id));
-
-  if (phrase_id > 0) {
-    // Replace phrase tags with values
-    boost::replace_all(instruction, kRelativeDirectionTag, relative_direction);
-    boost::replace_all(instruction, kDestinationTag, destination);
-  }
+  // Set instruction to the determined tagged phrase with its tags replaced
+  dictionary_.destination_verbal_subset.templates.at(phrase_id).Render(instruction, {
+      {PhraseTag::kRelativeDirection, relative_direction},
+      {PhraseTag::kDestination, destination}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -835,12 +995,10 @@ std::string NarrativeBuilder::FormBecomesInstruction(Maneuver& maneuver,
   // Determine which phrase to use
   uint8_t phrase_id = 0;
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.becomes_subset.phrases.at(std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kPreviousStreetNamesTag, prev_street_names);
-  boost::replace_all(instruction, kStreetNamesTag, street_names);
+  // Set instruction to the determined tagged phrase with its tags replaced
+  dictionary_.becomes_subset.templates.at(phrase_id).Render(instruction, {
+      {PhraseTag::kPreviousStreetNames, prev_street_names},
+      {PhraseTag::kStreetNames, street_names}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -871,12 +1029,10 @@ std::string NarrativeBuilder::FormVerbalBecomesInstruction(
   // Determine which phrase to use
   uint8_t phrase_id = 0;
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.becomes_verbal_subset.phrases.at(std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kPreviousStreetNamesTag, prev_street_names);
-  boost::replace_all(instruction, kStreetNamesTag, street_names);
+  // Set instruction to the determined tagged phrase with its tags replaced
+  dictionary_.becomes_verbal_subset.templates.at(phrase_id).Render(instruction, {
+      {PhraseTag::kPreviousStreetNames, prev_street_names},
+      {PhraseTag::kStreetNames, street_names}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -905,12 +1061,9 @@ std::string NarrativeBuilder::FormContinueInstruction(Maneuver& maneuver) {
     phrase_id = 1;
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.continue_subset.phrases.at(
-      std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kStreetNamesTag, street_names);
+  // Set instruction to the determined tagged phrase with its tags replaced
+  dictionary_.continue_subset.templates.at(phrase_id).Render(instruction, {
+      {PhraseTag::kStreetNames, street_names}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -940,12 +1093,9 @@ std::string NarrativeBuilder::FormVerbalAlertContinueInstruction(
     phrase_id = 1;
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.continue_verbal_alert_subset.phrases.at(
-      std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kStreetNamesTag, street_names);
+  // Set instruction to the determined tagged phrase with its tags replaced
+  dictionary_.continue_verbal_alert_subset.templates.at(phrase_id).Render(instruction, {
+      {PhraseTag::kStreetNames, street_names}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -976,15 +1126,12 @@ std::string NarrativeBuilder::FormVerbalContinueInstruction(
     phrase_id = 1;
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.continue_verbal_subset.phrases.at(
-      std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kLengthTag,
-      FormLength(maneuver, dictionary_.continue_verbal_subset.metric_lengths,
-                 dictionary_.continue_verbal_subset.us_customary_lengths));
-  boost::replace_all(instruction, kStreetNamesTag, street_names);
+  // Set instruction to the determined tagged phrase with its tags replaced
+  dictionary_.continue_verbal_subset.templates.at(phrase_id).Render(instruction, {
+      {PhraseTag::kLength, FormLength(maneuver,
+          dictionary_.continue_verbal_subset.metric_lengths,
+          dictionary_.continue_verbal_subset.us_customary_lengths)},
+      {PhraseTag::kStreetNames, street_names}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -1043,14 +1190,12 @@ std::string NarrativeBuilder::FormTurnInstruction(Maneuver& maneuver,
     phrase_id = 3;
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction = subset->phrases.at(std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kRelativeDirectionTag,
-      FormRelativeTwoDirection(maneuver.type(), subset->relative_directions));
-  boost::replace_all(instruction, kStreetNamesTag, street_names);
-  boost::replace_all(instruction, kBeginStreetNamesTag, begin_street_names);
+  // Set instruction to the determined tagged phrase with its tags replaced
+  subset->templates.at(phrase_id).Render(instruction, {
+      {PhraseTag::kRelativeDirection, FormRelativeTwoDirection(maneuver.type(),
+          subset->relative_directions)},
+      {PhraseTag::kStreetNames, street_names},
+      {PhraseTag::kBeginStreetNames, begin_street_names}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -1127,15 +1272,12 @@ std::string NarrativeBuilder::FormVerbalTurnInstruction(
     phrase_id = 3;
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction = subset->phrases.at(std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kRelativeDirectionTag,
-      FormRelativeTwoDirection(
-          maneuver.type(), subset->relative_directions));
-  boost::replace_all(instruction, kStreetNamesTag, street_names);
-  boost::replace_all(instruction, kBeginStreetNamesTag, begin_street_names);
+  // Set instruction to the determined tagged phrase with its tags replaced
+  subset->templates.at(phrase_id).Render(instruction, {
+      {PhraseTag::kRelativeDirection, FormRelativeTwoDirection(maneuver.type(),
+          subset->relative_directions)},
+      {PhraseTag::kStreetNames, street_names},
+      {PhraseTag::kBeginStreetNames, begin_street_names}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -1178,15 +1320,12 @@ std::string NarrativeBuilder::FormUturnInstruction(Maneuver& maneuver,
     phrase_id += 3;
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.uturn_subset.phrases.at(std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kRelativeDirectionTag,
-      FormRelativeTwoDirection(maneuver.type(),
-                               dictionary_.uturn_subset.relative_directions));
-  boost::replace_all(instruction, kStreetNamesTag, street_names);
-  boost::replace_all(instruction, kCrossStreetNamesTag, cross_street_names);
+  // Set instruction to the determined tagged phrase with its tags replaced
+  dictionary_.uturn_subset.templates.at(phrase_id).Render(instruction, {
+      {PhraseTag::kRelativeDirection, FormRelativeTwoDirection(maneuver.type(),
+          dictionary_.uturn_subset.relative_directions)},
+      {PhraseTag::kStreetNames, street_names},
+      {PhraseTag::kCrossStreetNames, cross_street_names}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -1289,14 +1428,11 @@ std::string NarrativeBuilder::FormVerbalUturnInstruction(
   std::string instruction;
   instruction.reserve(kInstructionInitialCapacity);
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.uturn_verbal_subset.phrases.at(
-      std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kRelativeDirectionTag, relative_dir);
-  boost::replace_all(instruction, kStreetNamesTag, street_names);
-  boost::replace_all(instruction, kCrossStreetNamesTag, cross_street_names);
+  // Set instruction to the determined tagged phrase with its tags replaced
+  dictionary_.uturn_verbal_subset.templates.at(phrase_id).Render(instruction, {
+      {PhraseTag::kRelativeDirection, relative_dir},
+      {PhraseTag::kStreetNames, street_names},
+      {PhraseTag::kCrossStreetNames, cross_street_names}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -1344,14 +1480,11 @@ std::string NarrativeBuilder::FormVerbalUturnInstruction(
         element_max_count, limit_by_consecutive_count);
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.ramp_straight_subset.phrases.at(
-      std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kBranchSignTag, exit_branch_sign);
-  boost::replace_all(instruction, kTowardSignTag, exit_toward_sign);
-  boost::replace_all(instruction, kNameSignTag, exit_name_sign);
+  // Set instruction to the determined tagged phrase with its tags replaced
+  dictionary_.ramp_straight_subset.templates.at(phrase_id).Render(instruction, {
+      {PhraseTag::kBranchSign, exit_branch_sign},
+      {PhraseTag::kTowardSign, exit_toward_sign},
+      {PhraseTag::kNameSign, exit_name_sign}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -1451,14 +1584,11 @@ std::string NarrativeBuilder::FormVerbalRampStraightInstruction(
   std::string instruction;
   instruction.reserve(kInstructionInitialCapacity);
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.ramp_straight_verbal_subset.phrases.at(
-      std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kBranchSignTag, exit_branch_sign);
-  boost::replace_all(instruction, kTowardSignTag, exit_toward_sign);
-  boost::replace_all(instruction, kNameSignTag, exit_name_sign);
+  // Set instruction to the determined tagged phrase with its tags replaced
+  dictionary_.ramp_straight_verbal_subset.templates.at(phrase_id).Render(instruction, {
+      {PhraseTag::kBranchSign, exit_branch_sign},
+      {PhraseTag::kTowardSign, exit_toward_sign},
+      {PhraseTag::kNameSign, exit_name_sign}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -1517,16 +1647,13 @@ std::string NarrativeBuilder::FormRampInstruction(
         element_max_count, limit_by_consecutive_count);
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.ramp_subset.phrases.at(std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kRelativeDirectionTag,
-      FormRelativeTwoDirection(maneuver.type(),
-                               dictionary_.ramp_subset.relative_directions));
-  boost::replace_all(instruction, kBranchSignTag, exit_branch_sign);
-  boost::replace_all(instruction, kTowardSignTag, exit_toward_sign);
-  boost::replace_all(instruction, kNameSignTag, exit_name_sign);
+  // Set instruction to the determined tagged phrase with its tags replaced
+  dictionary_.ramp_subset.templates.at(phrase_id).Render(instruction, {
+      {PhraseTag::kRelativeDirection, FormRelativeTwoDirection(maneuver.type(),
+          dictionary_.ramp_subset.relative_directions)},
+      {PhraseTag::kBranchSign, exit_branch_sign},
+      {PhraseTag::kTowardSign, exit_toward_sign},
+      {PhraseTag::kNameSign, exit_name_sign}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -1650,14 +1777,12 @@ std::string NarrativeBuilder::FormVerbalRampInstruction(
   std::string instruction;
   instruction.reserve(kInstructionInitialCapacity);
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.ramp_verbal_subset.phrases.at(std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kRelativeDirectionTag, relative_dir);
-  boost::replace_all(instruction, kBranchSignTag, exit_branch_sign);
-  boost::replace_all(instruction, kTowardSignTag, exit_toward_sign);
-  boost::replace_all(instruction, kNameSignTag, exit_name_sign);
+  // Set instruction to the determined tagged phrase with its tags replaced
+  dictionary_.ramp_verbal_subset.templates.at(phrase_id).Render(instruction, {
+      {PhraseTag::kRelativeDirection, relative_dir},
+      {PhraseTag::kBranchSign, exit_branch_sign},
+      {PhraseTag::kTowardSign, exit_toward_sign},
+      {PhraseTag::kNameSign, exit_name_sign}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -1717,17 +1842,14 @@ std::string NarrativeBuilder::FormExitInstruction(
         element_max_count, limit_by_consecutive_count);
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.exit_subset.phrases.at(std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kRelativeDirectionTag,
-      FormRelativeTwoDirection(maneuver.type(),
-                               dictionary_.exit_subset.relative_directions));
-  boost::replace_all(instruction, kNumberSignTag, exit_number_sign);
-  boost::replace_all(instruction, kBranchSignTag, exit_branch_sign);
-  boost::replace_all(instruction, kTowardSignTag, exit_toward_sign);
-  boost::replace_all(instruction, kNameSignTag, exit_name_sign);
+  // Set instruction to the determined tagged phrase with its tags replaced
+  dictionary_.exit_subset.templates.at(phrase_id).Render(instruction, {
+      {PhraseTag::kRelativeDirection, FormRelativeTwoDirection(maneuver.type(),
+          dictionary_.exit_subset.relative_directions)},
+      {PhraseTag::kNumberSign, exit_number_sign},
+      {PhraseTag::kBranchSign, exit_branch_sign},
+      {PhraseTag::kTowardSign, exit_toward_sign},
+      {PhraseTag::kNameSign, exit_name_sign}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -1850,15 +1972,13 @@ std::string NarrativeBuilder::FormVerbalExitInstruction(
   std::string instruction;
   instruction.reserve(kInstructionInitialCapacity);
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.exit_verbal_subset.phrases.at(std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kRelativeDirectionTag, relative_dir);
-  boost::replace_all(instruction, kNumberSignTag, exit_number_sign);
-  boost::replace_all(instruction, kBranchSignTag, exit_branch_sign);
-  boost::replace_all(instruction, kTowardSignTag, exit_toward_sign);
-  boost::replace_all(instruction, kNameSignTag, exit_name_sign);
+  // Set instruction to the determined tagged phrase with its tags replaced
+  dictionary_.exit_verbal_subset.templates.at(phrase_id).Render(instruction, {
+      {PhraseTag::kRelativeDirection, relative_dir},
+      {PhraseTag::kNumberSign, exit_number_sign},
+      {PhraseTag::kBranchSign, exit_branch_sign},
+      {PhraseTag::kTowardSign, exit_toward_sign},
+      {PhraseTag::kNameSign, exit_name_sign}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -1914,16 +2034,13 @@ std::string NarrativeBuilder::FormKeepInstruction(
         element_max_count, limit_by_consecutive_count);
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.keep_subset.phrases.at(std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kRelativeDirectionTag,
-      FormRelativeThreeDirection(maneuver.type(),
-                                 dictionary_.keep_subset.relative_directions));
-  boost::replace_all(instruction, kNumberSignTag, exit_number_sign);
-  boost::replace_all(instruction, kStreetNamesTag, street_names);
-  boost::replace_all(instruction, kTowardSignTag, exit_toward_sign);
+  // Set instruction to the determined tagged phrase with its tags replaced
+  dictionary_.keep_subset.templates.at(phrase_id).Render(instruction, {
+      {PhraseTag::kRelativeDirection, FormRelativeThreeDirection(maneuver.type(),
+          dictionary_.keep_subset.relative_directions)},
+      {PhraseTag::kNumberSign, exit_number_sign},
+      {PhraseTag::kStreetNames, street_names},
+      {PhraseTag::kTowardSign, exit_toward_sign}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -2046,14 +2163,12 @@ std::string NarrativeBuilder::FormVerbalKeepInstruction(
   std::string instruction;
   instruction.reserve(kInstructionInitialCapacity);
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.keep_verbal_subset.phrases.at(std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kRelativeDirectionTag, relative_dir);
-  boost::replace_all(instruction, kNumberSignTag, exit_number_sign);
-  boost::replace_all(instruction, kStreetNamesTag, street_names);
-  boost::replace_all(instruction, kTowardSignTag, exit_toward_sign);
+  // Set instruction to the determined tagged phrase with its tags replaced
+  dictionary_.keep_verbal_subset.templates.at(phrase_id).Render(instruction, {
+      {PhraseTag::kRelativeDirection, relative_dir},
+      {PhraseTag::kNumberSign, exit_number_sign},
+      {PhraseTag::kStreetNames, street_names},
+      {PhraseTag::kTowardSign, exit_toward_sign}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -2097,16 +2212,13 @@ std::string NarrativeBuilder::FormKeepToStayOnInstruction(
         element_max_count, limit_by_consecutive_count);
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.keep_to_stay_on_subset.phrases.at(std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kRelativeDirectionTag,
-      FormRelativeThreeDirection(maneuver.type(),
-                                 dictionary_.keep_to_stay_on_subset.relative_directions));
-  boost::replace_all(instruction, kStreetNamesTag, street_names);
-  boost::replace_all(instruction, kNumberSignTag, exit_number_sign);
-  boost::replace_all(instruction, kTowardSignTag, exit_toward_sign);
+  // Set instruction to the determined tagged phrase with its tags replaced
+  dictionary_.keep_to_stay_on_subset.templates.at(phrase_id).Render(instruction, {
+      {PhraseTag::kRelativeDirection, FormRelativeThreeDirection(maneuver.type(),
+          dictionary_.keep_to_stay_on_subset.relative_directions)},
+      {PhraseTag::kStreetNames, street_names},
+      {PhraseTag::kNumberSign, exit_number_sign},
+      {PhraseTag::kTowardSign, exit_toward_sign}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -2186,15 +2298,12 @@ std::string NarrativeBuilder::FormVerbalKeepToStayOnInstruction(
   std::string instruction;
   instruction.reserve(kInstructionInitialCapacity);
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.keep_to_stay_on_verbal_subset.phrases.at(
-      std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kRelativeDirectionTag, relative_dir);
-  boost::replace_all(instruction, kStreetNamesTag, street_names);
-  boost::replace_all(instruction, kNumberSignTag, exit_number_sign);
-  boost::replace_all(instruction, kTowardSignTag, exit_toward_sign);
+  // Set instruction to the determined tagged phrase with its tags replaced
+  dictionary_.keep_to_stay_on_verbal_subset.templates.at(phrase_id).Render(instruction, {
+      {PhraseTag::kRelativeDirection, relative_dir},
+      {PhraseTag::kStreetNames, street_names},
+      {PhraseTag::kNumberSign, exit_number_sign},
+      {PhraseTag::kTowardSign, exit_toward_sign}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -2223,11 +2332,9 @@ std::string NarrativeBuilder::FormMergeInstruction(Maneuver& maneuver) {
     phrase_id = 1;
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.merge_subset.phrases.at(std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kStreetNamesTag, street_names);
+  // Set instruction to the determined tagged phrase with its tags replaced
+  dictionary_.merge_subset.templates.at(phrase_id).Render(instruction, {
+      {PhraseTag::kStreetNames, street_names}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -2265,12 +2372,9 @@ std::string NarrativeBuilder::FormVerbalMergeInstruction(
     phrase_id = 1;
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.merge_verbal_subset.phrases.at(
-      std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kStreetNamesTag, street_names);
+  // Set instruction to the determined tagged phrase with its tags replaced
+  dictionary_.merge_verbal_subset.templates.at(phrase_id).Render(instruction, {
+      {PhraseTag::kStreetNames, street_names}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -2299,11 +2403,9 @@ std::string NarrativeBuilder::FormEnterRoundaboutInstruction(Maneuver& maneuver)
         maneuver.roundabout_exit_count()-1);
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.enter_roundabout_subset.phrases.at(std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kOrdinalValueTag, ordinal_value);
+  // Set instruction to the determined tagged phrase with its tags replaced
+  dictionary_.enter_roundabout_subset.templates.at(phrase_id).Render(instruction, {
+      {PhraseTag::kOrdinalValue, ordinal_value}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -2333,11 +2435,9 @@ std::string NarrativeBuilder::FormVerbalAlertEnterRoundaboutInstruction(
         maneuver.roundabout_exit_count()-1);
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.enter_roundabout_verbal_subset.phrases.at(std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kOrdinalValueTag, ordinal_value);
+  // Set instruction to the determined tagged phrase with its tags replaced
+  dictionary_.enter_roundabout_verbal_subset.templates.at(phrase_id).Render(instruction, {
+      {PhraseTag::kOrdinalValue, ordinal_value}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -2367,11 +2467,9 @@ std::string NarrativeBuilder::FormVerbalEnterRoundaboutInstruction(
         maneuver.roundabout_exit_count()-1);
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.enter_roundabout_verbal_subset.phrases.at(std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kOrdinalValueTag, ordinal_value);
+  // Set instruction to the determined tagged phrase with its tags replaced
+  dictionary_.enter_roundabout_verbal_subset.templates.at(phrase_id).Render(instruction, {
+      {PhraseTag::kOrdinalValue, ordinal_value}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -2408,12 +2506,10 @@ std::string NarrativeBuilder::FormExitRoundaboutInstruction(Maneuver& maneuver)
     phrase_id = 1;
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.exit_roundabout_subset.phrases.at(std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kStreetNamesTag, street_names);
-  boost::replace_all(instruction, kBeginStreetNamesTag, begin_street_names);
+  // Set instruction to the determined tagged phrase with its tags replaced
+  dictionary_.exit_roundabout_subset.templates.at(phrase_id).Render(instruction, {
+      {PhraseTag::kStreetNames, street_names},
+      {PhraseTag::kBeginStreetNames, begin_street_names}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -2453,12 +2549,10 @@ std::string NarrativeBuilder::FormVerbalExitRoundaboutInstruction(
     phrase_id = 1;
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.exit_roundabout_verbal_subset.phrases.at(std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kStreetNamesTag, street_names);
-  boost::replace_all(instruction, kBeginStreetNamesTag, begin_street_names);
+  // Set instruction to the determined tagged phrase with its tags replaced
+  dictionary_.exit_roundabout_verbal_subset.templates.at(phrase_id).Render(instruction, {
+      {PhraseTag::kStreetNames, street_names},
+      {PhraseTag::kBeginStreetNames, begin_street_names}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -2493,12 +2587,10 @@ std::string NarrativeBuilder::FormEnterFerryInstruction(Maneuver& maneuver) {
     }
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.enter_ferry_subset.phrases.at(std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kStreetNamesTag, street_names);
-  boost::replace_all(instruction, kFerryLabelTag, ferry_label);
+  // Set instruction to the determined tagged phrase with its tags replaced
+  dictionary_.enter_ferry_subset.templates.at(phrase_id).Render(instruction, {
+      {PhraseTag::kStreetNames, street_names},
+      {PhraseTag::kFerryLabel, ferry_label}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -2543,12 +2635,10 @@ std::string NarrativeBuilder::FormVerbalEnterFerryInstruction(
     }
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.enter_ferry_verbal_subset.phrases.at(std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kStreetNamesTag, street_names);
-  boost::replace_all(instruction, kFerryLabelTag, ferry_label);
+  // Set instruction to the determined tagged phrase with its tags replaced
+  dictionary_.enter_ferry_verbal_subset.templates.at(phrase_id).Render(instruction, {
+      {PhraseTag::kStreetNames, street_names},
+      {PhraseTag::kFerryLabel, ferry_label}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -2605,13 +2695,11 @@ std::string NarrativeBuilder::FormExitFerryInstruction(Maneuver& maneuver) {
     phrase_id += 16;
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.exit_ferry_subset.phrases.at(std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kCardinalDirectionTag, cardinal_direction);
-  boost::replace_all(instruction, kStreetNamesTag, street_names);
-  boost::replace_all(instruction, kBeginStreetNamesTag, begin_street_names);
+  // Set instruction to the determined tagged phrase with its tags replaced
+  dictionary_.exit_ferry_subset.templates.at(phrase_id).Render(instruction, {
+      {PhraseTag::kCardinalDirection, cardinal_direction},
+      {PhraseTag::kStreetNames, street_names},
+      {PhraseTag::kBeginStreetNames, begin_street_names}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -2689,13 +2777,11 @@ std::string NarrativeBuilder::FormVerbalExitFerryInstruction(
     phrase_id += 16;
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.exit_ferry_verbal_subset.phrases.at(std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kCardinalDirectionTag, cardinal_direction);
-  boost::replace_all(instruction, kStreetNamesTag, street_names);
-  boost::replace_all(instruction, kBeginStreetNamesTag, begin_street_names);
+  // Set instruction to the determined tagged phrase with its tags replaced
+  dictionary_.exit_ferry_verbal_subset.templates.at(phrase_id).Render(instruction, {
+      {PhraseTag::kCardinalDirection, cardinal_direction},
+      {PhraseTag::kStreetNames, street_names},
+      {PhraseTag::kBeginStreetNames, begin_street_names}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -2730,12 +2816,10 @@ std::string NarrativeBuilder::FormTransitConnectionStartInstruction(
     }
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.transit_connection_start_subset.phrases.at(std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kTransitStopTag, transit_stop);
-  boost::replace_all(instruction, kStationLabelTag, station_label);
+  // Set instruction to the determined tagged phrase with its tags replaced
+  dictionary_.transit_connection_start_subset.templates.at(phrase_id).Render(instruction, {
+      {PhraseTag::kTransitStop, transit_stop},
+      {PhraseTag::kStationLabel, station_label}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -2770,12 +2854,10 @@ std::string NarrativeBuilder::FormVerbalTransitConnectionStartInstruction(
     }
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.transit_connection_start_verbal_subset.phrases.at(std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kTransitStopTag, transit_stop);
-  boost::replace_all(instruction, kStationLabelTag, station_label);
+  // Set instruction to the determined tagged phrase with its tags replaced
+  dictionary_.transit_connection_start_verbal_subset.templates.at(phrase_id).Render(instruction, {
+      {PhraseTag::kTransitStop, transit_stop},
+      {PhraseTag::kStationLabel, station_label}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -2810,12 +2892,10 @@ std::string NarrativeBuilder::FormTransitConnectionTransferInstruction(
     }
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.transit_connection_transfer_subset.phrases.at(std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kTransitStopTag, transit_stop);
-  boost::replace_all(instruction, kStationLabelTag, station_label);
+  // Set instruction to the determined tagged phrase with its tags replaced
+  dictionary_.transit_connection_transfer_subset.templates.at(phrase_id).Render(instruction, {
+      {PhraseTag::kTransitStop, transit_stop},
+      {PhraseTag::kStationLabel, station_label}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -2850,12 +2930,10 @@ std::string NarrativeBuilder::FormVerbalTransitConnectionTransferInstruction(
     }
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.transit_connection_transfer_verbal_subset.phrases.at(std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kTransitStopTag, transit_stop);
-  boost::replace_all(instruction, kStationLabelTag, station_label);
+  // Set instruction to the determined tagged phrase with its tags replaced
+  dictionary_.transit_connection_transfer_verbal_subset.templates.at(phrase_id).Render(instruction, {
+      {PhraseTag::kTransitStop, transit_stop},
+      {PhraseTag::kStationLabel, station_label}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -2890,12 +2968,10 @@ std::string NarrativeBuilder::FormTransitConnectionDestinationInstruction(
     }
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.transit_connection_destination_subset.phrases.at(std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kTransitStopTag, transit_stop);
-  boost::replace_all(instruction, kStationLabelTag, station_label);
+  // Set instruction to the determined tagged phrase with its tags replaced
+  dictionary_.transit_connection_destination_subset.templates.at(phrase_id).Render(instruction, {
+      {PhraseTag::kTransitStop, transit_stop},
+      {PhraseTag::kStationLabel, station_label}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -2930,12 +3006,10 @@ std::string NarrativeBuilder::FormVerbalTransitConnectionDestinationInstruction(
     }
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.transit_connection_destination_verbal_subset.phrases.at(std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kTransitStopTag, transit_stop);
-  boost::replace_all(instruction, kStationLabelTag, station_label);
+  // Set instruction to the determined tagged phrase with its tags replaced
+  dictionary_.transit_connection_destination_verbal_subset.templates.at(phrase_id).Render(instruction, {
+      {PhraseTag::kTransitStop, transit_stop},
+      {PhraseTag::kStationLabel, station_label}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -2959,13 +3033,11 @@ std::string NarrativeBuilder::FormDepartInstruction(Maneuver& maneuver) {
     phrase_id = 1;
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.depart_subset.phrases.at(std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kTransitStopTag, transit_stop_name);
-  boost::replace_all(instruction, kTimeTag,
-      get_localized_time(maneuver.GetTransitDepartureTime(), dictionary_.GetLocale()));
+  // Set instruction to the determined tagged phrase with its tags replaced
+  dictionary_.depart_subset.templates.at(phrase_id).Render(instruction, {
+      {PhraseTag::kTransitStop, transit_stop_name},
+      {PhraseTag::kTime, get_localized_time(maneuver.GetTransitDepartureTime(),
+          dictionary_.GetLocale())}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -2988,13 +3060,11 @@ std::string NarrativeBuilder::FormVerbalDepartInstruction(Maneuver& maneuver) {
     phrase_id = 1;
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.depart_verbal_subset.phrases.at(std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kTransitStopTag, transit_stop_name);
-  boost::replace_all(instruction, kTimeTag,
-      get_localized_time(maneuver.GetTransitDepartureTime(), dictionary_.GetLocale()));
+  // Set instruction to the determined tagged phrase with its tags replaced
+  dictionary_.depart_verbal_subset.templates.at(phrase_id).Render(instruction, {
+      {PhraseTag::kTransitStop, transit_stop_name},
+      {PhraseTag::kTime, get_localized_time(maneuver.GetTransitDepartureTime(),
+          dictionary_.GetLocale())}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -3017,13 +3087,11 @@ std::string NarrativeBuilder::FormArriveInstruction(Maneuver& maneuver) {
     phrase_id = 1;
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.arrive_subset.phrases.at(std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kTransitStopTag, transit_stop_name);
-  boost::replace_all(instruction, kTimeTag,
-      get_localized_time(maneuver.GetTransitArrivalTime(), dictionary_.GetLocale()));
+  // Set instruction to the determined tagged phrase with its tags replaced
+  dictionary_.arrive_subset.templates.at(phrase_id).Render(instruction, {
+      {PhraseTag::kTransitStop, transit_stop_name},
+      {PhraseTag::kTime, get_localized_time(maneuver.GetTransitArrivalTime(),
+          dictionary_.GetLocale())}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -3046,13 +3114,11 @@ std::string NarrativeBuilder::FormVerbalArriveInstruction(Maneuver& maneuver) {
     phrase_id = 1;
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.arrive_verbal_subset.phrases.at(std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kTransitStopTag, transit_stop_name);
-  boost::replace_all(instruction, kTimeTag,
-      get_localized_time(maneuver.GetTransitArrivalTime(), dictionary_.GetLocale()));
+  // Set instruction to the determined tagged phrase with its tags replaced
+  dictionary_.arrive_verbal_subset.templates.at(phrase_id).Render(instruction, {
+      {PhraseTag::kTransitStop, transit_stop_name},
+      {PhraseTag::kTime, get_localized_time(maneuver.GetTransitArrivalTime(),
+          dictionary_.GetLocale())}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -3079,18 +3145,13 @@ std::string NarrativeBuilder::FormTransitInstruction(
     phrase_id = 1;
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.transit_subset.phrases.at(std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(
-      instruction,
-      kTransitNameTag,
-      FormTransitName(maneuver,
-                      dictionary_.transit_subset.empty_transit_name_labels));
-  boost::replace_all(instruction, kTransitHeadSignTag, transit_headsign);
-  boost::replace_all(instruction, kTransitStopCountTag, std::to_string(stop_count)); //TODO: locale specific numerals
-  boost::replace_all(instruction, kTransitStopCountLabelTag, stop_count_label);
+  // Set instruction to the determined tagged phrase with its tags replaced
+  dictionary_.transit_subset.templates.at(phrase_id).Render(instruction, {
+      {PhraseTag::kTransitName, FormTransitName(maneuver,
+          dictionary_.transit_subset.empty_transit_name_labels)},
+      {PhraseTag::kTransitHeadSign, transit_headsign},
+      {PhraseTag::kTransitStopCount, std::to_string(stop_count)}, //TODO: locale specific numerals
+      {PhraseTag::kTransitStopCountLabel, stop_count_label}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -3113,16 +3174,11 @@ std::string NarrativeBuilder::FormVerbalTransitInstruction(Maneuver& maneuver) {
     phrase_id = 1;
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.transit_verbal_subset.phrases.at(std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(
-      instruction,
-      kTransitNameTag,
-      FormTransitName(maneuver,
-                      dictionary_.transit_verbal_subset.empty_transit_name_labels));
-  boost::replace_all(instruction, kTransitHeadSignTag, transit_headsign);
+  // Set instruction to the determined tagged phrase with its tags replaced
+  dictionary_.transit_verbal_subset.templates.at(phrase_id).Render(instruction, {
+      {PhraseTag::kTransitName, FormTransitName(maneuver,
+          dictionary_.transit_verbal_subset.empty_transit_name_labels)},
+      {PhraseTag::kTransitHeadSign, transit_headsign}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -3149,19 +3205,13 @@ std::string NarrativeBuilder::FormTransitRemainOnInstruction(
     phrase_id = 1;
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.transit_remain_on_subset.phrases.at(std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(
-      instruction,
-      kTransitNameTag,
-      FormTransitName(
-          maneuver,
-          dictionary_.transit_remain_on_subset.empty_transit_name_labels));
-  boost::replace_all(instruction, kTransitHeadSignTag, transit_headsign);
-  boost::replace_all(instruction, kTransitStopCountTag, std::to_string(stop_count)); //TODO: locale specific numerals
-  boost::replace_all(instruction, kTransitStopCountLabelTag, stop_count_label);
+  // Set instruction to the determined tagged phrase with its tags replaced
+  dictionary_.transit_remain_on_subset.templates.at(phrase_id).Render(instruction, {
+      {PhraseTag::kTransitName, FormTransitName(maneuver,
+          dictionary_.transit_remain_on_subset.empty_transit_name_labels)},
+      {PhraseTag::kTransitHeadSign, transit_headsign},
+      {PhraseTag::kTransitStopCount, std::to_string(stop_count)}, //TODO: locale specific numerals
+      {PhraseTag::kTransitStopCountLabel, stop_count_label}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -3186,17 +3236,11 @@ std::string NarrativeBuilder::FormVerbalTransitRemainOnInstruction(
     phrase_id = 1;
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.transit_remain_on_verbal_subset.phrases.at(std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(
-      instruction,
-      kTransitNameTag,
-      FormTransitName(
-          maneuver,
-          dictionary_.transit_remain_on_verbal_subset.empty_transit_name_labels));
-  boost::replace_all(instruction, kTransitHeadSignTag, transit_headsign);
+  // Set instruction to the determined tagged phrase with its tags replaced
+  dictionary_.transit_remain_on_verbal_subset.templates.at(phrase_id).Render(instruction, {
+      {PhraseTag::kTransitName, FormTransitName(maneuver,
+          dictionary_.transit_remain_on_verbal_subset.empty_transit_name_labels)},
+      {PhraseTag::kTransitHeadSign, transit_headsign}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -3223,19 +3267,13 @@ std::string NarrativeBuilder::FormTransitTransferInstruction(
     phrase_id = 1;
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.transit_transfer_subset.phrases.at(std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(
-      instruction,
-      kTransitNameTag,
-      FormTransitName(
-          maneuver,
-          dictionary_.transit_transfer_subset.empty_transit_name_labels));
-  boost::replace_all(instruction, kTransitHeadSignTag, transit_headsign);
-  boost::replace_all(instruction, kTransitStopCountTag, std::to_string(stop_count)); //TODO: locale specific numerals
-  boost::replace_all(instruction, kTransitStopCountLabelTag, stop_count_label);
+  // Set instruction to the determined tagged phrase with its tags replaced
+  dictionary_.transit_transfer_subset.templates.at(phrase_id).Render(instruction, {
+      {PhraseTag::kTransitName, FormTransitName(maneuver,
+          dictionary_.transit_transfer_subset.empty_transit_name_labels)},
+      {PhraseTag::kTransitHeadSign, transit_headsign},
+      {PhraseTag::kTransitStopCount, std::to_string(stop_count)}, //TODO: locale specific numerals
+      {PhraseTag::kTransitStopCountLabel, stop_count_label}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -3260,17 +3298,11 @@ std::string NarrativeBuilder::FormVerbalTransitTransferInstruction(
     phrase_id = 1;
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.transit_transfer_verbal_subset.phrases.at(std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(
-      instruction,
-      kTransitNameTag,
-      FormTransitName(
-          maneuver,
-          dictionary_.transit_transfer_verbal_subset.empty_transit_name_labels));
-  boost::replace_all(instruction, kTransitHeadSignTag, transit_headsign);
+  // Set instruction to the determined tagged phrase with its tags replaced
+  dictionary_.transit_transfer_verbal_subset.templates.at(phrase_id).Render(instruction, {
+      {PhraseTag::kTransitName, FormTransitName(maneuver,
+          dictionary_.transit_transfer_verbal_subset.empty_transit_name_labels)},
+      {PhraseTag::kTransitHeadSign, transit_headsign}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -3328,14 +3360,11 @@ std::string NarrativeBuilder::FormPostTransitConnectionDestinationInstruction(
     phrase_id += 16;
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.post_transit_connection_destination_subset.
-      phrases.at(std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kCardinalDirectionTag, cardinal_direction);
-  boost::replace_all(instruction, kStreetNamesTag, street_names);
-  boost::replace_all(instruction, kBeginStreetNamesTag, begin_street_names);
+  // Set instruction to the determined tagged phrase with its tags replaced
+  dictionary_.post_transit_connection_destination_subset.templates.at(phrase_id).Render(instruction, {
+      {PhraseTag::kCardinalDirection, cardinal_direction},
+      {PhraseTag::kStreetNames, street_names},
+      {PhraseTag::kBeginStreetNames, begin_street_names}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -3395,13 +3424,11 @@ std::string NarrativeBuilder::FormVerbalPostTransitConnectionDestinationInstruct
     phrase_id += 16;
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.post_transit_connection_destination_verbal_subset.phrases.at(std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kCardinalDirectionTag, cardinal_direction);
-  boost::replace_all(instruction, kStreetNamesTag, street_names);
-  boost::replace_all(instruction, kBeginStreetNamesTag, begin_street_names);
+  // Set instruction to the determined tagged phrase with its tags replaced
+  dictionary_.post_transit_connection_destination_verbal_subset.templates.at(phrase_id).Render(instruction, {
+      {PhraseTag::kCardinalDirection, cardinal_direction},
+      {PhraseTag::kStreetNames, street_names},
+      {PhraseTag::kBeginStreetNames, begin_street_names}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -3432,16 +3459,12 @@ std::string NarrativeBuilder::FormVerbalPostTransitionInstruction(
     phrase_id = 1;
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.post_transition_verbal_subset.phrases.at(
-      std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kLengthTag,
-      FormLength(
-          maneuver, dictionary_.post_transition_verbal_subset.metric_lengths,
-          dictionary_.post_transition_verbal_subset.us_customary_lengths));
-  boost::replace_all(instruction, kStreetNamesTag, street_names);
+  // Set instruction to the determined tagged phrase with its tags replaced
+  dictionary_.post_transition_verbal_subset.templates.at(phrase_id).Render(instruction, {
+      {PhraseTag::kLength, FormLength(maneuver,
+          dictionary_.post_transition_verbal_subset.metric_lengths,
+          dictionary_.post_transition_verbal_subset.us_customary_lengths)},
+      {PhraseTag::kStreetNames, street_names}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -3464,12 +3487,10 @@ std::string NarrativeBuilder::FormVerbalPostTransitionTransitInstruction(
       dictionary_.post_transition_transit_verbal_subset
           .transit_stop_count_labels);
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.post_transition_transit_verbal_subset.phrases.at(std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kTransitStopCountTag, std::to_string(stop_count)); //TODO: locale specific numerals
-  boost::replace_all(instruction, kTransitStopCountLabelTag, stop_count_label);
+  // Set instruction to the determined tagged phrase with its tags replaced
+  dictionary_.post_transition_transit_verbal_subset.templates.at(phrase_id).Render(instruction, {
+      {PhraseTag::kTransitStopCount, std::to_string(stop_count)}, //TODO: locale specific numerals
+      {PhraseTag::kTransitStopCountLabel, stop_count_label}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -3794,12 +3815,10 @@ std::string NarrativeBuilder::FormVerbalMultiCue(Maneuver* maneuver,
           next_maneuver.verbal_pre_transition_instruction();
 
 
-  // Set instruction to the verbal multi-cue
-  instruction = dictionary_.verbal_multi_cue_subset.phrases.at("0");
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kCurrentVerbalCueTag, current_verbal_cue);
-  boost::replace_all(instruction, kNextVerbalCueTag, next_verbal_cue);
+  // Set instruction to the verbal multi-cue with its tags replaced
+  dictionary_.verbal_multi_cue_subset.templates.at(0).Render(instruction, {
+      {PhraseTag::kCurrentVerbalCue, current_verbal_cue},
+      {PhraseTag::kNextVerbalCue, next_verbal_cue}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -7,11 +7,11 @@
 #include <sstream>
 
 #include <boost/property_tree/ptree.hpp>
-#include <boost/property_tree/json_parser.hpp>
 #include <prime_server/http_protocol.hpp>
 
 #include "baldr/json.h"
 #include "baldr/errorcode_util.h"
+#include "baldr/rapidjson_utils.h"
 #include "midgard/logging.h"
 
 #include "proto/directions_options.pb.h"
@@ -70,73 +70,85 @@ namespace valhalla {
       try{
         //crack open the original request
         std::string request_str(static_cast<const char*>(job.front().data()), job.front().size());
-        std::stringstream stream(request_str);
-        boost::property_tree::ptree request;
-        try{
-          boost::property_tree::read_json(stream, request);
-          jsonp = request.get_optional<std::string>("jsonp");
-        }
-        catch(...) {
+        rapidjson::Document request;
+        request.Parse(request_str.c_str(), request_str.size());
+        if(request.HasParseError())
           return jsonify_error({500, 200}, info, jsonp);
-        }
+        jsonp = GetOptionalFromRapidJson<std::string>(request, "/jsonp");
 
-        // Grab language from options and set
-        auto language = request.get_optional<std::string>("directions_options.language");
-        // If language is not found then set to the default language (en-US)
-        if (!language || (odin::get_locales().find(*language) == odin::get_locales().end())) {
-          request.put<std::string>("directions_options.language", odin::DirectionsOptions::default_instance().language());
-          std::stringstream ss;
-          boost::property_tree::write_json(ss, request, false);
-          // Update request string with language
-          request_str = ss.str();
-        }
-
-        //see if we can get some options
-        valhalla::odin::DirectionsOptions directions_options;
-        auto options = request.get_child_optional("directions_options");
-        if(options)
-          directions_options = valhalla::odin::GetDirectionsOptions(*options);
-
-        //forward the original request
-        worker_t::result_t result{true};
-        result.messages.emplace_back(std::move(request_str));
-
-        //for each leg
+        //crack open the path of each leg
+        std::list<odin::TripPath*> legs;
         for(auto leg = ++job.cbegin(); leg != job.cend(); ++leg) {
-          //crack open the path
-          odin::TripPath trip_path;
+          legs.emplace_back(arena.create<odin::TripPath>());
           try {
-            trip_path.ParseFromArray(leg->data(), static_cast<int>(leg->size()));
+            legs.back()->ParseFromArray(leg->data(), static_cast<int>(leg->size()));
           }
           catch(...) {
             return jsonify_error({500, 201}, info, jsonp);
           }
+        }
 
-          //get some annotated directions
-          odin::DirectionsBuilder directions;
-          odin::TripDirections trip_directions;
-          try{
-            trip_directions = directions.Build(directions_options, trip_path);
-          }
-          catch(...) {
-            return jsonify_error({500, 202}, info, jsonp);
-          }
+        //get some annotated directions
+        auto language = GetOptionalFromRapidJson<std::string>(request, "/directions_options/language");
+        auto directions = narrate(request, legs);
 
-          LOG_INFO("maneuver_count::" + std::to_string(trip_directions.maneuver_size()));
+        //forward the original request, updated if we had to set the language
+        worker_t::result_t result{true};
+        if(language != GetOptionalFromRapidJson<std::string>(request, "/directions_options/language"))
+          request_str = rapidjson::to_string(request);
+        result.messages.emplace_back(std::move(request_str));
 
-          //the protobuf directions
-          result.messages.emplace_back(trip_directions.SerializeAsString());
-        }
+        //the protobuf directions
+        for(const auto* trip_directions : directions)
+          result.messages.emplace_back(trip_directions->SerializeAsString());
 
         return result;
       }
+      catch(const valhalla_exception_t& e) {
+        return jsonify_error({e.status_code, e.error_code, e.extra}, info, jsonp);
+      }
       catch(const std::exception& e) {
         return jsonify_error({400, 299, std::string(e.what())}, info, jsonp);
       }
     }
 
+    std::list<odin::TripDirections*> odin_worker_t::narrate(rapidjson::Document& request, std::list<odin::TripPath*>& legs) {
+      // Grab language from options and set
+      auto language = GetOptionalFromRapidJson<std::string>(request, "/directions_options/language");
+      // If language is not found then set to the default language (en-US)
+      if (!language || (odin::get_locales().find(*language) == odin::get_locales().end())) {
+        rapidjson::Value default_language(odin::DirectionsOptions::default_instance().language().c_str(), request.GetAllocator());
+        rapidjson::Pointer{"/directions_options/language"}.Set(request, default_language);
+      }
+
+      //see if we can get some options
+      valhalla::odin::DirectionsOptions directions_options;
+      auto options = rapidjson::Pointer{"/directions_options"}.Get(request);
+      if(options)
+        directions_options = valhalla::odin::GetDirectionsOptions(*options);
+
+      //for each leg
+      std::list<odin::TripDirections*> directions;
+      for(auto* trip_path : legs) {
+        //get some annotated directions
+        odin::DirectionsBuilder builder;
+        directions.emplace_back(arena.create<odin::TripDirections>());
+        try{
+          builder.Build(directions_options, *trip_path, *directions.back());
+        }
+        catch(...) {
+          throw valhalla_exception_t{500, 202};
+        }
+
+        LOG_INFO("maneuver_count::" + std::to_string(directions.back()->maneuver_size()));
+      }
+
+      return directions;
+    }
+
     void odin_worker_t::cleanup() {
       jsonp = boost::none;
+      arena.reset();
     }
 
     void run_service(const boost::property_tree::ptree& config) {
@@ -150,8 +162,10 @@ namespace valhalla {
 
       //listen for requests
       zmq::context_t context;
+      odin_worker_t odin_worker(config);
       prime_server::worker_t worker(context, upstream_endpoint, downstream_endpoint, loopback_endpoint, interrupt_endpoint,
-        std::bind(&odin_worker_t::work, odin_worker_t(config), std::placeholders::_1, std::placeholders::_2, std::placeholders::_3));
+        std::bind(&odin_worker_t::work, std::ref(odin_worker), std::placeholders::_1, std::placeholders::_2, std::placeholders::_3),
+        std::bind(&odin_worker_t::cleanup, std::ref(odin_worker)));
       worker.work();
 
       //TODO: should we listen for SIGINT and terminate gracefully/exit(0)?
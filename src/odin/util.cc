@@ -14,6 +14,20 @@
 
 namespace {
 
+  //the names of the narrative fields a request can ask for, named like the output they control
+  const std::unordered_map<std::string, uint32_t> kNarrativeFields {
+    {"instruction", valhalla::odin::DirectionsOptions::kInstruction},
+    {"verbal_transition_alert_instruction", valhalla::odin::DirectionsOptions::kVerbalTransitionAlert},
+    {"verbal_pre_transition_instruction", valhalla::odin::DirectionsOptions::kVerbalPreTransition},
+    {"verbal_post_transition_instruction", valhalla::odin::DirectionsOptions::kVerbalPostTransition},
+  };
+
+  //unknown names are ignored like the rest of the unvalidated options
+  uint32_t to_narrative_field(const std::string& name) {
+    auto field = kNarrativeFields.find(name);
+    return field == kNarrativeFields.cend() ? 0 : field->second;
+  }
+
   valhalla::odin::locales_singleton_t load_narrative_locals() {
     valhalla::odin::locales_singleton_t locales;
     //for each locale
@@ -99,6 +113,51 @@ DirectionsOptions GetDirectionsOptions(const boost::property_tree::ptree& pt) {
     directions_options.set_narrative(*narr_ptr);
   }
 
+  auto fields_ptr = pt.get_child_optional("narrative_fields");
+  if (fields_ptr) {
+    uint32_t narrative_fields = 0;
+    for (const auto& field : *fields_ptr) {
+      narrative_fields |= to_narrative_field(field.second.get_value<std::string>());
+    }
+    directions_options.set_narrative_fields(narrative_fields);
+  }
+
+  return directions_options;
+}
+
+DirectionsOptions GetDirectionsOptions(const rapidjson::Value& options) {
+  valhalla::odin::DirectionsOptions directions_options;
+
+  auto units = GetOptionalFromRapidJson<std::string>(options, "/units");
+  if (units) {
+    if ((*units == "miles") || (*units == "mi")) {
+      directions_options.set_units(DirectionsOptions_Units_kMiles);
+    } else {
+      directions_options.set_units(DirectionsOptions_Units_kKilometers);
+    }
+  }
+
+  auto language = GetOptionalFromRapidJson<std::string>(options, "/language");
+  if (language) {
+    directions_options.set_language(*language);
+  }
+
+  auto narrative = GetOptionalFromRapidJson<bool>(options, "/narrative");
+  if (narrative) {
+    directions_options.set_narrative(*narrative);
+  }
+
+  auto fields = GetOptionalFromRapidJson<rapidjson::Value::ConstArray>(options, "/narrative_fields");
+  if (fields) {
+    uint32_t narrative_fields = 0;
+    for (const auto& field : *fields) {
+      if (field.IsString()) {
+        narrative_fields |= to_narrative_field(field.GetString());
+      }
+    }
+    directions_options.set_narrative_fields(narrative_fields);
+  }
+
   return directions_options;
 }
 
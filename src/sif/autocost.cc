@@ -75,6 +75,12 @@ class AutoCost : public DynamicCost {
    */
   virtual bool AllowMultiPass() const;
 
+  /**
+   * Does the costing method use the historical speed profiles in the tiles.
+   * @return  Returns true, edges are costed by their speed profiles.
+   */
+  virtual bool UsesSpeedProfiles() const;
+
   /**
    * Get the access mode used by this costing method.
    * @return  Returns access mode.
@@ -131,6 +137,29 @@ class AutoCost : public DynamicCost {
    */
   virtual Cost EdgeCost(const baldr::DirectedEdge* edge) const;
 
+  /**
+   * Get the cost to traverse the specified directed edge at a time of the
+   * week. Uses the historical speed profile of the edge if it has one.
+   * @param   edge             Pointer to a directed edge.
+   * @param   tile             Tile that holds the directed edge.
+   * @param   seconds_of_week  Seconds since midnight Sunday local time.
+   * @return  Returns the cost and time (seconds)
+   */
+  virtual Cost EdgeCost(const baldr::DirectedEdge* edge,
+                        const baldr::GraphTile* tile,
+                        const uint32_t seconds_of_week) const;
+
+  /**
+   * Get the cost to traverse the specified directed edge at the given speed.
+   * Both EdgeCost methods use this so that derived costing models need only
+   * override this method to change the edge cost.
+   * @param   edge   Pointer to a directed edge.
+   * @param   speed  Speed (kph) along the edge.
+   * @return  Returns the cost and time (seconds)
+   */
+  virtual Cost SpeedCost(const baldr::DirectedEdge* edge,
+                         const uint32_t speed) const;
+
   /**
    * Returns the cost to make the transition from the predecessor edge.
    * Defaults to 0. Costing models that wish to include edge transition
@@ -307,6 +336,11 @@ bool AutoCost::AllowMultiPass() const {
   return true;
 }
 
+// Does the costing method use the historical speed profiles in the tiles.
+bool AutoCost::UsesSpeedProfiles() const {
+  return true;
+}
+
 // Get the access mode used by this costing method.
 uint32_t AutoCost::access_mode() const {
   return kAutoAccess;
@@ -363,10 +397,21 @@ bool AutoCost::Allowed(const baldr::NodeInfo* node) const  {
 
 // Get the cost to traverse the edge in seconds
 Cost AutoCost::EdgeCost(const DirectedEdge* edge) const {
+  return SpeedCost(edge, edge->speed());
+}
+
+// Get the cost to traverse the edge in seconds at a time of the week
+Cost AutoCost::EdgeCost(const DirectedEdge* edge, const GraphTile* tile,
+                        const uint32_t seconds_of_week) const {
+  return SpeedCost(edge, tile->GetSpeed(edge, seconds_of_week));
+}
+
+// Get the cost to traverse the edge in seconds at the given speed
+Cost AutoCost::SpeedCost(const DirectedEdge* edge, const uint32_t speed) const {
   float factor = (edge->use() == Use::kFerry) ?
         ferry_weight_ : density_factor_[edge->density()];
 
-  float sec = (edge->length() * speedfactor_[edge->speed()]);
+  float sec = (edge->length() * speedfactor_[speed]);
   return Cost(sec * factor, sec);
 }
 
@@ -527,11 +572,13 @@ class AutoShorterCost : public AutoCost {
 
   /**
    * Returns the cost to traverse the edge and an estimate of the actual time
-   * (in seconds) to traverse the edge.
+   * (in seconds) to traverse the edge at the given speed.
    * @param  edge     Pointer to a directed edge.
+   * @param  speed    Speed (kph) along the edge.
    * @return  Returns the cost to traverse the edge.
    */
-  virtual Cost EdgeCost(const baldr::DirectedEdge* edge) const;
+  virtual Cost SpeedCost(const baldr::DirectedEdge* edge,
+                         const uint32_t speed) const;
 
   /**
    * Get the cost factor for A* heuristics. This factor is multiplied
@@ -563,11 +610,12 @@ AutoShorterCost::~AutoShorterCost() {
 }
 
 // Returns the cost to traverse the edge and an estimate of the actual time
-// (in seconds) to traverse the edge.
-Cost AutoShorterCost::EdgeCost(const baldr::DirectedEdge* edge) const {
+// (in seconds) to traverse the edge at the given speed.
+Cost AutoShorterCost::SpeedCost(const baldr::DirectedEdge* edge,
+                                const uint32_t speed) const {
   float factor = (edge->use() == Use::kFerry) ? ferry_weight_ : 1.0f;
-  return Cost(edge->length() * adjspeedfactor_[edge->speed()] * factor,
-              edge->length() * speedfactor_[edge->speed()]);
+  return Cost(edge->length() * adjspeedfactor_[speed] * factor,
+              edge->length() * speedfactor_[speed]);
 }
 
 float AutoShorterCost::AStarCostFactor() const {
@@ -797,11 +845,13 @@ class HOVCost : public AutoCost {
 
   /**
    * Returns the cost to traverse the edge and an estimate of the actual time
-   * (in seconds) to traverse the edge.
+   * (in seconds) to traverse the edge at the given speed.
    * @param  edge     Pointer to a directed edge.
+   * @param  speed    Speed (kph) along the edge.
    * @return  Returns the cost to traverse the edge.
    */
-  virtual Cost EdgeCost(const baldr::DirectedEdge* edge) const;
+  virtual Cost SpeedCost(const baldr::DirectedEdge* edge,
+                         const uint32_t speed) const;
 
   /**
    * Checks if access is allowed for the provided node. Node access can
@@ -903,8 +953,9 @@ bool HOVCost::AllowedReverse(const baldr::DirectedEdge* edge,
 }
 
 // Returns the cost to traverse the edge and an estimate of the actual time
-// (in seconds) to traverse the edge.
-Cost HOVCost::EdgeCost(const baldr::DirectedEdge* edge) const {
+// (in seconds) to traverse the edge at the given speed.
+Cost HOVCost::SpeedCost(const baldr::DirectedEdge* edge,
+                        const uint32_t speed) const {
 
   float factor = (edge->use() == Use::kFerry) ?
         ferry_weight_ : density_factor_[edge->density()];
@@ -913,7 +964,7 @@ Cost HOVCost::EdgeCost(const baldr::DirectedEdge* edge) const {
       !(edge->forwardaccess() & kAutoAccess))
     factor *= kHOVFactor;
 
-  float sec = (edge->length() * speedfactor_[edge->speed()]);
+  float sec = (edge->length() * speedfactor_[speed]);
   return Cost(sec * factor, sec);
 }
 
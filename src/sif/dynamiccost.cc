@@ -87,6 +87,13 @@ bool DynamicCost::AllowMultiPass() const {
   return false;
 }
 
+// Does the costing method use the historical speed profiles in the tiles.
+// Defaults to false. Costing methods that override the time of the week
+// EdgeCost method to use them must override this method too.
+bool DynamicCost::UsesSpeedProfiles() const {
+  return false;
+}
+
 // Get the cost to traverse the specified directed edge using a transit
 // departure (schedule based edge traversal). Cost includes
 // the time (seconds) to traverse the edge. Only transit cost models override
@@ -97,6 +104,14 @@ Cost DynamicCost::EdgeCost(const baldr::DirectedEdge* edge,
   return { 0.0f, 0.0f };
 }
 
+// Get the cost to traverse the specified directed edge at a time of the
+// week. Only costing models with time dependent speeds override this method.
+Cost DynamicCost::EdgeCost(const baldr::DirectedEdge* edge,
+              const baldr::GraphTile* tile,
+              const uint32_t seconds_of_week) const {
+  return EdgeCost(edge);
+}
+
 // Returns the cost to make the transition from the predecessor edge.
 // Defaults to 0. Costing models that wish to include edge transition
 // costs (i.e., intersection/turn costs) must override this method.
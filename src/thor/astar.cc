@@ -22,7 +22,9 @@ AStarPathAlgorithm::AStarPathAlgorithm()
       travel_type_(0),
       adjacencylist_(nullptr),
       edgestatus_(nullptr),
-      tile_creation_date_(0) {
+      tile_creation_date_(0),
+      time_dependent_(false),
+      start_time_(0) {
 }
 
 // Destructor
@@ -35,6 +37,7 @@ void AStarPathAlgorithm::Clear() {
   // Clear the edge labels and destination list
   edgelabels_.clear();
   destinations_.clear();
+  destination_remainders_.clear();
 
   // Clear elements from the adjacency list
   adjacencylist_.reset();
@@ -105,7 +108,9 @@ void AStarPathAlgorithm::ModifyHierarchyLimits(const float dist,
   hierarchy_limits_[1].expansion_within_dist *= factor;
 }
 
-// Calculate best path. This method is single mode, not time-dependent.
+// Calculate best path. This method is single mode. It is time-dependent
+// when the origin has a date_time: edges with a historical speed profile are
+// costed at the time of the week the path reaches them.
 std::vector<PathInfo> AStarPathAlgorithm::GetBestPath(PathLocation& origin,
              PathLocation& destination, GraphReader& graphreader,
              const std::shared_ptr<DynamicCost>* mode_costing,
@@ -122,6 +127,11 @@ std::vector<PathInfo> AStarPathAlgorithm::GetBestPath(PathLocation& origin,
   Init(origin.edges.front().projected, destination.edges.front().projected, costing);
   float mindist = astarheuristic_.GetDistance(origin.edges.front().projected);
 
+  // Get the departure time as seconds from the start of the week
+  time_dependent_ = origin.date_time_ && *origin.date_time_ != "current";
+  start_time_ = time_dependent_ ?
+      DateTime::seconds_from_week_start(*origin.date_time_) : 0;
+
   // Initialize the origin and destination locations. Initialize the
   // destination first in case the origin edge includes a destination edge.
   uint32_t density = SetDestination(graphreader, destination, costing);
@@ -262,15 +272,20 @@ std::vector<PathInfo> AStarPathAlgorithm::GetBestPath(PathLocation& origin,
       // Update the_shortcuts mask
       shortcuts |= directededge->shortcut();
 
-      // Compute the cost to the end of this edge
-      Cost newcost = pred.cost() + costing->EdgeCost(directededge) +
+      // Compute the cost to the end of this edge. If time-dependent use the
+      // time of the week at which the edge is entered.
+      Cost edgecost = time_dependent_ ?
+          costing->EdgeCost(directededge, tile, (start_time_ +
+              static_cast<uint32_t>(pred.cost().secs)) % kSecondsPerWeek) :
+          costing->EdgeCost(directededge);
+      Cost newcost = pred.cost() + edgecost +
 			     costing->TransitionCost(directededge, nodeinfo, pred);
 
       // If this edge is a destination, subtract the partial/remainder cost
       // (cost from the dest. location to the end of the edge).
       auto p = destinations_.find(edgeid);
       if (p != destinations_.end()) {
-        newcost -= p->second;
+        newcost -= RemainderCost(edgeid, directededge, edgecost, costing);
       }
 
       // Check if edge is temporarily labeled and this path has less cost. If
@@ -353,9 +368,12 @@ void AStarPathAlgorithm::SetOrigin(GraphReader& graphreader,
       continue;
     }
 
-    // Get cost
+    // Get cost. If time-dependent use the departure time
     nodeinfo = endtile->node(directededge->endnode());
-    Cost cost = costing->EdgeCost(directededge) * (1.0f - edge.dist);
+    Cost edgecost = time_dependent_ ?
+        costing->EdgeCost(directededge, tile, start_time_) :
+        costing->EdgeCost(directededge);
+    Cost cost = edgecost * (1.0f - edge.dist);
     float dist = astarheuristic_.GetDistance(nodeinfo->latlng());
 
     // We need to penalize this location based on its score (distance in meters from input)
@@ -373,7 +391,7 @@ void AStarPathAlgorithm::SetOrigin(GraphReader& graphreader,
         // a trivial route passes along a single edge, meaning that the
         // destination point must be on this edge, and so the distance
         // remaining must be zero.
-        cost -= p->second;
+        cost -= RemainderCost(edgeid, directededge, edgecost, costing);
         dist = 0.0;
       }
     }
@@ -394,11 +412,13 @@ void AStarPathAlgorithm::SetOrigin(GraphReader& graphreader,
     edgelabels_.push_back(std::move(edge_label));
   }
 
-  // Set the origin timezone
+  // Set the origin timezone, without one there is no local time to start at
   if (nodeinfo != nullptr && origin.date_time_ &&
 	  *origin.date_time_ == "current") {
     origin.date_time_= DateTime::iso_date_time(
     		DateTime::get_tz_db().from_index(nodeinfo->timezone()));
+    if (origin.date_time_->empty())
+      origin.date_time_.reset();
   }
 }
 
@@ -426,6 +446,7 @@ uint32_t AStarPathAlgorithm::SetDestination(GraphReader& graphreader,
     const GraphTile* tile = graphreader.GetGraphTile(edge.id);
     destinations_[edge.id] = costing->EdgeCost(tile->directededge(edge.id)) *
                                 (1.0f - edge.dist);
+    destination_remainders_[edge.id] = 1.0f - edge.dist;
 
     // We need to penalize this location based on its score (distance in meters from input)
     // We assume the slowest speed you could travel to cover that distance to start/end the route
@@ -438,6 +459,20 @@ uint32_t AStarPathAlgorithm::SetDestination(GraphReader& graphreader,
   return density;
 }
 
+// Get the cost of the part of a destination edge past the destination. A
+// time dependent path swaps the time invariant cost of it for one at the
+// speed the edge had when the path entered it (the location score is kept).
+Cost AStarPathAlgorithm::RemainderCost(const GraphId& edgeid,
+                 const DirectedEdge* edge, const Cost& edgecost,
+                 const std::shared_ptr<DynamicCost>& costing) const {
+  Cost remainder = destinations_.find(edgeid)->second;
+  if (time_dependent_) {
+    remainder += (edgecost - costing->EdgeCost(edge)) *
+                   destination_remainders_.find(edgeid)->second;
+  }
+  return remainder;
+}
+
 // Check for path completion along the same edge. Edge ID in question
 // is along both an origin and destination and origin shows up at the
 // beginning of the edge while the destination shows up at the end of
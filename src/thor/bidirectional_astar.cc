@@ -1,5 +1,6 @@
 #include <map>
 #include <algorithm>
+#include <unordered_set>
 #include "thor/bidirectional_astar.h"
 #include "baldr/datetime.h"
 #include "midgard/logging.h"
@@ -10,11 +11,12 @@ using namespace valhalla::sif;
 namespace {
 
 // Find a threshold to continue the search - should be based on
-// the max edge cost in the adjacency set?
-int GetThreshold(const TravelMode mode, const int n) {
-  return (mode == TravelMode::kDrive) ?
-      n + std::min(8500, std::max(100, n / 3)) :
-      n + 500;
+// the max edge cost in the adjacency set? Search further when looking
+// for alternates.
+int GetThreshold(const TravelMode mode, const int n, const bool alternates) {
+  int extend = (mode == TravelMode::kDrive) ?
+      std::min(8500, std::max(100, n / 3)) : 500;
+  return n + (alternates ? extend * valhalla::thor::kAlternateThresholdFactor : extend);
 }
 
 }
@@ -27,6 +29,7 @@ constexpr uint64_t kInitialEdgeLabelCountBD = 1000000;
 // Default constructor
 BidirectionalAStar::BidirectionalAStar(): PathAlgorithm() {
   threshold_ = 0;
+  alternates_ = 0;
   mode_ = TravelMode::kDrive;
   access_mode_ = kAutoAccess;
   travel_type_ = 0;
@@ -50,6 +53,7 @@ void BidirectionalAStar::Clear() {
   adjacencylist_reverse_.reset();
   edgestatus_forward_.reset();
   edgestatus_reverse_.reset();
+  connections_.clear();
 }
 
 // Initialize the A* heuristic and adjacency lists for both the forward
@@ -330,7 +334,20 @@ std::vector<PathInfo> BidirectionalAStar::GetBestPath(PathLocation& origin,
              PathLocation& destination, GraphReader& graphreader,
              const std::shared_ptr<DynamicCost>* mode_costing,
              const sif::TravelMode mode) {
+  auto paths = GetAlternatePaths(origin, destination, graphreader,
+                                 mode_costing, mode, 0);
+  return paths.empty() ? std::vector<PathInfo>() : std::move(paths.front());
+}
+
+// Calculate the best path and alternate paths from the connections found
+// by a single bi-directional A* search.
+std::vector<std::vector<PathInfo>> BidirectionalAStar::GetAlternatePaths(
+             PathLocation& origin, PathLocation& destination,
+             GraphReader& graphreader,
+             const std::shared_ptr<DynamicCost>* mode_costing,
+             const sif::TravelMode mode, const uint32_t alternates) {
   // Set the mode and costing
+  alternates_ = alternates;
   mode_ = mode;
   costing_ = mode_costing[static_cast<uint32_t>(mode_)];
   travel_type_ = costing_->travel_type();
@@ -380,7 +397,7 @@ std::vector<PathInfo> BidirectionalAStar::GetBestPath(PathLocation& origin,
       } else {
         // Search is exhausted. If a connection has been found, return it
         if (best_connection_.cost < std::numeric_limits<float>::max()) {
-          return FormPath(graphreader);
+          return FormPaths(graphreader);
         } else {
           // No route found.
           LOG_ERROR("Bi-directional route failure - forward search exhausted: n = " +
@@ -402,7 +419,7 @@ std::vector<PathInfo> BidirectionalAStar::GetBestPath(PathLocation& origin,
       } else {
         // Search is exhausted. If a connection has been found, return it
         if (best_connection_.cost < std::numeric_limits<float>::max()) {
-          return FormPath(graphreader);
+          return FormPaths(graphreader);
         } else {
           // No route found.
           LOG_ERROR("Bi-directional route failure - reverse search exhausted: n = " +
@@ -419,7 +436,7 @@ std::vector<PathInfo> BidirectionalAStar::GetBestPath(PathLocation& origin,
     // so for now we use this bit of a hack...stay tuned.
     if (best_connection_.cost < std::numeric_limits<float>::max()) {
       if (edgelabels_forward_.size() + edgelabels_reverse_.size() > threshold_) {
-        return FormPath(graphreader);
+        return FormPaths(graphreader);
       }
     }
 
@@ -487,7 +504,8 @@ void BidirectionalAStar::SetForwardConnection(const sif::EdgeLabel& pred) {
 
   // Set a threshold to extend search
   if (threshold_ == 0) {
-    threshold_ = GetThreshold(mode_, edgelabels_forward_.size() + edgelabels_reverse_.size());
+    threshold_ = GetThreshold(mode_, edgelabels_forward_.size() + edgelabels_reverse_.size(),
+                              alternates_ > 0);
   }
   uint32_t predidx = edgelabels_reverse_[oppedgestatus.index()].predecessor();
   float oppcost = (predidx == kInvalidLabel) ?
@@ -497,6 +515,9 @@ void BidirectionalAStar::SetForwardConnection(const sif::EdgeLabel& pred) {
   if (c < best_connection_.cost) {
     best_connection_ = { pred.edgeid(), oppedge, c };
   }
+  if (alternates_ > 0) {
+    connections_.push_back({ pred.edgeid(), oppedge, c });
+  }
 }
 
 // The edge on the reverse search connects to a reached edge on the forward
@@ -517,7 +538,8 @@ void BidirectionalAStar::SetReverseConnection(const sif::EdgeLabel& pred) {
 
   // Set a threshold to extend search
   if (threshold_ == 0) {
-    threshold_ = GetThreshold(mode_, edgelabels_forward_.size() + edgelabels_reverse_.size());
+    threshold_ = GetThreshold(mode_, edgelabels_forward_.size() + edgelabels_reverse_.size(),
+                              alternates_ > 0);
   }
   uint32_t predidx = edgelabels_forward_[oppedgestatus.index()].predecessor();
   float oppcost = (predidx == kInvalidLabel) ?
@@ -527,6 +549,9 @@ void BidirectionalAStar::SetReverseConnection(const sif::EdgeLabel& pred) {
   if (c < best_connection_.cost) {
     best_connection_ = { oppedge, pred.edgeid(), c };
   }
+  if (alternates_ > 0) {
+    connections_.push_back({ oppedge, pred.edgeid(), c });
+  }
 }
 
 // Add edges at the origin to the forward adjacency list.
@@ -583,11 +608,13 @@ void BidirectionalAStar::SetOrigin(GraphReader& graphreader,
     edgelabels_forward_.back().set_not_thru(false);
   }
 
-  // Set the origin timezone
+  // Set the origin timezone, without one there is no local time to start at
   if (nodeinfo != nullptr && origin.date_time_ &&
       *origin.date_time_ == "current") {
     origin.date_time_= DateTime::iso_date_time(
     		DateTime::get_tz_db().from_index(nodeinfo->timezone()));
+    if (origin.date_time_->empty())
+      origin.date_time_.reset();
   }
 }
 
@@ -652,11 +679,76 @@ void BidirectionalAStar::SetDestination(GraphReader& graphreader,
   }
 }
 
+// Form the best path and the alternate paths.
+std::vector<std::vector<PathInfo>> BidirectionalAStar::FormPaths(GraphReader& graphreader) {
+  std::vector<std::vector<PathInfo>> paths;
+  paths.emplace_back(FormPath(graphreader, best_connection_));
+  if (alternates_ == 0) {
+    return paths;
+  }
+
+  // Edges on the paths taken so far
+  std::unordered_set<GraphId> used;
+  for (const auto& p : paths.front()) {
+    used.insert(p.edgeid);
+  }
+
+  // Try the cheapest connections first. The forward and reverse searches
+  // can both record the same connection so skip edges already tried.
+  std::sort(connections_.begin(), connections_.end(),
+      [](const CandidateConnection& a, const CandidateConnection& b) {
+        return a.cost < b.cost;
+      });
+  float max_cost = best_connection_.cost * kAlternateMaxStretch;
+  std::unordered_set<GraphId> tried;
+  std::unordered_set<GraphId> nodes;
+  for (const auto& connection : connections_) {
+    if (paths.size() > alternates_ || connection.cost > max_cost) {
+      break;
+    }
+
+    // The path through an edge of an earlier path is mostly that path
+    if (used.count(connection.edgeid) > 0 ||
+        !tried.insert(connection.edgeid).second) {
+      continue;
+    }
+    auto path = FormPath(graphreader, connection);
+
+    // Reject paths that loop back on themselves or mostly follow the paths
+    // found so far
+    bool loop = false;
+    float length = 0.0f, shared = 0.0f;
+    nodes.clear();
+    for (const auto& p : path) {
+      const DirectedEdge* edge = graphreader.GetGraphTile(p.edgeid)->directededge(p.edgeid);
+      if (!nodes.insert(edge->endnode()).second) {
+        loop = true;
+        break;
+      }
+      length += edge->length();
+      if (used.count(p.edgeid) > 0) {
+        shared += edge->length();
+      }
+    }
+    if (loop || shared > kAlternateMaxSharing * length) {
+      continue;
+    }
+    for (const auto& p : path) {
+      used.insert(p.edgeid);
+    }
+    paths.emplace_back(std::move(path));
+  }
+  LOG_DEBUG("Found " + std::to_string(paths.size() - 1) + " alternates from " +
+           std::to_string(connections_.size()) + " connections");
+  return paths;
+}
+
 // Form the path from the adjacency list.
-std::vector<PathInfo> BidirectionalAStar::FormPath(GraphReader& graphreader) {
+std::vector<PathInfo> BidirectionalAStar::FormPath(GraphReader& graphreader,
+                              const CandidateConnection& connection) {
   // Get the indexes where the connection occurs.
-  uint32_t idx1 = edgestatus_forward_->Get(best_connection_.edgeid).index();
-  uint32_t idx2 = edgestatus_reverse_->Get(best_connection_.opp_edgeid).index();
+  uint32_t idx1 = edgestatus_forward_->Get(connection.edgeid).index();
+  uint32_t idx2 = edgestatus_reverse_->Get(connection.opp_edgeid).index();
 
   // Metrics (TODO - more accurate cost)
   uint32_t pathcost = edgelabels_forward_[idx1].cost().cost +
@@ -0,0 +1,378 @@
+#include "thor/local_search_optimizer.h"
+#include "midgard/logging.h"
+
+#include <algorithm>
+#include <random>
+#include <thread>
+
+using namespace valhalla::thor;
+using steady_clock = std::chrono::steady_clock;
+
+namespace {
+
+// Smallest change in tour cost that counts as an improvement
+constexpr double kMinImprovement = 1e-3;
+
+// Longest run of consecutive locations that Or-opt moves at once
+constexpr uint32_t kMaxSegmentLength = 3;
+
+// Number of perturbations in a row (per location) that may fail to improve
+// the best tour before a search gives up
+constexpr uint32_t kKicksPerLocation = 10;
+
+// Number of nearest unvisited locations a randomized starting tour picks from
+constexpr uint32_t kRandomizedChoices = 3;
+
+/**
+ * One iterated local search over a tour whose first and last locations are
+ * fixed. Keeps the position of every location in the tour along with the
+ * running cost of the tour in both directions so that 2-opt and Or-opt moves,
+ * including ones that reverse part of the tour, are evaluated in constant
+ * time even though costs are not symmetric.
+ */
+class LocalSearch {
+ public:
+  LocalSearch(const uint32_t count, const std::vector<float>& costs,
+              const std::vector<std::vector<uint32_t>>& successors,
+              const std::vector<std::vector<uint32_t>>& predecessors,
+              const steady_clock::time_point& deadline, const uint32_t seed)
+    : count_(count), costs_(costs), successors_(successors),
+      predecessors_(predecessors), deadline_(deadline), random_generator_(seed),
+      pos_(count), forward_(count), backward_(count) {
+  }
+
+  /**
+   * Build a starting tour, improve it, then keep perturbing and improving the
+   * best tour found until that stops paying off or time runs out.
+   * @param  randomize  Whether to randomize the starting tour.
+   * @return Returns the best tour found.
+   */
+  std::vector<uint32_t> Run(const bool randomize) {
+    NearestNeighbor(randomize);
+    Improve();
+    std::vector<uint32_t> best_tour = tour_;
+    best_cost_ = TourCost();
+
+    uint32_t stale = 0;
+    while (stale < kKicksPerLocation * count_ && !Expired()) {
+      tour_ = best_tour;
+      Perturb();
+      Improve();
+      if (TourCost() < best_cost_ - kMinImprovement) {
+        best_tour = tour_;
+        best_cost_ = TourCost();
+        stale = 0;
+      } else {
+        stale++;
+      }
+    }
+    return best_tour;
+  }
+
+  double best_cost() const {
+    return best_cost_;
+  }
+
+ protected:
+  uint32_t count_;
+  const std::vector<float>& costs_;
+  const std::vector<std::vector<uint32_t>>& successors_;
+  const std::vector<std::vector<uint32_t>>& predecessors_;
+  steady_clock::time_point deadline_;
+  std::mt19937_64 random_generator_;
+  double best_cost_;
+
+  std::vector<uint32_t> tour_;     // Current tour (order of locations)
+  std::vector<uint32_t> pos_;      // Position of each location in the tour
+  std::vector<double> forward_;    // Cost of the tour up to each position
+  std::vector<double> backward_;   // Same but traversing it in reverse
+
+  double Cost(const uint32_t loc1, const uint32_t loc2) const {
+    return costs_[(loc1 * count_) + loc2];
+  }
+
+  double TourCost() const {
+    return forward_.back();
+  }
+
+  bool Expired() const {
+    return steady_clock::now() >= deadline_;
+  }
+
+  // Recompute positions and running costs after the tour changed
+  void Update() {
+    forward_[0] = backward_[0] = 0.0;
+    pos_[tour_[0]] = 0;
+    for (uint32_t i = 1; i < count_; i++) {
+      pos_[tour_[i]] = i;
+      forward_[i] = forward_[i - 1] + Cost(tour_[i - 1], tour_[i]);
+      backward_[i] = backward_[i - 1] + Cost(tour_[i], tour_[i - 1]);
+    }
+  }
+
+  // Visit the closest unvisited location next, or if randomized one of the
+  // few closest, ending at the fixed destination
+  void NearestNeighbor(const bool randomize) {
+    std::vector<bool> visited(count_, false);
+    std::vector<uint32_t> closest;
+    tour_.assign(1, 0);
+    for (uint32_t n = 1; n < count_ - 1; n++) {
+      uint32_t current = tour_.back();
+      closest.clear();
+      for (uint32_t loc = 1; loc < count_ - 1; loc++) {
+        if (visited[loc]) {
+          continue;
+        }
+        auto itr = std::upper_bound(closest.begin(), closest.end(), loc,
+            [this, current](uint32_t a, uint32_t b) { return Cost(current, a) < Cost(current, b); });
+        closest.insert(itr, loc);
+        if (closest.size() > kRandomizedChoices) {
+          closest.pop_back();
+        }
+      }
+      uint32_t next = closest.front();
+      if (randomize) {
+        std::uniform_int_distribution<size_t> choice(0, closest.size() - 1);
+        next = closest[choice(random_generator_)];
+      }
+      visited[next] = true;
+      tour_.push_back(next);
+    }
+    tour_.push_back(count_ - 1);
+    Update();
+  }
+
+  // Apply improving moves until there are none left
+  void Improve() {
+    bool improved = true;
+    while (improved && !Expired()) {
+      improved = TwoOpt();
+      improved = OrOpt() || improved;
+    }
+  }
+
+  // Change in cost from reversing the tour between positions i and j
+  double TwoOptDelta(const uint32_t i, const uint32_t j) const {
+    return Cost(tour_[i - 1], tour_[j]) + (backward_[j] - backward_[i]) +
+           Cost(tour_[i], tour_[j + 1]) - Cost(tour_[i - 1], tour_[i]) -
+           (forward_[j] - forward_[i]) - Cost(tour_[j], tour_[j + 1]);
+  }
+
+  // Reverse portions of the tour so that one of the new connections is to a
+  // close neighbor
+  bool TwoOpt() {
+    bool improved = false;
+    uint32_t last = count_ - 2;
+    for (uint32_t i = 1; i <= last; i++) {
+      // Connect the location before i to one of its closest successors
+      for (auto loc : successors_[tour_[i - 1]]) {
+        uint32_t j = pos_[loc];
+        if (j > i && j <= last && TwoOptDelta(i, j) < -kMinImprovement) {
+          std::reverse(tour_.begin() + i, tour_.begin() + j + 1);
+          Update();
+          improved = true;
+        }
+      }
+    }
+    for (uint32_t j = 1; j <= last; j++) {
+      // Connect the location after j to one of its closest predecessors
+      for (auto loc : predecessors_[tour_[j + 1]]) {
+        uint32_t i = pos_[loc];
+        if (i >= 1 && i < j && TwoOptDelta(i, j) < -kMinImprovement) {
+          std::reverse(tour_.begin() + i, tour_.begin() + j + 1);
+          Update();
+          improved = true;
+        }
+      }
+    }
+    return improved;
+  }
+
+  // Change in cost from moving the locations between positions i and e in
+  // between the locations at positions p and p + 1, reversing them or not
+  double OrOptDelta(const uint32_t i, const uint32_t e, const uint32_t p,
+                    const bool reverse) const {
+    double removed = Cost(tour_[i - 1], tour_[i]) + Cost(tour_[e], tour_[e + 1]) +
+                     Cost(tour_[p], tour_[p + 1]);
+    double added = Cost(tour_[i - 1], tour_[e + 1]);
+    if (reverse) {
+      added += Cost(tour_[p], tour_[e]) + Cost(tour_[i], tour_[p + 1]) +
+               (backward_[e] - backward_[i]) - (forward_[e] - forward_[i]);
+    } else {
+      added += Cost(tour_[p], tour_[i]) + Cost(tour_[e], tour_[p + 1]);
+    }
+    return added - removed;
+  }
+
+  // Move the locations between positions i and e after position p if that
+  // improves the tour. Returns true if the tour changed.
+  bool TryMove(const uint32_t i, const uint32_t e, const uint32_t p) {
+    // Moving next to where it already is would just be a 2-opt move
+    if (p + 1 >= i && p <= e) {
+      return false;
+    }
+    double forward = OrOptDelta(i, e, p, false);
+    double reverse = OrOptDelta(i, e, p, true);
+    if (std::min(forward, reverse) >= -kMinImprovement) {
+      return false;
+    }
+
+    // Rotate the segment into place, it ends up starting at first
+    uint32_t first;
+    if (p < i) {
+      std::rotate(tour_.begin() + p + 1, tour_.begin() + i, tour_.begin() + e + 1);
+      first = p + 1;
+    } else {
+      std::rotate(tour_.begin() + i, tour_.begin() + e + 1, tour_.begin() + p + 1);
+      first = p - (e - i);
+    }
+    if (reverse < forward) {
+      std::reverse(tour_.begin() + first, tour_.begin() + first + (e - i) + 1);
+    }
+    Update();
+    return true;
+  }
+
+  // Move short runs of locations next to one of the close neighbors of
+  // either of their ends
+  bool OrOpt() {
+    bool improved = false;
+    for (uint32_t length = 1; length <= kMaxSegmentLength; length++) {
+      for (uint32_t i = 1; i + length < count_; i++) {
+        uint32_t e = i + length - 1;
+        uint32_t first = tour_[i];
+        uint32_t last = tour_[e];
+        bool moved = false;
+        for (auto loc : predecessors_[first]) {
+          if ((moved = TryMove(i, e, pos_[loc]))) break;
+        }
+        if (!moved) {
+          for (auto loc : predecessors_[last]) {
+            if ((moved = TryMove(i, e, pos_[loc]))) break;
+          }
+        }
+        if (!moved) {
+          for (auto loc : successors_[last]) {
+            if ((moved = TryMove(i, e, pos_[loc] - 1))) break;
+          }
+        }
+        if (!moved) {
+          for (auto loc : successors_[first]) {
+            if ((moved = TryMove(i, e, pos_[loc] - 1))) break;
+          }
+        }
+        improved = improved || moved;
+      }
+    }
+    return improved;
+  }
+
+  // Double bridge: swap two adjacent portions of the tour, a change that the
+  // moves above can not easily undo
+  void Perturb() {
+    std::uniform_int_distribution<uint32_t> position(1, count_ - 1);
+    uint32_t cut[3];
+    do {
+      for (auto& c : cut) {
+        c = position(random_generator_);
+      }
+      std::sort(cut, cut + 3);
+    } while (cut[0] == cut[1] || cut[1] == cut[2]);
+    std::rotate(tour_.begin() + cut[0], tour_.begin() + cut[1], tour_.begin() + cut[2]);
+    Update();
+  }
+};
+
+}
+
+namespace valhalla {
+namespace thor {
+
+LocalSearchOptimizer::LocalSearchOptimizer(const uint32_t threads,
+        const std::chrono::milliseconds& time_limit)
+    : threads_(std::max(threads, 1u)), time_limit_(time_limit), seed_(0) {
+}
+
+// Optimize the tour through a set of locations given the cost matrix
+// among all locations. The first location (origin) and last location
+// (destination) remain fixed in the tour.
+std::vector<uint32_t> LocalSearchOptimizer::Solve(const uint32_t count,
+        const std::vector<float>& costs) const {
+  // Handle trivial cases.
+  if (count <= 3) {
+    std::vector<uint32_t> tour(count);
+    for (uint32_t i = 0; i < count; i++) {
+      tour[i] = i;
+    }
+    return tour;
+  } else if (count == 4) {
+    // Only one possible way to alter the path.
+    std::vector<uint32_t> tour1 = { 0, 1, 2, 3 };
+    std::vector<uint32_t> tour2 = { 0, 2, 1, 3 };
+    return (TourCost(count, costs, tour1) < TourCost(count, costs, tour2)) ? tour1 : tour2;
+  }
+  auto deadline = steady_clock::now() + time_limit_;
+
+  // Find the closest successors and predecessors of each location. Nothing
+  // comes before the origin or after the destination.
+  uint32_t neighbors = std::min(kOptimizerNeighbors, count - 2);
+  std::vector<std::vector<uint32_t>> successors(count), predecessors(count);
+  std::vector<uint32_t> candidates;
+  for (uint32_t loc = 0; loc < count; loc++) {
+    if (loc != count - 1) {
+      candidates.clear();
+      for (uint32_t to = 1; to < count; to++) {
+        if (to != loc) candidates.push_back(to);
+      }
+      std::partial_sort(candidates.begin(), candidates.begin() + neighbors, candidates.end(),
+          [&costs, count, loc](uint32_t a, uint32_t b) { return costs[loc * count + a] < costs[loc * count + b]; });
+      successors[loc].assign(candidates.begin(), candidates.begin() + neighbors);
+    }
+    if (loc != 0) {
+      candidates.clear();
+      for (uint32_t from = 0; from < count - 1; from++) {
+        if (from != loc) candidates.push_back(from);
+      }
+      std::partial_sort(candidates.begin(), candidates.begin() + neighbors, candidates.end(),
+          [&costs, count, loc](uint32_t a, uint32_t b) { return costs[a * count + loc] < costs[b * count + loc]; });
+      predecessors[loc].assign(candidates.begin(), candidates.begin() + neighbors);
+    }
+  }
+
+  // Run a search per thread, the first starting from the plain nearest
+  // neighbor tour and the rest from randomized ones
+  std::vector<std::vector<uint32_t>> tours(threads_);
+  std::vector<double> tour_costs(threads_);
+  auto search = [&](uint32_t index) {
+    LocalSearch local_search(count, costs, successors, predecessors, deadline, seed_ + index);
+    tours[index] = local_search.Run(index > 0);
+    tour_costs[index] = local_search.best_cost();
+  };
+  std::vector<std::thread> workers;
+  for (uint32_t i = 1; i < threads_; i++) {
+    workers.emplace_back(search, i);
+  }
+  search(0);
+  for (auto& worker : workers) {
+    worker.join();
+  }
+
+  // Return the best tour
+  auto best = std::min_element(tour_costs.begin(), tour_costs.end()) - tour_costs.begin();
+  LOG_DEBUG("Best tour cost = " + std::to_string(tour_costs[best]) +
+            " timed out = " + std::to_string(steady_clock::now() >= deadline));
+  return tours[best];
+}
+
+// Get the cost for the specified tour (order of locations).
+float LocalSearchOptimizer::TourCost(const uint32_t count,
+        const std::vector<float>& costs, const std::vector<uint32_t>& tour) {
+  float c = 0;
+  for (uint32_t i = 0; i + 1 < count; i++) {
+    c += costs[(tour[i] * count) + tour[i+1]];
+  }
+  return c;
+}
+
+}
+}
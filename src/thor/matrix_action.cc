@@ -6,6 +6,7 @@ using namespace prime_server;
 #include "midgard/logging.h"
 #include "midgard/constants.h"
 #include "baldr/json.h"
+#include "baldr/json_writer.h"
 #include "sif/autocost.h"
 #include "sif/bicyclecost.h"
 #include "sif/pedestriancost.h"
@@ -42,67 +43,61 @@ namespace {
 
 
   constexpr double kMilePerMeter = 0.000621371;
-  const headers_t::value_type CORS{"Access-Control-Allow-Origin", "*"};
-  const headers_t::value_type JSON_MIME{"Content-type", "application/json;charset=utf-8"};
-  const headers_t::value_type JS_MIME{"Content-type", "application/javascript;charset=utf-8"};
 
-  json::ArrayPtr locations(const std::vector<baldr::PathLocation>& correlated) {
-    auto input_locs = json::array({});
+  void locations(const char* key, const std::vector<baldr::PathLocation>& correlated, json::writer_t& writer) {
+    writer.start_array(key);
+    writer.start_array();
     for(size_t i = 0; i < correlated.size(); i++) {
-      input_locs->emplace_back(
-        json::map({
-          {"lat", json::fp_t{correlated[i].latlng_.lat(), 6}},
-          {"lon", json::fp_t{correlated[i].latlng_.lng(), 6}}
-        })
-      );
+      writer.start_object();
+      writer("lat", json::fp_t{correlated[i].latlng_.lat(), 6});
+      writer("lon", json::fp_t{correlated[i].latlng_.lng(), 6});
+      writer.end_object();
     }
-    return input_locs;
+    writer.end_array();
+    writer.end_array();
   }
 
-  json::ArrayPtr serialize_row(const std::vector<TimeDistance>& tds,
-      size_t start_td, const size_t td_count, const size_t source_index, const size_t target_index, double distance_scale) {
-    auto row = json::array({});
+  void serialize_row(const std::vector<TimeDistance>& tds,
+      size_t start_td, const size_t td_count, const size_t source_index, const size_t target_index, double distance_scale,
+      json::writer_t& writer) {
+    writer.start_array();
     for(size_t i = start_td; i < start_td + td_count; ++i) {
+      writer.start_object();
+      writer("from_index", static_cast<uint64_t>(source_index));
+      writer("to_index", static_cast<uint64_t>(target_index + (i - start_td)));
       //check to make sure a route was found; if not, return null for distance & time in matrix result
       if (tds[i].time != kMaxCost) {
-        row->emplace_back(json::map({
-          {"from_index", static_cast<uint64_t>(source_index)},
-          {"to_index", static_cast<uint64_t>(target_index + (i - start_td))},
-          {"time", static_cast<uint64_t>(tds[i].time)},
-          {"distance", json::fp_t{tds[i].dist * distance_scale, 3}}
-        }));
+        writer("time", static_cast<uint64_t>(tds[i].time));
+        writer("distance", json::fp_t{tds[i].dist * distance_scale, 3});
       } else {
-        row->emplace_back(json::map({
-          {"from_index", static_cast<uint64_t>(source_index)},
-          {"to_index", static_cast<uint64_t>(target_index + (i - start_td))},
-          {"time", static_cast<std::nullptr_t>(nullptr)},
-          {"distance", static_cast<std::nullptr_t>(nullptr)}
-        }));
+        writer("time", nullptr);
+        writer("distance", nullptr);
       }
+      writer.end_object();
     }
-    return row;
+    writer.end_array();
   }
 
-  json::MapPtr serialize(const std::string action, const boost::optional<std::string>& id, const std::vector<PathLocation>& correlated_s, const std::vector<PathLocation>& correlated_t, const std::vector<TimeDistance>& tds, std::string& units, double distance_scale) {
-    json::ArrayPtr matrix = json::array({});
+  void serialize(const std::string action, const boost::optional<std::string>& id, const std::vector<PathLocation>& correlated_s,
+      const std::vector<PathLocation>& correlated_t, const std::vector<TimeDistance>& tds, std::string& units, double distance_scale,
+      json::writer_t& writer) {
+    writer.start_object();
+    writer.start_array(action.c_str());
     for(size_t source_index = 0; source_index < correlated_s.size(); ++source_index) {
-        matrix->emplace_back(
-          serialize_row(tds, source_index * correlated_t.size(), correlated_t.size(),
-                        source_index, action == "many_to_one" ? correlated_s.size()-1 : 0, distance_scale));
+        serialize_row(tds, source_index * correlated_t.size(), correlated_t.size(),
+                      source_index, action == "many_to_one" ? correlated_s.size()-1 : 0, distance_scale, writer);
     }
-    auto json = json::map({
-      {action, matrix},
-      {"units", units},
-    });
+    writer.end_array();
+    writer("units", units);
     if (action == "sources_to_targets") {
-      json->emplace("targets", json::array({locations(correlated_t)}));
-      json->emplace("sources", json::array({locations(correlated_s)}));
+      locations("targets", correlated_t, writer);
+      locations("sources", correlated_s, writer);
     } else {
-      json->emplace("locations", json::array({locations(correlated_s.size() > correlated_t.size() ? correlated_s : correlated_t)}));
+      locations("locations", correlated_s.size() > correlated_t.size() ? correlated_s : correlated_t, writer);
     }
     if (id)
-      json->emplace("id", *id);
-    return json;
+      writer("id", *id);
+    writer.end_object();
   }
 
 }
@@ -110,7 +105,7 @@ namespace {
 namespace valhalla {
   namespace thor {
 
-    worker_t::result_t  thor_worker_t::matrix(ACTION_TYPE action, const boost::property_tree::ptree &request, http_request_info_t& request_info) {
+    std::string thor_worker_t::matrix(ACTION_TYPE action, const rapidjson::Document& request, const bool header_dnt) {
       //get time for start of request
       auto s = std::chrono::system_clock::now();
 
@@ -123,13 +118,35 @@ namespace valhalla {
 
       // Parse out units; if none specified, use kilometers
       double distance_scale = kKmPerMeter;
-      auto units = request.get<std::string>("units", "km");
+      auto units = GetFromRapidJson<std::string>(request, "/units", "km");
       if (units == "mi")
         distance_scale = kMilePerMeter;
 
-      json::MapPtr json;
       //do the real work
-      std::vector<TimeDistance> time_distances;
+      auto time_distances = source_to_target();
+      //jsonp callback if need be
+      writer.clear();
+      auto jsonp = GetOptionalFromRapidJson<std::string>(request, "/jsonp");
+      if(jsonp)
+        writer.raw(*jsonp + '(');
+      serialize(matrix_type, GetOptionalFromRapidJson<std::string>(request, "/id"), correlated_s, correlated_t,
+        time_distances, units, distance_scale, writer);
+      if(jsonp)
+        writer.raw(")");
+
+      //get processing time for thor
+      auto e = std::chrono::system_clock::now();
+      std::chrono::duration<float, std::milli> elapsed_time = e - s;
+      //log request if greater than X (ms)
+      if (!healthcheck && !header_dnt && elapsed_time.count() / (correlated_s.size() * correlated_t.size()) > long_request) {
+        LOG_WARN("thor::" + matrix_type + " matrix request elapsed time (ms)::"+ std::to_string(elapsed_time.count()));
+        LOG_WARN("thor::" + matrix_type + " matrix request exceeded threshold::"+ rapidjson::to_string(request));
+        midgard::logging::Log("valhalla_thor_long_request_matrix", " [ANALYTICS] ");
+      }
+      return writer.str();
+    }
+
+    std::vector<TimeDistance> thor_worker_t::source_to_target() {
       auto costmatrix = [&]() {
         thor::CostMatrix matrix;
         return matrix.SourceToTarget(correlated_s, correlated_t, reader, mode_costing, mode);
@@ -141,9 +158,9 @@ namespace valhalla {
       switch (source_to_target_algorithm) {
       case SELECT_OPTIMAL:
         if (correlated_s.size() + correlated_t.size() > 100) {
-          time_distances = timedistancematrix();
+          return timedistancematrix();
         } else {
-          time_distances = costmatrix();
+          return costmatrix();
         }
         /** TODO - test performance of TimeDistanceMatrix vs. CostMatrix for various
             modes and conditions (e.g. number of locations, distances between
@@ -151,49 +168,17 @@ namespace valhalla {
           switch (mode) {
           case TravelMode::kPedestrian:
           case TravelMode::kBicycle:
-            time_distances = timedistancematrix();
-            break;
+            return timedistancematrix();
           default:
-            time_distances = costmatrix();
+            return costmatrix();
           }
         } */
-        break;
       case COST_MATRIX:
-        time_distances = costmatrix();
-        break;
-      case TIME_DISTANCE_MATRIX: {
-        time_distances = timedistancematrix();
-        break;
-      }
-      }
-      json = serialize(matrix_type, request.get_optional<std::string>("id"), correlated_s, correlated_t,
-        time_distances, units, distance_scale);
-
-      //jsonp callback if need be
-      std::ostringstream stream;
-      auto jsonp = request.get_optional<std::string>("jsonp");
-      if(jsonp)
-        stream << *jsonp << '(';
-      stream << *json;
-      if(jsonp)
-        stream << ')';
-
-      //get processing time for thor
-      auto e = std::chrono::system_clock::now();
-      std::chrono::duration<float, std::milli> elapsed_time = e - s;
-      //log request if greater than X (ms)
-      if (!healthcheck && !request_info.spare && elapsed_time.count() / (correlated_s.size() * correlated_t.size()) > long_request) {
-        std::stringstream ss;
-        boost::property_tree::json_parser::write_json(ss, request, false);
-        LOG_WARN("thor::" + matrix_type + " matrix request elapsed time (ms)::"+ std::to_string(elapsed_time.count()));
-        LOG_WARN("thor::" + matrix_type + " matrix request exceeded threshold::"+ ss.str());
-        midgard::logging::Log("valhalla_thor_long_request_matrix", " [ANALYTICS] ");
+        return costmatrix();
+      case TIME_DISTANCE_MATRIX:
+      default:
+        return timedistancematrix();
       }
-      http_response_t response(200, "OK", stream.str(), headers_t{CORS, jsonp ? JS_MIME : JSON_MIME});
-      response.from_info(request_info);
-      worker_t::result_t result{false};
-      result.messages.emplace_back(response.to_string());
-      return result;
     }
   }
 }
@@ -0,0 +1,173 @@
+#include <cstdint>
+#include <prime_server/prime_server.hpp>
+
+using namespace prime_server;
+
+#include "midgard/logging.h"
+#include "midgard/constants.h"
+#include "baldr/json_writer.h"
+
+#include "thor/service.h"
+#include "thor/costmatrix.h"
+#include "thor/vehicle_router.h"
+
+using namespace valhalla;
+using namespace valhalla::midgard;
+using namespace valhalla::baldr;
+using namespace valhalla::thor;
+
+namespace {
+
+  constexpr double kMilePerMeter = 0.000621371;
+
+  //a missing time window is open on both ends
+  std::pair<float, float> time_window(const rapidjson::Value& value) {
+    return std::make_pair(GetFromRapidJson<float>(value, "/time_window/0", 0.f),
+      GetFromRapidJson<float>(value, "/time_window/1", kUnbounded));
+  }
+
+  void serialize(const VehicleRouter::Solution& solution, const std::vector<Vehicle>& vehicles,
+      const std::vector<Stop>& stops, const std::vector<TimeDistance>& tds, const std::vector<PathLocation>& correlated,
+      const boost::optional<std::string>& id, const std::string& units, double distance_scale, json::writer_t& writer) {
+    auto count = correlated.size();
+    writer.start_object();
+    writer.start_object("optimized_fleet");
+    writer.start_array("routes");
+    for(const auto& route : solution.routes) {
+      const auto& vehicle = vehicles[route.vehicle];
+      writer.start_object();
+      writer("vehicle_index", static_cast<uint64_t>(route.vehicle));
+      //the whole trip, ready to be handed to the route action
+      writer.start_array("location_indices");
+      writer(static_cast<uint64_t>(vehicle.start));
+      for(auto s : route.stops)
+        writer(static_cast<uint64_t>(stops[s].location));
+      if(vehicle.end != kOpenRoute)
+        writer(static_cast<uint64_t>(vehicle.end));
+      writer.end_array();
+      //when each stop is reached and served
+      writer.start_array("stops");
+      double distance = 0;
+      auto at = vehicle.start;
+      for(size_t i = 0; i < route.stops.size(); ++i) {
+        const auto& stop = stops[route.stops[i]];
+        distance += tds[at * count + stop.location].dist;
+        at = stop.location;
+        writer.start_object();
+        writer("location_index", static_cast<uint64_t>(stop.location));
+        writer("arrival", static_cast<uint64_t>(route.arrivals[i]));
+        writer("start", static_cast<uint64_t>(route.starts[i]));
+        writer("departure", static_cast<uint64_t>(route.starts[i] + stop.service_time));
+        writer.end_object();
+      }
+      writer.end_array();
+      if(vehicle.end != kOpenRoute)
+        distance += tds[at * count + vehicle.end].dist;
+      writer("departure", static_cast<uint64_t>(route.departure));
+      writer("arrival", static_cast<uint64_t>(route.arrival));
+      writer("time", static_cast<uint64_t>(route.travel_time));
+      writer("distance", json::fp_t{distance * distance_scale, 3});
+      writer("load", json::fp_t{route.load, 3});
+      writer.end_object();
+    }
+    writer.end_array();
+    writer.start_array("unassigned");
+    for(auto s : solution.unassigned)
+      writer(static_cast<uint64_t>(stops[s].location));
+    writer.end_array();
+    writer("time", static_cast<uint64_t>(solution.travel_time));
+    writer.end_object();
+    writer("units", units);
+    writer.start_array("locations");
+    for(const auto& location : correlated) {
+      writer.start_object();
+      writer("lat", json::fp_t{location.latlng_.lat(), 6});
+      writer("lon", json::fp_t{location.latlng_.lng(), 6});
+      writer.end_object();
+    }
+    writer.end_array();
+    if (id)
+      writer("id", *id);
+    writer.end_object();
+  }
+
+}
+
+namespace valhalla {
+  namespace thor {
+
+    std::string thor_worker_t::optimized_fleet(const rapidjson::Document& request, const bool header_dnt) {
+      //get time for start of request
+      auto s = std::chrono::system_clock::now();
+
+      parse_locations(request);
+      parse_costing(request);
+      if (!healthcheck)
+        valhalla::midgard::logging::Log("matrix_type::optimized_fleet", " [ANALYTICS] ");
+
+      // Parse out units; if none specified, use kilometers
+      double distance_scale = kKmPerMeter;
+      auto units = GetFromRapidJson<std::string>(request, "/units", "km");
+      if (units == "mi")
+        distance_scale = kMilePerMeter;
+
+      //the times between all of the locations, the ones we cant get between are infinite
+      auto time_distances = source_to_target();
+      uint32_t count = correlated_s.size();
+      std::vector<float> times;
+      times.reserve(time_distances.size());
+      for(const auto& td : time_distances)
+        times.push_back(td.time == kMaxCost ? kUnbounded : td.time);
+
+      //the vehicles start and end at depots
+      std::vector<Vehicle> vehicles;
+      std::vector<bool> depot(count, false);
+      for(const auto& vehicle : GetFromRapidJson<rapidjson::Value::ConstArray>(request, "/vehicles")) {
+        auto start = GetFromRapidJson<uint32_t>(vehicle, "/start");
+        auto end = GetFromRapidJson<uint32_t>(vehicle, "/end", kOpenRoute);
+        auto window = time_window(vehicle);
+        vehicles.emplace_back(start, end, GetFromRapidJson<float>(vehicle, "/capacity", kUnbounded),
+          window.first, window.second);
+        depot.at(start) = true;
+        if(end != kOpenRoute)
+          depot.at(end) = true;
+      }
+
+      //every other location is a stop that one of them has to make
+      std::vector<Stop> stops;
+      auto request_locations = GetFromRapidJson<rapidjson::Value::ConstArray>(request, "/sources");
+      for(uint32_t i = 0; i < count; ++i) {
+        if(depot[i])
+          continue;
+        const auto& location = request_locations[i];
+        auto window = time_window(location);
+        stops.emplace_back(i, GetFromRapidJson<float>(location, "/demand", 0.f),
+          GetFromRapidJson<float>(location, "/service_time", 0.f), window.first, window.second);
+      }
+
+      //do the real work
+      auto solution = vehicle_router.Solve(count, times, vehicles, stops);
+
+      //jsonp callback if need be
+      writer.clear();
+      if(jsonp)
+        writer.raw(*jsonp + '(');
+      serialize(solution, vehicles, stops, time_distances, correlated_s, GetOptionalFromRapidJson<std::string>(request, "/id"),
+        units, distance_scale, writer);
+      if(jsonp)
+        writer.raw(")");
+
+      //get processing time for thor
+      auto e = std::chrono::system_clock::now();
+      std::chrono::duration<float, std::milli> elapsed_time = e - s;
+      //log request if greater than X (ms)
+      if (!healthcheck && !header_dnt && elapsed_time.count() / (correlated_s.size() * correlated_t.size()) > long_request) {
+        LOG_WARN("thor::optimized_fleet elapsed time (ms)::"+ std::to_string(elapsed_time.count()));
+        LOG_WARN("thor::optimized_fleet exceeded threshold::"+ rapidjson::to_string(request));
+        midgard::logging::Log("valhalla_thor_long_request_optimized_fleet", " [ANALYTICS] ");
+      }
+      return writer.str();
+    }
+
+  }
+}
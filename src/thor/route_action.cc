@@ -1,4 +1,8 @@
 #include <cstdint>
+#include <sstream>
+#include <atomic>
+#include <thread>
+#include <exception>
 #include <prime_server/prime_server.hpp>
 
 using namespace prime_server;
@@ -20,34 +24,89 @@ using namespace valhalla::baldr;
 using namespace valhalla::sif;
 using namespace valhalla::thor;
 
-
 namespace {
 
-  const headers_t::value_type CORS{"Access-Control-Allow-Origin", "*"};
-  const headers_t::value_type JSON_MIME{"Content-type", "application/json;charset=utf-8"};
-  const headers_t::value_type JS_MIME{"Content-type", "application/javascript;charset=utf-8"};
+  // Use A* if any origin and destination edges are the same - otherwise
+  // use bidirectional A*. Bidirectional A* does not handle trivial cases
+  // with oneways. A* is also used when departing at a set time with a
+  // costing that uses speed profiles since it is the only one that uses
+  // the time dependent speeds.
+  bool use_astar(const PathLocation& origin, const PathLocation& destination,
+                 const cost_ptr_t& costing) {
+    if (origin.date_time_ && *origin.date_time_ != "current" &&
+        costing->UsesSpeedProfiles()) {
+      return true;
+    }
+    for (auto& edge1 : origin.edges) {
+      for (auto& edge2 : destination.edges) {
+        if (edge1.id == edge2.id) {
+          return true;
+        }
+      }
+    }
+    return false;
+  }
+
+  std::vector<PathInfo> find_path(PathAlgorithm* path_algorithm, PathLocation& origin,
+      PathLocation& destination, GraphReader& reader, const cost_ptr_t* mode_costing,
+      const TravelMode mode) {
+    // Find the path. If bidirectional A* disable use of destination only
+    // edges on the first pass. If there is a failure, we allow them on the
+    // second pass.
+    valhalla::sif::cost_ptr_t cost = mode_costing[static_cast<uint32_t>(mode)];
+    bool using_astar = dynamic_cast<AStarPathAlgorithm*>(path_algorithm) != nullptr;
+    if (dynamic_cast<BidirectionalAStar*>(path_algorithm) != nullptr) {
+      cost->set_allow_destination_only(false);
+    }
+    auto path = path_algorithm->GetBestPath(origin, destination, reader,
+                                             mode_costing, mode);
+    // If path is not found try again with relaxed limits (if allowed)
+    if (path.empty()) {
+      if (cost->AllowMultiPass()) {
+        // 2nd pass. Less aggressive hierarchy transitioning.
+        path_algorithm->Clear();
+        float relax_factor = using_astar ? 16.0f : 8.0f;
+        float expansion_within_factor = using_astar ? 4.0f : 2.0f;
+        cost->RelaxHierarchyLimits(relax_factor, expansion_within_factor);
+        cost->set_allow_destination_only(true);
+        path = path_algorithm->GetBestPath(origin, destination,
+                                  reader, mode_costing, mode);
+      }
+    }
+
+    // All or nothing
+    if(path.empty())
+      throw valhalla_exception_t{400, 442};
+    return path;
+  }
 
 }
 
 namespace valhalla {
   namespace thor {
 
-  worker_t::result_t thor_worker_t::route(const boost::property_tree::ptree& request, const std::string &request_str, const boost::optional<int> &date_time_type, const bool header_dnt){
+  std::list<valhalla::odin::TripPath*> thor_worker_t::route(const rapidjson::Document& request, const boost::optional<int> &date_time_type, const bool header_dnt){
     parse_locations(request);
     auto costing = parse_costing(request);
 
-    worker_t::result_t result{true};
+    //only build the parts of the trip path the request asked for
+    AttributesController controller;
+    filter_attributes(request, controller);
+
     //get time for start of request
     auto s = std::chrono::system_clock::now();
-    // Forward the original request
-    result.messages.emplace_back(request_str);
-
-    auto trippaths = (date_time_type && *date_time_type == 2) ?
-        path_arrive_by(correlated, costing, request_str) :
-        path_depart_at(correlated, costing, date_time_type, request_str);
-    for (const auto &trippath: trippaths) {
-      result.messages.emplace_back(trippath.SerializeAsString());
-    }
+
+    //alternates come from a single bidirectional search between two locations
+    std::list<valhalla::odin::TripPath*> trippaths;
+    auto alternates = GetFromRapidJson<uint32_t>(request, "/alternates", 0);
+    bool arrive_by = date_time_type && *date_time_type == 2;
+    if (alternates > 0 && !arrive_by && correlated.size() == 2 &&
+        get_path_algorithm(costing, correlated.front(), correlated.back()) == &bidir_astar)
+      trippaths = path_alternates(controller, correlated, alternates);
+    if (trippaths.empty())
+      trippaths = arrive_by ?
+            path_arrive_by(request, controller, correlated, costing) :
+          path_depart_at(request, controller, correlated, costing, date_time_type);
 
     //get processing time for thor
     auto e = std::chrono::system_clock::now();
@@ -55,67 +114,96 @@ namespace valhalla {
     //log request if greater than X (ms)
     if (!healthcheck && !header_dnt && (elapsed_time.count() / correlated.size()) > long_request) {
       LOG_WARN("thor::route trip_path elapsed time (ms)::"+ std::to_string(elapsed_time.count()));
-      LOG_WARN("thor::route trip_path exceeded threshold::"+ request_str);
+      LOG_WARN("thor::route trip_path exceeded threshold::"+ rapidjson::to_string(request));
       midgard::logging::Log("valhalla_thor_long_request_route", " [ANALYTICS] ");
     }
-    return result;
+    return trippaths;
   }
 
   thor::PathAlgorithm* thor_worker_t::get_path_algorithm(const std::string& routetype,
         const baldr::PathLocation& origin, const baldr::PathLocation& destination) {
     if (routetype == "multimodal" || routetype == "transit") {
       return &multi_modal_astar;
+    } else if (use_astar(origin, destination, mode_costing[static_cast<uint32_t>(mode)])) {
+      return &astar;
     } else {
-      // Use A* if any origin and destination edges are the same - otherwise
-      // use bidirectional A*. Bidirectional A* does not handle trivial cases
-      // with oneways.
-      for (auto& edge1 : origin.edges) {
-        for (auto& edge2 : destination.edges) {
-          if (edge1.id == edge2.id) {
-            return &astar;
-          }
-        }
-      }
       return &bidir_astar;
     }
   }
 
   std::vector<thor::PathInfo> thor_worker_t::get_path(PathAlgorithm* path_algorithm, baldr::PathLocation& origin,
       baldr::PathLocation& destination) {
-    // Find the path. If bidirectional A* disable use of destination only
-    // edges on the first pass. If there is a failure, we allow them on the
-    // second pass.
-    valhalla::sif::cost_ptr_t cost = mode_costing[static_cast<uint32_t>(mode)];
-    if (path_algorithm == &bidir_astar) {
-      cost->set_allow_destination_only(false);
-    }
-    auto path = path_algorithm->GetBestPath(origin, destination, reader,
-                                             mode_costing, mode);
-    // If path is not found try again with relaxed limits (if allowed)
-    if (path.empty()) {
-      if (cost->AllowMultiPass()) {
-        // 2nd pass. Less aggressive hierarchy transitioning.
-        path_algorithm->Clear();
-        bool using_astar = (path_algorithm == &astar);
-        float relax_factor = using_astar ? 16.0f : 8.0f;
-        float expansion_within_factor = using_astar ? 4.0f : 2.0f;
-        cost->RelaxHierarchyLimits(relax_factor, expansion_within_factor);
-        cost->set_allow_destination_only(true);
-        path = path_algorithm->GetBestPath(origin, destination,
-                                  reader, mode_costing, mode);
+    return find_path(path_algorithm, origin, destination, reader, mode_costing, mode);
+  }
+
+  std::vector<std::vector<thor::PathInfo> > thor_worker_t::leg_paths(const rapidjson::Document& request,
+      const std::vector<PathLocation>& correlated, const std::string &costing) {
+    // Only worth it with enough legs to go around. Multimodal legs and legs
+    // with a date_time depend on the time the previous leg ended so they are
+    // done in order
+    std::vector<std::vector<thor::PathInfo> > legs;
+    if (!leg_reader || correlated.size() - 1 < min_parallel_legs ||
+        costing == "multimodal" || costing == "transit" ||
+        correlated.front().date_time_ || correlated.back().date_time_)
+      return legs;
+    legs.resize(correlated.size() - 1);
+
+    // Legs get their own costing since a failed search relaxes it. Costing
+    // is made here as it is not safe to make on several threads at once
+    std::vector<valhalla::sif::cost_ptr_t> leg_costings;
+    for (size_t i = 0; i < legs.size(); ++i)
+      leg_costings.push_back(get_costing(request, costing));
+
+    // Each thread takes the next leg nobody has searched yet
+    std::atomic<size_t> next_leg(0);
+    std::atomic<bool> failed(false);
+    std::vector<std::exception_ptr> errors(leg_searchers.size() + 1);
+    auto search = [&](GraphReader& graph, AStarPathAlgorithm& leg_astar,
+        BidirectionalAStar& leg_bidir_astar, std::exception_ptr& error) {
+      try {
+        for (size_t i = next_leg++; i < legs.size() && !failed; i = next_leg++) {
+          auto origin = correlated[i];
+          auto destination = correlated[i + 1];
+          valhalla::sif::cost_ptr_t leg_costing[static_cast<int>(sif::TravelMode::kMaxTravelMode)];
+          leg_costing[static_cast<uint32_t>(mode)] = leg_costings[i];
+          PathAlgorithm* path_algorithm =
+              use_astar(origin, destination, leg_costing[static_cast<uint32_t>(mode)]) ?
+              static_cast<PathAlgorithm*>(&leg_astar) : &leg_bidir_astar;
+          path_algorithm->Clear();
+          legs[i] = find_path(path_algorithm, origin, destination, graph, leg_costing, mode);
+        }
+      }
+      catch (...) {
+        error = std::current_exception();
+        failed = true;
       }
+    };
+
+    // This thread searches too, with the path algorithms that can be
+    // interrupted and a reader that shares its tiles with the other threads
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < leg_searchers.size(); ++i) {
+      auto& searcher = *leg_searchers[i];
+      threads.emplace_back(search, std::ref(searcher.reader), std::ref(searcher.astar),
+          std::ref(searcher.bidir_astar), std::ref(errors[i + 1]));
     }
+    search(*leg_reader, astar, bidir_astar, errors.front());
+    for (auto& thread : threads)
+      thread.join();
 
     // All or nothing
-    if(path.empty())
-      throw valhalla_exception_t{400, 442};
-    return path;
+    for (const auto& error : errors) {
+      if (error)
+        std::rethrow_exception(error);
+    }
+    return legs;
   }
 
-  std::list<valhalla::odin::TripPath> thor_worker_t::path_arrive_by(std::vector<PathLocation>& correlated, const std::string &costing, const std::string &request_str) {
+  std::list<valhalla::odin::TripPath*> thor_worker_t::path_arrive_by(const rapidjson::Document& request, const AttributesController& controller, std::vector<PathLocation>& correlated, const std::string &costing) {
     // Things we'll need
+    auto legs = leg_paths(request, correlated, costing);
     std::vector<thor::PathInfo> path;
-    std::list<valhalla::odin::TripPath> trip_paths;
+    std::list<valhalla::odin::TripPath*> trip_paths;
     correlated.front().stoptype_ = correlated.back().stoptype_ = Location::StopType::BREAK;
 
     // For each pair of locations
@@ -135,8 +223,14 @@ namespace valhalla {
         destination->edges.erase(erasure_position, destination->edges.end());
       }
 
-      // Get best path and keep it
-      auto temp_path = get_path(path_algorithm, *origin, *destination);
+      // Get best path and keep it. A leg searched up front is only good if it
+      // ends on the edge the next leg started on
+      std::vector<thor::PathInfo> temp_path;
+      auto leg = std::distance(origin, correlated.rend()) - 1;
+      if(!legs.empty() && (path.empty() || legs[leg].back().edgeid == path.front().edgeid))
+        temp_path.swap(legs[leg]);
+      else
+        temp_path = get_path(path_algorithm, *origin, *destination);
       temp_path.swap(path);
 
       // Merge through legs by updating the time and splicing the lists
@@ -157,19 +251,18 @@ namespace valhalla {
           --destination;
         }
 
-        // Create controller for default route attributes
-        AttributesController controller;
-
-        // Form output information based on path edges
-        auto trip_path = thor::TripPathBuilder::Build(controller, reader, mode_costing, path,
-                                                      *origin, *destination, throughs, interrupt_callback);
+        // Form output information based on path edges, keep it in the arena
+        // so its nodes and edges are all freed in one go after the request
+        auto* trip_path = arena.create<odin::TripPath>();
+        thor::TripPathBuilder::Build(*trip_path, controller, reader, mode_costing, path,
+                                     *origin, *destination, throughs, interrupt_callback);
         path.clear();
 
-        // Keep the protobuf path
-        trip_paths.emplace_back(std::move(trip_path));
+        // Keep the protobuf path, the legs are found from the last one back
+        trip_paths.emplace_front(trip_path);
 
         // Some logging
-        log_admin(trip_paths.back());
+        log_admin(*trip_path);
       }
     }
 
@@ -177,10 +270,39 @@ namespace valhalla {
     return trip_paths;
   }
 
-  std::list<valhalla::odin::TripPath> thor_worker_t::path_depart_at(std::vector<PathLocation>& correlated, const std::string &costing, const boost::optional<int> &date_time_type, const std::string &request_str) {
+  std::list<valhalla::odin::TripPath*> thor_worker_t::path_alternates(const AttributesController& controller, std::vector<PathLocation>& correlated, const uint32_t alternates) {
+    // Use the same first pass as get_path, if it fails the caller falls back
+    // to the regular route which can relax the costing
+    auto& origin = correlated.front();
+    auto& destination = correlated.back();
+    origin.stoptype_ = destination.stoptype_ = Location::StopType::BREAK;
+    bidir_astar.Clear();
+    mode_costing[static_cast<uint32_t>(mode)]->set_allow_destination_only(false);
+    auto paths = bidir_astar.GetAlternatePaths(origin, destination, reader,
+                                               mode_costing, mode, alternates);
+    bidir_astar.Clear();
+
+    // Each path is its own trip, the first one is the best
+    std::list<valhalla::odin::TripPath*> trip_paths;
+    for (size_t i = 0; i < paths.size(); ++i) {
+      auto* trip_path = arena.create<odin::TripPath>();
+      thor::TripPathBuilder::Build(*trip_path, controller, reader, mode_costing, paths[i],
+                                   origin, destination, {}, interrupt_callback);
+      trip_path->set_trip_id(i);
+      trip_paths.emplace_back(trip_path);
+    }
+
+    // Some logging
+    if (!trip_paths.empty())
+      log_admin(*trip_paths.front());
+    return trip_paths;
+  }
+
+  std::list<valhalla::odin::TripPath*> thor_worker_t::path_depart_at(const rapidjson::Document& request, const AttributesController& controller, std::vector<PathLocation>& correlated, const std::string &costing, const boost::optional<int> &date_time_type) {
     // Things we'll need
+    auto legs = leg_paths(request, correlated, costing);
     std::vector<thor::PathInfo> path;
-    std::list<valhalla::odin::TripPath> trip_paths;
+    std::list<valhalla::odin::TripPath*> trip_paths;
     correlated.front().stoptype_ = correlated.back().stoptype_ = Location::StopType::BREAK;
 
     // For each pair of locations
@@ -200,8 +322,14 @@ namespace valhalla {
         origin->edges.erase(erasure_position, origin->edges.end());
       }
 
-      // Get best path and keep it
-      auto temp_path = get_path(path_algorithm, *origin, *destination);
+      // Get best path and keep it. A leg searched up front is only good if it
+      // starts on the edge the previous leg ended on
+      std::vector<thor::PathInfo> temp_path;
+      auto leg = std::distance(correlated.begin(), origin);
+      if(!legs.empty() && (path.empty() || legs[leg].front().edgeid == path.back().edgeid))
+        temp_path.swap(legs[leg]);
+      else
+        temp_path = get_path(path_algorithm, *origin, *destination);
 
       // Merge through legs by updating the time and splicing the lists
       if(!path.empty()) {
@@ -223,19 +351,18 @@ namespace valhalla {
           --origin;
         }
 
-        // Create controller for default route attributes
-        AttributesController controller;
-
-        // Form output information based on path edges
-        auto trip_path = thor::TripPathBuilder::Build(controller, reader, mode_costing, path,
-                                                      *origin, *destination, throughs, interrupt_callback);
+        // Form output information based on path edges, keep it in the arena
+        // so its nodes and edges are all freed in one go after the request
+        auto* trip_path = arena.create<odin::TripPath>();
+        thor::TripPathBuilder::Build(*trip_path, controller, reader, mode_costing, path,
+                                     *origin, *destination, throughs, interrupt_callback);
         path.clear();
 
         // Keep the protobuf path
-        trip_paths.emplace_back(std::move(trip_path));
+        trip_paths.emplace_back(trip_path);
 
         // Some logging
-        log_admin(trip_paths.back());
+        log_admin(*trip_path);
       }
     }
 
@@ -34,17 +34,17 @@ namespace {
   const headers_t::value_type JSON_MIME{"Content-type", "application/json;charset=utf-8"};
   const headers_t::value_type JS_MIME{"Content-type", "application/javascript;charset=utf-8"};
 
-  std::vector<baldr::PathLocation> store_correlated_locations(const boost::property_tree::ptree& request, const std::vector<baldr::Location>& locations) {
+  std::vector<baldr::PathLocation> store_correlated_locations(const rapidjson::Document& request, const std::vector<baldr::Location>& locations) {
     //we require correlated locations
     std::vector<baldr::PathLocation> correlated;
     correlated.reserve(locations.size());
     size_t i = 0;
     do {
-      auto path_location = request.get_child_optional("correlated_" + std::to_string(i));
-      if(!path_location)
+      auto path_location = request.FindMember(("correlated_" + std::to_string(i)).c_str());
+      if(path_location == request.MemberEnd())
         break;
       try {
-        correlated.emplace_back(PathLocation::FromPtree(locations, *path_location));
+        correlated.emplace_back(PathLocation::FromRapidJson(locations, path_location->value));
       }
       catch (...) {
         throw valhalla_exception_t{400, 420};
@@ -65,8 +65,14 @@ namespace valhalla {
 
     thor_worker_t::thor_worker_t(const boost::property_tree::ptree& config):
       mode(valhalla::sif::TravelMode::kPedestrian),
-      config(config), matcher_factory(config), reader(matcher_factory.graphreader()),
-      long_request(config.get<float>("thor.logging.long_request")){
+      config(config),
+      optimizer(config.get<uint32_t>("thor.optimizer.threads", 1),
+                std::chrono::milliseconds(config.get<uint32_t>("thor.optimizer.time_limit",
+                    kDefaultOptimizerTimeLimit.count()))),
+      vehicle_router(std::chrono::milliseconds(config.get<uint32_t>("thor.optimizer.time_limit",
+                    kDefaultOptimizerTimeLimit.count()))),
+      long_request(config.get<float>("thor.logging.long_request")),
+      matcher_factory(config), reader(matcher_factory.graphreader()){
       // Register edge/node costing methods
       factory.Register("auto", sif::CreateAutoCost);
       factory.Register("auto_shorter", sif::CreateAutoShorterCost);
@@ -93,11 +99,33 @@ namespace valhalla {
         source_to_target_algorithm = SELECT_OPTIMAL;
       }
 
+      // Extra threads to search the legs of long routes with. The readers of
+      // the legs forward the tiles they load to each other (but not to those
+      // of other workers) so each tile is only read once
+      auto route_threads = config.get<unsigned int>("thor.route.threads", 1);
+      min_parallel_legs = config.get<size_t>("thor.route.min_parallel_legs", 4);
+      if (route_threads > 1) {
+        const auto& leg_reader_config = config.get_child("mjolnir");
+        std::shared_ptr<baldr::CopyForwardingTileCache::group_t> leg_caches(
+            new baldr::CopyForwardingTileCache::group_t);
+        leg_reader.reset(new baldr::GraphReader(leg_reader_config, std::unique_ptr<baldr::TileCache>(
+            baldr::TileCacheFactory::createTileCache(leg_reader_config, leg_caches))));
+        for (unsigned int i = 1; i < route_threads; ++i) {
+          leg_searchers.emplace_back(new leg_searcher_t(leg_reader_config, leg_caches));
+        }
+      }
+
       interrupt_callback = nullptr;
     }
 
     thor_worker_t::~thor_worker_t(){}
 
+    thor_worker_t::leg_searcher_t::leg_searcher_t(const boost::property_tree::ptree& config,
+        const std::shared_ptr<baldr::CopyForwardingTileCache::group_t>& caches):
+      reader(config, std::unique_ptr<baldr::TileCache>(
+          baldr::TileCacheFactory::createTileCache(config, caches))) {
+    }
+
     worker_t::result_t thor_worker_t::jsonify_error(const valhalla_exception_t& exception, http_request_info_t& request_info) const {
 
        //build up the json map
@@ -124,63 +152,44 @@ namespace valhalla {
     }
 
     worker_t::result_t thor_worker_t::work(const std::list<zmq::message_t>& job, void* request_info, const worker_t::interrupt_function_t& interrupt) {
-      //get time for start of request
-      auto s = std::chrono::system_clock::now();
       auto& info = *static_cast<http_request_info_t*>(request_info);
       LOG_INFO("Got Thor Request " + std::to_string(info.id));
       try{
         //get some info about what we need to do
-        boost::property_tree::ptree request;
+        rapidjson::Document request;
         std::string request_str(static_cast<const char*>(job.front().data()), job.front().size());
-        std::stringstream stream(request_str);
-        try {
-          boost::property_tree::read_json(stream, request);
-          jsonp = request.get_optional<std::string>("jsonp");
-        }
-        catch(const std::exception& e) {
-          valhalla::midgard::logging::Log("500::" + std::string(e.what()), " [ANALYTICS] ");
-          return jsonify_error({500, 499, std::string(e.what())}, info);
+        request.Parse(request_str.c_str(), request_str.size());
+        if(request.HasParseError()) {
+          std::string error = rapidjson::GetParseError_En(request.GetParseError());
+          valhalla::midgard::logging::Log("500::" + error, " [ANALYTICS] ");
+          return jsonify_error({500, 499, error}, info);
         }
-        catch(...) {
-          valhalla::midgard::logging::Log("500::non-std::exception", " [ANALYTICS] ");
-          return jsonify_error({500, 401}, info);
+        jsonp = GetOptionalFromRapidJson<std::string>(request, "/jsonp");
+
+        //trace requests carry their shape in binary as the next message
+        odin::Trace request_trace;
+        if(job.size() > 1 && !request_trace.ParseFromArray(job.back().data(), job.back().size()))
+          throw valhalla_exception_t{400, 424};
+
+        //do our part of it
+        std::list<odin::TripPath*> trip_paths;
+        auto response = act(request, request_trace, info, interrupt, trip_paths);
+
+        //we answered it ourselves
+        if(response) {
+          worker_t::result_t result{false};
+          http_response_t http_response(200, "OK", *response, headers_t{CORS, jsonp ? JS_MIME : JSON_MIME});
+          http_response.from_info(info);
+          result.messages.emplace_back(http_response.to_string());
+          return result;
         }
 
-        // Set the interrupt function
-        interrupt_callback = &interrupt;
-
-        //flag healthcheck requests; do not send to logstash
-        healthcheck = request.get<bool>("healthcheck", false);
-        // Initialize request - get the PathALgorithm to use
-        ACTION_TYPE action = static_cast<ACTION_TYPE>(request.get<int>("action"));
-        boost::optional<int> date_time_type;
-        if (request.find("date_time.type") != request.not_found())
-          date_time_type = request.get<float>("date_time.type");
-        // Allow the request to be aborted
-        astar.set_interrupt(&interrupt);
-        bidir_astar.set_interrupt(&interrupt);
-        multi_modal_astar.set_interrupt(&interrupt);
-        //what action is it
-        switch (action) {
-          case ONE_TO_MANY:
-          case MANY_TO_ONE:
-          case MANY_TO_MANY:
-          case SOURCES_TO_TARGETS:
-            return matrix(action, request, info);
-          case OPTIMIZED_ROUTE:
-            return optimized_route(request, request_str, info.spare);
-          case ISOCHRONE:
-            return isochrone(request, info);
-          case ROUTE:
-          case VIAROUTE:
-            return route(request, request_str, date_time_type, info.spare);
-          case TRACE_ROUTE:
-            return trace_route(request, request_str, info.spare);
-          case TRACE_ATTRIBUTES:
-            return trace_attributes(request, request_str, info);
-          default:
-            throw valhalla_exception_t{400, 400}; //this should never happen
-        }
+        //forward the original request along with the paths
+        worker_t::result_t result{true};
+        result.messages.emplace_back(std::move(request_str));
+        for(const auto* trip_path : trip_paths)
+          result.messages.emplace_back(trip_path->SerializeAsString());
+        return result;
       }
       catch(const valhalla_exception_t& e) {
         valhalla::midgard::logging::Log("400::" + std::string(e.what()), " [ANALYTICS] ");
@@ -192,18 +201,66 @@ namespace valhalla {
       }
     }
 
+    boost::optional<std::string> thor_worker_t::act(const rapidjson::Document& request, odin::Trace& request_trace,
+        http_request_info_t& request_info, const worker_t::interrupt_function_t& interrupt, std::list<odin::TripPath*>& trip_paths) {
+      jsonp = GetOptionalFromRapidJson<std::string>(request, "/jsonp");
+      trace.Swap(&request_trace);
+
+      // Set the interrupt function
+      interrupt_callback = &interrupt;
+
+      //flag healthcheck requests; do not send to logstash
+      healthcheck = GetFromRapidJson<bool>(request, "/healthcheck", false);
+      // Initialize request - get the PathALgorithm to use
+      ACTION_TYPE action = static_cast<ACTION_TYPE>(GetFromRapidJson<int>(request, "/action"));
+      auto date_time_type = GetOptionalFromRapidJson<int>(request, "/date_time/type");
+      // Allow the request to be aborted
+      astar.set_interrupt(&interrupt);
+      bidir_astar.set_interrupt(&interrupt);
+      multi_modal_astar.set_interrupt(&interrupt);
+      //what action is it
+      switch (action) {
+        case ONE_TO_MANY:
+        case MANY_TO_ONE:
+        case MANY_TO_MANY:
+        case SOURCES_TO_TARGETS:
+          return matrix(action, request, request_info.spare);
+        case OPTIMIZED_ROUTE:
+          trip_paths = optimized_route(request, request_info.spare);
+          break;
+        case OPTIMIZED_FLEET:
+          return optimized_fleet(request, request_info.spare);
+        case ISOCHRONE:
+          return isochrone(request, request_info.spare);
+        case ROUTE:
+        case VIAROUTE:
+          trip_paths = route(request, date_time_type, request_info.spare);
+          break;
+        case TRACE_ROUTE:
+          trip_paths = trace_route(request, request_info.spare);
+          break;
+        case TRACE_ATTRIBUTES:
+          return trace_attributes(request, request_info.spare);
+        default:
+          throw valhalla_exception_t{400, 400}; //this should never happen
+      }
+      return boost::none;
+    }
+
     // Get the costing options if in the config or get the empty default.
     // Creates the cost in the cost factory
-    valhalla::sif::cost_ptr_t thor_worker_t::get_costing(const boost::property_tree::ptree& request,
+    valhalla::sif::cost_ptr_t thor_worker_t::get_costing(const rapidjson::Document& request,
                                           const std::string& costing) {
-      std::string method_options = "costing_options." + costing;
-      auto costing_options = request.get_child(method_options, {});
-      return factory.Create(costing, costing_options);
+      auto method_options = "/costing_options/" + costing;
+      const auto* costing_options = rapidjson::Pointer{method_options}.Get(request);
+      if(!costing_options)
+        return factory.Create(costing, boost::property_tree::ptree{});
+      return factory.Create(costing, *costing_options);
     }
 
-    std::string thor_worker_t::parse_costing(const boost::property_tree::ptree& request) {
+    std::string thor_worker_t::parse_costing(const rapidjson::Document& request) {
       // Parse out the type of route - this provides the costing method to use
-      auto costing = request.get<std::string>("costing");
+      auto costing = GetFromRapidJson<std::string>(request, "/costing");
 
       // Set travel mode and construct costing
       if (costing == "multimodal" || costing == "transit") {
@@ -223,57 +280,67 @@ namespace valhalla {
       return costing;
     }
 
-    void thor_worker_t::parse_locations(const boost::property_tree::ptree& request) {
+    void thor_worker_t::parse_locations(const rapidjson::Document& request) {
       //we require locations
-      auto request_locations = request.get_child_optional("locations");
-      auto request_sources = request.get_child_optional("sources");
-      auto request_targets = request.get_child_optional("targets");
+      auto request_locations = GetOptionalFromRapidJson<rapidjson::Value::ConstArray>(request, "/locations");
+      auto request_sources = GetOptionalFromRapidJson<rapidjson::Value::ConstArray>(request, "/sources");
+      auto request_targets = GetOptionalFromRapidJson<rapidjson::Value::ConstArray>(request, "/targets");
       if(request_locations) {
         for(const auto& location : *request_locations) {
-          try{ locations.push_back(baldr::Location::FromPtree(location.second)); }
+          try{ locations.push_back(baldr::Location::FromRapidJson(location, 50)); }
           catch (...) { throw valhalla_exception_t{400, 421}; }
         }
         correlated = store_correlated_locations(request, locations);
       }//if we have a sources and targets request here we will divvy up the correlated amongst them
       else if(request_sources && request_targets) {
         for(const auto& s : *request_sources) {
-          try{ locations.push_back(baldr::Location::FromPtree(s.second)); }
+          try{ locations.push_back(baldr::Location::FromRapidJson(s, 50)); }
           catch (...) { throw valhalla_exception_t{400, 422}; }
         }
         for(const auto& t : *request_targets) {
-          try{ locations.push_back(baldr::Location::FromPtree(t.second)); }
+          try{ locations.push_back(baldr::Location::FromRapidJson(t, 50)); }
           catch (...) { throw valhalla_exception_t{400, 423}; }
         }
         correlated = store_correlated_locations(request, locations);
 
-        correlated_s.insert(correlated_s.begin(), correlated.begin(), correlated.begin() + request_sources->size());
-        correlated_t.insert(correlated_t.begin(), correlated.begin() + request_sources->size(), correlated.end());
+        correlated_s.insert(correlated_s.begin(), correlated.begin(), correlated.begin() + request_sources->Size());
+        correlated_t.insert(correlated_t.begin(), correlated.begin() + request_sources->Size(), correlated.end());
       }//we need something
       else
         throw valhalla_exception_t{400, 410};
 
       //type - 0: current, 1: depart, 2: arrive
-      if (request.find("date_time.type") == request.not_found())
+      auto date_time_type = GetOptionalFromRapidJson<int>(request, "/date_time/type");
+      if (!date_time_type)
         return;
 
-      int date_time_type = request.get<float>("date_time.type");
-      auto date_time_value = request.get_optional<std::string>("date_time.value");
+      auto date_time_value = GetOptionalFromRapidJson<std::string>(request, "/date_time/value");
 
-      if (date_time_type == 0) //current.
+      if (*date_time_type == 0) //current.
         locations.front().date_time_ = "current";
-      else if (date_time_type == 1) //depart at
+      else if (*date_time_type == 1) //depart at
         locations.front().date_time_ = date_time_value;
-      else if (date_time_type == 2) //arrive)
+      else if (*date_time_type == 2) //arrive)
         locations.back().date_time_ = date_time_value;
     }
 
-    void thor_worker_t::parse_shape(const boost::property_tree::ptree& request) {
-      //we require locations
-      auto request_shape = request.get_child("shape");
+    void thor_worker_t::parse_shape(const rapidjson::Document& request) {
+      //loki normally gives us the trace in binary
+      if(trace.lat_size()) {
+        if(trace.lng_size() != trace.lat_size())
+          throw valhalla_exception_t{400, 424};
+        shape.reserve(trace.lat_size());
+        for(int i = 0; i < trace.lat_size(); ++i)
+          shape.emplace_back(trace.lng(i), trace.lat(i));
+        return;
+      }
 
+      //otherwise we require shape in the request
+      auto request_shape = GetFromRapidJson<rapidjson::Value::ConstArray>(request, "/shape");
+      shape.reserve(request_shape.Size());
       for(const auto& pt : request_shape) {
         try{
-          shape.push_back(baldr::Location::FromPtree(pt.second).latlng_);
+          shape.push_back(baldr::Location::FromRapidJson(pt).latlng_);
         }
         catch (...) {
           throw std::runtime_error("Failed to parse shape");
@@ -282,27 +349,32 @@ namespace valhalla {
 
     }
 
-    void thor_worker_t::parse_trace_config(const boost::property_tree::ptree& request) {
-      auto costing = request.get<std::string>("costing");
+    void thor_worker_t::parse_trace_config(const rapidjson::Document& request) {
+      auto costing = GetFromRapidJson<std::string>(request, "/costing");
       trace_config.put<std::string>("mode", costing);
 
       if (trace_customizable.empty()) {
         return;
       }
 
-      auto trace_options = request.get_child_optional("trace_options");
+      auto trace_options = GetOptionalFromRapidJson<rapidjson::Value::ConstObject>(request, "/trace_options");
       if (!trace_options) {
         return;
       }
 
       for (const auto& pair : *trace_options) {
-        const auto& name = pair.first;
-        const auto& values = pair.second.data();
+        std::string name = pair.name.GetString();
         if (trace_customizable.find(name) != trace_customizable.end()
-            && !values.empty() ){
+            && !(pair.value.IsString() && !pair.value.GetStringLength()) ){
+          if (pair.value.IsNumber()) {
+            trace_config.put<float>(name, pair.value.GetDouble());
+            continue;
+          }
+          if (!pair.value.IsString())
+            throw std::invalid_argument("Invalid argument: unable to parse " + name + " to float");
           try {
             // Possibly throw std::invalid_argument or std::out_of_range
-            trace_config.put<float>(name, std::stof(values));
+            trace_config.put<float>(name, std::stof(pair.value.GetString()));
           } catch (const std::invalid_argument& ex) {
             throw std::invalid_argument("Invalid argument: unable to parse " + name + " to float");
           } catch (const std::out_of_range& ex) {
@@ -341,13 +413,23 @@ namespace valhalla {
       multi_modal_astar.Clear();
       locations.clear();
       shape.clear();
+      trace.Clear();
       correlated.clear();
       correlated_s.clear();
       correlated_t.clear();
       isochrone_gen.Clear();
       matcher_factory.ClearFullCache();
+      arena.reset();
       if(reader.OverCommitted())
         reader.Clear();
+      if(leg_reader && leg_reader->OverCommitted())
+        leg_reader->Clear();
+      for(auto& searcher : leg_searchers) {
+        searcher->astar.Clear();
+        searcher->bidir_astar.Clear();
+        if(searcher->reader.OverCommitted())
+          searcher->reader.Clear();
+      }
     }
 
     void run_service(const boost::property_tree::ptree& config) {
@@ -35,9 +35,6 @@ using namespace valhalla::thor;
 
 
 namespace {
-  const headers_t::value_type CORS { "Access-Control-Allow-Origin", "*" };
-  const headers_t::value_type JSON_MIME { "Content-type", "application/json;charset=utf-8" };
-  const headers_t::value_type JS_MIME { "Content-type", "application/javascript;charset=utf-8" };
 
   json::MapPtr serialize(const AttributesController& controller,
       const valhalla::odin::TripPath& trip_path,
@@ -369,18 +366,18 @@ namespace {
 namespace valhalla {
 namespace thor {
 
-void thor_worker_t::filter_attributes(const boost::property_tree::ptree& request, AttributesController& controller) {
-  std::string filter_action = request.get("filters.action", "");
+void thor_worker_t::filter_attributes(const rapidjson::Document& request, AttributesController& controller) {
+  auto filter_action = GetFromRapidJson<std::string>(request, "/filters/action", "");
 
   if (filter_action.size() && filter_action == "include") {
     controller.disable_all();
-    for (const auto& kv : request.get_child("filters.attributes"))
-      controller.attributes.at(kv.second.get_value<std::string>()) = true;
+    for (const auto& kv : GetFromRapidJson<rapidjson::Value::ConstArray>(request, "/filters/attributes"))
+      controller.attributes.at(kv.GetString()) = true;
 
   } else if (filter_action.size() && filter_action == "exclude") {
     controller.enable_all();
-    for (const auto& kv : request.get_child("filters.attributes"))
-      controller.attributes.at(kv.second.get_value<std::string>()) = false;
+    for (const auto& kv : GetFromRapidJson<rapidjson::Value::ConstArray>(request, "/filters/attributes"))
+      controller.attributes.at(kv.GetString()) = false;
 
   } else {
     controller.enable_all();
@@ -393,9 +390,8 @@ void thor_worker_t::filter_attributes(const boost::property_tree::ptree& request
  * portion of the route. This includes details for each section of road along the
  * path as well as any intersections along the path.
  */
-worker_t::result_t thor_worker_t::trace_attributes(
-    const boost::property_tree::ptree &request,
-    const std::string &request_str, http_request_info_t& request_info) {
+std::string thor_worker_t::trace_attributes(
+    const rapidjson::Document& request, const bool header_dnt) {
   //get time for start of request
   auto s = std::chrono::system_clock::now();
 
@@ -410,12 +406,12 @@ worker_t::result_t thor_worker_t::trace_attributes(
    * Valhalla will allow an efficient “edge-walking” algorithm rather than a more extensive
    * map-matching method. If true, this enforces to only use exact route match algorithm.
    */
-  odin::TripPath trip_path;
+  odin::TripPath* trip_path = nullptr;
   std::vector<thor::MatchResult> match_results;
-  std::pair<odin::TripPath, std::vector<thor::MatchResult>> trip_match;
+  std::pair<odin::TripPath*, std::vector<thor::MatchResult>> trip_match;
   AttributesController controller;
   filter_attributes(request, controller);
-  auto shape_match = STRING_TO_MATCH.find(request.get<std::string>("shape_match", "walk_or_snap"));
+  auto shape_match = STRING_TO_MATCH.find(GetFromRapidJson<std::string>(request, "/shape_match", "walk_or_snap"));
   if (shape_match == STRING_TO_MATCH.cend())
     throw valhalla_exception_t{400, 445};
   else {
@@ -425,7 +421,7 @@ worker_t::result_t thor_worker_t::trace_attributes(
       case EDGE_WALK:
         try {
           trip_path = route_match(controller);
-          if (trip_path.node().size() == 0)
+          if (trip_path->node().size() == 0)
             throw valhalla_exception_t{400, 443};
         } catch (const valhalla_exception_t& e) {
           throw valhalla_exception_t{400, 443, shape_match->first + " algorithm failed to find exact route match.  Try using shape_match:'walk_or_snap' to fallback to map-matching algorithm"};
@@ -436,7 +432,7 @@ worker_t::result_t thor_worker_t::trace_attributes(
       case MAP_SNAP:
         try {
           trip_match = map_match(controller, true);
-          trip_path = std::move(trip_match.first);
+          trip_path = trip_match.first;
           match_results = std::move(trip_match.second);
         } catch (const valhalla_exception_t& e) {
           throw valhalla_exception_t{400, 444, shape_match->first + " algorithm failed to snap the shape points to the correct shape."};
@@ -447,11 +443,11 @@ worker_t::result_t thor_worker_t::trace_attributes(
       //No shortcuts are used and detailed information at every intersection becomes available.
       case WALK_OR_SNAP:
         trip_path = route_match(controller);
-        if (trip_path.node().size() == 0) {
+        if (trip_path->node().size() == 0) {
           LOG_WARN(shape_match->first + " algorithm failed to find exact route match; Falling back to map_match...");
           try {
             trip_match = map_match(controller, true);
-            trip_path = std::move(trip_match.first);
+            trip_path = trip_match.first;
             match_results = std::move(trip_match.second);
           } catch (const valhalla_exception_t& e) {
             throw valhalla_exception_t{400, 444, shape_match->first + " algorithm failed to snap the shape points to the correct shape."};
@@ -461,22 +457,22 @@ worker_t::result_t thor_worker_t::trace_attributes(
       }
     }
 
-  auto id = request.get_optional<std::string>("id");
+  auto id = GetOptionalFromRapidJson<std::string>(request, "/id");
   // Get the directions_options if they are in the request
   DirectionsOptions directions_options;
-  auto options = request.get_child_optional("directions_options");
+  auto options = rapidjson::Pointer{"/directions_options"}.Get(request);
   if(options)
     directions_options = valhalla::odin::GetDirectionsOptions(*options);
 
   //serialize output to Thor
   json::MapPtr json;
-  if (trip_path.node().size() > 0)
-    json = serialize(controller, trip_path, id, directions_options, match_results);
+  if (trip_path && trip_path->node().size() > 0)
+    json = serialize(controller, *trip_path, id, directions_options, match_results);
   else throw valhalla_exception_t{400, 442};
 
   //jsonp callback if need be
   std::ostringstream stream;
-  auto jsonp = request.get_optional<std::string>("jsonp");
+  auto jsonp = GetOptionalFromRapidJson<std::string>(request, "/jsonp");
   if (jsonp)
     stream << *jsonp << '(';
   stream << *json;
@@ -487,16 +483,12 @@ worker_t::result_t thor_worker_t::trace_attributes(
   auto e = std::chrono::system_clock::now();
   std::chrono::duration<float, std::milli> elapsed_time = e - s;
   //log request if greater than X (ms)
-  if (!healthcheck && !request_info.spare && (elapsed_time.count() / shape.size()) > (long_request / 1100)) {
+  if (!healthcheck && !header_dnt && (elapsed_time.count() / shape.size()) > (long_request / 1100)) {
     LOG_WARN("thor::trace_attributes elapsed time (ms)::"+ std::to_string(elapsed_time.count()));
-    LOG_WARN("thor::trace_attributes exceeded threshold::"+ request_str);
+    LOG_WARN("thor::trace_attributes exceeded threshold::"+ rapidjson::to_string(request));
     midgard::logging::Log("valhalla_thor_long_request_trace_attributes", " [ANALYTICS] ");
   }
-  http_response_t response(200, "OK", stream.str(), headers_t{CORS, jsonp ? JS_MIME : JSON_MIME});
-  response.from_info(request_info);
-  worker_t::result_t result{false};
-  result.messages.emplace_back(response.to_string());
-  return result;
+  return stream.str();
 }
 }
 }
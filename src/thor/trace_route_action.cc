@@ -3,6 +3,7 @@ using namespace prime_server;
 
 #include <algorithm>
 #include <memory>
+#include <sstream>
 #include <utility>
 #include <vector>
 #include <unordered_map>
@@ -47,8 +48,8 @@ namespace thor {
 /*
  * The trace_route action takes a GPS trace and turns it into a route result.
  */
-worker_t::result_t thor_worker_t::trace_route(const boost::property_tree::ptree &request,
-    const std::string &request_str, const bool header_dnt) {
+std::list<odin::TripPath*> thor_worker_t::trace_route(const rapidjson::Document& request,
+    const bool header_dnt) {
   //get time for start of request
   auto s = std::chrono::system_clock::now();
 
@@ -63,16 +64,12 @@ worker_t::result_t thor_worker_t::trace_route(const boost::property_tree::ptree
    * Valhalla will allow an efficient “edge-walking” algorithm rather than a more extensive
    * map-matching method. If true, this enforces to only use exact route match algorithm.
    */
-  odin::TripPath trip_path;
+  odin::TripPath* trip_path = nullptr;
   std::vector<thor::MatchResult> match_results;
-  std::pair<odin::TripPath, std::vector<thor::MatchResult>> trip_match;
+  std::pair<odin::TripPath*, std::vector<thor::MatchResult>> trip_match;
   AttributesController controller;
 
-  worker_t::result_t result { true };
-  // Forward the original request
-  result.messages.emplace_back(request_str);
-
-  auto shape_match = STRING_TO_MATCH.find(request.get<std::string>("shape_match", "walk_or_snap"));
+  auto shape_match = STRING_TO_MATCH.find(GetFromRapidJson<std::string>(request, "/shape_match", "walk_or_snap"));
   if (shape_match == STRING_TO_MATCH.cend())
     throw valhalla_exception_t{400, 445};
   else {
@@ -82,7 +79,7 @@ worker_t::result_t thor_worker_t::trace_route(const boost::property_tree::ptree
       case EDGE_WALK:
         try {
           trip_path = route_match(controller);
-          if (trip_path.node().size() == 0)
+          if (trip_path->node().size() == 0)
             throw valhalla_exception_t{400, 443};
         } catch (const valhalla_exception_t& e) {
           throw valhalla_exception_t{400, 443, shape_match->first + " algorithm failed to find exact route match.  Try using shape_match:'walk_or_snap' to fallback to map-matching algorithm"};
@@ -93,7 +90,7 @@ worker_t::result_t thor_worker_t::trace_route(const boost::property_tree::ptree
       case MAP_SNAP:
         try {
           trip_match = map_match(controller);
-          trip_path = std::move(trip_match.first);
+          trip_path = trip_match.first;
           match_results = std::move(trip_match.second);
         } catch(const valhalla_exception_t& e) {
           throw valhalla_exception_t{e.status_code, e.error_code, e.extra};
@@ -104,11 +101,11 @@ worker_t::result_t thor_worker_t::trace_route(const boost::property_tree::ptree
       //No shortcuts are used and detailed information at every intersection becomes available.
       case WALK_OR_SNAP:
         trip_path = route_match(controller);
-        if (trip_path.node().size() == 0) {
+        if (trip_path->node().size() == 0) {
           LOG_WARN(shape_match->first + " algorithm failed to find exact route match; Falling back to map_match...");
           try {
             trip_match = map_match(controller);
-            trip_path = std::move(trip_match.first);
+            trip_path = trip_match.first;
             match_results = std::move(trip_match.second);
           } catch(const valhalla_exception_t& e) {
             throw valhalla_exception_t{e.status_code, e.error_code, e.extra};
@@ -116,11 +113,9 @@ worker_t::result_t thor_worker_t::trace_route(const boost::property_tree::ptree
         }
         break;
       }
-      log_admin(trip_path);
+      log_admin(*trip_path);
     }
 
-  result.messages.emplace_back(trip_path.SerializeAsString());
-
   // Get processing time for thor
   auto e = std::chrono::system_clock::now();
   std::chrono::duration<float, std::milli> elapsed_time = e - s;
@@ -130,11 +125,11 @@ worker_t::result_t thor_worker_t::trace_route(const boost::property_tree::ptree
     LOG_WARN(
         "thor::trace_route elapsed time (ms)::"
             + std::to_string(elapsed_time.count()));
-    LOG_WARN("thor::trace_route exceeded threshold::" + request_str);
+    LOG_WARN("thor::trace_route exceeded threshold::" + rapidjson::to_string(request));
     midgard::logging::Log("valhalla_thor_long_request_trace_route",
                           " [ANALYTICS] ");
   }
-  return result;
+  return {trip_path};
 }
 
 
@@ -145,15 +140,15 @@ worker_t::result_t thor_worker_t::trace_route(const boost::property_tree::ptree
  * form the list of edges. It will return no nodes if path not found.
  *
  */
-odin::TripPath thor_worker_t::route_match(const AttributesController& controller) {
-  odin::TripPath trip_path;
+odin::TripPath* thor_worker_t::route_match(const AttributesController& controller) {
+  auto* trip_path = arena.create<odin::TripPath>();
   std::vector<PathInfo> path_infos;
   if (RouteMatcher::FormPath(mode_costing, mode, reader, shape, correlated, path_infos)) {
     // Form the trip path based on mode costing, origin, destination, and path edges
-    trip_path = thor::TripPathBuilder::Build(controller, reader, mode_costing,
-                                             path_infos, correlated.front(),
-                                             correlated.back(), std::list<PathLocation>{},
-                                             interrupt_callback);
+    thor::TripPathBuilder::Build(*trip_path, controller, reader, mode_costing,
+                                 path_infos, correlated.front(),
+                                 correlated.back(), std::list<PathLocation>{},
+                                 interrupt_callback);
   }
 
   return trip_path;
@@ -163,9 +158,9 @@ odin::TripPath thor_worker_t::route_match(const AttributesController& controller
 // PathInfo is primarily a list of edge Ids but it also include elapsed time to the end
 // of each edge. We will need to use the existing costing method to form the elapsed time
 // the path. We will start with just using edge costs and will add transition costs.
-std::pair<odin::TripPath, std::vector<thor::MatchResult>> thor_worker_t::map_match(
+std::pair<odin::TripPath*, std::vector<thor::MatchResult>> thor_worker_t::map_match(
     const AttributesController& controller, bool trace_attributes_action) {
-  odin::TripPath trip_path;
+  auto* trip_path = arena.create<odin::TripPath>();
   std::vector<thor::MatchResult> match_results;
   std::unordered_map<size_t, std::pair<RouteDiscontinuity, RouteDiscontinuity>> route_discontinuities;
 
@@ -180,11 +175,14 @@ std::pair<odin::TripPath, std::vector<thor::MatchResult>> thor_worker_t::map_mat
   }
 
   matcher->set_interrupt(interrupt_callback);
+  auto gps_accuracy = matcher->config().get<float>("gps_accuracy");
+  auto search_radius = matcher->config().get<float>("search_radius");
+  bool has_times = trace.time_size() == static_cast<int>(shape.size());
   std::vector<meili::Measurement> sequence;
-  for (const auto& coord : shape) {
-    sequence.emplace_back(coord,
-                          matcher->config().get<float>("gps_accuracy"),
-                          matcher->config().get<float>("search_radius"));
+  sequence.reserve(shape.size());
+  for (size_t i = 0; i < shape.size(); ++i) {
+    sequence.emplace_back(shape[i], gps_accuracy, search_radius,
+                          has_times ? trace.time(i) : -1.0);
   }
 
   // Create the vector of matched path results
@@ -420,10 +418,10 @@ std::pair<odin::TripPath, std::vector<thor::MatchResult>> thor_worker_t::map_mat
     // destination.edges contains path_edges.back()
 
     // Form the trip path based on mode costing, origin, destination, and path edges
-    trip_path = thor::TripPathBuilder::Build(controller, matcher->graphreader(),
-                                             mode_costing, path_edges, origin,
-                                             destination, std::list<PathLocation>{},
-                                             interrupt_callback, &route_discontinuities);
+    thor::TripPathBuilder::Build(*trip_path, controller, matcher->graphreader(),
+                                 mode_costing, path_edges, origin,
+                                 destination, std::list<PathLocation>{},
+                                 interrupt_callback, &route_discontinuities);
   } else {
     throw baldr::valhalla_exception_t { 400, 442 };
   }
@@ -428,10 +428,25 @@ TripPathBuilder::TripPathBuilder() {
 TripPathBuilder::~TripPathBuilder() {
 }
 
+// Form the trip path on the heap and hand it back
+TripPath TripPathBuilder::Build(
+    const AttributesController& controller, GraphReader& graphreader,
+    const std::shared_ptr<sif::DynamicCost>* mode_costing,
+    const std::vector<PathInfo>& path, PathLocation& origin, PathLocation& dest,
+    const std::list<PathLocation>& through_loc,
+    const std::function<void ()>* interrupt_callback,
+    std::unordered_map<size_t, std::pair<RouteDiscontinuity, RouteDiscontinuity>>* route_discontinuities) {
+  TripPath trip_path;
+  Build(trip_path, controller, graphreader, mode_costing, path, origin, dest,
+        through_loc, interrupt_callback, route_discontinuities);
+  return trip_path;
+}
+
 // For now just find the length of the path!
 // TODO - probably need the location information passed in - to
 // add to the TripPath
-TripPath TripPathBuilder::Build(
+void TripPathBuilder::Build(
+    TripPath& trip_path,
     const AttributesController& controller, GraphReader& graphreader,
     const std::shared_ptr<sif::DynamicCost>* mode_costing,
     const std::vector<PathInfo>& path, PathLocation& origin, PathLocation& dest,
@@ -443,9 +458,6 @@ TripPath TripPathBuilder::Build(
     (*interrupt_callback)();
   }
 
-  // TripPath is a protocol buffer that contains information about the trip
-  TripPath trip_path;
-
   // Get the local tile level
   uint32_t local_level = TileHierarchy::levels().rbegin()->first;
 
@@ -519,6 +531,11 @@ TripPath TripPathBuilder::Build(
   std::vector<AdminInfo> admin_info_list;
   uint32_t last_node_admin_index;
 
+  // Walking the edges at each node is only worth it if some intersecting edge
+  // attribute was asked for
+  bool intersecting_edges = controller.category_attribute_enabled(
+      kNodeIntersectingEdgeCategory);
+
   // If the path was only one edge we have a special case
   if (path.size() == 1) {
     const GraphTile* tile = graphreader.GetGraphTile(path.front().edgeid);
@@ -606,7 +623,8 @@ TripPath TripPathBuilder::Build(
                                 origin_date, dest_date);
 
       tp_orig->set_date_time(origin_date);
-      origin.date_time_ = tp_orig->date_time();
+      if (!origin_date.empty())
+        origin.date_time_ = origin_date;
       tp_dest->set_date_time(dest_date);
 
     } else if (origin.date_time_) { // leave at
@@ -622,7 +640,8 @@ TripPath TripPathBuilder::Build(
                                 origin_date, dest_date);
 
       tp_dest->set_date_time(dest_date);
-      dest.date_time_ = tp_dest->date_time();
+      if (!dest_date.empty())
+        dest.date_time_ = dest_date;
       tp_orig->set_date_time(origin_date);
     }
 
@@ -638,7 +657,7 @@ TripPath TripPathBuilder::Build(
 
     // Assign the trip path admins
     AssignAdmins(controller, trip_path, admin_info_list);
-    return trip_path;
+    return;
   }
 
   // Iterate through path
@@ -950,7 +969,7 @@ TripPath TripPathBuilder::Build(
     //          A || \\ G
     //            ||  \\
     //            (1)  (X)
-    if (startnode.Is_Valid()) {
+    if (intersecting_edges && startnode.Is_Valid()) {
       // Get the graph tile and the first edge from the node
       const GraphTile* tile = graphreader.GetGraphTile(startnode);
       const NodeInfo* nodeinfo = tile->node(startnode);
@@ -1039,7 +1058,8 @@ TripPath TripPathBuilder::Build(
                               origin_date, dest_date);
 
     tp_orig->set_date_time(origin_date);
-    origin.date_time_ = tp_orig->date_time();
+    if (!origin_date.empty())
+      origin.date_time_ = origin_date;
     tp_dest->set_date_time(dest_date);
 
   } else if (origin.date_time_) { // leave at
@@ -1055,7 +1075,8 @@ TripPath TripPathBuilder::Build(
                               origin_date, dest_date);
 
     tp_dest->set_date_time(dest_date);
-    dest.date_time_ = tp_dest->date_time();
+    if (!dest_date.empty())
+      dest.date_time_ = dest_date;
     tp_orig->set_date_time(origin_date);
   }
 
@@ -1081,9 +1102,6 @@ TripPath TripPathBuilder::Build(
 
   if (osmchangeset != 0 && controller.attributes.at(kOsmChangeset))
     trip_path.set_osm_changeset(osmchangeset);
-
-  //hand it back
-  return trip_path;
 }
 
 // Add a trip edge to the trip node and set its attributes
@@ -1104,23 +1122,34 @@ TripPath_Edge* TripPathBuilder::AddTripEdge(const AttributesController& controll
 
   TripPath_Edge* trip_edge = trip_node->mutable_edge();
 
-  // Get the edgeinfo
-  auto edgeinfo = graphtile->edgeinfo(directededge->edgeinfo_offset());
+  // Get the edgeinfo only if something we were asked for lives in it
+  bool names = controller.attributes.at(kEdgeNames);
+  bool way_id = controller.attributes.at(kEdgeWayId);
+  if (names || way_id) {
+    auto edgeinfo = graphtile->edgeinfo(directededge->edgeinfo_offset());
 
-  // Add names to edge if requested
-  if (controller.attributes.at(kEdgeNames)) {
-    std::vector<std::string> names = edgeinfo.GetNames();
-    for (const auto& name : names) {
-      trip_edge->add_name(name);
+    // Add names to edge if requested
+    if (names) {
+      for (const auto& name : edgeinfo.GetNames()) {
+        trip_edge->add_name(name);
+      }
     }
-  }
+
+    // Set way id (base data id) if requested
+    if (way_id)
+      trip_edge->set_way_id(edgeinfo.wayid());
 
 #ifdef LOGGING_LEVEL_TRACE
-  LOG_TRACE(std::string("wayid=") + std::to_string(edgeinfo.wayid()));
+    LOG_TRACE(std::string("wayid=") + std::to_string(edgeinfo.wayid()));
 #endif
+  }
 
   // Set the exits (if the directed edge has exit sign information) and if requested
-  if (directededge->exitsign()) {
+  if (directededge->exitsign() &&
+      (controller.attributes.at(kEdgeSignExitNumber) ||
+       controller.attributes.at(kEdgeSignExitBranch) ||
+       controller.attributes.at(kEdgeSignExitToward) ||
+       controller.attributes.at(kEdgeSignExitName))) {
     std::vector<SignInfo> signs = graphtile->GetSigns(idx);
     if (!signs.empty()) {
       TripPath_Sign* trip_exit = trip_edge->mutable_sign();
@@ -1277,10 +1306,6 @@ TripPath_Edge* TripPathBuilder::AddTripEdge(const AttributesController& controll
   if (controller.attributes.at(kEdgeId))
     trip_edge->set_id(edge.value);
 
-  // Set way id (base data id) if requested
-  if (controller.attributes.at(kEdgeWayId))
-    trip_edge->set_way_id(edgeinfo.wayid());
-
   // Set weighted grade if requested
   if (controller.attributes.at(kEdgeWeightedGrade))
     trip_edge->set_weighted_grade((directededge->weighted_grade() - 6.f) / 0.6f);
@@ -0,0 +1,334 @@
+#include "thor/vehicle_router.h"
+#include "midgard/logging.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace valhalla::thor;
+using steady_clock = std::chrono::steady_clock;
+
+namespace {
+
+// Smallest change in travel time that counts as an improvement
+constexpr float kMinImprovement = 1e-3f;
+
+/**
+ * The routes of the whole fleet while they are being built and improved.
+ * Every route kept here keeps to its vehicle's constraints.
+ */
+class FleetRoutes {
+ public:
+  FleetRoutes(const uint32_t count, const std::vector<float>& times,
+              const std::vector<Vehicle>& vehicles, const std::vector<Stop>& stops,
+              const steady_clock::time_point& deadline)
+    : count_(count), times_(times), vehicles_(vehicles), stops_(stops),
+      deadline_(deadline), routes_(vehicles.size()), costs_(vehicles.size()) {
+    for (uint32_t v = 0; v < vehicles_.size(); v++) {
+      costs_[v] = Evaluate(v, routes_[v]);
+    }
+    for (uint32_t s = 0; s < stops_.size(); s++) {
+      unassigned_.push_back(s);
+    }
+  }
+
+  // Place stops, hardest to place first, until none of them fit anywhere.
+  // This always runs to the end, whatever the time limit, so the stops left
+  // unassigned are the ones no vehicle can serve.
+  void Construct() {
+    while (!unassigned_.empty()) {
+      uint32_t best_index = 0;
+      Insertion best{0, kUnbounded, 0};
+      float best_regret = -1.0f;
+      for (uint32_t i = 0; i < unassigned_.size(); i++) {
+        // Cheapest spot in each route and what the runner up route costs
+        Insertion first{0, kUnbounded, 0};
+        float second = kUnbounded;
+        for (uint32_t v = 0; v < routes_.size(); v++) {
+          auto insertion = CheapestInsertion(v, unassigned_[i]);
+          if (insertion.delta < first.delta) {
+            second = first.delta;
+            first = insertion;
+          } else if (insertion.delta < second) {
+            second = insertion.delta;
+          }
+        }
+        if (std::isinf(first.delta)) {
+          continue;
+        }
+        float regret = second - first.delta;
+        if (regret > best_regret || (regret == best_regret && first.delta < best.delta)) {
+          best_regret = regret;
+          best = first;
+          best_index = i;
+        }
+      }
+      if (std::isinf(best.delta)) {
+        break;
+      }
+      Insert(best.vehicle, best.position, unassigned_[best_index]);
+      unassigned_.erase(unassigned_.begin() + best_index);
+    }
+  }
+
+  // Apply improving moves until there are none left or time runs out
+  void Improve() {
+    bool improved = true;
+    while (improved && !Expired()) {
+      improved = Relocate();
+      improved = Exchange() || improved;
+      improved = TwoOpt() || improved;
+      // Moves may have made room for stops that did not fit before
+      if (improved && !unassigned_.empty()) {
+        Construct();
+      }
+    }
+  }
+
+  VehicleRouter::Solution Solution() const {
+    VehicleRouter::Solution solution;
+    solution.travel_time = 0.0f;
+    for (uint32_t v = 0; v < routes_.size(); v++) {
+      solution.routes.emplace_back(Schedule(v));
+      solution.travel_time += solution.routes.back().travel_time;
+    }
+    solution.unassigned = unassigned_;
+    std::sort(solution.unassigned.begin(), solution.unassigned.end());
+    return solution;
+  }
+
+ protected:
+  uint32_t count_;
+  const std::vector<float>& times_;
+  const std::vector<Vehicle>& vehicles_;
+  const std::vector<Stop>& stops_;
+  steady_clock::time_point deadline_;
+  std::vector<std::vector<uint32_t>> routes_;    // Stops of each vehicle
+  std::vector<float> costs_;                     // Travel time of each route
+  std::vector<uint32_t> unassigned_;             // Stops not yet placed
+  std::vector<uint32_t> candidate_;              // Scratch route
+  std::vector<uint32_t> other_candidate_;        // Scratch route
+
+  float Time(const uint32_t from, const uint32_t to) const {
+    return times_[(from * count_) + to];
+  }
+
+  bool Expired() const {
+    return steady_clock::now() >= deadline_;
+  }
+
+  // Travel time of the route, or unbounded if it breaks a constraint
+  float Evaluate(const uint32_t v, const std::vector<uint32_t>& route) const {
+    const auto& vehicle = vehicles_[v];
+    float load = 0.0f, time = vehicle.earliest, travel_time = 0.0f;
+    uint32_t at = vehicle.start;
+    for (auto s : route) {
+      const auto& stop = stops_[s];
+      load += stop.demand;
+      float leg = Time(at, stop.location);
+      if (load > vehicle.capacity || std::isinf(leg)) {
+        return kUnbounded;
+      }
+      travel_time += leg;
+      time = std::max(time + leg, stop.earliest);
+      if (time > stop.latest) {
+        return kUnbounded;
+      }
+      time += stop.service_time;
+      at = stop.location;
+    }
+    if (vehicle.end != kOpenRoute) {
+      float leg = Time(at, vehicle.end);
+      if (std::isinf(leg)) {
+        return kUnbounded;
+      }
+      travel_time += leg;
+      time += leg;
+    }
+    return time > vehicle.latest ? kUnbounded : travel_time;
+  }
+
+  // Where a stop would go in a vehicle's route and the travel time it adds
+  struct Insertion {
+    uint32_t vehicle;
+    float delta;
+    uint32_t position;
+  };
+
+  // Cheapest position to put the stop in the vehicle's route. The added
+  // travel time is unbounded if it fits nowhere.
+  Insertion CheapestInsertion(const uint32_t v, const uint32_t s) {
+    Insertion best{v, kUnbounded, 0};
+    if (std::isinf(costs_[v])) {
+      return best;
+    }
+    const auto& route = routes_[v];
+    for (uint32_t p = 0; p <= route.size(); p++) {
+      candidate_.assign(route.begin(), route.begin() + p);
+      candidate_.push_back(s);
+      candidate_.insert(candidate_.end(), route.begin() + p, route.end());
+      float delta = Evaluate(v, candidate_) - costs_[v];
+      if (delta < best.delta) {
+        best.delta = delta;
+        best.position = p;
+      }
+    }
+    return best;
+  }
+
+  void Insert(const uint32_t v, const uint32_t position, const uint32_t s) {
+    routes_[v].insert(routes_[v].begin() + position, s);
+    costs_[v] = Evaluate(v, routes_[v]);
+  }
+
+  // Move a stop to another spot in its own route or in another route
+  bool Relocate() {
+    bool improved = false;
+    for (uint32_t v = 0; v < routes_.size() && !Expired(); v++) {
+      for (uint32_t i = 0; i < routes_[v].size(); i++) {
+        uint32_t s = routes_[v][i];
+        std::vector<uint32_t> removed(routes_[v]);
+        removed.erase(removed.begin() + i);
+        float removed_cost = Evaluate(v, removed);
+        bool moved = false;
+        for (uint32_t w = 0; w < routes_.size() && !moved; w++) {
+          const auto& target = v == w ? removed : routes_[w];
+          float before = v == w ? costs_[v] : costs_[v] + costs_[w];
+          float others = v == w ? 0.0f : removed_cost;
+          if (std::isinf(others) || std::isinf(costs_[w])) {
+            continue;
+          }
+          for (uint32_t p = 0; p <= target.size(); p++) {
+            if (v == w && p == i) {
+              continue;
+            }
+            candidate_.assign(target.begin(), target.begin() + p);
+            candidate_.push_back(s);
+            candidate_.insert(candidate_.end(), target.begin() + p, target.end());
+            float cost = Evaluate(w, candidate_);
+            if (others + cost < before - kMinImprovement) {
+              routes_[w] = candidate_;
+              costs_[w] = cost;
+              if (v != w) {
+                routes_[v] = removed;
+                costs_[v] = removed_cost;
+              }
+              moved = improved = true;
+              break;
+            }
+          }
+        }
+      }
+    }
+    return improved;
+  }
+
+  // Swap a stop of one route with a stop of another route
+  bool Exchange() {
+    bool improved = false;
+    for (uint32_t v = 0; v < routes_.size() && !Expired(); v++) {
+      for (uint32_t w = v + 1; w < routes_.size(); w++) {
+        for (uint32_t i = 0; i < routes_[v].size(); i++) {
+          for (uint32_t j = 0; j < routes_[w].size(); j++) {
+            candidate_ = routes_[v];
+            other_candidate_ = routes_[w];
+            std::swap(candidate_[i], other_candidate_[j]);
+            float cost_v = Evaluate(v, candidate_);
+            if (std::isinf(cost_v)) {
+              continue;
+            }
+            float cost_w = Evaluate(w, other_candidate_);
+            if (cost_v + cost_w < costs_[v] + costs_[w] - kMinImprovement) {
+              routes_[v].swap(candidate_);
+              routes_[w].swap(other_candidate_);
+              costs_[v] = cost_v;
+              costs_[w] = cost_w;
+              improved = true;
+            }
+          }
+        }
+      }
+    }
+    return improved;
+  }
+
+  // Reverse part of a route
+  bool TwoOpt() {
+    bool improved = false;
+    for (uint32_t v = 0; v < routes_.size() && !Expired(); v++) {
+      for (uint32_t i = 0; i + 1 < routes_[v].size(); i++) {
+        for (uint32_t j = i + 1; j < routes_[v].size(); j++) {
+          candidate_ = routes_[v];
+          std::reverse(candidate_.begin() + i, candidate_.begin() + j + 1);
+          float cost = Evaluate(v, candidate_);
+          if (cost < costs_[v] - kMinImprovement) {
+            routes_[v].swap(candidate_);
+            costs_[v] = cost;
+            improved = true;
+          }
+        }
+      }
+    }
+    return improved;
+  }
+
+  // Times along a route. The vehicle leaves as late as it can without
+  // arriving at its first stop any later.
+  VehicleRoute Schedule(const uint32_t v) const {
+    const auto& vehicle = vehicles_[v];
+    VehicleRoute route;
+    route.vehicle = v;
+    route.stops = routes_[v];
+    route.departure = vehicle.earliest;
+    if (!route.stops.empty()) {
+      const auto& first = stops_[route.stops.front()];
+      route.departure = std::max(route.departure,
+          first.earliest - Time(vehicle.start, first.location));
+    }
+    route.travel_time = route.load = 0.0f;
+    float time = route.departure;
+    uint32_t at = vehicle.start;
+    for (auto s : route.stops) {
+      const auto& stop = stops_[s];
+      float leg = Time(at, stop.location);
+      route.travel_time += leg;
+      route.load += stop.demand;
+      route.arrivals.push_back(time + leg);
+      time = std::max(time + leg, stop.earliest);
+      route.starts.push_back(time);
+      time += stop.service_time;
+      at = stop.location;
+    }
+    if (vehicle.end != kOpenRoute) {
+      float leg = Time(at, vehicle.end);
+      route.travel_time += leg;
+      time += leg;
+    }
+    route.arrival = time;
+    return route;
+  }
+};
+
+}
+
+namespace valhalla {
+namespace thor {
+
+VehicleRouter::VehicleRouter(const std::chrono::milliseconds& time_limit)
+    : time_limit_(time_limit) {
+}
+
+// Route the fleet.
+VehicleRouter::Solution VehicleRouter::Solve(const uint32_t count,
+        const std::vector<float>& times, const std::vector<Vehicle>& vehicles,
+        const std::vector<Stop>& stops) const {
+  FleetRoutes fleet(count, times, vehicles, stops, steady_clock::now() + time_limit_);
+  fleet.Construct();
+  fleet.Improve();
+  auto solution = fleet.Solution();
+  LOG_DEBUG("Fleet travel time = " + std::to_string(solution.travel_time) +
+            " unassigned = " + std::to_string(solution.unassigned.size()));
+  return solution;
+}
+
+}
+}
@@ -0,0 +1,181 @@
+#include <functional>
+#include <string>
+#include <list>
+#include <stdexcept>
+
+#include <boost/property_tree/ptree.hpp>
+#include <prime_server/prime_server.hpp>
+#include <prime_server/http_protocol.hpp>
+
+#include "midgard/logging.h"
+#include "baldr/errorcode_util.h"
+#include "baldr/rapidjson_utils.h"
+#include "proto/trace.pb.h"
+#include "proto/trippath.pb.h"
+#include "proto/tripdirections.pb.h"
+
+#include "loki/service.h"
+#include "thor/service.h"
+#include "odin/service.h"
+#include "tyr/service.h"
+#include "tyr/actor.h"
+
+using namespace prime_server;
+using namespace valhalla;
+using namespace valhalla::baldr;
+using namespace valhalla::tyr;
+
+namespace {
+
+  const headers_t::value_type CORS{"Access-Control-Allow-Origin", "*"};
+  const headers_t::value_type JSON_MIME{"Content-type", "application/json;charset=utf-8"};
+  const headers_t::value_type JS_MIME{"Content-type", "application/javascript;charset=utf-8"};
+
+}
+
+namespace valhalla {
+  namespace tyr {
+
+    struct actor_t::pimpl_t {
+      pimpl_t(const boost::property_tree::ptree& config):
+        loki_worker(config), thor_worker(config), odin_worker(config), tyr_worker(config) {
+      }
+
+      //each stage works on what the last one left in memory, nothing is serialized until the response
+      std::string act(const http_request_t& request, http_request_info_t& request_info, const worker_t::interrupt_function_t& interrupt) {
+        //find the locations in the graph
+        auto response = loki_worker.act(request, request_info, request_rj, request_trace);
+        if(response)
+          return *response;
+
+        //find the paths
+        response = thor_worker.act(request_rj, request_trace, request_info, interrupt, trip_paths);
+        if(response)
+          return *response;
+
+        //describe them
+        auto directions = odin_worker.narrate(request_rj, trip_paths);
+        return tyr_worker.serialize(request_rj, directions, request_info);
+      }
+
+      boost::optional<std::string> jsonp() const {
+        return GetOptionalFromRapidJson<std::string>(request_rj, "/jsonp");
+      }
+
+      void cleanup() {
+        loki_worker.cleanup();
+        thor_worker.cleanup();
+        odin_worker.cleanup();
+        tyr_worker.cleanup();
+        rapidjson::Document().Swap(request_rj);
+        request_trace.Clear();
+        trip_paths.clear();
+      }
+
+      loki::loki_worker_t loki_worker;
+      thor::thor_worker_t thor_worker;
+      odin::odin_worker_t odin_worker;
+      tyr::tyr_worker_t tyr_worker;
+      rapidjson::Document request_rj;
+      odin::Trace request_trace;
+      std::list<odin::TripPath*> trip_paths;
+      const worker_t::interrupt_function_t no_interrupt = [](){};
+    };
+
+    actor_t::actor_t(const boost::property_tree::ptree& config): pimpl(new pimpl_t(config)) {
+    }
+
+    std::string actor_t::act(const std::string& path, const std::string& request_str, const std::function<void ()>* interrupt) {
+      //make it look like it came from the http server
+      http_request_t request(method_t::POST, path, request_str);
+      http_request_info_t request_info{};
+      try {
+        auto response = pimpl->act(request, request_info, interrupt ? *interrupt : pimpl->no_interrupt);
+        cleanup();
+        return response;
+      }
+      catch(...) {
+        cleanup();
+        throw;
+      }
+    }
+
+    std::string actor_t::route(const std::string& request_str, const std::function<void ()>* interrupt) {
+      return act("/route", request_str, interrupt);
+    }
+
+    std::string actor_t::locate(const std::string& request_str, const std::function<void ()>* interrupt) {
+      return act("/locate", request_str, interrupt);
+    }
+
+    std::string actor_t::matrix(const std::string& request_str, const std::function<void ()>* interrupt) {
+      return act("/sources_to_targets", request_str, interrupt);
+    }
+
+    std::string actor_t::optimized_route(const std::string& request_str, const std::function<void ()>* interrupt) {
+      return act("/optimized_route", request_str, interrupt);
+    }
+
+    std::string actor_t::optimized_fleet(const std::string& request_str, const std::function<void ()>* interrupt) {
+      return act("/optimized_fleet", request_str, interrupt);
+    }
+
+    std::string actor_t::isochrone(const std::string& request_str, const std::function<void ()>* interrupt) {
+      return act("/isochrone", request_str, interrupt);
+    }
+
+    std::string actor_t::trace_route(const std::string& request_str, const std::function<void ()>* interrupt) {
+      return act("/trace_route", request_str, interrupt);
+    }
+
+    std::string actor_t::trace_attributes(const std::string& request_str, const std::function<void ()>* interrupt) {
+      return act("/trace_attributes", request_str, interrupt);
+    }
+
+    worker_t::result_t actor_t::work(const std::list<zmq::message_t>& job, void* request_info, const worker_t::interrupt_function_t& interrupt) {
+      auto& info = *static_cast<http_request_info_t*>(request_info);
+      LOG_INFO("Got Actor Request " + std::to_string(info.id));
+      try{
+        auto request = http_request_t::from_string(static_cast<const char*>(job.front().data()), job.front().size());
+        auto response = pimpl->act(request, info, interrupt);
+        auto jsonp = pimpl->jsonp();
+        worker_t::result_t result{false};
+        http_response_t http_response(200, "OK", response, headers_t{CORS, jsonp ? JS_MIME : JSON_MIME});
+        http_response.from_info(info);
+        result.messages.emplace_back(http_response.to_string());
+        return result;
+      }
+      catch(const valhalla_exception_t& e) {
+        valhalla::midgard::logging::Log("400::" + std::string(e.what()), " [ANALYTICS] ");
+        return jsonify_error(e, info, pimpl->jsonp());
+      }
+      catch(const std::exception& e) {
+        valhalla::midgard::logging::Log("400::" + std::string(e.what()), " [ANALYTICS] ");
+        return jsonify_error({400, 599, std::string(e.what())}, info, pimpl->jsonp());
+      }
+    }
+
+    void actor_t::cleanup() {
+      pimpl->cleanup();
+    }
+
+    void run_actor_service(const boost::property_tree::ptree& config) {
+      //gets requests from the http server
+      auto upstream_endpoint = config.get<std::string>("loki.service.proxy") + "_out";
+      //returns the response back to the server
+      auto loopback_endpoint = config.get<std::string>("httpd.service.loopback");
+      auto interrupt_endpoint = config.get<std::string>("httpd.service.interrupt");
+
+      //listen for requests
+      zmq::context_t context;
+      actor_t actor(config);
+      prime_server::worker_t worker(context, upstream_endpoint, "ipc://NO_ENDPOINT", loopback_endpoint, interrupt_endpoint,
+        std::bind(&actor_t::work, std::ref(actor), std::placeholders::_1, std::placeholders::_2, std::placeholders::_3),
+        std::bind(&actor_t::cleanup, std::ref(actor)));
+      worker.work();
+
+      //TODO: should we listen for SIGINT and terminate gracefully/exit(0)?
+    }
+
+  }
+}
@@ -6,7 +6,6 @@
 #include <cstdint>
 #include <sstream>
 #include <boost/property_tree/ptree.hpp>
-#include <boost/property_tree/json_parser.hpp>
 
 #include <prime_server/prime_server.hpp>
 #include <prime_server/http_protocol.hpp>
@@ -16,7 +15,9 @@
 #include "midgard/logging.h"
 #include "midgard/encoded.h"
 #include "baldr/json.h"
+#include "baldr/json_writer.h"
 #include "baldr/errorcode_util.h"
+#include "baldr/rapidjson_utils.h"
 #include "odin/util.h"
 #include "proto/tripdirections.pb.h"
 #include "proto/directions_options.pb.h"
@@ -70,66 +71,73 @@ namespace {
     }
     */
 
-    json::ArrayPtr route_name(const std::list<valhalla::odin::TripDirections>& legs){
-      auto route_name = json::array({});
+    void route_name(const std::list<valhalla::odin::TripDirections*>& legs, json::writer_t& writer){
+      writer.start_array("route_name");
       //first one
-      if(legs.front().maneuver(0).street_name_size() > 0)
-        route_name->push_back(legs.front().maneuver(0).street_name(0));
+      if(legs.front()->maneuver(0).street_name_size() > 0)
+        writer(legs.front()->maneuver(0).street_name(0));
       //the rest
-      for(const auto& leg : legs) {
-        if(leg.maneuver(leg.maneuver_size() - 1).street_name_size() > 0)
-          route_name->push_back(leg.maneuver(leg.maneuver_size() - 1).street_name(0));
+      for(const auto* leg : legs) {
+        if(leg->maneuver(leg->maneuver_size() - 1).street_name_size() > 0)
+          writer(leg->maneuver(leg->maneuver_size() - 1).street_name(0));
       }
-      return route_name;
+      writer.end_array();
     }
 
-    json::ArrayPtr via_indices(const std::list<valhalla::odin::TripDirections>& legs){
+    void via_indices(const std::list<valhalla::odin::TripDirections*>& legs, json::writer_t& writer){
+      writer.start_array("via_indices");
       //first one
-      auto via_indices = json::array({static_cast<uint64_t>(0)});
+      uint64_t index = 0;
+      writer(index);
       //the rest
-      for(const auto& leg : legs)
-        via_indices->push_back(static_cast<uint64_t>(leg.maneuver_size() - 1) + boost::get<uint64_t>(via_indices->back()));
-      return via_indices;
+      for(const auto* leg : legs)
+        writer(index += static_cast<uint64_t>(leg->maneuver_size() - 1));
+      writer.end_array();
     }
 
-    json::MapPtr route_summary(const std::list<valhalla::odin::TripDirections>& legs){
-      auto route_summary = json::map({});
+    void route_summary(const std::list<valhalla::odin::TripDirections*>& legs, json::writer_t& writer){
+      writer.start_object("route_summary");
 
-      if(legs.front().maneuver(0).street_name_size() > 0)
-        route_summary->emplace("start_point", legs.front().maneuver(0).street_name(0));
+      if(legs.front()->maneuver(0).street_name_size() > 0)
+        writer("start_point", legs.front()->maneuver(0).street_name(0));
       else
-        route_summary->emplace("start_point", string(""));
+        writer("start_point", "");
 
-      if(legs.back().maneuver(legs.back().maneuver_size() - 1).street_name_size() > 0)
-        route_summary->emplace("end_point", legs.back().maneuver(legs.back().maneuver_size() - 1).street_name(0));
+      if(legs.back()->maneuver(legs.back()->maneuver_size() - 1).street_name_size() > 0)
+        writer("end_point", legs.back()->maneuver(legs.back()->maneuver_size() - 1).street_name(0));
       else
-        route_summary->emplace("end_point", string(""));
+        writer("end_point", "");
 
       uint32_t seconds = 0;
       float kilometers = 0.f;
-      for(const auto& leg : legs) {
-        kilometers += leg.summary().length();
-        seconds += leg.summary().time();
+      for(const auto* leg : legs) {
+        kilometers += leg->summary().length();
+        seconds += leg->summary().time();
       }
 
-      route_summary->emplace("total_time", static_cast<uint64_t>(seconds));
-      route_summary->emplace("total_distance", static_cast<uint64_t>((kilometers * 1000.f) + .5f));
-      return route_summary;
+      writer("total_time", static_cast<uint64_t>(seconds));
+      writer("total_distance", static_cast<uint64_t>((kilometers * 1000.f) + .5f));
+      writer.end_object();
     }
 
-    json::ArrayPtr via_points(const std::list<valhalla::odin::TripDirections>& legs){
+    void via_points(const std::list<valhalla::odin::TripDirections*>& legs, json::writer_t& writer){
+      writer.start_array("via_points");
       //first one
-      auto via_points = json::array({
-        json::array({json::fp_t{legs.front().location(0).ll().lat(),6}, json::fp_t{legs.front().location(0).ll().lng(),6}})
-      });
+      writer.start_array();
+      writer(json::fp_t{legs.front()->location(0).ll().lat(),6});
+      writer(json::fp_t{legs.front()->location(0).ll().lng(),6});
+      writer.end_array();
       //the rest
-      for(const auto& leg : legs) {
-        for(int i = 1; i < leg.location_size(); ++i) {
-          const auto& location = leg.location(i);
-          via_points->emplace_back(json::array({json::fp_t{location.ll().lat(),6}, json::fp_t{location.ll().lng(),6}}));
+      for(const auto* leg : legs) {
+        for(int i = 1; i < leg->location_size(); ++i) {
+          const auto& location = leg->location(i);
+          writer.start_array();
+          writer(json::fp_t{location.ll().lat(),6});
+          writer(json::fp_t{location.ll().lng(),6});
+          writer.end_array();
         }
       }
-      return via_points;
+      writer.end_array();
     }
 
     const std::unordered_map<int, std::string> maneuver_type = {
@@ -180,38 +188,35 @@ namespace {
       { static_cast<int>(valhalla::odin::TripDirections_Maneuver_CardinalDirection_kNorthWest), "NW" }
     };
 
-    json::ArrayPtr route_instructions(const std::list<valhalla::odin::TripDirections>& legs){
-      auto route_instructions = json::array({});
-      for(const auto& leg : legs) {
-        for(const auto& maneuver : leg.maneuver()) {
+    void route_instructions(const std::list<valhalla::odin::TripDirections*>& legs, json::writer_t& writer){
+      writer.start_array("route_instructions");
+      for(const auto* leg : legs) {
+        for(const auto& maneuver : leg->maneuver()) {
           //if we dont know the type of maneuver then skip it
           auto maneuver_text = maneuver_type.find(static_cast<int>(maneuver.type()));
           if(maneuver_text == maneuver_type.end())
             continue;
 
-          //length
-          std::ostringstream length;
-          length << static_cast<uint64_t>(maneuver.length()*1000.f) << "m";
-
           //json
-          route_instructions->emplace_back(json::array({
-            maneuver_text->second, //maneuver type
-            (maneuver.street_name_size() ? maneuver.street_name(0) : string("")), //street name
-            static_cast<uint64_t>(maneuver.length() * 1000.f), //length in meters
-            static_cast<uint64_t>(maneuver.begin_shape_index()), //index in the shape
-            static_cast<uint64_t>(maneuver.time()), //time in seconds
-            length.str(), //length as a string with a unit suffix
-            cardinal_direction_string.find(static_cast<int>(maneuver.begin_cardinal_direction()))->second, // one of: N S E W NW NE SW SE
-            static_cast<uint64_t>(maneuver.begin_heading())
-          }));
+          auto length = static_cast<uint64_t>(maneuver.length() * 1000.f);
+          writer.start_array();
+          writer(maneuver_text->second); //maneuver type
+          writer(maneuver.street_name_size() ? maneuver.street_name(0) : string("")); //street name
+          writer(length); //length in meters
+          writer(static_cast<uint64_t>(maneuver.begin_shape_index())); //index in the shape
+          writer(static_cast<uint64_t>(maneuver.time())); //time in seconds
+          writer(std::to_string(length) + "m"); //length as a string with a unit suffix
+          writer(cardinal_direction_string.find(static_cast<int>(maneuver.begin_cardinal_direction()))->second); // one of: N S E W NW NE SW SE
+          writer(static_cast<uint64_t>(maneuver.begin_heading()));
+          writer.end_array();
         }
       }
-      return route_instructions;
+      writer.end_array();
     }
 
-    std::string shape(const std::list<valhalla::odin::TripDirections>& legs) {
+    std::string shape(const std::list<valhalla::odin::TripDirections*>& legs) {
       if(legs.size() == 1)
-        return legs.front().shape();
+        return legs.front()->shape();
 
       //TODO: there is a tricky way to do this... since the end of each leg is the same as the beginning
       //we essentially could just peel off the first encoded shape point of all the legs (but the first)
@@ -219,35 +224,33 @@ namespace {
       //that the string length of the first number is a fixed length (which would be great!) have to have a look
       //should make this a function in midgard probably so the logic is all in the same place
       std::vector<std::pair<float, float> > decoded;
-      for(const auto& leg : legs) {
-        auto decoded_leg = midgard::decode<std::vector<std::pair<float, float> > >(leg.shape());
+      for(const auto* leg : legs) {
+        auto decoded_leg = midgard::decode<std::vector<std::pair<float, float> > >(leg->shape());
         decoded.insert(decoded.end(), decoded.size() ? decoded_leg.begin() + 1 : decoded_leg.begin(), decoded_leg.end());
       }
       return midgard::encode(decoded);
     }
 
     void serialize(const valhalla::odin::DirectionsOptions& directions_options,
-      const std::list<valhalla::odin::TripDirections>& legs, std::ostringstream& stream) {
-      auto json = json::map
-      ({
-        {"hint_data", json::map
-          ({
-            {"locations", json::array({ string(""), string("") })}, //TODO: are these internal ids?
-            {"checksum", static_cast<uint64_t>(0)} //TODO: what is this exactly?
-          })
-        },
-        {"route_name", route_name(legs)}, //TODO: list of all of the streets or just the via points?
-        {"via_indices", via_indices(legs)}, //maneuver index
-        {"found_alternative", static_cast<bool>(false)}, //no alt route support
-        {"route_summary", route_summary(legs)}, //start/end name, total time/distance
-        {"via_points", via_points(legs)}, //array of lat,lng pairs
-        {"route_instructions", route_instructions(legs)}, //array of maneuvers
-        {"route_geometry", shape(legs)}, //polyline encoded shape
-        {"status_message", string("Found route between points")}, //found route between points OR cannot find route between points
-        {"status", static_cast<uint64_t>(0)} //0 success or 207 no route
-      });
-      //serialize it
-      stream << *json;
+      const std::list<valhalla::odin::TripDirections*>& legs, json::writer_t& writer) {
+      writer.start_object();
+      writer.start_object("hint_data");
+      writer.start_array("locations"); //TODO: are these internal ids?
+      writer("");
+      writer("");
+      writer.end_array();
+      writer("checksum", static_cast<uint64_t>(0)); //TODO: what is this exactly?
+      writer.end_object();
+      route_name(legs, writer); //TODO: list of all of the streets or just the via points?
+      via_indices(legs, writer); //maneuver index
+      writer("found_alternative", false); //no alt route support
+      route_summary(legs, writer); //start/end name, total time/distance
+      via_points(legs, writer); //array of lat,lng pairs
+      route_instructions(legs, writer); //array of maneuvers
+      writer("route_geometry", shape(legs)); //polyline encoded shape
+      writer("status_message", "Found route between points"); //found route between points OR cannot find route between points
+      writer("status", static_cast<uint64_t>(0)); //0 success or 207 no route
+      writer.end_object();
     }
   }
 
@@ -326,80 +329,80 @@ namespace {
     */
     using namespace std;
 
-    json::MapPtr summary(const std::list<valhalla::odin::TripDirections>& legs){
+    void summary(const std::list<valhalla::odin::TripDirections*>& legs, json::writer_t& writer){
 
       uint64_t time = 0;
       long double length = 0;
       AABB2<PointLL> bbox(10000.0f, 10000.0f, -10000.0f, -10000.0f);
-      for(const auto& leg : legs) {
-        time += static_cast<uint64_t>(leg.summary().time());
-        length += leg.summary().length();
-
-        AABB2<PointLL> leg_bbox(leg.summary().bbox().min_ll().lng(),
-                                leg.summary().bbox().min_ll().lat(),
-                                leg.summary().bbox().max_ll().lng(),
-                                leg.summary().bbox().max_ll().lat());
+      for(const auto* leg : legs) {
+        time += static_cast<uint64_t>(leg->summary().time());
+        length += leg->summary().length();
+
+        AABB2<PointLL> leg_bbox(leg->summary().bbox().min_ll().lng(),
+                                leg->summary().bbox().min_ll().lat(),
+                                leg->summary().bbox().max_ll().lng(),
+                                leg->summary().bbox().max_ll().lat());
         bbox.Expand(leg_bbox);
       }
 
-      auto route_summary = json::map({});
-      route_summary->emplace("time", time);
-      route_summary->emplace("length", json::fp_t{length, 3});
-      route_summary->emplace("min_lat", json::fp_t{bbox.miny(), 6});
-      route_summary->emplace("min_lon", json::fp_t{bbox.minx(), 6});
-      route_summary->emplace("max_lat", json::fp_t{bbox.maxy(), 6});
-      route_summary->emplace("max_lon", json::fp_t{bbox.maxx(), 6});
+      writer.start_object("summary");
+      writer("time", time);
+      writer("length", json::fp_t{length, 3});
+      writer("min_lat", json::fp_t{bbox.miny(), 6});
+      writer("min_lon", json::fp_t{bbox.minx(), 6});
+      writer("max_lat", json::fp_t{bbox.maxy(), 6});
+      writer("max_lon", json::fp_t{bbox.maxx(), 6});
+      writer.end_object();
       LOG_DEBUG("trip_time::" + std::to_string(time) +"s");
-      return route_summary;
     }
 
-    json::ArrayPtr locations(const std::list<valhalla::odin::TripDirections>& legs){
-      auto locations = json::array({});
+    void locations(const std::list<valhalla::odin::TripDirections*>& legs, json::writer_t& writer){
+      writer.start_array("locations");
 
       int index = 0;
       for(auto leg = legs.begin(); leg != legs.end(); ++leg) {
-        for(auto location = leg->location().begin() + index; location != leg->location().end(); ++location) {
+        for(auto location = (*leg)->location().begin() + index; location != (*leg)->location().end(); ++location) {
           index = 1;
-          auto loc = json::map({});
+          writer.start_object();
           if (location->type() == odin::Location_Type_kThrough) {
-            loc->emplace("type", std::string("through"));
+            writer("type", "through");
           } else {
-            loc->emplace("type", std::string("break"));
+            writer("type", "break");
           }
-          loc->emplace("lat", json::fp_t{location->ll().lat(), 6});
-          loc->emplace("lon",json::fp_t{location->ll().lng(), 6});
+          writer("lat", json::fp_t{location->ll().lat(), 6});
+          writer("lon", json::fp_t{location->ll().lng(), 6});
           if (!location->name().empty())
-            loc->emplace("name",location->name());
+            writer("name", location->name());
           if (!location->street().empty())
-            loc->emplace("street",location->street());
+            writer("street", location->street());
           if (!location->city().empty())
-            loc->emplace("city",location->city());
+            writer("city", location->city());
           if (!location->state().empty())
-            loc->emplace("state",location->state());
+            writer("state", location->state());
           if (!location->postal_code().empty())
-            loc->emplace("postal_code",location->postal_code());
+            writer("postal_code", location->postal_code());
           if (!location->country().empty())
-            loc->emplace("country",location->country());
+            writer("country", location->country());
           if (location->has_heading())
-            loc->emplace("heading",static_cast<uint64_t>(location->heading()));
+            writer("heading", static_cast<uint64_t>(location->heading()));
           if (!location->date_time().empty())
-            loc->emplace("date_time",location->date_time());
+            writer("date_time", location->date_time());
           if (location->has_side_of_street()) {
             if (location->side_of_street() == odin::Location_SideOfStreet_kLeft)
-              loc->emplace("side_of_street", std::string("left"));
+              writer("side_of_street", "left");
             else if (location->side_of_street() == odin::Location_SideOfStreet_kRight)
-              loc->emplace("side_of_street", std::string("right"));
+              writer("side_of_street", "right");
           }
           if (location->has_original_index())
-            loc->emplace("original_index",static_cast<uint64_t>(location->original_index()));
+            writer("original_index", static_cast<uint64_t>(location->original_index()));
 
-          //loc->emplace("sideOfStreet",location->side_of_street());
+          //writer("sideOfStreet", location->side_of_street());
 
-          locations->emplace_back(loc);
+          writer.end_object();
         }
       }
 
-      return locations;
+      writer.end_array();
     }
 
     const std::unordered_map<int, std::string> vehicle_to_string {
@@ -454,347 +457,283 @@ namespace {
       }
     }
 
-    json::ArrayPtr legs(const std::list<valhalla::odin::TripDirections>& directions_legs){
+    void sign_elements(const char* key, const google::protobuf::RepeatedPtrField<TripDirections_Maneuver_Sign_Element>& elements,
+      json::writer_t& writer) {
+      if (elements.size() == 0)
+        return;
+      writer.start_array(key);
+      for (const auto& element : elements) {
+        writer.start_object();
+        // Add the text
+        writer("text", element.text());
+        // Add the consecutive count only if greater than zero
+        if (element.consecutive_count() > 0)
+          writer("consecutive_count", static_cast<uint64_t>(element.consecutive_count()));
+        writer.end_object();
+      }
+      writer.end_array();
+    }
+
+    void transit_info(const TripDirections_TransitInfo& transit_info, json::writer_t& writer) {
+      writer.start_object("transit_info");
+
+      if (transit_info.has_onestop_id()) {
+        writer("onestop_id", transit_info.onestop_id());
+        valhalla::midgard::logging::Log("transit_route_stopid::" + transit_info.onestop_id(), " [ANALYTICS] ");
+      }
+      if (transit_info.has_short_name()) {
+        writer("short_name", transit_info.short_name());
+      }
+      if (transit_info.has_long_name()) {
+        writer("long_name", transit_info.long_name());
+      }
+      if (transit_info.has_headsign()) {
+        writer("headsign", transit_info.headsign());
+      }
+      if (transit_info.has_color()) {
+        writer("color", static_cast<uint64_t>(transit_info.color()));
+      }
+      if (transit_info.has_text_color()) {
+        writer("text_color", static_cast<uint64_t>(transit_info.text_color()));
+      }
+      if (transit_info.has_description()) {
+        writer("description", transit_info.description());
+      }
+      if (transit_info.has_operator_onestop_id()) {
+        writer("operator_onestop_id", transit_info.operator_onestop_id());
+      }
+      if (transit_info.has_operator_name()) {
+        writer("operator_name", transit_info.operator_name());
+      }
+      if (transit_info.has_operator_url()) {
+        writer("operator_url", transit_info.operator_url());
+      }
+
+      // Add transit stops
+      if (transit_info.transit_stops().size() > 0) {
+        writer.start_array("transit_stops");
+        for (const auto& transit_stop : transit_info.transit_stops()) {
+          writer.start_object();
+
+          // type
+          if (transit_stop.has_type()) {
+            if (transit_stop.type() == TripDirections_TransitStop_Type_kStation) {
+              writer("type", "station");
+            } else {
+              writer("type", "stop");
+            }
+          }
+
+          // onestop_id
+          if (transit_stop.has_onestop_id()) {
+            writer("onestop_id", transit_stop.onestop_id());
+            valhalla::midgard::logging::Log("transit_stopid::" + transit_stop.onestop_id(), " [ANALYTICS] ");
+          }
+
+          // name
+          if (transit_stop.has_name()) {
+            writer("name", transit_stop.name());
+          }
+
+          // arrival_date_time
+          if (transit_stop.has_arrival_date_time()) {
+            writer("arrival_date_time", transit_stop.arrival_date_time());
+          }
+
+          // departure_date_time
+          if (transit_stop.has_departure_date_time()) {
+            writer("departure_date_time", transit_stop.departure_date_time());
+          }
+
+          // is_parent_stop
+          if (transit_stop.has_is_parent_stop()) {
+            writer("is_parent_stop", transit_stop.is_parent_stop());
+          }
+
+          // assumed_schedule
+          if (transit_stop.has_assumed_schedule()) {
+            writer("assumed_schedule", transit_stop.assumed_schedule());
+          }
+
+          // latitude and longitude
+          if (transit_stop.has_ll()) {
+            writer("lat", json::fp_t{transit_stop.ll().lat(), 6});
+            writer("lon", json::fp_t{transit_stop.ll().lng(), 6});
+          }
+
+          writer.end_object();
+        }
+        writer.end_array();
+      }
+
+      writer.end_object();
+    }
+
+    void legs(const std::list<valhalla::odin::TripDirections*>& directions_legs, json::writer_t& writer){
 
       // TODO: multiple legs.
-      auto legs = json::array({});
-      for(const auto& directions_leg : directions_legs) {
-        auto leg = json::map({});
-        auto summary = json::map({});
-        auto maneuvers = json::array({});
+      writer.start_array("legs");
+      for(const auto* directions_leg : directions_legs) {
+        writer.start_object();
 
-        for(const auto& maneuver : directions_leg.maneuver()) {
+        if (directions_leg->maneuver_size() > 0)
+          writer.start_array("maneuvers");
+        for(const auto& maneuver : directions_leg->maneuver()) {
 
-          auto man = json::map({});
+          writer.start_object();
 
           // Maneuver type
-          man->emplace("type", static_cast<uint64_t>(maneuver.type()));
+          writer("type", static_cast<uint64_t>(maneuver.type()));
 
           // Instruction and verbal instructions
-          man->emplace("instruction", maneuver.text_instruction());
+          writer("instruction", maneuver.text_instruction());
           if (maneuver.has_verbal_transition_alert_instruction()) {
-            man->emplace("verbal_transition_alert_instruction",
-                         maneuver.verbal_transition_alert_instruction());
+            writer("verbal_transition_alert_instruction",
+                   maneuver.verbal_transition_alert_instruction());
           }
           if (maneuver.has_verbal_pre_transition_instruction()) {
-            man->emplace("verbal_pre_transition_instruction",
-                         maneuver.verbal_pre_transition_instruction());
+            writer("verbal_pre_transition_instruction",
+                   maneuver.verbal_pre_transition_instruction());
           }
           if (maneuver.has_verbal_post_transition_instruction()) {
-            man->emplace("verbal_post_transition_instruction",
-                         maneuver.verbal_post_transition_instruction());
+            writer("verbal_post_transition_instruction",
+                   maneuver.verbal_post_transition_instruction());
           }
 
           // Set street names
           if (maneuver.street_name_size() > 0) {
-            auto street_names = json::array({});
+            writer.start_array("street_names");
             for (int i = 0; i < maneuver.street_name_size(); i++)
-              street_names->emplace_back(maneuver.street_name(i));
-            man->emplace("street_names", std::move(street_names));
+              writer(maneuver.street_name(i));
+            writer.end_array();
           }
 
           // Set begin street names
           if (maneuver.begin_street_name_size() > 0) {
-            auto begin_street_names = json::array({});
+            writer.start_array("begin_street_names");
             for (int i = 0; i < maneuver.begin_street_name_size(); i++)
-              begin_street_names->emplace_back(maneuver.begin_street_name(i));
-            man->emplace("begin_street_names", std::move(begin_street_names));
+              writer(maneuver.begin_street_name(i));
+            writer.end_array();
           }
 
           // Time, length, and shape indexes
-          man->emplace("time", static_cast<uint64_t>(maneuver.time()));
-          man->emplace("length", json::fp_t{maneuver.length(), 3});
-          man->emplace("begin_shape_index", static_cast<uint64_t>(maneuver.begin_shape_index()));
-          man->emplace("end_shape_index", static_cast<uint64_t>(maneuver.end_shape_index()));
+          writer("time", static_cast<uint64_t>(maneuver.time()));
+          writer("length", json::fp_t{maneuver.length(), 3});
+          writer("begin_shape_index", static_cast<uint64_t>(maneuver.begin_shape_index()));
+          writer("end_shape_index", static_cast<uint64_t>(maneuver.end_shape_index()));
 
           // Portions toll and rough
           if (maneuver.portions_toll())
-            man->emplace("toll", maneuver.portions_toll());
+            writer("toll", maneuver.portions_toll());
           if (maneuver.portions_unpaved())
-            man->emplace("rough", maneuver.portions_unpaved());
+            writer("rough", maneuver.portions_unpaved());
 
           // Process sign
           if (maneuver.has_sign()) {
-            auto sign = json::map({});
-
-            // Process exit number
-            if (maneuver.sign().exit_number_elements_size() > 0) {
-              auto exit_number_elements = json::array({});
-              for (int i = 0; i < maneuver.sign().exit_number_elements_size();
-                  ++i) {
-                auto exit_number_element = json::map({});
-
-                // Add the exit number text
-                exit_number_element->emplace(
-                    "text", maneuver.sign().exit_number_elements(i).text());
-
-                // Add the exit number consecutive count only if greater than zero
-                if (maneuver.sign().exit_number_elements(i).consecutive_count() > 0) {
-                  exit_number_element->emplace(
-                      "consecutive_count",static_cast<uint64_t>(
-                          maneuver.sign().exit_number_elements(i).consecutive_count()));
-                }
-
-                exit_number_elements->emplace_back(exit_number_element);
-              }
-              sign->emplace("exit_number_elements",
-                            std::move(exit_number_elements));
-            }
-
-            // Process exit branch
-            if (maneuver.sign().exit_branch_elements_size() > 0) {
-              auto exit_branch_elements = json::array({});
-              for (int i = 0; i < maneuver.sign().exit_branch_elements_size();
-                  ++i) {
-                auto exit_branch_element = json::map({});
-
-                // Add the exit branch text
-                exit_branch_element->emplace(
-                    "text", maneuver.sign().exit_branch_elements(i).text());
-
-                // Add the exit branch consecutive count only if greater than zero
-                if (maneuver.sign().exit_branch_elements(i).consecutive_count() > 0) {
-                  exit_branch_element->emplace(
-                      "consecutive_count",static_cast<uint64_t>(
-                          maneuver.sign().exit_branch_elements(i).consecutive_count()));
-                }
-
-                exit_branch_elements->emplace_back(exit_branch_element);
-              }
-              sign->emplace("exit_branch_elements",
-                            std::move(exit_branch_elements));
-            }
-
-            // Process exit toward
-            if (maneuver.sign().exit_toward_elements_size() > 0) {
-              auto exit_toward_elements = json::array({});
-              for (int i = 0; i < maneuver.sign().exit_toward_elements_size();
-                  ++i) {
-                auto exit_toward_element = json::map({});
-
-                // Add the exit toward text
-                exit_toward_element->emplace(
-                    "text", maneuver.sign().exit_toward_elements(i).text());
-
-                // Add the exit toward consecutive count only if greater than zero
-                if (maneuver.sign().exit_toward_elements(i).consecutive_count() > 0) {
-                  exit_toward_element->emplace(
-                      "consecutive_count",static_cast<uint64_t>(
-                          maneuver.sign().exit_toward_elements(i).consecutive_count()));
-                }
-
-                exit_toward_elements->emplace_back(exit_toward_element);
-              }
-              sign->emplace("exit_toward_elements",
-                            std::move(exit_toward_elements));
-            }
-
-            // Process exit name
-            if (maneuver.sign().exit_name_elements_size() > 0) {
-              auto exit_name_elements = json::array({});
-              for (int i = 0; i < maneuver.sign().exit_name_elements_size();
-                  ++i) {
-                auto exit_name_element = json::map({});
-
-                // Add the exit name text
-                exit_name_element->emplace(
-                    "text", maneuver.sign().exit_name_elements(i).text());
-
-                // Add the exit name consecutive count only if greater than zero
-                if (maneuver.sign().exit_name_elements(i).consecutive_count() > 0) {
-                  exit_name_element->emplace(
-                      "consecutive_count",static_cast<uint64_t>(
-                          maneuver.sign().exit_name_elements(i).consecutive_count()));
-                }
-
-                exit_name_elements->emplace_back(exit_name_element);
-              }
-              sign->emplace("exit_name_elements",
-                            std::move(exit_name_elements));
-            }
-
-            man->emplace("sign", std::move(sign));
+            writer.start_object("sign");
+            sign_elements("exit_number_elements", maneuver.sign().exit_number_elements(), writer);
+            sign_elements("exit_branch_elements", maneuver.sign().exit_branch_elements(), writer);
+            sign_elements("exit_toward_elements", maneuver.sign().exit_toward_elements(), writer);
+            sign_elements("exit_name_elements", maneuver.sign().exit_name_elements(), writer);
+            writer.end_object();
           }
 
           // Roundabout count
           if (maneuver.has_roundabout_exit_count()) {
-            man->emplace("roundabout_exit_count", static_cast<uint64_t>(maneuver.roundabout_exit_count()));
+            writer("roundabout_exit_count", static_cast<uint64_t>(maneuver.roundabout_exit_count()));
           }
 
           // Depart and arrive instructions
           if (maneuver.has_depart_instruction()) {
-            man->emplace("depart_instruction", maneuver.depart_instruction());
+            writer("depart_instruction", maneuver.depart_instruction());
           }
           if (maneuver.has_verbal_depart_instruction()) {
-            man->emplace("verbal_depart_instruction", maneuver.verbal_depart_instruction());
+            writer("verbal_depart_instruction", maneuver.verbal_depart_instruction());
           }
           if (maneuver.has_arrive_instruction()) {
-            man->emplace("arrive_instruction", maneuver.arrive_instruction());
+            writer("arrive_instruction", maneuver.arrive_instruction());
           }
           if (maneuver.has_verbal_arrive_instruction()) {
-            man->emplace("verbal_arrive_instruction", maneuver.verbal_arrive_instruction());
+            writer("verbal_arrive_instruction", maneuver.verbal_arrive_instruction());
           }
 
           // Process transit route
-          if (maneuver.has_transit_info()) {
-            const auto& transit_info = maneuver.transit_info();
-            auto json_transit_info = json::map({});
-
-            if (transit_info.has_onestop_id()) {
-              json_transit_info->emplace("onestop_id", transit_info.onestop_id());
-              valhalla::midgard::logging::Log("transit_route_stopid::" + transit_info.onestop_id(), " [ANALYTICS] ");
-            }
-            if (transit_info.has_short_name()) {
-              json_transit_info->emplace("short_name", transit_info.short_name());
-            }
-            if (transit_info.has_long_name()) {
-              json_transit_info->emplace("long_name", transit_info.long_name());
-            }
-            if (transit_info.has_headsign()) {
-              json_transit_info->emplace("headsign", transit_info.headsign());
-            }
-            if (transit_info.has_color()) {
-              json_transit_info->emplace("color", static_cast<uint64_t>(transit_info.color()));
-            }
-            if (transit_info.has_text_color()) {
-              json_transit_info->emplace("text_color", static_cast<uint64_t>(transit_info.text_color()));
-            }
-            if (transit_info.has_description()) {
-              json_transit_info->emplace("description", transit_info.description());
-            }
-            if (transit_info.has_operator_onestop_id()) {
-              json_transit_info->emplace("operator_onestop_id", transit_info.operator_onestop_id());
-            }
-            if (transit_info.has_operator_name()) {
-              json_transit_info->emplace("operator_name", transit_info.operator_name());
-            }
-            if (transit_info.has_operator_url()) {
-              json_transit_info->emplace("operator_url", transit_info.operator_url());
-            }
-
-            // Add transit stops
-            if (transit_info.transit_stops().size() > 0) {
-              auto json_transit_stops = json::array({});
-              for (const auto& transit_stop : transit_info.transit_stops()) {
-                auto json_transit_stop = json::map({});
-
-                // type
-                if (transit_stop.has_type()) {
-                  if (transit_stop.type() == TripDirections_TransitStop_Type_kStation) {
-                    json_transit_stop->emplace("type", std::string("station"));
-                  } else {
-                    json_transit_stop->emplace("type", std::string("stop"));
-                  }
-                }
-
-                // onestop_id
-                if (transit_stop.has_onestop_id()) {
-                    json_transit_stop->emplace("onestop_id", transit_stop.onestop_id());
-                    valhalla::midgard::logging::Log("transit_stopid::" + transit_stop.onestop_id(), " [ANALYTICS] ");
-                }
-
-                // name
-                if (transit_stop.has_name()) {
-                    json_transit_stop->emplace("name", transit_stop.name());
-                }
-
-                // arrival_date_time
-                if (transit_stop.has_arrival_date_time()) {
-                    json_transit_stop->emplace("arrival_date_time", transit_stop.arrival_date_time());
-                }
-
-                // departure_date_time
-                if (transit_stop.has_departure_date_time()) {
-                    json_transit_stop->emplace("departure_date_time", transit_stop.departure_date_time());
-                }
-
-                // is_parent_stop
-                if (transit_stop.has_is_parent_stop()) {
-                    json_transit_stop->emplace("is_parent_stop", transit_stop.is_parent_stop());
-                }
-
-                // assumed_schedule
-                if (transit_stop.has_assumed_schedule()) {
-                    json_transit_stop->emplace("assumed_schedule", transit_stop.assumed_schedule());
-                }
-
-                // latitude and longitude
-                if (transit_stop.has_ll()) {
-                    json_transit_stop->emplace("lat", json::fp_t{transit_stop.ll().lat(), 6});
-                    json_transit_stop->emplace("lon",json::fp_t{transit_stop.ll().lng(), 6});
-                }
-
-                json_transit_stops->emplace_back(json_transit_stop);
-
-              }
-              json_transit_info->emplace("transit_stops",
-                                          std::move(json_transit_stops));
-            }
-
-            man->emplace("transit_info", std::move(json_transit_info));
-          }
+          if (maneuver.has_transit_info())
+            transit_info(maneuver.transit_info(), writer);
 
           if (maneuver.verbal_multi_cue())
-            man->emplace("verbal_multi_cue", maneuver.verbal_multi_cue());
+            writer("verbal_multi_cue", maneuver.verbal_multi_cue());
 
           // Travel mode
           auto mode_type = travel_mode_type(maneuver);
-          man->emplace("travel_mode", mode_type.first);
+          writer("travel_mode", mode_type.first);
 
           // Travel type
-          man->emplace("travel_type", mode_type.second);
+          writer("travel_type", mode_type.second);
 
-          //  man->emplace("hasGate", maneuver.);
-          //  man->emplace("hasFerry", maneuver.);
+          //  writer("hasGate", maneuver.);
+          //  writer("hasFerry", maneuver.);
           //“portionsTollNote” : “<portionsTollNote>”,
           //“portionsUnpavedNote” : “<portionsUnpavedNote>”,
           //“gateAccessRequiredNote” : “<gateAccessRequiredNote>”,
           //“checkFerryInfoNote” : “<checkFerryInfoNote>”
-          maneuvers->emplace_back(man);
+          writer.end_object();
 
         }
-        if (directions_leg.maneuver_size() > 0) {
-          leg->emplace("maneuvers", maneuvers);
-        }
-        summary->emplace("time", static_cast<uint64_t>(directions_leg.summary().time()));
-        summary->emplace("length", json::fp_t{directions_leg.summary().length(), 3});
-        summary->emplace("min_lat", json::fp_t{directions_leg.summary().bbox().min_ll().lat(), 6});
-        summary->emplace("min_lon",json::fp_t{directions_leg.summary().bbox().min_ll().lng(), 6});
-        summary->emplace("max_lat", json::fp_t{directions_leg.summary().bbox().max_ll().lat(), 6});
-        summary->emplace("max_lon",json::fp_t{directions_leg.summary().bbox().max_ll().lng(), 6});
-        leg->emplace("summary",summary);
-        leg->emplace("shape", directions_leg.shape());
-
-        legs->emplace_back(leg);
+        if (directions_leg->maneuver_size() > 0)
+          writer.end_array();
+
+        writer.start_object("summary");
+        writer("time", static_cast<uint64_t>(directions_leg->summary().time()));
+        writer("length", json::fp_t{directions_leg->summary().length(), 3});
+        writer("min_lat", json::fp_t{directions_leg->summary().bbox().min_ll().lat(), 6});
+        writer("min_lon", json::fp_t{directions_leg->summary().bbox().min_ll().lng(), 6});
+        writer("max_lat", json::fp_t{directions_leg->summary().bbox().max_ll().lat(), 6});
+        writer("max_lon", json::fp_t{directions_leg->summary().bbox().max_ll().lng(), 6});
+        writer.end_object();
+        writer("shape", directions_leg->shape());
+
+        writer.end_object();
       }
-      return legs;
+      writer.end_array();
+    }
+
+    void trip(const valhalla::odin::DirectionsOptions& directions_options,
+              const std::list<valhalla::odin::TripDirections*>& directions_legs,
+              json::writer_t& writer) {
+      writer.start_object("trip");
+      locations(directions_legs, writer);
+      summary(directions_legs, writer);
+      legs(directions_legs, writer);
+      writer("status_message", "Found route between points"); //found route between points OR cannot find route between points
+      writer("status", static_cast<uint64_t>(0)); //0 success
+      writer("units", (directions_options.units() == valhalla::odin::DirectionsOptions::kKilometers) ? "kilometers" : "miles");
+      writer("language", directions_options.language());
+      writer.end_object();
     }
 
     void serialize(const boost::optional<std::string>& id,
                    const valhalla::odin::DirectionsOptions& directions_options,
-                   const std::list<valhalla::odin::TripDirections>& directions_legs,
-                   std::ostringstream& stream) {
-
-      //build up the json object
-      auto json = json::map
-      ({
-        {"trip", json::map
-          ({
-            {"locations", locations(directions_legs)},
-            {"summary", summary(directions_legs)},
-            {"legs", legs(directions_legs)},
-            {"status_message", string("Found route between points")}, //found route between points OR cannot find route between points
-            {"status", static_cast<uint64_t>(0)}, //0 success
-            {"units", std::string((directions_options.units() == valhalla::odin::DirectionsOptions::kKilometers) ? "kilometers" : "miles")},
-            {"language", directions_options.language()}
-          })
+                   const std::list<valhalla::odin::TripDirections*>& directions_legs,
+                   const std::vector<std::list<valhalla::odin::TripDirections*> >& alternates,
+                   json::writer_t& writer) {
+
+      //write out the json object
+      writer.start_object();
+      trip(directions_options, directions_legs, writer);
+      //each alternate is a whole trip of its own
+      if (!alternates.empty()) {
+        writer.start_array("alternates");
+        for (const auto& alternate : alternates) {
+          writer.start_object();
+          trip(directions_options, alternate, writer);
+          writer.end_object();
         }
-      });
+        writer.end_array();
+      }
       if (id)
-        json->emplace("id", *id);
-
-      //serialize it
-      stream << *json;
+        writer("id", *id);
+      writer.end_object();
     }
   }
 
@@ -802,37 +741,37 @@ namespace {
   const headers_t::value_type CORS{"Access-Control-Allow-Origin", "*"};
   const headers_t::value_type JSON_MIME{"Content-type", "application/json;charset=utf-8"};
   const headers_t::value_type JS_MIME{"Content-type", "application/javascript;charset=utf-8"};
-
-  worker_t::result_t jsonify_error(const valhalla_exception_t& exception, http_request_info_t& request_info, const boost::optional<std::string>& jsonp) {
-
-    //build up the json map
-    auto json_error = json::map({});
-    json_error->emplace("status", exception.status_code_body);
-    json_error->emplace("status_code", static_cast<uint64_t>(exception.status_code));
-    json_error->emplace("error", std::string(exception.error_code_message));
-    json_error->emplace("error_code", static_cast<uint64_t>(exception.error_code));
-
-    //serialize it
-    std::stringstream ss;
-    if(jsonp)
-      ss << *jsonp << '(';
-    ss << *json_error;
-    if(jsonp)
-      ss << ')';
-
-    worker_t::result_t result{false};
-    http_response_t response(exception.status_code, exception.status_code_body, ss.str(), headers_t{CORS, jsonp ? JS_MIME : JSON_MIME});
-    response.from_info(request_info);
-    result.messages.emplace_back(response.to_string());
-
-    return result;
-  }
 }
 
 
 namespace valhalla {
   namespace tyr {
 
+    worker_t::result_t jsonify_error(const valhalla_exception_t& exception, http_request_info_t& request_info, const boost::optional<std::string>& jsonp) {
+
+      //build up the json map
+      auto json_error = json::map({});
+      json_error->emplace("status", exception.status_code_body);
+      json_error->emplace("status_code", static_cast<uint64_t>(exception.status_code));
+      json_error->emplace("error", std::string(exception.error_code_message));
+      json_error->emplace("error_code", static_cast<uint64_t>(exception.error_code));
+
+      //serialize it
+      std::stringstream ss;
+      if(jsonp)
+        ss << *jsonp << '(';
+      ss << *json_error;
+      if(jsonp)
+        ss << ')';
+
+      worker_t::result_t result{false};
+      http_response_t response(exception.status_code, exception.status_code_body, ss.str(), headers_t{CORS, jsonp ? JS_MIME : JSON_MIME});
+      response.from_info(request_info);
+      result.messages.emplace_back(response.to_string());
+
+      return result;
+    }
+
     tyr_worker_t::tyr_worker_t(const boost::property_tree::ptree& config):
       config(config),
       long_request(config.get<float>("tyr.logging.long_request")){}
@@ -840,80 +779,30 @@ namespace valhalla {
     tyr_worker_t::~tyr_worker_t(){}
 
     worker_t::result_t tyr_worker_t::work(const std::list<zmq::message_t>& job, void* request_info, const worker_t::interrupt_function_t&) {
-      //get time for start of request
-      auto s = std::chrono::system_clock::now();
       auto& info = *static_cast<http_request_info_t*>(request_info);
       LOG_INFO("Got Tyr Request " + std::to_string(info.id));
       try{
         //get some info about what we need to do
-        std::string request_str(static_cast<const char*>(job.front().data()), job.front().size());
-        std::stringstream stream(request_str);
-        boost::property_tree::ptree request;
-
-        try{
-          boost::property_tree::read_json(stream, request);
-          jsonp = request.get_optional<std::string>("jsonp");
-        }
-        catch(...) {
+        rapidjson::Document request;
+        request.Parse(static_cast<const char*>(job.front().data()), job.front().size());
+        if(request.HasParseError())
           return jsonify_error({500, 500}, info, jsonp);
-        }
-
-        //flag healthcheck requests; do not send to logstash
-        healthcheck = request.get<bool>("healthcheck", false);
-        //see if we can get some options
-        valhalla::odin::DirectionsOptions directions_options;
-        auto options = request.get_child_optional("directions_options");
-        if(options)
-          directions_options = valhalla::odin::GetDirectionsOptions(*options);
-
-        if (!healthcheck)
-          midgard::logging::Log("language::" + directions_options.language(), " [ANALYTICS] ");
+        jsonp = GetOptionalFromRapidJson<std::string>(request, "/jsonp");
 
         //get the legs
-        std::list<odin::TripDirections> legs;
+        std::list<odin::TripDirections*> legs;
         for(auto leg = ++job.cbegin(); leg != job.cend(); ++leg) {
-          legs.emplace_back();
+          legs.emplace_back(arena.create<odin::TripDirections>());
           try {
-            legs.back().ParseFromArray(leg->data(), static_cast<int>(leg->size()));
+            legs.back()->ParseFromArray(leg->data(), static_cast<int>(leg->size()));
           }
           catch(...) {
             return jsonify_error({500, 501}, info, jsonp);
           }
         }
 
-        //jsonp callback if need be
-        std::ostringstream json_stream;
-        auto jsonp = request.get_optional<std::string>("jsonp");
-        if(jsonp)
-          json_stream << *jsonp << '(';
-        //serialize them
-        if(request.get<int>("action") == VIAROUTE)
-          osrm_serializers::serialize(directions_options, legs, json_stream);
-        else
-          valhalla_serializers::serialize(request.get_optional<std::string>("id"), directions_options, legs, json_stream);
-        if(jsonp)
-          json_stream << ')';
-
-        //log request if greater than X (ms)
-        auto trip_directions_length = 0.f;
-        for(const auto& leg : legs) {
-          trip_directions_length += leg.summary().length();
-        }
-        if (!healthcheck) midgard::logging::Log("trip_length::" + std::to_string(trip_directions_length) + "km", " [ANALYTICS] ");
-        //get processing time for tyr
-        auto e = std::chrono::system_clock::now();
-        std::chrono::duration<float, std::milli> elapsed_time = e - s;
-        //log request if greater than X (ms)
-        if (!healthcheck && !info.spare && (elapsed_time.count() / trip_directions_length) > long_request) {
-          std::stringstream ss;
-          boost::property_tree::json_parser::write_json(ss, request, false);
-          LOG_WARN("tyr::request elapsed time (ms)::"+ std::to_string(elapsed_time.count()));
-          LOG_WARN("tyr::request exceeded threshold::"+ ss.str());
-          midgard::logging::Log("valhalla_tyr_long_request", " [ANALYTICS] ");
-        }
-
         worker_t::result_t result{false};
-        http_response_t response(200, "OK", json_stream.str(), headers_t{CORS, jsonp ? JS_MIME : JSON_MIME});
+        http_response_t response(200, "OK", serialize(request, legs, info), headers_t{CORS, jsonp ? JS_MIME : JSON_MIME});
         response.from_info(info);
         result.messages.emplace_back(response.to_string());
 
@@ -925,8 +814,70 @@ namespace valhalla {
       }
     }
 
+    std::string tyr_worker_t::serialize(const rapidjson::Document& request, const std::list<odin::TripDirections*>& legs,
+      http_request_info_t& request_info) {
+      //get time for start of request
+      auto s = std::chrono::system_clock::now();
+      jsonp = GetOptionalFromRapidJson<std::string>(request, "/jsonp");
+
+      //flag healthcheck requests; do not send to logstash
+      healthcheck = GetFromRapidJson<bool>(request, "/healthcheck", false);
+      //see if we can get some options
+      valhalla::odin::DirectionsOptions directions_options;
+      auto options = rapidjson::Pointer{"/directions_options"}.Get(request);
+      if(options)
+        directions_options = valhalla::odin::GetDirectionsOptions(*options);
+
+      if (!healthcheck)
+        midgard::logging::Log("language::" + directions_options.language(), " [ANALYTICS] ");
+
+      //jsonp callback if need be
+      writer.clear();
+      if(jsonp)
+        writer.raw(*jsonp + '(');
+      //the legs of the best trip come first, any alternate trips follow
+      std::list<odin::TripDirections*> trip_legs;
+      std::vector<std::list<odin::TripDirections*> > alternates;
+      for(auto* leg : legs) {
+        if(leg->trip_id() == 0) {
+          trip_legs.push_back(leg);
+          continue;
+        }
+        if(alternates.size() < leg->trip_id())
+          alternates.resize(leg->trip_id());
+        alternates[leg->trip_id() - 1].push_back(leg);
+      }
+
+      //serialize them
+      if(GetFromRapidJson<int>(request, "/action") == VIAROUTE)
+        osrm_serializers::serialize(directions_options, trip_legs, writer);
+      else
+        valhalla_serializers::serialize(GetOptionalFromRapidJson<std::string>(request, "/id"), directions_options, trip_legs, alternates, writer);
+      if(jsonp)
+        writer.raw(")");
+
+      //log request if greater than X (ms)
+      auto trip_directions_length = 0.f;
+      for(const auto* leg : legs) {
+        trip_directions_length += leg->summary().length();
+      }
+      if (!healthcheck) midgard::logging::Log("trip_length::" + std::to_string(trip_directions_length) + "km", " [ANALYTICS] ");
+      //get processing time for tyr
+      auto e = std::chrono::system_clock::now();
+      std::chrono::duration<float, std::milli> elapsed_time = e - s;
+      //log request if greater than X (ms)
+      if (!healthcheck && !request_info.spare && (elapsed_time.count() / trip_directions_length) > long_request) {
+        LOG_WARN("tyr::request elapsed time (ms)::"+ std::to_string(elapsed_time.count()));
+        LOG_WARN("tyr::request exceeded threshold::"+ rapidjson::to_string(request));
+        midgard::logging::Log("valhalla_tyr_long_request", " [ANALYTICS] ");
+      }
+
+      return writer.str();
+    }
+
     void tyr_worker_t::cleanup() {
       jsonp = boost::none;
+      arena.reset();
     }
 
     void run_service(const boost::property_tree::ptree& config) {
@@ -940,8 +891,10 @@ namespace valhalla {
 
       //listen for requests
       zmq::context_t context;
+      tyr_worker_t tyr_worker(config);
       prime_server::worker_t worker(context, upstream_endpoint, "ipc://NO_ENDPOINT", loopback_endpoint, interrupt_endpoint,
-        std::bind(&tyr_worker_t::work, tyr_worker_t(config), std::placeholders::_1, std::placeholders::_2, std::placeholders::_3));
+        std::bind(&tyr_worker_t::work, std::ref(tyr_worker), std::placeholders::_1, std::placeholders::_2, std::placeholders::_3),
+        std::bind(&tyr_worker_t::cleanup, std::ref(tyr_worker)));
       worker.work();
 
       //TODO: should we listen for SIGINT and terminate gracefully/exit(0)?
@@ -0,0 +1,134 @@
+#include <cstdlib>
+#include <new>
+#include <atomic>
+#include <vector>
+#include <string>
+#include <sstream>
+#include <chrono>
+
+#include "midgard/logging.h"
+#include "baldr/json.h"
+#include "baldr/json_writer.h"
+
+using namespace valhalla::baldr;
+
+//count every allocation in the program so we can see what each serializer costs
+namespace {
+  std::atomic<size_t> allocations(0);
+}
+void* operator new(std::size_t size) {
+  ++allocations;
+  if(void* p = std::malloc(size ? size : 1))
+    return p;
+  throw std::bad_alloc();
+}
+void operator delete(void* p) noexcept {
+  std::free(p);
+}
+void operator delete(void* p, std::size_t) noexcept {
+  std::free(p);
+}
+
+namespace {
+
+  //something shaped like a route response, a bunch of maneuvers with a few names each
+  struct maneuver_t {
+    std::string instruction;
+    std::vector<std::string> street_names;
+    uint64_t time, begin_shape_index, end_shape_index;
+    double length;
+  };
+  std::vector<maneuver_t> make_maneuvers(size_t count) {
+    std::vector<maneuver_t> maneuvers;
+    for(size_t i = 0; i < count; ++i)
+      maneuvers.push_back(maneuver_t{"Turn right onto West 26th Street.", {"West 26th Street", "NY 9A"},
+        i * 7, i * 13, i * 13 + 12, i * .125});
+    return maneuvers;
+  }
+
+  //what we used to do, build up the tree then stream it out
+  std::string tree(const std::vector<maneuver_t>& maneuvers) {
+    auto array = json::array({});
+    for(const auto& maneuver : maneuvers) {
+      auto names = json::array({});
+      for(const auto& name : maneuver.street_names)
+        names->emplace_back(name);
+      array->emplace_back(json::map({
+        {"instruction", maneuver.instruction},
+        {"street_names", names},
+        {"time", maneuver.time},
+        {"length", json::fp_t{maneuver.length, 3}},
+        {"begin_shape_index", maneuver.begin_shape_index},
+        {"end_shape_index", maneuver.end_shape_index},
+      }));
+    }
+    auto response = json::map({
+      {"trip", json::map({{"legs", json::array({json::map({{"maneuvers", array}})})}})},
+      {"id", std::string("benchmark")},
+    });
+    std::ostringstream stream;
+    stream << *response;
+    return stream.str();
+  }
+
+  //what we do now, write it as we go into a buffer we keep around
+  json::writer_t writer;
+  std::string stream(const std::vector<maneuver_t>& maneuvers) {
+    writer.clear();
+    writer.start_object();
+    writer.start_object("trip");
+    writer.start_array("legs");
+    writer.start_object();
+    writer.start_array("maneuvers");
+    for(const auto& maneuver : maneuvers) {
+      writer.start_object();
+      writer("instruction", maneuver.instruction);
+      writer.start_array("street_names");
+      for(const auto& name : maneuver.street_names)
+        writer(name);
+      writer.end_array();
+      writer("time", maneuver.time);
+      writer("length", json::fp_t{maneuver.length, 3});
+      writer("begin_shape_index", maneuver.begin_shape_index);
+      writer("end_shape_index", maneuver.end_shape_index);
+      writer.end_object();
+    }
+    writer.end_array();
+    writer.end_object();
+    writer.end_array();
+    writer.end_object();
+    writer("id", "benchmark");
+    writer.end_object();
+    return writer.str();
+  }
+
+  template <class serializer_t>
+  void time_it(const std::string& name, const std::vector<maneuver_t>& maneuvers, size_t iterations, const serializer_t& serializer) {
+    //warm up so that reused buffers are already sized
+    size_t bytes = serializer(maneuvers).size();
+    auto before = allocations.load();
+    auto start = std::chrono::system_clock::now();
+    for(size_t i = 0; i < iterations; ++i)
+      bytes += serializer(maneuvers).size();
+    std::chrono::duration<double> elapsed = std::chrono::system_clock::now() - start;
+    auto allocated = allocations.load() - before;
+    LOG_INFO(name + ": " + std::to_string(elapsed.count() * 1000 / iterations) + " ms per response, " +
+      std::to_string(bytes / (1024.0 * 1024.0) / elapsed.count()) + " MB/s, " +
+      std::to_string(static_cast<double>(allocated) / iterations) + " allocations per response");
+  }
+
+}
+
+int main(int argc, char** argv) {
+
+  size_t maneuver_count = argc > 1 ? std::stoul(argv[1]) : 100;
+  size_t iterations = argc > 2 ? std::stoul(argv[2]) : 1000;
+
+  auto maneuvers = make_maneuvers(maneuver_count);
+  LOG_INFO(std::to_string(maneuver_count) + " maneuvers: " + std::to_string(stream(maneuvers).size()) + " bytes of json");
+
+  time_it("tree", maneuvers, iterations, tree);
+  time_it("writer", maneuvers, iterations, stream);
+
+  return EXIT_SUCCESS;
+}
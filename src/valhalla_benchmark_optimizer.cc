@@ -0,0 +1,82 @@
+#include <cstdlib>
+#include <cmath>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <random>
+#include <thread>
+#include <iostream>
+
+#include "midgard/logging.h"
+#include "thor/optimizer.h"
+#include "thor/local_search_optimizer.h"
+
+using namespace valhalla::thor;
+
+namespace {
+
+  //locations scattered over a city with some one way streets and turn
+  //restrictions thrown in so that the costs are not symmetric
+  std::vector<float> random_costs(uint32_t count, std::mt19937& generator) {
+    std::uniform_real_distribution<float> coordinate(0.f, 10000.f);
+    std::uniform_real_distribution<float> detour(1.f, 1.3f);
+    std::vector<std::pair<float, float> > points(count);
+    for(auto& point : points)
+      point = std::make_pair(coordinate(generator), coordinate(generator));
+    std::vector<float> costs(count * count, 0.f);
+    for(uint32_t i = 0; i < count; ++i)
+      for(uint32_t j = 0; j < count; ++j)
+        if(i != j)
+          costs[i * count + j] = std::hypot(points[i].first - points[j].first,
+            points[i].second - points[j].second) * detour(generator);
+    return costs;
+  }
+
+  template <class solve_t>
+  void time_it(const std::string& name, uint32_t count, const std::vector<float>& costs, const solve_t& solve) {
+    auto start = std::chrono::steady_clock::now();
+    auto tour = solve();
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    LOG_INFO(std::to_string(count) + " locations, " + name + ": " + std::to_string(elapsed.count()) +
+      " ms, tour cost " + std::to_string(LocalSearchOptimizer::TourCost(count, costs, tour)));
+  }
+
+}
+
+int main(int argc, char** argv) {
+
+  if(argc > 1 && std::string(argv[1]) == "--help") {
+    std::cerr << "Usage: " << argv[0] << " [location_count ...]" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::vector<uint32_t> counts;
+  for(int i = 1; i < argc; ++i)
+    counts.push_back(std::stoul(argv[i]));
+  if(counts.empty())
+    counts = {10, 25, 50, 100};
+
+  //compare the annealer with local search on the same costs
+  std::mt19937 generator(42);
+  uint32_t threads = std::max(std::thread::hardware_concurrency(), 1u);
+  for(auto count : counts) {
+    auto costs = random_costs(count, generator);
+    time_it("simulated annealing", count, costs, [&]() {
+      Optimizer optimizer;
+      optimizer.Seed(42);
+      return optimizer.Solve(count, costs);
+    });
+    time_it("local search 1 thread", count, costs, [&]() {
+      LocalSearchOptimizer optimizer;
+      optimizer.Seed(42);
+      return optimizer.Solve(count, costs);
+    });
+    time_it("local search " + std::to_string(threads) + " threads", count, costs, [&]() {
+      LocalSearchOptimizer optimizer(threads);
+      optimizer.Seed(42);
+      return optimizer.Solve(count, costs);
+    });
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,107 @@
+#include <cstdlib>
+#include <vector>
+#include <string>
+#include <sstream>
+#include <chrono>
+#include <random>
+#include <iomanip>
+
+#include <boost/property_tree/ptree.hpp>
+#include <boost/property_tree/json_parser.hpp>
+
+#include "midgard/logging.h"
+#include "baldr/rapidjson_utils.h"
+#include "baldr/location.h"
+#include "baldr/pathlocation.h"
+
+using namespace valhalla;
+
+namespace {
+
+  //a route request the way loki forwards it to thor, with a correlated entry per location
+  std::string make_request(size_t location_count) {
+    std::mt19937 generator(17);
+    std::uniform_real_distribution<float> jitter(-0.01f, 0.01f);
+    std::stringstream ss;
+    ss << std::setprecision(9) << "{\"costing\":\"auto\",\"action\":0,\"id\":\"benchmark\","
+       << "\"costing_options\":{\"auto\":{\"maneuver_penalty\":5,\"toll_booth_cost\":15,\"use_ferry\":0.5}},"
+       << "\"directions_options\":{\"units\":\"miles\",\"language\":\"en-US\",\"narrative\":true},\"locations\":[";
+    for(size_t i = 0; i < location_count; ++i)
+      ss << (i ? "," : "") << "{\"lat\":" << 40.7f + jitter(generator) << ",\"lon\":" << -76.5f + jitter(generator)
+         << ",\"type\":\"break\",\"heading\":90,\"minimum_reachability\":50,\"radius\":0}";
+    ss << "]";
+    for(size_t i = 0; i < location_count; ++i) {
+      ss << ",\"correlated_" << i << "\":{\"location_index\":" << i << ",\"edges\":[";
+      for(size_t j = 0; j < 4; ++j)
+        ss << (j ? "," : "") << "{\"id\":" << 1234567 + j << ",\"dist\":0.5,\"sos\":0,\"score\":3.2,\"minimum_reachability\":50,"
+           << "\"projected\":{\"lon\":" << -76.5 + jitter(generator) << ",\"lat\":" << 40.7 + jitter(generator) << "}}";
+      ss << "]}";
+    }
+    ss << "}";
+    return ss.str();
+  }
+
+  //what each of thor, odin and tyr used to do with the request
+  size_t ptree_stage(const std::string& json) {
+    boost::property_tree::ptree request;
+    std::stringstream stream(json);
+    boost::property_tree::read_json(stream, request);
+    std::vector<baldr::Location> locations;
+    for(const auto& location : request.get_child("locations"))
+      locations.push_back(baldr::Location::FromPtree(location.second));
+    std::vector<baldr::PathLocation> correlated;
+    for(size_t i = 0; i < locations.size(); ++i)
+      correlated.push_back(baldr::PathLocation::FromPtree(locations, request.get_child("correlated_" + std::to_string(i))));
+    auto costing_options = request.get_child("costing_options." + request.get<std::string>("costing"), {});
+    auto language = request.get_optional<std::string>("directions_options.language");
+    return correlated.size() + costing_options.size() + (language ? 1 : 0);
+  }
+
+  //what they do now
+  size_t rapidjson_stage(const std::string& json) {
+    rapidjson::Document request;
+    request.Parse(json.c_str(), json.size());
+    if(request.HasParseError())
+      throw std::runtime_error("Failed to parse request");
+    std::vector<baldr::Location> locations;
+    for(const auto& location : GetFromRapidJson<rapidjson::Value::ConstArray>(request, "/locations"))
+      locations.push_back(baldr::Location::FromRapidJson(location, 50));
+    std::vector<baldr::PathLocation> correlated;
+    for(size_t i = 0; i < locations.size(); ++i)
+      correlated.push_back(baldr::PathLocation::FromRapidJson(locations, request["correlated_" + std::to_string(i)]));
+    auto costing_options = rapidjson::Pointer{"/costing_options/" + GetFromRapidJson<std::string>(request, "/costing")}.Get(request);
+    auto language = GetOptionalFromRapidJson<std::string>(request, "/directions_options/language");
+    return correlated.size() + (costing_options ? costing_options->MemberCount() : 0) + (language ? 1 : 0);
+  }
+
+  template <class stage_t>
+  double time_it(const std::string& input, size_t iterations, const stage_t& stage) {
+    size_t parsed = 0;
+    auto start = std::chrono::system_clock::now();
+    for(size_t i = 0; i < iterations; ++i)
+      parsed += stage(input);
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::system_clock::now() - start;
+    if(parsed == 0)
+      throw std::runtime_error("Nothing was parsed");
+    return elapsed.count() / iterations;
+  }
+
+}
+
+int main(int argc, char** argv) {
+
+  size_t location_count = argc > 1 ? std::stoul(argv[1]) : 10;
+  size_t iterations = argc > 2 ? std::stoul(argv[2]) : 1000;
+
+  auto request = make_request(location_count);
+  LOG_INFO(std::to_string(location_count) + " locations: " + std::to_string(request.size()) + " bytes of json");
+
+  //thor, odin and tyr each handle the request once per route
+  auto ptree_ms = time_it(request, iterations, ptree_stage);
+  auto rapidjson_ms = time_it(request, iterations, rapidjson_stage);
+  LOG_INFO("ptree per stage: " + std::to_string(ptree_ms) + " ms, per request: " + std::to_string(ptree_ms * 3) + " ms");
+  LOG_INFO("rapidjson per stage: " + std::to_string(rapidjson_ms) + " ms, per request: " + std::to_string(rapidjson_ms * 3) + " ms");
+  LOG_INFO("speedup: " + std::to_string(ptree_ms / rapidjson_ms) + "x");
+
+  return EXIT_SUCCESS;
+}
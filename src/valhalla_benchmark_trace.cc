@@ -0,0 +1,104 @@
+#include <cstdlib>
+#include <vector>
+#include <string>
+#include <sstream>
+#include <chrono>
+#include <random>
+#include <iomanip>
+
+#include <boost/property_tree/ptree.hpp>
+#include <boost/property_tree/json_parser.hpp>
+
+#include "midgard/logging.h"
+#include "midgard/pointll.h"
+#include "meili/measurement.h"
+#include "proto/trace.pb.h"
+
+using namespace valhalla;
+
+namespace {
+
+  constexpr float kGpsAccuracy = 5.f;
+  constexpr float kSearchRadius = 50.f;
+
+  //a wandering trace with a point every second
+  odin::Trace make_trace(size_t count) {
+    std::mt19937 generator(17);
+    std::uniform_real_distribution<float> step(-0.0001f, 0.0001f);
+    odin::Trace trace;
+    float lat = 40.7f, lng = -76.5f;
+    double time = 1490000000;
+    for(size_t i = 0; i < count; ++i) {
+      trace.add_lat(lat += step(generator));
+      trace.add_lng(lng += step(generator));
+      trace.add_time(time += 1);
+    }
+    return trace;
+  }
+
+  std::string to_json(const odin::Trace& trace) {
+    std::stringstream ss;
+    ss << std::setprecision(9) << "{\"shape\":[";
+    for(int i = 0; i < trace.lat_size(); ++i)
+      ss << (i ? "," : "") << "{\"lat\":" << trace.lat(i) << ",\"lon\":" << trace.lng(i) << ",\"time\":" << trace.time(i) << '}';
+    ss << "]}";
+    return ss.str();
+  }
+
+  //what thor used to do with shape from the json request
+  std::vector<meili::Measurement> from_json(const std::string& json) {
+    boost::property_tree::ptree request;
+    std::stringstream stream(json);
+    boost::property_tree::read_json(stream, request);
+    std::vector<meili::Measurement> measurements;
+    for(const auto& pt : request.get_child("shape"))
+      measurements.emplace_back(midgard::PointLL{pt.second.get<float>("lon"), pt.second.get<float>("lat")},
+        kGpsAccuracy, kSearchRadius, pt.second.get<double>("time"));
+    return measurements;
+  }
+
+  //what thor does with the binary trace that loki forwards
+  std::vector<meili::Measurement> from_binary(const std::string& binary) {
+    odin::Trace trace;
+    if(!trace.ParseFromString(binary))
+      throw std::runtime_error("Failed to parse binary trace");
+    std::vector<meili::Measurement> measurements;
+    measurements.reserve(trace.lat_size());
+    for(int i = 0; i < trace.lat_size(); ++i)
+      measurements.emplace_back(midgard::PointLL{trace.lng(i), trace.lat(i)}, kGpsAccuracy, kSearchRadius, trace.time(i));
+    return measurements;
+  }
+
+  template <class parser_t>
+  double time_it(const std::string& input, size_t iterations, const parser_t& parser) {
+    size_t measurements = 0;
+    auto start = std::chrono::system_clock::now();
+    for(size_t i = 0; i < iterations; ++i)
+      measurements += parser(input).size();
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::system_clock::now() - start;
+    if(measurements == 0)
+      throw std::runtime_error("Nothing was parsed");
+    return elapsed.count() / iterations;
+  }
+
+}
+
+int main(int argc, char** argv) {
+
+  size_t point_count = argc > 1 ? std::stoul(argv[1]) : 10000;
+  size_t iterations = argc > 2 ? std::stoul(argv[2]) : 20;
+
+  auto trace = make_trace(point_count);
+  auto json = to_json(trace);
+  auto binary = trace.SerializeAsString();
+  LOG_INFO(std::to_string(point_count) + " points: " + std::to_string(json.size()) + " bytes of json, " +
+    std::to_string(binary.size()) + " bytes of binary");
+
+  auto json_ms = time_it(json, iterations, from_json);
+  auto binary_ms = time_it(binary, iterations, from_binary);
+  LOG_INFO("json shape parse: " + std::to_string(json_ms) + " ms per trace");
+  LOG_INFO("binary trace parse: " + std::to_string(binary_ms) + " ms per trace");
+  LOG_INFO("speedup: " + std::to_string(json_ms / binary_ms) + "x");
+
+  return EXIT_SUCCESS;
+}
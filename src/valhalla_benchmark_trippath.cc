@@ -0,0 +1,94 @@
+#include <cstdlib>
+#include <vector>
+#include <list>
+#include <string>
+#include <chrono>
+#include <iostream>
+
+#include <boost/property_tree/ptree.hpp>
+#include <boost/property_tree/json_parser.hpp>
+
+#include "midgard/logging.h"
+#include "baldr/graphreader.h"
+#include "baldr/location.h"
+#include "baldr/pathlocation.h"
+#include "loki/search.h"
+#include "sif/autocost.h"
+#include "thor/bidirectional_astar.h"
+#include "thor/trippathbuilder.h"
+#include "thor/attributes_controller.h"
+#include "proto/trippath.pb.h"
+
+using namespace valhalla;
+using namespace valhalla::thor;
+
+namespace {
+
+  //what a client that only draws the route and shows the eta asks for
+  AttributesController geometry_and_time() {
+    AttributesController controller;
+    controller.disable_all();
+    for(const auto& key : {kShape, kEdgeLength, kEdgeSpeed, kEdgeBeginShapeIndex, kEdgeEndShapeIndex, kNodeElapsedTime})
+      controller.attributes.at(key) = true;
+    return controller;
+  }
+
+  template <class build_t>
+  void time_it(const std::string& name, size_t iterations, const build_t& build) {
+    //warm up the tile cache so we measure building and not loading
+    size_t bytes = build().ByteSize();
+    auto start = std::chrono::system_clock::now();
+    for(size_t i = 0; i < iterations; ++i)
+      bytes += build().ByteSize();
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::system_clock::now() - start;
+    LOG_INFO(name + ": " + std::to_string(elapsed.count() / iterations) + " ms per trip path, " +
+      std::to_string(bytes / (iterations + 1)) + " bytes per trip path");
+  }
+
+}
+
+int main(int argc, char** argv) {
+
+  if(argc < 6) {
+    std::cerr << "Usage: " << argv[0] << " config.json origin_lat origin_lon destination_lat destination_lon [iterations]" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  boost::property_tree::ptree config;
+  boost::property_tree::read_json(argv[1], config);
+  baldr::GraphReader reader(config.get_child("mjolnir"));
+  size_t iterations = argc > 6 ? std::stoul(argv[6]) : 100;
+
+  //find the route once, its only the trip path building we care about
+  std::shared_ptr<sif::DynamicCost> mode_costing[4];
+  auto cost = sif::CreateAutoCost(config.get_child("costing_options.auto", {}));
+  auto mode = cost->travel_mode();
+  mode_costing[static_cast<uint32_t>(mode)] = cost;
+  std::vector<baldr::Location> locations{
+    {{std::stof(argv[3]), std::stof(argv[2])}},
+    {{std::stof(argv[5]), std::stof(argv[4])}}
+  };
+  auto projections = loki::Search(locations, reader, cost->GetEdgeFilter(), cost->GetNodeFilter());
+  auto origin = projections.at(locations.front());
+  auto destination = projections.at(locations.back());
+  BidirectionalAStar astar;
+  auto path = astar.GetBestPath(origin, destination, reader, mode_costing, mode);
+  if(path.empty()) {
+    LOG_ERROR("No route found");
+    return EXIT_FAILURE;
+  }
+  LOG_INFO(std::to_string(path.size()) + " edges in the path");
+
+  //everything the route action used to build vs only what geometry and time need
+  AttributesController full;
+  auto trimmed = geometry_and_time();
+  std::list<baldr::PathLocation> throughs;
+  time_it("full", iterations, [&]() {
+    return TripPathBuilder::Build(full, reader, mode_costing, path, origin, destination, throughs);
+  });
+  time_it("geometry and time", iterations, [&]() {
+    return TripPathBuilder::Build(trimmed, reader, mode_costing, path, origin, destination, throughs);
+  });
+
+  return EXIT_SUCCESS;
+}
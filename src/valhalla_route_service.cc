@@ -22,6 +22,7 @@ using namespace prime_server;
 #include "thor/service.h"
 #include "odin/service.h"
 #include "tyr/service.h"
+#include "tyr/actor.h"
 
 int main(int argc, char** argv) {
 
@@ -76,6 +77,19 @@ int main(int argc, char** argv) {
   std::thread server_thread = std::thread(std::bind(&http_server_t::serve,
     http_server_t(context, listen, loki_proxy + "_in", loopback, interrupt, true)));
 
+  //run every stage of a request in a single worker, handing its state along in memory
+  if(config.get<bool>("httpd.service.in_process", false)) {
+    std::thread actor_proxy_thread(std::bind(&proxy_t::forward, proxy_t(context, loki_proxy + "_in", loki_proxy + "_out")));
+    actor_proxy_thread.detach();
+    std::list<std::thread> actor_worker_threads;
+    for(size_t i = 0; i < worker_concurrency; ++i) {
+      actor_worker_threads.emplace_back(valhalla::tyr::run_actor_service, config);
+      actor_worker_threads.back().detach();
+    }
+    server_thread.join();
+    return 0;
+  }
+
   //loki layer
   std::thread loki_proxy_thread(std::bind(&proxy_t::forward, proxy_t(context, loki_proxy + "_in", loki_proxy + "_out")));
   loki_proxy_thread.detach();
@@ -282,7 +282,8 @@ int main(int argc, char *argv[]) {
   }
   auto contours = isotile->GenerateContours(contour_times, false, 1.0f,
                             kOptimalGeneralization);
-  auto geojson = json::to_geojson<PointLL>(contours);
+  json::writer_t geojson;
+  json::to_geojson<PointLL>(contours, geojson);
 
   auto t3 = std::chrono::high_resolution_clock::now();
   msecs = std::chrono::duration_cast<std::chrono::milliseconds>(t3 - t2).count();
@@ -290,7 +291,7 @@ int main(int argc, char *argv[]) {
   msecs = std::chrono::duration_cast<std::chrono::milliseconds>(t3 - t1).count();
   LOG_INFO("Isochrone took " + std::to_string(msecs) + " ms");
 
-  std::cout << std::endl << *geojson;
+  std::cout << std::endl << geojson.str();
 
   return EXIT_SUCCESS;
 }
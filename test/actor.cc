@@ -0,0 +1,162 @@
+#include <cstdint>
+#include "test.h"
+#include "mjolnir/pbfgraphparser.h"
+#include "mjolnir/graphbuilder.h"
+#include "mjolnir/graphenhancer.h"
+#include "mjolnir/graphvalidator.h"
+#include "baldr/errorcode_util.h"
+#include "tyr/actor.h"
+#include "midgard/encoded.h"
+
+#include <string>
+#include <sstream>
+#include <boost/property_tree/ptree.hpp>
+#include <boost/property_tree/json_parser.hpp>
+#include <boost/filesystem.hpp>
+
+using namespace valhalla;
+using namespace valhalla::mjolnir;
+
+namespace {
+
+const std::string tile_dir = "test/data/actor_tiles";
+
+void make_tiles() {
+  boost::filesystem::remove_all(tile_dir);
+  boost::property_tree::ptree conf;
+  conf.put("mjolnir.tile_dir", tile_dir);
+  conf.put("mjolnir.admin", "");
+  std::string ways_file = "test_ways_actor.bin";
+  std::string way_nodes_file = "test_way_nodes_actor.bin";
+  std::string access_file = "test_access_actor.bin";
+  std::string restriction_file = "test_complex_restrictions_actor.bin";
+  auto osmdata = PBFGraphParser::Parse(conf.get_child("mjolnir"), {"test/data/harrisburg.osm.pbf"},
+                                       ways_file, way_nodes_file, access_file, restriction_file);
+  GraphBuilder::Build(conf, osmdata, ways_file, way_nodes_file, restriction_file);
+  GraphEnhancer::Enhance(conf, access_file);
+  GraphValidator::Validate(conf);
+  boost::filesystem::remove(ways_file);
+  boost::filesystem::remove(way_nodes_file);
+  boost::filesystem::remove(access_file);
+  boost::filesystem::remove(restriction_file);
+}
+
+// The test config pointed at the tiles above with what loki needs filled in
+boost::property_tree::ptree config() {
+  boost::property_tree::ptree conf;
+  boost::property_tree::read_json("test/valhalla.json", conf);
+  conf.put("mjolnir.tile_dir", tile_dir);
+  conf.erase("mjolnir.admin");
+  conf.erase("mjolnir.timezone");
+  conf.put("loki.service_defaults.minimum_reachability", 50);
+  conf.put("loki.service_defaults.radius", 0);
+  boost::property_tree::ptree action;
+  action.put("", "trace_attributes");
+  conf.get_child("loki.actions").push_back(std::make_pair("", action));
+  conf.put("service_limits.max_avoid_locations", 50);
+  conf.put("service_limits.max_reachability", 100);
+  conf.put("service_limits.max_radius", 200);
+  conf.put("service_limits.trace.max_shape", 16000);
+  conf.put("service_limits.trace.max_distance", 200000.0);
+  conf.put("service_limits.trace.max_gps_accuracy", 100.0);
+  conf.put("service_limits.trace.max_search_radius", 100.0);
+  conf.put("service_limits.pedestrian.min_transit_walking_distance", 1);
+  conf.put("service_limits.pedestrian.max_transit_walking_distance", 10000);
+  return conf;
+}
+
+// Across downtown harrisburg, and a walk with fewer fields asked for
+const std::string drive = R"({"id":"drive","costing":"auto","locations":[
+  {"lat":40.2636,"lon":-76.8822},{"lat":40.2730,"lon":-76.8650},{"lat":40.2580,"lon":-76.8700}]})";
+const std::string walk = R"({"id":"walk","costing":"pedestrian","directions_options":{"narrative":false},
+  "locations":[{"lat":40.2730,"lon":-76.8650},{"lat":40.2636,"lon":-76.8822}]})";
+const std::string nowhere = R"({"id":"nowhere","costing":"auto","locations":[
+  {"lat":10.0,"lon":10.0},{"lat":10.01,"lon":10.01}]})";
+
+void TestRequestLifetime() {
+  tyr::actor_t actor(config());
+
+  // Nothing from one request should be left over for the next one, whether
+  // it asked for something else or failed part way through
+  auto first = actor.route(drive);
+  if (first.find("\"instruction\"") == std::string::npos || first.find("\"id\":\"drive\"") == std::string::npos)
+    throw std::runtime_error("Expected a route with instructions");
+  auto walked = actor.route(walk);
+  if (walked.find("\"instruction\"") != std::string::npos || walked.find("\"id\":\"walk\"") == std::string::npos)
+    throw std::runtime_error("Expected a route without instructions");
+  try {
+    actor.route(nowhere);
+    throw std::logic_error("Routing where there are no tiles should fail");
+  }
+  catch (const baldr::valhalla_exception_t&) { }
+  if (actor.route(drive) != first)
+    throw std::runtime_error("The same request should get the same response");
+
+  // And a worker that has served others answers like a fresh one
+  if (tyr::actor_t(config()).route(walk) != walked)
+    throw std::runtime_error("Earlier requests should not change the response");
+}
+
+// A trace made out of the shape of a route, with or without a time per point
+std::string trace(const std::vector<midgard::PointLL>& shape, bool times) {
+  std::string json = R"({"costing":"auto","shape_match":"map_snap","shape":[)";
+  for (size_t i = 0; i < shape.size(); ++i) {
+    json += (i ? ",{" : "{") + std::string("\"lat\":") + std::to_string(shape[i].lat()) +
+            ",\"lon\":" + std::to_string(shape[i].lng()) +
+            (times ? ",\"time\":" + std::to_string(1500000000 + i * 5) : "") + "}";
+  }
+  return json + "]}";
+}
+
+void TestTraceTimes() {
+  tyr::actor_t actor(config());
+  boost::property_tree::ptree route;
+  std::stringstream stream(actor.route(walk));
+  boost::property_tree::read_json(stream, route);
+  auto shape = midgard::decode<std::vector<midgard::PointLL> >(
+      route.get_child("trip.legs").front().second.get<std::string>("shape"));
+
+  // Times on the points are passed on to the matcher now but they should not
+  // change where a trace is matched to
+  auto timed = actor.trace_attributes(trace(shape, true));
+  auto untimed = actor.trace_attributes(trace(shape, false));
+  if (timed.find("\"edges\":[{") == std::string::npos)
+    throw std::runtime_error("Expected the trace to match some edges");
+  if (timed != untimed)
+    throw std::runtime_error("A trace with times should match the same as one without");
+}
+
+void TestDateTime() {
+  tyr::actor_t actor(config());
+  auto plain = actor.route(drive);
+
+  // These tiles have no time zones or speed profiles so leaving now, leaving
+  // at a time and arriving by a time should all take the same legs
+  for (const auto& date_time : { R"({"type":0})",
+                                 R"({"type":1,"value":"2017-05-10T08:00"})",
+                                 R"({"type":2,"value":"2017-05-10T08:00"})" }) {
+    auto request = drive;
+    request.insert(request.rfind('}'), std::string(R"(,"date_time":)") + date_time);
+    auto timed = actor.route(request);
+    if (timed != plain)
+      throw std::runtime_error("Expected the same route with a date_time of " + std::string(date_time));
+  }
+}
+
+}
+
+int main() {
+  test::suite suite("actor");
+
+  make_tiles();
+
+  suite.test(TEST_CASE(TestRequestLifetime));
+
+  suite.test(TEST_CASE(TestTraceTimes));
+
+  suite.test(TEST_CASE(TestDateTime));
+
+  boost::filesystem::remove_all(tile_dir);
+
+  return suite.tear_down();
+}
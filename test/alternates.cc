@@ -0,0 +1,232 @@
+#include <cstdint>
+#include "test.h"
+
+#include "baldr/graphreader.h"
+#include "baldr/pathlocation.h"
+#include "baldr/rapidjson_utils.h"
+#include "baldr/tilehierarchy.h"
+#include "mjolnir/graphtilebuilder.h"
+#include "mjolnir/directededgebuilder.h"
+#include "sif/autocost.h"
+#include "thor/bidirectional_astar.h"
+#include "tyr/service.h"
+
+#include <algorithm>
+#include <boost/property_tree/ptree.hpp>
+#include <boost/filesystem.hpp>
+#include <prime_server/prime_server.hpp>
+#include <prime_server/http_protocol.hpp>
+
+using namespace valhalla::midgard;
+using namespace valhalla::baldr;
+using namespace valhalla::mjolnir;
+using namespace valhalla::sif;
+using namespace valhalla::thor;
+using namespace valhalla;
+
+namespace {
+
+// Straight from s to t with a small bump between m1 and m2 and three ways
+// around it. The ways through y and w are within the stretch, the one through
+// z is not and the bump mostly shares the straight path:
+//
+//                  w
+//                  y
+//
+//    s - o ------- m1 - m2 ----- d - t
+//                    x
+//
+//                  z
+//
+const std::string tile_dir = "test/data/alternates_tiles";
+enum { s, o, m1, m2, d, t, x, y, w, z };
+const std::vector<PointLL> nodes = {
+  {0.010, 0.10}, {0.020, 0.10}, {0.100, 0.10}, {0.120, 0.10}, {0.180, 0.10}, {0.190, 0.10},
+  {0.110, 0.095}, {0.100, 0.135}, {0.100, 0.145}, {0.100, 0.02} };
+const std::vector<std::pair<uint32_t, uint32_t> > ways = {
+  {s, o}, {o, m1}, {m1, m2}, {m2, d}, {d, t}, {m1, x}, {x, m2},
+  {o, y}, {y, d}, {o, w}, {w, d}, {o, z}, {z, d} };
+
+GraphId tile_id() {
+  return TileHierarchy::GetGraphId(nodes[o], TileHierarchy::levels().rbegin()->first);
+}
+
+GraphId node_id(const uint32_t node) {
+  return GraphId(tile_id().tileid(), tile_id().level(), node);
+}
+
+// Every way is two directed edges, the edges leave their nodes in node order
+void make_tile() {
+  boost::filesystem::remove_all(tile_dir);
+  GraphTileBuilder tile(tile_dir, tile_id(), false);
+  tile.AddAdmin("", "", "", "");
+
+  // The ways at each node and where they go
+  std::vector<std::vector<std::pair<uint32_t, uint32_t> > > outbound(nodes.size());
+  for (uint32_t i = 0; i < ways.size(); ++i) {
+    outbound[ways[i].first].emplace_back(i, ways[i].second);
+    outbound[ways[i].second].emplace_back(i, ways[i].first);
+  }
+
+  for (uint32_t u = 0; u < nodes.size(); ++u) {
+    NodeInfo node;
+    node.set_latlng(nodes[u]);
+    node.set_access(kAllAccess);
+    node.set_edge_index(tile.directededges().size());
+    node.set_edge_count(outbound[u].size());
+    tile.nodes().emplace_back(std::move(node));
+
+    for (uint32_t local_idx = 0; local_idx < outbound[u].size(); ++local_idx) {
+      auto way = outbound[u][local_idx].first;
+      auto v = outbound[u][local_idx].second;
+      uint32_t opp_index = 0;
+      while (outbound[v][opp_index].first != way)
+        ++opp_index;
+      bool forward = ways[way].first == u;
+      DirectedEdgeBuilder edge({}, node_id(v), forward, nodes[u].Distance(nodes[v]) + .5, 50, 50, 50,
+                               Use::kRoad, RoadClass::kPrimary, local_idx, false, 0, 0);
+      edge.set_opp_index(opp_index);
+      edge.set_opp_local_idx(opp_index);
+      edge.set_forwardaccess(kAllAccess);
+      edge.set_reverseaccess(kAllAccess);
+      std::vector<PointLL> shape = {nodes[ways[way].first], nodes[ways[way].second]};
+      bool added;
+      edge.set_edgeinfo_offset(tile.AddEdgeInfo(way, node_id(ways[way].first), node_id(ways[way].second),
+                                                way, shape, {"way " + std::to_string(way)}, added));
+      tile.directededges().emplace_back(std::move(edge));
+    }
+  }
+  tile.StoreTileData();
+}
+
+// The directed edge between two adjacent nodes
+GraphId edge_id(GraphReader& reader, const uint32_t u, const uint32_t v) {
+  const GraphTile* tile = reader.GetGraphTile(tile_id());
+  const NodeInfo* node = tile->node(u);
+  for (uint32_t i = 0; i < node->edge_count(); ++i) {
+    if (tile->directededge(node->edge_index() + i)->endnode() == node_id(v))
+      return GraphId(tile_id().tileid(), tile_id().level(), node->edge_index() + i);
+  }
+  throw std::logic_error("No edge from " + std::to_string(u) + " to " + std::to_string(v));
+}
+
+// The nodes a path goes through
+std::vector<uint32_t> path_nodes(GraphReader& reader, const std::vector<PathInfo>& path) {
+  std::vector<uint32_t> visited;
+  for (const auto& p : path)
+    visited.push_back(reader.GetGraphTile(p.edgeid)->directededge(p.edgeid)->endnode().id());
+  return visited;
+}
+
+// Paths from halfway along s->o to halfway along d->t, as the nodes they go through
+std::vector<std::vector<uint32_t> > paths(const uint32_t alternates) {
+  boost::property_tree::ptree conf;
+  conf.put("tile_dir", tile_dir);
+  GraphReader reader(conf);
+
+  PathLocation origin(PointLL(0.015, 0.10));
+  origin.edges.emplace_back(edge_id(reader, s, o), 0.5f, PointLL(0.015, 0.10), 0.0f);
+  PathLocation destination(PointLL(0.185, 0.10));
+  destination.edges.emplace_back(edge_id(reader, d, t), 0.5f, PointLL(0.185, 0.10), 0.0f);
+
+  auto mode = TravelMode::kDrive;
+  cost_ptr_t costs[static_cast<int>(TravelMode::kMaxTravelMode)];
+  costs[static_cast<int>(mode)] = CreateAutoCost(boost::property_tree::ptree());
+  BidirectionalAStar bidir_astar;
+  std::vector<std::vector<uint32_t> > found;
+  for (const auto& path : bidir_astar.GetAlternatePaths(origin, destination, reader, costs, mode, alternates))
+    found.push_back(path_nodes(reader, path));
+
+  // The first one is always the best path
+  bidir_astar.Clear();
+  auto best = bidir_astar.GetBestPath(origin, destination, reader, costs, mode);
+  if (found.empty() || found.front() != path_nodes(reader, best))
+    throw std::logic_error("The first path should be the best path");
+  return found;
+}
+
+const std::vector<uint32_t> straight = {o, m1, m2, d, t};
+const std::vector<uint32_t> through_y = {o, y, d, t};
+const std::vector<uint32_t> through_w = {o, w, d, t};
+
+void TestStretchAndSharing() {
+  make_tile();
+
+  // Going through z costs too much more and going over the bump shares too
+  // much of the straight path, however many alternates are asked for
+  std::vector<std::vector<uint32_t> > expected = {straight, through_y, through_w};
+  for (uint32_t alternates : { 2, 3, 5 }) {
+    if (paths(alternates) != expected)
+      throw std::logic_error("Expected the straight path and the ones through y and w with " +
+                             std::to_string(alternates) + " alternates");
+  }
+}
+
+void TestCount() {
+  make_tile();
+
+  // Only as many as are asked for, the cheapest first
+  if (paths(0) != std::vector<std::vector<uint32_t> >{straight})
+    throw std::logic_error("Expected only the straight path without alternates");
+  if (paths(1) != std::vector<std::vector<uint32_t> >{straight, through_y})
+    throw std::logic_error("Expected the straight path and the one through y with one alternate");
+  boost::filesystem::remove_all(tile_dir);
+}
+
+void TestResponseShape() {
+  boost::property_tree::ptree conf;
+  conf.put("tyr.logging.long_request", 110.0f);
+  valhalla::tyr::tyr_worker_t worker(conf);
+
+  // A best trip with two legs and two alternate trips of one leg each
+  std::vector<valhalla::odin::TripDirections> directions(4);
+  for (size_t i = 0; i < directions.size(); ++i) {
+    directions[i].set_trip_id(i < 2 ? 0 : i - 1);
+    directions[i].mutable_summary()->set_length(i + 1);
+  }
+  std::list<valhalla::odin::TripDirections*> legs;
+  for (auto& leg : directions)
+    legs.push_back(&leg);
+
+  rapidjson::Document request;
+  request.Parse("{\"action\":0,\"id\":\"shape\"}");
+  prime_server::http_request_info_t info{};
+  rapidjson::Document response;
+  response.Parse(worker.serialize(request, legs, info).c_str());
+  if (response.HasParseError())
+    throw std::logic_error("Expected a json response");
+
+  // The best trip stays where it always was and the alternates follow it
+  if (GetFromRapidJson<rapidjson::Value::ConstArray>(response, "/trip/legs").Size() != 2 ||
+      GetFromRapidJson<std::string>(response, "/id") != "shape")
+    throw std::logic_error("Expected the best trip with both of its legs");
+  auto alternates = GetFromRapidJson<rapidjson::Value::ConstArray>(response, "/alternates");
+  if (alternates.Size() != 2)
+    throw std::logic_error("Expected an entry for each alternate");
+  for (rapidjson::SizeType i = 0; i < alternates.Size(); ++i) {
+    auto alternate_legs = GetFromRapidJson<rapidjson::Value::ConstArray>(alternates[i], "/trip/legs");
+    if (alternate_legs.Size() != 1 ||
+        GetFromRapidJson<double>(alternate_legs[0], "/summary/length") != i + 3)
+      throw std::logic_error("Expected each alternate to be a trip of its own leg");
+  }
+
+  // Without alternates there is nothing extra in the response
+  legs.resize(2);
+  response.Parse(worker.serialize(request, legs, info).c_str());
+  if (response.HasMember("alternates"))
+    throw std::logic_error("Did not expect alternates in the response");
+}
+
+}
+
+int main() {
+  test::suite suite("alternates");
+
+  suite.test(TEST_CASE(TestStretchAndSharing));
+
+  suite.test(TEST_CASE(TestCount));
+
+  suite.test(TEST_CASE(TestResponseShape));
+
+  return suite.tear_down();
+}
@@ -0,0 +1,234 @@
+#include <cstdint>
+#include "test.h"
+#include "odin/arena.h"
+#include "odin/directionsbuilder.h"
+#include "odin/service.h"
+#include "proto/trippath.pb.h"
+#include "proto/tripdirections.pb.h"
+#include "mjolnir/pbfgraphparser.h"
+#include "mjolnir/graphbuilder.h"
+#include "mjolnir/graphenhancer.h"
+#include "mjolnir/graphvalidator.h"
+#include "baldr/graphreader.h"
+#include "baldr/rapidjson_utils.h"
+#include "loki/search.h"
+#include "sif/autocost.h"
+#include "thor/bidirectional_astar.h"
+#include "thor/service.h"
+#include "thor/trippathbuilder.h"
+
+#include <string>
+#include <boost/property_tree/ptree.hpp>
+#include <boost/filesystem.hpp>
+#include <prime_server/prime_server.hpp>
+#include <prime_server/http_protocol.hpp>
+
+using namespace valhalla::odin;
+using namespace valhalla::baldr;
+using namespace valhalla::mjolnir;
+using namespace valhalla::thor;
+
+namespace {
+
+  //lets us see where the messages end up
+  struct test_arena_t : public arena_t {
+    using arena_t::arena_t;
+    bool in_block(const void* message) const {
+      auto byte = static_cast<const char*>(message);
+      return byte >= block.data() && byte < block.data() + block.size();
+    }
+    const google::protobuf::Arena* get() const {
+      return &arena;
+    }
+  };
+
+  //a leg with enough named edges to need some space
+  void fill(TripPath& path, size_t edges) {
+    for(size_t i = 0; i < edges; ++i) {
+      auto* edge = path.add_node()->mutable_edge();
+      edge->add_name("a street name that is too long to fit inline " + std::to_string(i));
+      edge->set_length(i);
+    }
+  }
+
+  void test_create() {
+    test_arena_t arena(64 * 1024);
+    auto* path = arena.create<TripPath>();
+    auto* directions = arena.create<TripDirections>();
+    if(path->GetArena() != arena.get() || directions->GetArena() != arena.get())
+      throw std::runtime_error("Messages should be owned by the arena");
+    if(!arena.in_block(path) || !arena.in_block(directions))
+      throw std::runtime_error("The first messages should come out of the first block");
+
+    //whats added to them lives on the arena too
+    fill(*path, 10);
+    if(path->node(9).edge().name(0) != "a street name that is too long to fit inline 9" ||
+       !arena.in_block(&path->node(9)))
+      throw std::runtime_error("Fields of a message should come out of the arena");
+  }
+
+  void test_reset() {
+    test_arena_t arena(64 * 1024);
+    auto* first = arena.create<TripPath>();
+    fill(*first, 10);
+
+    //the next request starts over at the beginning of the same block
+    arena.reset();
+    auto* second = arena.create<TripPath>();
+    if(second != first)
+      throw std::runtime_error("Reset should reuse the first block");
+    if(second->node_size() != 0)
+      throw std::runtime_error("Reset should give back empty messages");
+  }
+
+  void test_outgrow() {
+    //a request that needs more than the first block gets more from the heap
+    test_arena_t arena(4 * 1024);
+    auto* path = arena.create<TripPath>();
+    fill(*path, 1000);
+    if(arena.in_block(&path->node(999)) || path->node(999).edge().length() != 999)
+      throw std::runtime_error("A big trip path should spill over into more blocks");
+
+    //which are given back but the first block is kept for the next request
+    arena.reset();
+    auto* next = arena.create<TripPath>();
+    if(next != path || !arena.in_block(next))
+      throw std::runtime_error("Reset should go back to the first block");
+    fill(*next, 1000);
+    if(next->node_size() != 1000)
+      throw std::runtime_error("Should be able to grow again after a reset");
+  }
+
+  const std::string tile_dir = "test/data/arena_tiles";
+
+  void make_tiles() {
+    boost::filesystem::remove_all(tile_dir);
+    boost::property_tree::ptree conf;
+    conf.put("mjolnir.tile_dir", tile_dir);
+    conf.put("mjolnir.admin", "");
+    std::string ways_file = "test_ways_arena.bin";
+    std::string way_nodes_file = "test_way_nodes_arena.bin";
+    std::string access_file = "test_access_arena.bin";
+    std::string restriction_file = "test_complex_restrictions_arena.bin";
+    auto osmdata = PBFGraphParser::Parse(conf.get_child("mjolnir"), {"test/data/harrisburg.osm.pbf"},
+                                         ways_file, way_nodes_file, access_file, restriction_file);
+    GraphBuilder::Build(conf, osmdata, ways_file, way_nodes_file, restriction_file);
+    GraphEnhancer::Enhance(conf, access_file);
+    GraphValidator::Validate(conf);
+    boost::filesystem::remove(ways_file);
+    boost::filesystem::remove(way_nodes_file);
+    boost::filesystem::remove(access_file);
+    boost::filesystem::remove(restriction_file);
+  }
+
+  boost::property_tree::ptree config() {
+    boost::property_tree::ptree conf;
+    conf.put("mjolnir.tile_dir", tile_dir);
+    conf.add_child("costing_options.auto", {});
+    conf.put("thor.logging.long_request", "110.0");
+    conf.put("meili.default.gps_accuracy", "4.07");
+    conf.put("meili.default.search_radius", "40");
+    conf.put("meili.grid.size", "500");
+    conf.put("meili.grid.cache_size", "64");
+    boost::property_tree::ptree customizable, mode, search_radius;
+    mode.put("", "mode");
+    search_radius.put("", "search_radius");
+    customizable.push_back(std::make_pair("", mode));
+    customizable.push_back(std::make_pair("", search_radius));
+    conf.add_child("meili.customizable", customizable);
+    return conf;
+  }
+
+  //a drive across downtown harrisburg correlated like loki would
+  rapidjson::Document make_request(GraphReader& reader) {
+    using stop_t = valhalla::baldr::Location::StopType;
+    std::vector<valhalla::baldr::Location> locations{
+      {{-76.8822, 40.2636}, stop_t::BREAK}, {{-76.8700, 40.2580}, stop_t::BREAK}};
+    auto costing = valhalla::sif::CreateAutoCost(boost::property_tree::ptree());
+    auto correlated = valhalla::loki::Search(locations, reader, costing->GetEdgeFilter(),
+                                             costing->GetNodeFilter());
+
+    rapidjson::Document request;
+    auto& allocator = request.GetAllocator();
+    request.SetObject();
+    request.AddMember("action", static_cast<int>(thor_worker_t::ROUTE), allocator);
+    request.AddMember("costing", "auto", allocator);
+    rapidjson::Value json_locations{rapidjson::kArrayType};
+    for (size_t i = 0; i < locations.size(); ++i) {
+      json_locations.PushBack(rapidjson::Value{rapidjson::kObjectType}
+          .AddMember("lat", locations[i].latlng_.lat(), allocator)
+          .AddMember("lon", locations[i].latlng_.lng(), allocator)
+          .AddMember("type", "break", allocator), allocator);
+      request.AddMember(rapidjson::Value("correlated_" + std::to_string(i), allocator),
+                        correlated.at(locations[i]).ToRapidJson(i, allocator), allocator);
+    }
+    request.AddMember("locations", json_locations, allocator);
+    return request;
+  }
+
+  void test_route() {
+    make_tiles();
+    auto conf = config();
+    GraphReader reader(conf.get_child("mjolnir"));
+    auto request = make_request(reader);
+
+    //the same route built on the heap, the way the command line tools do
+    std::vector<valhalla::baldr::Location> locations;
+    for (auto location = request["locations"].Begin(); location != request["locations"].End(); ++location)
+      locations.push_back(valhalla::baldr::Location::FromRapidJson(*location, 50));
+    auto origin = PathLocation::FromRapidJson(locations, request["correlated_0"]);
+    auto destination = PathLocation::FromRapidJson(locations, request["correlated_1"]);
+    std::shared_ptr<valhalla::sif::DynamicCost> costing[static_cast<int>(valhalla::sif::TravelMode::kMaxTravelMode)];
+    auto mode = valhalla::sif::TravelMode::kDrive;
+    costing[static_cast<int>(mode)] = valhalla::sif::CreateAutoCost(boost::property_tree::ptree());
+    BidirectionalAStar astar;
+    auto path = astar.GetBestPath(origin, destination, reader, costing, mode);
+    auto expected_path = TripPathBuilder::Build(AttributesController(), reader, costing, path,
+                                                origin, destination, {});
+    auto serialized_path = expected_path.SerializeAsString();
+    auto expected_directions = DirectionsBuilder().Build(DirectionsOptions(), expected_path);
+    if (expected_directions.maneuver_size() < 2)
+      throw std::runtime_error("Expected a route with some maneuvers");
+
+    //thor and odin put theirs on their arenas and should come up with the same
+    //thing, again after the arenas have been reset for the next request
+    thor_worker_t thor(conf);
+    odin_worker_t odin(conf);
+    for (int i = 0; i < 2; ++i) {
+      valhalla::odin::Trace trace;
+      prime_server::http_request_info_t info{};
+      prime_server::worker_t::interrupt_function_t interrupt = [](){};
+      std::list<TripPath*> trip_paths;
+      thor.act(request, trace, info, interrupt, trip_paths);
+      if (trip_paths.size() != 1 || !trip_paths.front()->GetArena())
+        throw std::runtime_error("Expected a trip path on thor's arena");
+      if (trip_paths.front()->SerializeAsString() != serialized_path)
+        throw std::runtime_error("The trip path on the arena should match the one on the heap");
+
+      auto directions = odin.narrate(request, trip_paths);
+      if (directions.size() != 1 || !directions.front()->GetArena())
+        throw std::runtime_error("Expected trip directions on odin's arena");
+      if (directions.front()->SerializeAsString() != expected_directions.SerializeAsString())
+        throw std::runtime_error("The trip directions on the arena should match the ones on the heap");
+      thor.cleanup();
+      odin.cleanup();
+    }
+
+    boost::filesystem::remove_all(tile_dir);
+  }
+
+}
+
+int main() {
+  test::suite suite("arena");
+
+  suite.test(TEST_CASE(test_create));
+
+  suite.test(TEST_CASE(test_reset));
+
+  suite.test(TEST_CASE(test_outgrow));
+
+  suite.test(TEST_CASE(test_route));
+
+  return suite.tear_down();
+}
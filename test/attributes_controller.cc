@@ -105,6 +105,26 @@ void TestNodeAttributeEnabled() {
   TryCategoryAttributeEnabled(controller, kNodeCategory, true);
 }
 
+void TestNodeIntersectingEdgeAttributeEnabled() {
+  AttributesController controller;
+
+  // Test default
+  TryCategoryAttributeEnabled(controller, kNodeIntersectingEdgeCategory, true);
+
+  // Test all node intersecting edge disabled
+  controller.disable_all();
+  TryCategoryAttributeEnabled(controller, kNodeIntersectingEdgeCategory, false);
+
+  // Test other node attributes do not count
+  controller.attributes.at(kNodeType) = true;
+  controller.attributes.at(kNodeElapsedTime) = true;
+  TryCategoryAttributeEnabled(controller, kNodeIntersectingEdgeCategory, false);
+
+  // Test one node intersecting edge enabled
+  controller.attributes.at(kNodeIntersectingEdgeDriveability) = true;
+  TryCategoryAttributeEnabled(controller, kNodeIntersectingEdgeCategory, true);
+}
+
 void TestAdminAttributeEnabled() {
   AttributesController controller;
 
@@ -151,6 +171,9 @@ int main() {
   // Test node category_attribute_enabled
   suite.test(TEST_CASE(TestNodeAttributeEnabled));
 
+  // Test node intersecting edge category_attribute_enabled
+  suite.test(TEST_CASE(TestNodeIntersectingEdgeAttributeEnabled));
+
   // Test admin category_attribute_enabled
   suite.test(TEST_CASE(TestAdminAttributeEnabled));
 
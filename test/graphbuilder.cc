@@ -1,6 +1,8 @@
 #include "test.h"
+#include "test_tiles.h"
 
 #include "mjolnir/graphbuilder.h"
+#include "mjolnir/pbfgraphparser.h"
 
 #include <sstream>
 #include <string>
@@ -10,12 +12,45 @@
 #include <boost/property_tree/ptree.hpp>
 #include <boost/property_tree/json_parser.hpp>
 #include <boost/optional.hpp>
+#include <boost/filesystem.hpp>
 
 using namespace std;
 using namespace valhalla::mjolnir;
 
 namespace {
 
+const std::string tile_dir = "test/data/graphbuilder_tiles";
+
+void TestBuildIsRepeatable() {
+  boost::property_tree::ptree conf;
+  conf.put("mjolnir.tile_dir", tile_dir);
+  std::string ways_file = "test_ways_graphbuilder.bin";
+  std::string way_nodes_file = "test_way_nodes_graphbuilder.bin";
+  std::string access_file = "test_access_graphbuilder.bin";
+  std::string restriction_file = "test_complex_restrictions_graphbuilder.bin";
+  boost::filesystem::remove_all(tile_dir);
+
+  // Building the same data twice, on any number of threads, should write
+  // the same bytes every time
+  auto osmdata = PBFGraphParser::Parse(conf.get_child("mjolnir"), {"test/data/harrisburg.osm.pbf"},
+                                       ways_file, way_nodes_file, access_file, restriction_file);
+  conf.put("mjolnir.concurrency", 1);
+  GraphBuilder::Build(conf, osmdata, ways_file, way_nodes_file, restriction_file);
+  auto first = test::read_dir(tile_dir, ".gph");
+  if (first.empty())
+    throw std::runtime_error("Expected some tiles");
+  boost::filesystem::remove_all(tile_dir);
+  conf.put("mjolnir.concurrency", 4);
+  GraphBuilder::Build(conf, osmdata, ways_file, way_nodes_file, restriction_file);
+  if (test::read_dir(tile_dir, ".gph") != first)
+    throw std::runtime_error("Building the same data again should write the same tiles");
+
+  boost::filesystem::remove(ways_file);
+  boost::filesystem::remove(way_nodes_file);
+  boost::filesystem::remove(access_file);
+  boost::filesystem::remove(restriction_file);
+  boost::filesystem::remove_all(tile_dir);
+}
 
 }
 
@@ -26,5 +61,7 @@ int main() {
   //suite.test(TEST_CASE(some_test));
   //TODO: sweet jesus add more tests of this class!
 
+  suite.test(TEST_CASE(TestBuildIsRepeatable));
+
   return suite.tear_down();
 }
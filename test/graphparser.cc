@@ -447,6 +447,55 @@ void BicycleTrafficSignals(const std::string& config_file) {
 
 }
 
+void SinglePass(const std::string& config_file) {
+  boost::property_tree::ptree conf;
+  boost::property_tree::json_parser::read_json(config_file, conf);
+
+  std::string ways_file = "test_ways.bin";
+  std::string way_nodes_file = "test_way_nodes.bin";
+  std::string access_file = "test_access.bin";
+  std::string restriction_file = "test_complex_restrictions.bin";
+
+  //parse it the usual way and keep the way nodes around
+  auto osmdata = PBFGraphParser::Parse(conf.get_child("mjolnir"), {"test/data/liechtenstein-latest.osm.pbf"},
+                                       ways_file, way_nodes_file, access_file, restriction_file);
+  std::vector<OSMWayNode> expected;
+  {
+    sequence<OSMWayNode> way_nodes(way_nodes_file, false);
+    way_nodes.enumerate([&expected](const OSMWayNode& way_node){ expected.push_back(way_node); });
+  }
+
+  //parse it again in a single pass and make sure we get the same thing
+  conf.put("mjolnir.single_pass", true);
+  auto single = PBFGraphParser::Parse(conf.get_child("mjolnir"), {"test/data/liechtenstein-latest.osm.pbf"},
+                                      ways_file, way_nodes_file, access_file, restriction_file);
+  if (single.osm_way_count != osmdata.osm_way_count || single.osm_node_count != osmdata.osm_node_count ||
+      single.intersection_count != osmdata.intersection_count || single.edge_count != osmdata.edge_count)
+    throw std::runtime_error("Single pass counts do not match");
+  if (single.restrictions.size() != osmdata.restrictions.size() || single.node_ref.size() != osmdata.node_ref.size() ||
+      single.node_exit_to.size() != osmdata.node_exit_to.size() || single.node_name.size() != osmdata.node_name.size())
+    throw std::runtime_error("Single pass restrictions or node names do not match");
+
+  sequence<OSMWayNode> way_nodes(way_nodes_file, false);
+  if (way_nodes.size() != expected.size())
+    throw std::runtime_error("Single pass way node count does not match");
+  auto way_node = expected.cbegin();
+  way_nodes.enumerate([&way_node](const OSMWayNode& actual){
+    if (actual.node.osmid != way_node->node.osmid || actual.node.lat != way_node->node.lat ||
+        actual.node.lng != way_node->node.lng || actual.node.intersection() != way_node->node.intersection() ||
+        actual.node.type() != way_node->node.type() || actual.way_index != way_node->way_index)
+      throw std::runtime_error("Single pass way node " + std::to_string(actual.node.osmid) + " does not match");
+    ++way_node;
+  });
+  if (boost::filesystem::exists(way_nodes_file + ".nodes"))
+    throw std::runtime_error("Single pass did not clean up its nodes file");
+
+  boost::filesystem::remove(ways_file);
+  boost::filesystem::remove(way_nodes_file);
+  boost::filesystem::remove(access_file);
+  boost::filesystem::remove(restriction_file);
+}
+
 void DoConfig() {
   std::ofstream file;
   try {
@@ -498,6 +547,10 @@ void TestBus() {
   Bus(config_file);
 }
 
+void TestSinglePass() {
+  SinglePass(config_file);
+}
+
 }
 
 int main() {
@@ -519,6 +572,7 @@ int main() {
   suite.test(TEST_CASE(TestBaltimoreArea));
   suite.test(TEST_CASE(TestBike));
   suite.test(TEST_CASE(TestBus));
+  suite.test(TEST_CASE(TestSinglePass));
 
   return suite.tear_down();
 }
@@ -0,0 +1,74 @@
+#include <cstdint>
+#include "test.h"
+#include "test_tiles.h"
+#include "mjolnir/pbfgraphparser.h"
+#include "mjolnir/graphbuilder.h"
+#include "mjolnir/hierarchybuilder.h"
+
+#include <boost/property_tree/ptree.hpp>
+#include <boost/filesystem.hpp>
+
+using namespace valhalla::mjolnir;
+
+namespace {
+
+const std::string base_dir = "test/data/hierarchy_tiles";
+const std::string serial_dir = "test/data/hierarchy_tiles_serial";
+const std::string parallel_dir = "test/data/hierarchy_tiles_parallel";
+
+boost::property_tree::ptree config(const std::string& tile_dir, unsigned int concurrency) {
+  boost::property_tree::ptree conf;
+  conf.put("mjolnir.tile_dir", tile_dir);
+  conf.put("mjolnir.concurrency", concurrency);
+  return conf;
+}
+
+void TestParallelMatchesSerial() {
+  // Build the base tiles once
+  boost::filesystem::remove_all(base_dir);
+  auto conf = config(base_dir, 1);
+  std::string ways_file = "test_ways_hierarchy.bin";
+  std::string way_nodes_file = "test_way_nodes_hierarchy.bin";
+  std::string access_file = "test_access_hierarchy.bin";
+  std::string restriction_file = "test_complex_restrictions_hierarchy.bin";
+  auto osmdata = PBFGraphParser::Parse(conf.get_child("mjolnir"), {"test/data/harrisburg.osm.pbf"},
+                                       ways_file, way_nodes_file, access_file, restriction_file);
+  GraphBuilder::Build(conf, osmdata, ways_file, way_nodes_file, restriction_file);
+
+  // Form the hierarchy on one thread and on several from the same tiles
+  test::copy_dir(base_dir, serial_dir);
+  test::copy_dir(base_dir, parallel_dir);
+  HierarchyBuilder::Build(config(serial_dir, 1));
+  HierarchyBuilder::Build(config(parallel_dir, 4));
+
+  // The tiles of every level should be byte for byte the same
+  auto serial = test::read_dir(serial_dir, ".gph");
+  auto parallel = test::read_dir(parallel_dir, ".gph");
+  if (serial.size() < 3)
+    throw std::runtime_error("Expected tiles on all three levels");
+  if (serial.size() != parallel.size())
+    throw std::runtime_error("Parallel hierarchy wrote a different number of tiles");
+  for (const auto& tile : serial) {
+    auto other = parallel.find(tile.first);
+    if (other == parallel.end() || other->second != tile.second)
+      throw std::runtime_error("Parallel hierarchy differs in " + tile.first);
+  }
+
+  boost::filesystem::remove(ways_file);
+  boost::filesystem::remove(way_nodes_file);
+  boost::filesystem::remove(access_file);
+  boost::filesystem::remove(restriction_file);
+  boost::filesystem::remove_all(base_dir);
+  boost::filesystem::remove_all(serial_dir);
+  boost::filesystem::remove_all(parallel_dir);
+}
+
+}
+
+int main() {
+  test::suite suite("hierarchybuilder");
+
+  suite.test(TEST_CASE(TestParallelMatchesSerial));
+
+  return suite.tear_down();
+}
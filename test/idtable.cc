@@ -2,6 +2,7 @@
 
 #include <cstdint>
 #include <unordered_set>
+#include <set>
 #include <cstdlib>
 #include "mjolnir/idtable.h"
 
@@ -50,12 +51,63 @@ void TestRandom() {
 
 }
 
+void TestRank() {
+
+  //sparse and dense chunks side by side, with ids past the array limit
+  IdTable t(5000000000);
+  std::set<uint64_t> ids;
+  for(uint64_t i = 0; i < 20000; ++i) {
+    ids.emplace(rand() % 65536);
+    ids.emplace(65536 * 7 + (rand() % 65536) * 3 % 65536);
+    ids.emplace(4999999999 - rand() % 100000);
+  }
+  ids.emplace(65535);
+  ids.emplace(65536 * 2);
+  for(auto id : ids)
+    t.set(id);
+  t.set(65535);
+  if(t.size() != ids.size())
+    throw std::runtime_error("Wrong number of ids set");
+
+  uint64_t rank = 0;
+  for(auto id : ids) {
+    if(!t.IsUsed(id))
+      throw std::runtime_error("Bit should be set");
+    if(t.rank(id) != rank)
+      throw std::runtime_error("Wrong rank for " + std::to_string(id));
+    if(t.rank(id + 1) != rank + 1)
+      throw std::runtime_error("Wrong rank after " + std::to_string(id));
+    ++rank;
+  }
+  if(t.IsUsed(65536 * 3) || t.IsUsed(6000000000))
+    throw std::runtime_error("Bit should not be set");
+  if(t.rank(6000000000) != ids.size())
+    throw std::runtime_error("Everything should rank below past the max");
+
+  //setting more updates the ranks
+  t.set(1000000);
+  if(t.rank(1000001) != static_cast<uint64_t>(std::distance(ids.begin(), ids.lower_bound(1000001))) + 1)
+    throw std::runtime_error("Rank should include the new id");
+}
+
+void TestSparseMemory() {
+
+  //a few ids spread over a big range should not cost a bit per id
+  IdTable t(5000000000);
+  for(uint64_t i = 0; i < 100000; ++i)
+    t.set(i * 50000);
+  if(t.memory() > 5000000000 / 8 / 10)
+    throw std::runtime_error("Sparse ids should use far less than a bitset");
+}
+
 int main() {
   test::suite suite("nodetable");
 
   // Test setting and getting on random sizes of bit tables
   suite.test(TEST_CASE(TestSetGet));
   suite.test(TEST_CASE(TestRandom));
+  suite.test(TEST_CASE(TestRank));
+  suite.test(TEST_CASE(TestSparseMemory));
 
   return suite.tear_down();
 }
@@ -1,12 +1,28 @@
 #include <cstdint>
 #include "test.h"
 #include "baldr/json.h"
+#include "baldr/json_writer.h"
 #include <set>
+#include <sstream>
+#include <type_traits>
+#include <utility>
 #include <boost/property_tree/json_parser.hpp>
 #include <boost/property_tree/ptree.hpp>
 
 namespace {
 
+//tells us whether the writer will take a value of type T
+template <class T>
+struct writable {
+  template <class W>
+  static auto check(W* w) -> decltype((*w)(std::declval<T>()), std::true_type{});
+  template <class W>
+  static std::false_type check(...);
+  static constexpr bool value = decltype(check<valhalla::baldr::json::writer_t>(nullptr))::value;
+};
+static_assert(!writable<double>::value && !writable<float>::value, "Floating point must be written as an fp_t");
+static_assert(writable<bool>::value && writable<int>::value && writable<valhalla::baldr::json::fp_t>::value, "Writer lost an overload");
+
 void TestJsonSerialize() {
 
   using namespace std;
@@ -81,6 +97,72 @@ void TestJsonSerialize() {
       throw std::runtime_error("Wrong json!");
 }
 
+void TestJsonWriter() {
+  using namespace valhalla::baldr;
+  json::writer_t writer;
+  writer.raw("callback(");
+  writer.start_object();
+  writer("string", std::string("West 26th Street"));
+  writer("escaped_string", "\"\t\r\n\\\a");
+  writer("unsigned", static_cast<uint32_t>(2875622111));
+  writer("signed", -7);
+  writer("fixed", json::fp_t{40.744377, 3});
+  writer("negative_fixed", json::fp_t{-73.5, 6});
+  writer("boolean", false);
+  writer("nothing", nullptr);
+  writer.start_array("nested");
+  writer.start_array();
+  writer(uint64_t(0));
+  writer.end_array();
+  writer.start_object();
+  writer.end_object();
+  writer.end_array();
+  writer("tree", json::map({{"array", json::array({uint64_t(9), json::fp_t{1.5, 1}})}}));
+  writer.end_object();
+  writer.raw(")");
+
+  std::string answer = "callback({\"string\":\"West 26th Street\",\"escaped_string\":\"\\\"\\t\\r\\n\\\\\\u0007\","
+    "\"unsigned\":2875622111,\"signed\":-7,\"fixed\":40.744,\"negative_fixed\":-73.500000,\"boolean\":false,"
+    "\"nothing\":null,\"nested\":[[0],{}],\"tree\":{\"array\":[9,1.5]}})";
+  if(writer.str() != answer)
+    throw std::logic_error("Wrong json: " + writer.str());
+
+  //starting over should give us a clean slate
+  writer.clear();
+  writer.start_array();
+  writer(json::fp_t{0.33f, 2});
+  writer.end_array();
+  if(writer.str() != "[0.33]")
+    throw std::logic_error("Wrong json after clearing: " + writer.str());
+}
+
+void TestJsonWriterMatchesTree() {
+  //the values in responses should not change by moving them off of the tree
+  using namespace valhalla::baldr;
+  json::writer_t writer;
+  for(const std::string value : {"West 26th Street", "I 83 North/US 22", "http://www.openstreetmap.org/copyright",
+      "\"/\t\r\n\b\f\\\a\x1f/", "Stra\xc3\x9f" "e/Weg"}) {
+    std::stringstream tree;
+    tree << *json::map({{"value", value}});
+    writer.clear();
+    writer.start_object();
+    writer("value", value);
+    writer.end_object();
+    if(writer.str() != tree.str())
+      throw std::logic_error("Expected " + tree.str() + " but got " + writer.str());
+
+    tree.str("");
+    tree << *json::array({value, value});
+    writer.clear();
+    writer.start_array();
+    writer(value);
+    writer(value.c_str());
+    writer.end_array();
+    if(writer.str() != tree.str())
+      throw std::logic_error("Expected " + tree.str() + " but got " + writer.str());
+  }
+}
+
 }
 
 int main() {
@@ -88,5 +170,9 @@ int main() {
 
   suite.test(TEST_CASE(TestJsonSerialize));
 
+  suite.test(TEST_CASE(TestJsonWriter));
+
+  suite.test(TEST_CASE(TestJsonWriterMatchesTree));
+
   return suite.tear_down();
 }
@@ -226,6 +226,11 @@ void test_from_json() {
     loc = from_json(R"({"lat":0,"lon":0,"heading":37.1})", m);
     if(*loc.heading_ != 37)
       throw std::runtime_error("Wrong heading");
+
+    // Test heading tolerance
+    loc = from_json(R"({"lat":0,"lon":0,"heading":90,"heading_tolerance":45})", m);
+    if(!loc.heading_tolerance_ || *loc.heading_tolerance_ != 45)
+      throw std::runtime_error("Wrong heading tolerance");
   }
 
 }
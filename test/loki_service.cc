@@ -105,18 +105,7 @@ namespace {
   };
 
 
-  void start_service(zmq::context_t& context) {
-    //server
-    std::thread server(std::bind(&http_server_t::serve,
-      http_server_t(context, "ipc:///tmp/test_loki_server", "ipc:///tmp/test_loki_proxy_in", "ipc:///tmp/test_loki_results", "ipc:///tmp/test_loki_interrupt")));
-    server.detach();
-
-    //load balancer
-    std::thread proxy(std::bind(&proxy_t::forward,
-      proxy_t(context, "ipc:///tmp/test_loki_proxy_in", "ipc:///tmp/test_loki_proxy_out")));
-    proxy.detach();
-
-    //make the config file
+  boost::property_tree::ptree make_config() {
     boost::property_tree::ptree config;
     std::stringstream json; json << R"({
       "mjolnir": { "tile_dir": "test/tiles" },
@@ -141,6 +130,22 @@ namespace {
       "costing_options": { "auto": {}, "pedestrian": {} }
     })";
     boost::property_tree::json_parser::read_json(json, config);
+    return config;
+  }
+
+  void start_service(zmq::context_t& context) {
+    //server
+    std::thread server(std::bind(&http_server_t::serve,
+      http_server_t(context, "ipc:///tmp/test_loki_server", "ipc:///tmp/test_loki_proxy_in", "ipc:///tmp/test_loki_results", "ipc:///tmp/test_loki_interrupt")));
+    server.detach();
+
+    //load balancer
+    std::thread proxy(std::bind(&proxy_t::forward,
+      proxy_t(context, "ipc:///tmp/test_loki_proxy_in", "ipc:///tmp/test_loki_proxy_out")));
+    proxy.detach();
+
+    //make the config file
+    auto config = make_config();
 
     //service worker
     std::thread worker(valhalla::loki::run_service, config);
@@ -184,6 +189,100 @@ namespace {
     // Make sure that all requests are tested
     test::assert_bool(success_count == requests.size(), "Expected passed tests count: " + std::to_string(requests.size()) + " Actual passed tests count: " + std::to_string(success_count));
   }
+
+  //lets us see the binary trace loki would forward to thor
+  struct trace_worker_t : public loki::loki_worker_t {
+    using loki::loki_worker_t::loki_worker_t;
+    const odin::Trace& parse(rapidjson::Document& request, const odin::Trace& input = {}) {
+      trace.CopyFrom(input);
+      parse_trace(request);
+      return trace;
+    }
+  };
+
+  boost::property_tree::ptree trace_config() {
+    auto config = make_config();
+    boost::property_tree::ptree action;
+    action.put("", "trace_route");
+    config.get_child("loki.actions").push_back(std::make_pair("", action));
+    return config;
+  }
+
+  void test_protobuf_body() {
+    //a binary trace with a bad latitude is rejected just like a bad json shape
+    loki::loki_worker_t worker(trace_config());
+    odin::Trace bad;
+    bad.add_lat(91); bad.add_lng(0);
+    bad.add_lat(0); bad.add_lng(0);
+    http_request_t request(POST, "/trace_route", bad.SerializeAsString(), query_t{{"json", {R"({"costing":"auto"})"}}},
+      headers_t{{"Content-Type", "application/x-protobuf"}});
+    http_request_info_t info{};
+    rapidjson::Document request_rj;
+    odin::Trace request_trace;
+    try {
+      worker.act(request, info, request_rj, request_trace);
+      throw std::logic_error("Binary trace with an invalid latitude should have been rejected");
+    }
+    catch(const baldr::valhalla_exception_t& e) {
+      if(e.error_code != 114)
+        throw std::logic_error("Expected error 114 but got " + std::to_string(e.error_code));
+    }
+  }
+
+  void test_protobuf_clamping() {
+    //longitudes out of range are wrapped the same way for binary and json input
+    odin::Trace input;
+    input.add_lat(10); input.add_lng(190);
+    input.add_lat(11); input.add_lng(-185);
+    rapidjson::Document binary_rj;
+    binary_rj.Parse(R"({"costing":"auto"})");
+    trace_worker_t binary_worker(trace_config());
+    auto binary = binary_worker.parse(binary_rj, input);
+
+    rapidjson::Document json_rj;
+    json_rj.Parse(R"({"costing":"auto","shape":[{"lat":10,"lon":190},{"lat":11,"lon":-185}]})");
+    trace_worker_t json_worker(trace_config());
+    auto json = json_worker.parse(json_rj);
+
+    if(binary.lng_size() != 2 || json.lng_size() != 2)
+      throw std::logic_error("Wrong number of points forwarded");
+    for(int i = 0; i < 2; ++i) {
+      if(binary.lat(i) != json.lat(i) || binary.lng(i) != json.lng(i))
+        throw std::logic_error("Binary and json traces should be forwarded identically");
+      if(binary.lng(i) < -180.f || binary.lng(i) > 180.f)
+        throw std::logic_error("Binary trace longitude was not clamped");
+    }
+  }
+
+  void test_trace_times() {
+    //json times are forwarded when every point has one and dropped otherwise
+    auto forwarded = [](const std::string& json) {
+      rapidjson::Document request;
+      request.Parse(json.c_str());
+      trace_worker_t worker(trace_config());
+      return worker.parse(request);
+    };
+    auto timed = forwarded(R"({"costing":"auto","shape":[{"lat":10,"lon":10,"time":100},{"lat":10.01,"lon":10,"time":130.5}]})");
+    if(timed.time_size() != 2 || timed.time(0) != 100 || timed.time(1) != 130.5)
+      throw std::logic_error("Times of a json trace should be forwarded");
+    auto untimed = forwarded(R"({"costing":"auto","shape":[{"lat":10,"lon":10},{"lat":10.01,"lon":10}]})");
+    if(untimed.time_size() != 0 || untimed.lat_size() != 2)
+      throw std::logic_error("A json trace without times should be forwarded without them");
+    auto partly = forwarded(R"({"costing":"auto","shape":[{"lat":10,"lon":10,"time":100},{"lat":10.01,"lon":10}]})");
+    if(partly.time_size() != 0 || partly.lat_size() != 2)
+      throw std::logic_error("Times missing from some points should be dropped from all of them");
+
+    //binary times pass straight through
+    odin::Trace input;
+    input.add_lat(10); input.add_lng(10); input.add_time(100);
+    input.add_lat(10.01); input.add_lng(10); input.add_time(130.5);
+    rapidjson::Document binary_rj;
+    binary_rj.Parse(R"({"costing":"auto"})");
+    trace_worker_t binary_worker(trace_config());
+    auto binary = binary_worker.parse(binary_rj, input);
+    if(binary.time_size() != 2 || binary.time(0) != timed.time(0) || binary.time(1) != timed.time(1))
+      throw std::logic_error("Times of a binary trace should be forwarded like json ones");
+  }
 }
 
 int main(void) {
@@ -195,6 +294,11 @@ int main(void) {
   //test failures
   suite.test(TEST_CASE(test_failure_requests));
 
+  //test binary trace input
+  suite.test(TEST_CASE(test_protobuf_body));
+  suite.test(TEST_CASE(test_protobuf_clamping));
+  suite.test(TEST_CASE(test_trace_times));
+
   //test successes
   //suite.test(TEST_CASE(test_success_requests));
 
@@ -1447,6 +1447,54 @@ void test_en_US_verbal_multi_cue() {
   validate(phrase_0, "<CURRENT_VERBAL_CUE> Then <NEXT_VERBAL_CUE>");
 }
 
+void test_phrase_template() {
+  std::string instruction = "left over from before";
+
+  // Tags are replaced in one pass, unknown and missing tags are left alone
+  PhraseTemplate phrase("<CURRENT_VERBAL_CUE> Then <NOT_A_TAG> <NEXT_VERBAL_CUE><LENGTH>");
+  std::string current = "Turn left.", next = "<CURRENT_VERBAL_CUE>";
+  phrase.Render(instruction, {
+      {PhraseTag::kCurrentVerbalCue, current},
+      {PhraseTag::kNextVerbalCue, next}});
+  validate(instruction, "Turn left. Then <NOT_A_TAG> <CURRENT_VERBAL_CUE><LENGTH>");
+
+  // No tags at all or an unclosed one
+  PhraseTemplate("You have arrived at your destination.").Render(instruction, {});
+  validate(instruction, "You have arrived at your destination.");
+  std::string east = "east";
+  PhraseTemplate("Go <north").Render(instruction, {{PhraseTag::kCardinalDirection, east}});
+  validate(instruction, "Go <north");
+}
+
+void test_en_US_templates() {
+  const NarrativeDictionary& dictionary = GetNarrativeDictionary("en-US");
+
+  // Every phrase is compiled at its id, the ids in between are left empty
+  // "18": "Bike <CARDINAL_DIRECTION> on <BEGIN_STREET_NAMES>. Continue on <STREET_NAMES>."
+  if (dictionary.start_subset.templates.size() != 19) {
+    throw std::runtime_error("Invalid template count: " + std::to_string(dictionary.start_subset.templates.size()));
+  }
+  for (const auto& phrase : dictionary.start_subset.phrases) {
+    validate(dictionary.start_subset.templates.at(std::stoul(phrase.first)).phrase(), phrase.second);
+  }
+  validate(dictionary.start_subset.templates.at(3).phrase(), "");
+
+  // Rendering one of the gaps is a bug in the caller, not an empty instruction
+  std::string instruction, left = "left";
+  try {
+    dictionary.start_subset.templates.at(3).Render(instruction, {
+        {PhraseTag::kRelativeDirection, left}});
+    throw std::logic_error("Rendering a missing phrase should throw");
+  }
+  catch (const std::runtime_error&) { }
+
+  // "3": "<DESTINATION> is on the <RELATIVE_DIRECTION>."
+  dictionary.destination_subset.templates.at(3).Render(instruction, {
+      {PhraseTag::kRelativeDirection, left},
+      {PhraseTag::kDestination, std::string("14 Main Street")}});
+  validate(instruction, "14 Main Street is on the left.");
+}
+
 }
 
 int main() {
@@ -1629,5 +1677,11 @@ int main() {
   // test the en-US verbal_multi_cue phrases
   suite.test(TEST_CASE(test_en_US_verbal_multi_cue));
 
+  // test filling in compiled phrases
+  suite.test(TEST_CASE(test_phrase_template));
+
+  // test the en-US compiled phrases
+  suite.test(TEST_CASE(test_en_US_templates));
+
   return suite.tear_down();
 }
@@ -7591,6 +7591,68 @@ void TestBuildVerbalMultiCue_0_miles_en_US() {
   TryBuild(directions_options, maneuvers, expected_maneuvers);
 }
 
+void TestBuildInstructionFieldOnly_miles_en_US() {
+  std::string country_code = "US";
+  std::string state_code = "PA";
+
+  // Configure directions options to only want the text instructions
+  DirectionsOptions directions_options;
+  directions_options.set_units(DirectionsOptions_Units_kMiles);
+  directions_options.set_language("en-US");
+  directions_options.set_narrative_fields(DirectionsOptions::kInstruction);
+
+  // Configure maneuvers
+  std::list<Maneuver> maneuvers;
+  PopulateVerbalMultiCueManeuverList_0(maneuvers, country_code, state_code);
+
+  // Configure expected maneuvers, none of the verbal instructions are formed
+  std::list<Maneuver> expected_maneuvers;
+  PopulateVerbalMultiCueManeuverList_0(expected_maneuvers, country_code,
+                                       state_code);
+  SetExpectedPreviousManeuverInstructions(
+      expected_maneuvers, "Turn left onto North Plum Street.", "", "", "");
+  SetExpectedManeuverInstructions(expected_maneuvers,
+                                  "Turn left onto East Fulton Street.", "", "",
+                                  "");
+
+  TryBuild(directions_options, maneuvers, expected_maneuvers);
+}
+
+void TestBuildVerbalPreTransitionFieldOnly_miles_en_US() {
+  std::string country_code = "US";
+  std::string state_code = "PA";
+
+  // Configure directions options to only want the verbal pre transition
+  DirectionsOptions directions_options;
+  directions_options.set_units(DirectionsOptions_Units_kMiles);
+  directions_options.set_language("en-US");
+  directions_options.set_narrative_fields(
+      DirectionsOptions::kVerbalPreTransition);
+
+  // Configure maneuvers
+  std::list<Maneuver> maneuvers;
+  PopulateVerbalMultiCueManeuverList_0(maneuvers, country_code, state_code);
+
+  // Configure expected maneuvers, the alerts are still formed for the
+  // verbal multi-cue so it matches the one formed with all the fields
+  std::list<Maneuver> expected_maneuvers;
+  PopulateVerbalMultiCueManeuverList_0(expected_maneuvers, country_code,
+                                       state_code);
+  SetExpectedPreviousManeuverInstructions(
+      expected_maneuvers,
+      "",
+      "Turn left onto North Plum Street.",
+      "Turn left onto North Plum Street. Then Turn left onto East Fulton Street.",
+      "");
+  SetExpectedManeuverInstructions(expected_maneuvers,
+                                  "",
+                                  "Turn left onto East Fulton Street.",
+                                  "Turn left onto East Fulton Street.",
+                                  "");
+
+  TryBuild(directions_options, maneuvers, expected_maneuvers);
+}
+
 // FormDestinati onInstruction
 Maneuver CreateVerbalPostManeuver(vector<std::string> street_names,
                                   float kilometers,
@@ -9080,6 +9142,12 @@ int main() {
   // BuildVerbalMultiCue_0_miles_en_US
   suite.test(TEST_CASE(TestBuildVerbalMultiCue_0_miles_en_US));
 
+  // BuildInstructionFieldOnly_miles_en_US
+  suite.test(TEST_CASE(TestBuildInstructionFieldOnly_miles_en_US));
+
+  // BuildVerbalPreTransitionFieldOnly_miles_en_US
+  suite.test(TEST_CASE(TestBuildVerbalPreTransitionFieldOnly_miles_en_US));
+
   // End of the build phrase tests
   /////////////////////////////////////////////////////////////////////////////
 
@@ -3,8 +3,10 @@
 #include <iostream>
 #include <vector>
 #include <algorithm>
+#include <random>
 #include "config.h"
 #include "thor/optimizer.h"
+#include "thor/local_search_optimizer.h"
 
 using namespace std;
 using namespace valhalla::thor;
@@ -23,8 +25,9 @@ void TryOptimizer(const uint32_t nlocs, const std::vector<float>& costs,
   }
 }
 
-void TestOptimizer() {
-  std::vector<float> costs = {
+// Time costs between 11 locations, the best tour through them is known
+std::vector<float> ElevenLocations() {
+  return {
       0, 3036, 707, 956, 318, 1934, 355, 1170, 1286, 3171, 2133,
       2978, 0, 2664, 3613, 3102, 2011, 3139, 3846, 1764, 2050, 1143,
       638, 2638, 0, 1295, 763, 1536, 800, 1528, 888, 2773, 1735,
@@ -36,8 +39,71 @@ void TestOptimizer() {
       1214, 1750, 900, 1849, 1338, 634, 1375, 2082, 0, 1907, 846,
       3128, 2036, 2814, 3763, 3252, 2549, 3290, 3228, 1914, 0, 2010,
       2068, 1133, 1754, 2704, 2193, 1102, 2230, 2937, 854, 2000, 0 };
+}
+
+void TestOptimizer() {
   std::vector<uint32_t> expected_order = { 0, 3, 7, 4, 6, 2, 8, 5, 9, 1, 10 };
-  TryOptimizer(11, costs, expected_order);
+  TryOptimizer(11, ElevenLocations(), expected_order);
+}
+
+void TestLocalSearchOptimizer() {
+  // Plenty of time so the result does not depend on how fast the machine is
+  LocalSearchOptimizer optimizer(1, std::chrono::seconds(10));
+  optimizer.Seed(111111);
+  auto order = optimizer.Solve(11, ElevenLocations());
+  std::vector<uint32_t> expected_order = { 0, 3, 7, 4, 6, 2, 8, 5, 9, 1, 10 };
+  if (order != expected_order) {
+    throw runtime_error("TestLocalSearchOptimizer: expected order failed");
+  }
+}
+
+void TestLocalSearchOptimizerIsOptimal() {
+  // Compare against every possible tour on random asymmetric costs
+  const uint32_t nlocs = 9;
+  std::mt19937 generator(5);
+  std::uniform_real_distribution<float> distribution(1.0f, 1000.0f);
+  LocalSearchOptimizer optimizer(1, std::chrono::seconds(10));
+  for (uint32_t trial = 0; trial < 20; trial++) {
+    std::vector<float> costs(nlocs * nlocs);
+    for (auto& cost : costs) {
+      cost = distribution(generator);
+    }
+    std::vector<uint32_t> tour(nlocs);
+    for (uint32_t n = 0; n < nlocs; n++) {
+      tour[n] = n;
+    }
+    float best = LocalSearchOptimizer::TourCost(nlocs, costs, tour);
+    while (std::next_permutation(tour.begin() + 1, tour.end() - 1)) {
+      best = std::min(best, LocalSearchOptimizer::TourCost(nlocs, costs, tour));
+    }
+
+    optimizer.Seed(trial);
+    auto order = optimizer.Solve(nlocs, costs);
+    if (order.front() != 0 || order.back() != nlocs - 1) {
+      throw runtime_error("TestLocalSearchOptimizerIsOptimal: origin or destination moved");
+    }
+    if (LocalSearchOptimizer::TourCost(nlocs, costs, order) > best + 0.01f) {
+      throw runtime_error("TestLocalSearchOptimizerIsOptimal: tour is not optimal");
+    }
+  }
+}
+
+void TestLocalSearchOptimizerThreads() {
+  // More searches can only find the same tour or a better one
+  LocalSearchOptimizer optimizer(4, std::chrono::seconds(10));
+  optimizer.Seed(111111);
+  auto costs = ElevenLocations();
+  auto order = optimizer.Solve(11, costs);
+  auto visited = order;
+  std::sort(visited.begin(), visited.end());
+  for (uint32_t n = 0; n < 11; n++) {
+    if (visited[n] != n) {
+      throw runtime_error("TestLocalSearchOptimizerThreads: not a tour of every location");
+    }
+  }
+  if (LocalSearchOptimizer::TourCost(11, costs, order) != 10445) {
+    throw runtime_error("TestLocalSearchOptimizerThreads: tour is not optimal");
+  }
 }
 
 }
@@ -47,5 +113,11 @@ int main() {
 
   suite.test(TEST_CASE(TestOptimizer));
 
+  suite.test(TEST_CASE(TestLocalSearchOptimizer));
+
+  suite.test(TEST_CASE(TestLocalSearchOptimizerIsOptimal));
+
+  suite.test(TEST_CASE(TestLocalSearchOptimizerThreads));
+
   return suite.tear_down();
 }
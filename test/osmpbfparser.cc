@@ -0,0 +1,132 @@
+#include <cstdint>
+#include "test.h"
+#include "mjolnir/osmpbfparser.h"
+
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <boost/filesystem.hpp>
+
+namespace {
+
+const std::vector<std::string> pbfs = { "test/data/harrisburg.osm.pbf", "test/data/bike.osm.pbf",
+                                        "test/data/bus.osm.pbf" };
+const auto all = static_cast<OSMPBF::Interest>(OSMPBF::Interest::NODES | OSMPBF::Interest::WAYS |
+                                               OSMPBF::Interest::RELATIONS | OSMPBF::Interest::CHANGESETS);
+
+// tags come out of a hash map so sort them to compare
+std::string sorted(const OSMPBF::Tags& tags) {
+  std::vector<std::string> kvs;
+  for (const auto& tag : tags)
+    kvs.push_back(tag.first + "=" + tag.second);
+  std::sort(kvs.begin(), kvs.end());
+  std::string joined;
+  for (const auto& kv : kvs)
+    joined += kv + ";";
+  return joined;
+}
+
+// writes down everything it is called back with in the order it is called
+struct record_callback : public OSMPBF::Callback {
+  virtual void node_callback(const uint64_t osmid, const double lng, const double lat, const OSMPBF::Tags& tags) override {
+    std::ostringstream s;
+    s.precision(9);
+    s << "n" << osmid << " " << lng << "," << lat << " " << sorted(tags);
+    seen.push_back(s.str());
+  }
+  virtual void way_callback(const uint64_t osmid, const OSMPBF::Tags& tags, const std::vector<uint64_t>& nodes) override {
+    std::string s = "w" + std::to_string(osmid) + " " + sorted(tags);
+    for (auto node : nodes)
+      s += std::to_string(node) + ",";
+    seen.push_back(s);
+    if (throw_after && ++ways == throw_after)
+      throw std::runtime_error("way callback failed");
+  }
+  virtual void relation_callback(const uint64_t osmid, const OSMPBF::Tags& tags,
+                                 const std::vector<OSMPBF::Member>& members) override {
+    std::string s = "r" + std::to_string(osmid) + " " + sorted(tags);
+    for (const auto& member : members)
+      s += std::to_string(member.member_type) + ":" + std::to_string(member.member_id) + ":" + member.role + ",";
+    seen.push_back(s);
+  }
+  virtual void changeset_callback(const uint64_t changeset_id) override {
+    seen.push_back("c" + std::to_string(changeset_id));
+  }
+  std::vector<std::string> seen;
+  size_t throw_after = 0;
+  size_t ways = 0;
+};
+
+std::vector<std::string> parse(const std::string& pbf, const unsigned int threads) {
+  std::ifstream file(pbf, std::ios::in | std::ios::binary);
+  record_callback callback;
+  OSMPBF::Parser::parse(file, all, callback, threads);
+  return callback.seen;
+}
+
+// the error message parsing failed with
+std::string parse_error(const std::string& pbf, const unsigned int threads, const size_t throw_after) {
+  std::ifstream file(pbf, std::ios::in | std::ios::binary);
+  record_callback callback;
+  callback.throw_after = throw_after;
+  try {
+    OSMPBF::Parser::parse(file, all, callback, threads);
+  }
+  catch (const std::runtime_error& e) {
+    return e.what();
+  }
+  throw std::logic_error("Parsing " + pbf + " on " + std::to_string(threads) + " threads should have failed");
+}
+
+void TestThreadedCallbackOrder() {
+  for (const auto& pbf : pbfs) {
+    auto serial = parse(pbf, 1);
+    if (serial.empty())
+      throw std::logic_error("Nothing was parsed out of " + pbf);
+    for (unsigned int threads : { 2, 4, 8 }) {
+      if (parse(pbf, threads) != serial)
+        throw std::logic_error("Parsing " + pbf + " on " + std::to_string(threads) +
+                               " threads called back differently");
+    }
+  }
+}
+
+void TestCallbackError() {
+  // the callback failing stops the pipeline and the caller gets its error
+  for (unsigned int threads : { 1, 4 }) {
+    auto error = parse_error(pbfs.front(), threads, 100);
+    if (error != "way callback failed")
+      throw std::logic_error("Expected the callback error but got: " + error);
+  }
+}
+
+void TestTruncatedFile() {
+  // the reader failing part way through the file is passed on as well
+  std::string truncated = "test/data/truncated.osm.pbf";
+  {
+    std::ifstream in(pbfs.front(), std::ios::in | std::ios::binary);
+    std::string bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    std::ofstream out(truncated, std::ios::out | std::ios::binary);
+    out.write(bytes.data(), bytes.size() / 2);
+  }
+  auto serial = parse_error(truncated, 1, 0);
+  auto threaded = parse_error(truncated, 4, 0);
+  boost::filesystem::remove(truncated);
+  if (serial != threaded)
+    throw std::logic_error("Expected the same error but got: " + serial + " and: " + threaded);
+}
+
+}
+
+int main() {
+  test::suite suite("osmpbfparser");
+
+  suite.test(TEST_CASE(TestThreadedCallbackOrder));
+
+  suite.test(TEST_CASE(TestCallbackError));
+
+  suite.test(TEST_CASE(TestTruncatedFile));
+
+  OSMPBF::Parser::free();
+  return suite.tear_down();
+}
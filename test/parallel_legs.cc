@@ -0,0 +1,156 @@
+#include <cstdint>
+#include "test.h"
+#include "mjolnir/pbfgraphparser.h"
+#include "mjolnir/graphbuilder.h"
+#include "mjolnir/graphenhancer.h"
+#include "mjolnir/graphvalidator.h"
+#include "baldr/graphreader.h"
+#include "baldr/rapidjson_utils.h"
+#include "loki/search.h"
+#include "sif/autocost.h"
+#include "thor/service.h"
+
+#include <boost/property_tree/ptree.hpp>
+#include <boost/filesystem.hpp>
+#include <prime_server/prime_server.hpp>
+#include <prime_server/http_protocol.hpp>
+
+using namespace valhalla::baldr;
+using namespace valhalla::mjolnir;
+using namespace valhalla::thor;
+
+namespace {
+
+const std::string tile_dir = "test/data/parallel_legs_tiles";
+
+void make_tiles() {
+  boost::filesystem::remove_all(tile_dir);
+  boost::property_tree::ptree conf;
+  conf.put("mjolnir.tile_dir", tile_dir);
+  conf.put("mjolnir.admin", "");
+  std::string ways_file = "test_ways_legs.bin";
+  std::string way_nodes_file = "test_way_nodes_legs.bin";
+  std::string access_file = "test_access_legs.bin";
+  std::string restriction_file = "test_complex_restrictions_legs.bin";
+  auto osmdata = PBFGraphParser::Parse(conf.get_child("mjolnir"), {"test/data/harrisburg.osm.pbf"},
+                                       ways_file, way_nodes_file, access_file, restriction_file);
+  GraphBuilder::Build(conf, osmdata, ways_file, way_nodes_file, restriction_file);
+  GraphEnhancer::Enhance(conf, access_file);
+  GraphValidator::Validate(conf);
+  boost::filesystem::remove(ways_file);
+  boost::filesystem::remove(way_nodes_file);
+  boost::filesystem::remove(access_file);
+  boost::filesystem::remove(restriction_file);
+}
+
+boost::property_tree::ptree config(unsigned int route_threads) {
+  boost::property_tree::ptree conf;
+  conf.put("mjolnir.tile_dir", tile_dir);
+  conf.add_child("costing_options.auto", {});
+  conf.put("thor.logging.long_request", "110.0");
+  conf.put("thor.route.threads", route_threads);
+  conf.put("thor.route.min_parallel_legs", 2);
+  conf.put("meili.default.gps_accuracy", "4.07");
+  conf.put("meili.default.search_radius", "40");
+  conf.put("meili.grid.size", "500");
+  conf.put("meili.grid.cache_size", "64");
+  boost::property_tree::ptree customizable, mode, search_radius;
+  mode.put("", "mode");
+  search_radius.put("", "search_radius");
+  customizable.push_back(std::make_pair("", mode));
+  customizable.push_back(std::make_pair("", search_radius));
+  conf.add_child("meili.customizable", customizable);
+  return conf;
+}
+
+// A route through intersections of bigger roads spread across the largest
+// tile (keeping clear of where it was cut out) correlated like loki would
+rapidjson::Document make_request(const size_t location_count) {
+  boost::property_tree::ptree conf;
+  conf.put("tile_dir", tile_dir);
+  GraphReader reader(conf);
+  const GraphTile* largest = nullptr;
+  for (const auto& id : reader.GetTileSet()) {
+    const GraphTile* tile = reader.GetGraphTile(id);
+    if (!largest || tile->header()->nodecount() > largest->header()->nodecount())
+      largest = tile;
+  }
+
+  std::vector<Location> locations;
+  for (uint32_t i = 0; i < largest->header()->nodecount(); ++i) {
+    const NodeInfo* node = largest->node(i);
+    const DirectedEdge* edge = largest->directededge(node->edge_index());
+    if (node->edge_count() > 2 && edge->classification() <= RoadClass::kSecondary &&
+        !edge->link() && (edge->forwardaccess() & kAutoAccess))
+      locations.emplace_back(node->latlng(), Location::StopType::BREAK);
+  }
+  if (locations.size() < location_count)
+    throw std::runtime_error("Not enough drivable nodes to route through");
+  std::vector<Location> spread;
+  for (size_t i = 0; i < location_count; ++i)
+    spread.push_back(locations[(2 * i + 1) * locations.size() / (2 * location_count)]);
+
+  auto costing = valhalla::sif::CreateAutoCost(boost::property_tree::ptree());
+  auto correlated = valhalla::loki::Search(spread, reader, costing->GetEdgeFilter(),
+                                           costing->GetNodeFilter());
+
+  rapidjson::Document request;
+  auto& allocator = request.GetAllocator();
+  request.SetObject();
+  request.AddMember("action", static_cast<int>(thor_worker_t::ROUTE), allocator);
+  request.AddMember("costing", "auto", allocator);
+  rapidjson::Value json_locations{rapidjson::kArrayType};
+  for (size_t i = 0; i < spread.size(); ++i) {
+    json_locations.PushBack(rapidjson::Value{rapidjson::kObjectType}
+        .AddMember("lat", spread[i].latlng_.lat(), allocator)
+        .AddMember("lon", spread[i].latlng_.lng(), allocator)
+        .AddMember("type", "break", allocator), allocator);
+    auto found = correlated.find(spread[i]);
+    if (found == correlated.end())
+      throw std::runtime_error("Could not correlate a location");
+    request.AddMember(rapidjson::Value("correlated_" + std::to_string(i), allocator),
+                      found->second.ToRapidJson(i, allocator), allocator);
+  }
+  request.AddMember("locations", json_locations, allocator);
+  return request;
+}
+
+// Serialized trip paths of the route
+std::vector<std::string> route(const rapidjson::Document& request, unsigned int route_threads) {
+  thor_worker_t worker(config(route_threads));
+  valhalla::odin::Trace trace;
+  prime_server::http_request_info_t info{};
+  prime_server::worker_t::interrupt_function_t interrupt = [](){};
+  std::list<valhalla::odin::TripPath*> trip_paths;
+  worker.act(request, trace, info, interrupt, trip_paths);
+  std::vector<std::string> serialized;
+  for (const auto* trip_path : trip_paths)
+    serialized.push_back(trip_path->SerializeAsString());
+  worker.cleanup();
+  return serialized;
+}
+
+void TestParallelMatchesSerial() {
+  make_tiles();
+  auto request = make_request(6);
+
+  // Every leg is a break so each one comes back as its own trip path
+  auto serial = route(request, 1);
+  auto parallel = route(request, 4);
+  if (serial.size() != 5)
+    throw std::runtime_error("Expected a trip path per leg");
+  if (serial != parallel)
+    throw std::runtime_error("Searching the legs in parallel changed the route");
+
+  boost::filesystem::remove_all(tile_dir);
+}
+
+}
+
+int main() {
+  test::suite suite("parallel_legs");
+
+  suite.test(TEST_CASE(TestParallelMatchesSerial));
+
+  return suite.tear_down();
+}
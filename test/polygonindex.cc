@@ -0,0 +1,51 @@
+#include "test.h"
+
+#include <cstdint>
+#include "mjolnir/admin.h"
+
+using namespace std;
+using namespace valhalla::mjolnir;
+using namespace valhalla::midgard;
+
+namespace {
+
+multi_polygon_type Polygon(const std::string& wkt) {
+  multi_polygon_type polygon;
+  boost::geometry::read_wkt(wkt, polygon);
+  return polygon;
+}
+
+void TestIntersecting() {
+  PolygonIndex index;
+  // Two squares side by side and a triangle whose box reaches the second
+  index.Add(7, Polygon("MULTIPOLYGON(((0 0,0 1,1 1,1 0,0 0)))"));
+  index.Add(3, Polygon("MULTIPOLYGON(((1 0,1 1,2 1,2 0,1 0)))"));
+  index.Add(5, Polygon("MULTIPOLYGON(((2 2,4 4,4 2,2 2)))"));
+  index.Pack();
+  if (index.size() != 3)
+    throw std::runtime_error("Should have 3 polygons");
+
+  auto polys = index.Intersecting(AABB2<PointLL>(0.5f, 0.5f, 1.5f, 0.75f));
+  if (polys.size() != 2 || polys[0].first != 7 || polys[1].first != 3)
+    throw std::runtime_error("Both squares should intersect, in the order they were added");
+
+  // Inside the bounding box of the triangle but not the triangle
+  polys = index.Intersecting(AABB2<PointLL>(2.1f, 3.5f, 2.4f, 3.9f));
+  if (!polys.empty())
+    throw std::runtime_error("Nothing should intersect above the triangle");
+
+  polys = index.Intersecting(AABB2<PointLL>(-1.0f, -1.0f, 5.0f, 5.0f));
+  if (GetMultiPolyId(polys, PointLL(0.5f, 0.5f)) != 7 || GetMultiPolyId(polys, PointLL(1.5f, 0.5f)) != 3 ||
+      GetMultiPolyId(polys, PointLL(3.5f, 2.5f)) != 5 || GetMultiPolyId(polys, PointLL(2.5f, 3.5f)) != 0)
+    throw std::runtime_error("Points should be found in the polygons that cover them");
+}
+
+}
+
+int main() {
+  test::suite suite("polygonindex");
+
+  suite.test(TEST_CASE(TestIntersecting));
+
+  return suite.tear_down();
+}
@@ -0,0 +1,135 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+import json
+import os
+import shutil
+import subprocess
+import tempfile
+import threading
+import unittest
+
+import valhalla
+
+TILE_DIR = 'test/data/python_tiles'
+CONFIG = 'test/data/python_config.json'
+
+ROUTE = {'locations': [{'lat': 40.2716, 'lon': -76.8869}, {'lat': 40.2586, 'lon': -76.8770}], 'costing': 'auto'}
+TRACE = [{'lat': 40.2716, 'lon': -76.8869}, {'lat': 40.2703, 'lon': -76.8860}, {'lat': 40.2690, 'lon': -76.8851}]
+
+
+def decode(shape):
+  # the points of an encoded route shape, which has 6 digits of precision
+  points, index, lat, lon = [], 0, 0, 0
+  while index < len(shape):
+    deltas = []
+    for _ in range(2):
+      shift, value = 0, 0
+      while True:
+        byte = ord(shape[index]) - 63
+        index += 1
+        value |= (byte & 0x1f) << shift
+        shift += 5
+        if byte < 0x20:
+          break
+      deltas.append(~(value >> 1) if value & 1 else value >> 1)
+    lat, lon = lat + deltas[0], lon + deltas[1]
+    points.append({'lat': lat / 1e6, 'lon': lon / 1e6})
+  return points
+
+
+def setUpModule():
+  # build some tiles with the tile builder from this build and point a config at them
+  with open('test/valhalla.json') as f:
+    config = json.load(f)
+  config['mjolnir']['tile_dir'] = os.path.abspath(TILE_DIR)
+  config['mjolnir']['admin'] = ''
+  for key in ['timezone', 'transit_dir']:
+    config['mjolnir'].pop(key, None)
+  config['mjolnir']['logging'] = {'type': 'std_out', 'color': False}
+  # what loki needs that the test config does not have
+  config['loki']['service_defaults'] = {'minimum_reachability': 50, 'radius': 0}
+  config['loki']['actions'] += ['trace_route', 'trace_attributes']
+  limits = config['service_limits']
+  limits.update({'max_avoid_locations': 50, 'max_reachability': 100, 'max_radius': 200})
+  limits['trace'] = {'max_shape': 16000, 'max_distance': 200000.0, 'max_gps_accuracy': 100.0, 'max_search_radius': 100.0}
+  limits['pedestrian'].update({'min_transit_walking_distance': 1, 'max_transit_walking_distance': 10000})
+  shutil.rmtree(TILE_DIR, ignore_errors=True)
+  with open(CONFIG, 'w') as f:
+    json.dump(config, f)
+  # the builder leaves its intermediate files where it runs
+  build_dir = tempfile.mkdtemp()
+  try:
+    subprocess.check_call([os.path.abspath('valhalla_build_tiles'), '-c', os.path.abspath(CONFIG),
+                           os.path.abspath('test/data/harrisburg.osm.pbf')], cwd=build_dir)
+  finally:
+    shutil.rmtree(build_dir)
+  valhalla.Configure(CONFIG)
+
+
+def tearDownModule():
+  shutil.rmtree(TILE_DIR, ignore_errors=True)
+  os.remove(CONFIG)
+
+
+class Actions(unittest.TestCase):
+
+  def test_single(self):
+    # one request in, one json response out
+    route = json.loads(valhalla.Route(json.dumps(ROUTE)))
+    self.assertEqual(len(route['trip']['legs']), 1)
+    self.assertGreater(route['trip']['summary']['length'], 0)
+
+  def test_batch(self):
+    # a list in, a list of the same responses out in the same order
+    requests = [json.dumps(ROUTE), json.dumps(dict(ROUTE, locations=ROUTE['locations'][::-1]))] * 8
+    responses = valhalla.Route(requests)
+    self.assertIsInstance(responses, list)
+    self.assertEqual(len(responses), len(requests))
+    for request, response in zip(requests, responses):
+      self.assertEqual(json.loads(response)['trip']['summary'], json.loads(valhalla.Route(request))['trip']['summary'])
+
+  def test_errors(self):
+    # bad requests come back as exceptions whether alone or in a list
+    self.assertRaises(RuntimeError, valhalla.Route, '{"locations":[]}')
+    self.assertRaises(RuntimeError, valhalla.Route, [json.dumps(ROUTE), '{"locations":[]}'])
+
+  def test_other_actions(self):
+    self.assertEqual(len(json.loads(valhalla.Locate(json.dumps(ROUTE)))), 2)
+    # the shape of a route snaps back onto the roads it came from
+    shape = json.loads(valhalla.Route(json.dumps(ROUTE)))['trip']['legs'][0]['shape']
+    trace = {'encoded_polyline': shape, 'costing': 'auto', 'shape_match': 'map_snap'}
+    self.assertGreater(len(json.loads(valhalla.TraceAttributes(json.dumps(trace)))['edges']), 0)
+
+
+class SegmentMatcher(unittest.TestCase):
+
+  def test_match_many(self):
+    # any number of traces, including more than there are threads, match the same as one at a time
+    matcher = valhalla.SegmentMatcher()
+    traces = [json.dumps({'trace': [{'lat': p['lat'], 'lon': p['lon'], 'time': i * 10} for i, p in enumerate(TRACE)]})]
+    for count in [0, 1, 3, 64]:
+      many = matcher.MatchMany(traces * count)
+      self.assertEqual(len(many), count)
+      self.assertEqual(many, [matcher.Match(trace) for trace in traces * count])
+
+  def test_shared(self):
+    # python threads can share one matcher, they take turns with it
+    matcher = valhalla.SegmentMatcher()
+    shape = json.loads(valhalla.Route(json.dumps(ROUTE)))['trip']['legs'][0]['shape']
+    points = [dict(p, time=i * 5) for i, p in enumerate(decode(shape))]
+    traces = [json.dumps({'trace': points[i:]}) for i in range(0, len(points) // 2, 4)]
+    expected = [matcher.Match(trace) for trace in traces]
+    results = {}
+    def match(thread):
+      results[thread] = [matcher.Match(trace) for trace in traces] + matcher.MatchMany(traces)
+    threads = [threading.Thread(target=match, args=(i,)) for i in range(8)]
+    for thread in threads:
+      thread.start()
+    for thread in threads:
+      thread.join()
+    self.assertEqual(len(results), len(threads))
+    for result in results.values():
+      self.assertEqual(result, expected * 2)
+
+if __name__ == '__main__':
+  unittest.main()
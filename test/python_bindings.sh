@@ -0,0 +1,3 @@
+#!/bin/sh
+# runs the python binding tests against the module and tile builder from this build
+PYTHONPATH=.libs${PYTHONPATH:+:$PYTHONPATH} exec ${PYTHON:-python} test/python/bindings.py
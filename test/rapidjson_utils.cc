@@ -0,0 +1,44 @@
+#include "test.h"
+
+#include <string>
+#include <sstream>
+#include <boost/property_tree/ptree.hpp>
+#include <boost/property_tree/json_parser.hpp>
+
+#include "baldr/rapidjson_utils.h"
+
+namespace {
+
+  void compare(const std::string& json) {
+    //what the workers used to get by serializing and parsing it back in
+    rapidjson::Document d;
+    d.Parse(json.c_str());
+    std::stringstream stream(rapidjson::to_string(d));
+    boost::property_tree::ptree expected;
+    boost::property_tree::read_json(stream, expected);
+
+    //should be exactly the same without the round trip
+    auto actual = rapidjson::to_ptree(d);
+    if(actual != expected)
+      throw std::logic_error("Converted tree does not match parsed tree for: " + json);
+  }
+
+  void test_to_ptree() {
+    compare("{}");
+    compare("{\"a\":1,\"b\":-2,\"c\":18446744073709551615,\"d\":1.25e-7,\"e\":0.1,\"f\":-76.29813373088837}");
+    compare("{\"a\":true,\"b\":false,\"c\":null,\"d\":\"\",\"e\":\"some \\\"quoted\\\" text\"}");
+    compare("{\"locations\":[{\"lat\":40.04405976651413,\"lon\":-76.29813373088837,\"type\":\"break\"},{\"lat\":40.0426,\"lon\":-76.2991}],"
+            "\"costing\":\"auto\",\"costing_options\":{\"auto\":{\"avoid_edges\":[1343687978654,3091605450398]}},\"action\":0}");
+    compare("{\"a\":[[1,2],[],[{\"b\":[3]}]],\"c\":{\"d\":{\"e\":{}}}}");
+    compare("{\"a\":1,\"a\":2}");
+  }
+
+}
+
+int main(void) {
+  test::suite suite("rapidjson_utils");
+
+  suite.test(TEST_CASE(test_to_ptree));
+
+  return suite.tear_down();
+}
@@ -51,6 +51,34 @@ void test_read_write() {
   read_nodes(file_name, count);
 }
 
+void test_external_sort() {
+  //scramble the ids so the runs have something to merge
+  size_t count = 10007;
+  std::string file_name = "external.nd";
+  {
+    sequence<osm_node> sequence(file_name, true, 512);
+    for(uint64_t i = 0; i < count; ++i)
+      sequence.push_back({(i * 7919) % count, 0.f, 0.f, static_cast<uint32_t>(i)});
+  }
+
+  //uneven runs sorted across a few threads
+  {
+    sequence<osm_node> sequence(file_name, false, 512);
+    sequence.sort([](const osm_node& a, const osm_node& b){return a.id < b.id;}, 1000, 3);
+  }
+  sequence<osm_node> sequence(file_name, false, 512);
+  if(sequence.size() != count)
+    throw std::runtime_error("Sorting lost some nodes");
+  for(uint64_t i = 0; i < count; ++i) {
+    osm_node node = *sequence[i];
+    if(node.id != i || node.attributes != (i * 8967) % count)
+      throw std::runtime_error("Found wrong node at: " + std::to_string(i));
+  }
+  std::ifstream runs(file_name + ".runs");
+  if(runs.is_open())
+    throw std::runtime_error("Sorting left its runs behind");
+}
+
 void test_iterator() {
   sequence<osm_node> sequence("nodes.nd", false, 512);
   auto i = sequence.begin();
@@ -79,5 +107,7 @@ int main() {
 
   suite.test(TEST_CASE(test_iterator));
 
+  suite.test(TEST_CASE(test_external_sort));
+
   return suite.tear_down();
 }
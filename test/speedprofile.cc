@@ -0,0 +1,99 @@
+#include "test.h"
+
+#include "baldr/speedprofile.h"
+#include "baldr/graphconstants.h"
+
+using namespace std;
+using namespace valhalla::baldr;
+
+// Expected size is 176 bytes. Since there are still "spare" bits
+// we want to alert if somehow any change grows this structure size
+constexpr size_t kSpeedProfileExpectedSize = 176;
+
+namespace {
+
+  void test_sizeof() {
+    if (sizeof(SpeedProfile) != kSpeedProfileExpectedSize)
+      throw std::runtime_error("SpeedProfile size should be " +
+                std::to_string(kSpeedProfileExpectedSize) + " bytes" +
+                " but is " + std::to_string(sizeof(SpeedProfile)));
+  }
+
+  // Speeds that go up by 1 kph each hour of the week
+  std::vector<uint32_t> ramp() {
+    std::vector<uint32_t> speeds;
+    for (uint32_t i = 0; i < kSpeedBucketCount; i++) {
+      speeds.push_back(10 + (i % 100));
+    }
+    return speeds;
+  }
+
+  void TestBucketSpeed() {
+    SpeedProfile profile(1234, ramp());
+    if (profile.edgeindex() != 1234) {
+      throw runtime_error("SpeedProfile edgeindex test failed");
+    }
+    if (profile.bucket_speed(0) != 10 || profile.bucket_speed(5) != 15) {
+      throw runtime_error("SpeedProfile bucket_speed test failed");
+    }
+
+    // Speeds above the maximum are clamped
+    std::vector<uint32_t> fast(kSpeedBucketCount, 300);
+    SpeedProfile fast_profile(0, fast);
+    if (fast_profile.bucket_speed(10) != kMaxSpeedKph) {
+      throw runtime_error("SpeedProfile clamp test failed");
+    }
+  }
+
+  void TestInterpolation() {
+    SpeedProfile profile(0, ramp());
+
+    // The hourly average applies at the middle of the hour
+    if (profile.speed(5 * kSpeedBucketSeconds + kSpeedBucketSeconds / 2) != 15) {
+      throw runtime_error("SpeedProfile mid hour test failed");
+    }
+
+    // Halfway between 2 middles the speed is halfway between their averages
+    std::vector<uint32_t> speeds(kSpeedBucketCount, 20);
+    speeds[1] = 40;
+    SpeedProfile step(0, speeds);
+    if (step.speed(kSpeedBucketSeconds) != 30) {
+      throw runtime_error("SpeedProfile interpolation test 1 failed");
+    }
+    if (step.speed(kSpeedBucketSeconds + kSpeedBucketSeconds / 4) != 35) {
+      throw runtime_error("SpeedProfile interpolation test 2 failed");
+    }
+  }
+
+  void TestWeekWrap() {
+    // Just after midnight Sunday interpolates with the last hour of Saturday
+    std::vector<uint32_t> speeds(kSpeedBucketCount, 50);
+    speeds[kSpeedBucketCount - 1] = 30;
+    SpeedProfile profile(0, speeds);
+    if (profile.speed(0) != 40) {
+      throw runtime_error("SpeedProfile week wrap test 1 failed");
+    }
+    if (profile.speed(kSecondsPerWeek - kSpeedBucketSeconds / 2) != 30) {
+      throw runtime_error("SpeedProfile week wrap test 2 failed");
+    }
+  }
+
+}
+
+int main(void)
+{
+  test::suite suite("speedprofile");
+
+  suite.test(TEST_CASE(test_sizeof));
+
+  // Test hourly speeds
+  suite.test(TEST_CASE(TestBucketSpeed));
+
+  // Test interpolation between hours
+  suite.test(TEST_CASE(TestInterpolation));
+
+  // Test wrapping around the end of the week
+  suite.test(TEST_CASE(TestWeekWrap));
+
+  return suite.tear_down();
+}
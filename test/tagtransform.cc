@@ -0,0 +1,130 @@
+#include <cstdint>
+#include "test.h"
+#include "mjolnir/luatagtransform.h"
+#include "mjolnir/nativetagtransform.h"
+#include "mjolnir/osmpbfparser.h"
+#include "graph_lua_proc.h"
+
+#include <fstream>
+#include <string>
+
+using namespace valhalla::mjolnir;
+
+namespace {
+
+const std::string graph_lua(lua_graph_lua, lua_graph_lua + lua_graph_lua_len);
+
+void Compare(LuaTagTransform& lua, NativeTagTransform& native, OSMType type, const Tags& tags) {
+  auto expected = lua.Transform(type, tags);
+  auto transformed = native.Transform(type, tags);
+  if (expected == transformed)
+    return;
+  std::string message = "Native tag transform differs from lua for:";
+  for (const auto& tag : tags)
+    message += " " + tag.first + "=" + tag.second;
+  throw std::runtime_error(message);
+}
+
+// Hands every object of a pbf to both transforms
+struct compare_callback : public OSMPBF::Callback {
+  compare_callback(LuaTagTransform& lua, NativeTagTransform& native) : lua_(lua), native_(native) {}
+  virtual void node_callback(const uint64_t osmid, const double lng, const double lat, const OSMPBF::Tags& tags) override {
+    Compare(lua_, native_, OSMType::kNode, tags);
+  }
+  virtual void way_callback(const uint64_t osmid, const OSMPBF::Tags& tags, const std::vector<uint64_t>& nodes) override {
+    Compare(lua_, native_, OSMType::kWay, tags);
+  }
+  virtual void relation_callback(const uint64_t osmid, const OSMPBF::Tags& tags,
+                                 const std::vector<OSMPBF::Member>& members) override {
+    Compare(lua_, native_, OSMType::kRelation, tags);
+  }
+  virtual void changeset_callback(const uint64_t changeset_id) override {}
+  LuaTagTransform& lua_;
+  NativeTagTransform& native_;
+};
+
+void TestTags() {
+  LuaTagTransform lua(graph_lua);
+  NativeTagTransform native(graph_lua);
+  // Nothing to keep
+  Compare(lua, native, OSMType::kWay, {});
+  Compare(lua, native, OSMType::kWay, {{"building", "yes"}});
+  Compare(lua, native, OSMType::kWay, {{"highway", "construction"}});
+  // Oneways and the modes allowed against them
+  Compare(lua, native, OSMType::kWay, {{"highway", "residential"}, {"oneway", "-1"}, {"oneway:bicycle", "no"}});
+  Compare(lua, native, OSMType::kWay, {{"highway", "primary"}, {"oneway", "yes"}, {"busway", "lane"},
+    {"cycleway:right", "track"}, {"cycleway:left", "shared_lane"}, {"lanes", "14"}});
+  Compare(lua, native, OSMType::kWay, {{"highway", "service"}, {"service", "driveway"}, {"hov", "designated"}});
+  Compare(lua, native, OSMType::kWay, {{"route", "ferry"}, {"motorcar", "no"}, {"maxspeed", "30 mph"}});
+  Compare(lua, native, OSMType::kWay, {{"highway", "track"}, {"tracktype", "grade2"}, {"access", "private"},
+    {"emergency", "yes"}});
+  // Measurements and weights in all their forms
+  for (const auto& measure : { "7'6\"", "6 ft", "2.5m", "3 meters", "10\"", "7ft6in", "7'6", "3.5t", "2000 lbs",
+                               "5000kg", "1.2.3" }) {
+    Compare(lua, native, OSMType::kWay, {{"highway", "secondary"}, {"maxheight", measure}, {"maxwidth", measure},
+      {"maxweight", measure}, {"maxlength", measure}});
+  }
+  // Barriers and payment at nodes
+  Compare(lua, native, OSMType::kNode, {});
+  Compare(lua, native, OSMType::kNode, {{"barrier", "bollard"}, {"foot", "no"}});
+  Compare(lua, native, OSMType::kNode, {{"barrier", "bollard"}, {"bollard", "rising"}});
+  Compare(lua, native, OSMType::kNode, {{"barrier", "toll_booth"}, {"payment:coins", "yes"}, {"payment:e_zpass", "yes"}});
+  Compare(lua, native, OSMType::kNode, {{"highway", "crossing"}, {"bicycle", "no"}, {"access", "no"}});
+  // Restrictions and routes
+  Compare(lua, native, OSMType::kRelation, {{"type", "restriction"}, {"restriction", "no_left_turn"},
+    {"day_on", "Monday"}});
+  Compare(lua, native, OSMType::kRelation, {{"type", "restriction"}, {"restriction", "bogus"}});
+  Compare(lua, native, OSMType::kRelation, {{"type", "route"}, {"route", "bicycle"}, {"network", "rcn"}});
+  Compare(lua, native, OSMType::kRelation, {{"type", "multipolygon"}});
+}
+
+void TestLuaErrors() {
+  // Ways blow up when tagged boom
+  LuaTagTransform lua(R"(
+    function nodes_proc (kv, nokeys)
+      return 0, kv
+    end
+    function ways_proc (kv, nokeys)
+      if kv["boom"] then
+        error("boom")
+      end
+      return 0, kv, 0, 0
+    end
+    function rels_proc (kv, nokeys)
+      return 0, kv
+    end
+  )");
+  // A failed call drops the tags and leaves lua ready for the next one
+  for (int i = 0; i < 100; ++i) {
+    if (!lua.Transform(OSMType::kWay, {{"highway", "primary"}, {"boom", "yes"}}).empty())
+      throw std::runtime_error("Tags of a failed lua call should have been dropped");
+  }
+  Tags tags{{"highway", "primary"}};
+  if (lua.Transform(OSMType::kWay, tags) != tags || lua.Transform(OSMType::kNode, tags) != tags)
+    throw std::runtime_error("Lua should work normally after a failed call");
+}
+
+void TestPBFs() {
+  LuaTagTransform lua(graph_lua);
+  NativeTagTransform native(graph_lua);
+  compare_callback callback(lua, native);
+  for (const auto& pbf : { "test/data/harrisburg.osm.pbf", "test/data/bike.osm.pbf", "test/data/bus.osm.pbf",
+                           "test/data/liechtenstein-latest.osm.pbf" }) {
+    std::ifstream file(pbf, std::ios::binary);
+    OSMPBF::Parser::parse(file, static_cast<OSMPBF::Interest>(OSMPBF::Interest::NODES | OSMPBF::Interest::WAYS |
+      OSMPBF::Interest::RELATIONS), callback);
+  }
+  OSMPBF::Parser::free();
+}
+
+}
+
+int main() {
+  test::suite suite("tagtransform");
+
+  suite.test(TEST_CASE(TestTags));
+  suite.test(TEST_CASE(TestLuaErrors));
+  suite.test(TEST_CASE(TestPBFs));
+
+  return suite.tear_down();
+}
@@ -0,0 +1,44 @@
+// -*- mode: c++ -*-
+
+#ifndef TEST_TILES_HPP
+#define TEST_TILES_HPP
+
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <string>
+#include <boost/filesystem.hpp>
+
+namespace test {
+
+//replaces the directory to with a copy of the directory from
+inline void copy_dir(const std::string& from, const std::string& to) {
+  boost::filesystem::remove_all(to);
+  for (boost::filesystem::recursive_directory_iterator i(from), end; i != end; ++i) {
+    auto target = to + i->path().string().substr(from.size());
+    if (boost::filesystem::is_directory(i->path()))
+      boost::filesystem::create_directories(target);
+    else
+      boost::filesystem::copy_file(i->path(), target);
+  }
+}
+
+//the contents of every file under dir keyed by its path relative to dir,
+//only files with the given extension if there is one
+inline std::map<std::string, std::string> read_dir(const std::string& dir,
+                                                   const std::string& extension = "") {
+  std::map<std::string, std::string> files;
+  for (boost::filesystem::recursive_directory_iterator i(dir), end; i != end; ++i) {
+    if (boost::filesystem::is_regular_file(i->path()) &&
+        (extension.empty() || i->path().extension() == extension)) {
+      std::ifstream file(i->path().string(), std::ios::binary);
+      files[i->path().string().substr(dir.size())] =
+        std::string((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    }
+  }
+  return files;
+}
+
+}
+
+#endif
@@ -0,0 +1,90 @@
+#include "test.h"
+#include "mjolnir/tilescheduler.h"
+
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace valhalla::mjolnir;
+
+namespace {
+
+void TestEachItemOnce() {
+  // Uneven weights so some threads run out and have to steal
+  std::vector<size_t> weights;
+  for (size_t i = 0; i < 1000; ++i)
+    weights.push_back(i % 7 == 0 ? 1000 : i % 13);
+  TileScheduler scheduler("Testing", weights, 4);
+
+  std::vector<std::atomic<int> > handed_out(weights.size());
+  for (auto& count : handed_out)
+    count = 0;
+  scheduler.run([&](size_t worker) {
+    size_t item;
+    while (scheduler.next(worker, item))
+      handed_out[item]++;
+  });
+  for (const auto& count : handed_out)
+    if (count != 1)
+      throw std::runtime_error("Each item should be handed out exactly once");
+}
+
+void TestLargestFirst() {
+  // With one thread the items come out heaviest first
+  TileScheduler scheduler("Testing", {3, 10, 0, 7, 10}, 1);
+  std::vector<size_t> order;
+  scheduler.run([&](size_t worker) {
+    size_t item;
+    while (scheduler.next(worker, item))
+      order.push_back(item);
+  });
+  if (order != std::vector<size_t>{1, 4, 3, 0, 2})
+    throw std::runtime_error("Items should be handed out largest first");
+}
+
+void TestRethrow() {
+  TileScheduler scheduler("Testing", std::vector<size_t>(10, 1), 3);
+  test::assert_throw<std::runtime_error>([&scheduler]() {
+    scheduler.run([&](size_t worker) {
+      size_t item;
+      while (scheduler.next(worker, item))
+        if (item == 5)
+          throw std::runtime_error("boom");
+    });
+  }, "Exceptions thrown by the work should be rethrown");
+}
+
+
+void TestStopOnError() {
+  // Once one thread fails the others should not work through the rest
+  TileScheduler scheduler("Testing", std::vector<size_t>(1000, 1), 2);
+  std::atomic<size_t> done(0);
+  test::assert_throw<std::runtime_error>([&]() {
+    scheduler.run([&](size_t worker) {
+      size_t item;
+      while (scheduler.next(worker, item)) {
+        if (worker == 0)
+          throw std::runtime_error("boom");
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        ++done;
+      }
+    });
+  }, "Exceptions thrown by the work should be rethrown");
+  if (done >= scheduler.size() / 2)
+    throw std::runtime_error("Threads should stop taking items after another one failed");
+}
+
+}
+
+int main() {
+  test::suite suite("tilescheduler");
+
+  suite.test(TEST_CASE(TestEachItemOnce));
+  suite.test(TEST_CASE(TestLargestFirst));
+  suite.test(TEST_CASE(TestRethrow));
+  suite.test(TEST_CASE(TestStopOnError));
+
+  return suite.tear_down();
+}
@@ -0,0 +1,151 @@
+#include <cstdint>
+#include "test.h"
+
+#include "baldr/graphreader.h"
+#include "baldr/pathlocation.h"
+#include "baldr/speedprofile.h"
+#include "baldr/tilehierarchy.h"
+#include "mjolnir/graphtilebuilder.h"
+#include "mjolnir/directededgebuilder.h"
+#include "sif/autocost.h"
+#include "thor/astar.h"
+
+#include <algorithm>
+#include <cmath>
+#include <boost/property_tree/ptree.hpp>
+#include <boost/filesystem.hpp>
+
+using namespace valhalla::midgard;
+using namespace valhalla::baldr;
+using namespace valhalla::mjolnir;
+using namespace valhalla::sif;
+using namespace valhalla::thor;
+
+namespace {
+
+// a straight road with the node in the middle of it:
+//
+//   a ---0--> b ---2--> c
+//     <--1---   <--3---
+//
+const std::string tile_dir = "test/data/timedependent_tiles";
+const PointLL a(0.01, 0.05), b(0.05, 0.05), c(0.09, 0.05);
+
+// The time invariant speed of the edges and the speeds of their profiles:
+// slow in the early hours of Sunday morning, fast the rest of the week
+constexpr uint32_t kEdgeSpeed = 50;
+constexpr uint32_t kSlowSpeed = 20;
+constexpr uint32_t kFastSpeed = 100;
+
+GraphId tile_id() {
+  return TileHierarchy::GetGraphId(b, TileHierarchy::levels().rbegin()->first);
+}
+
+void make_tile() {
+  boost::filesystem::remove_all(tile_dir);
+  GraphTileBuilder tile(tile_dir, tile_id(), false);
+  GraphId node_a(tile_id().tileid(), tile_id().level(), 0);
+  GraphId node_b(tile_id().tileid(), tile_id().level(), 1);
+  GraphId node_c(tile_id().tileid(), tile_id().level(), 2);
+
+  auto add_node = [&tile](const PointLL& ll, const uint32_t edge_index, const uint32_t edge_count) {
+    NodeInfo node;
+    node.set_latlng(ll);
+    node.set_access(kAllAccess);
+    node.set_edge_index(edge_index);
+    node.set_edge_count(edge_count);
+    tile.nodes().emplace_back(std::move(node));
+  };
+  auto add_edge = [&tile](const GraphId& u, const PointLL& u_ll, const GraphId& v, const PointLL& v_ll,
+                          const uint32_t way, const bool forward, const uint32_t local_idx,
+                          const uint32_t opp_local_idx, const uint32_t opp_index) {
+    DirectedEdgeBuilder edge({}, v, forward, u_ll.Distance(v_ll) + .5, kEdgeSpeed, kEdgeSpeed,
+                             kEdgeSpeed, Use::kRoad, RoadClass::kPrimary, local_idx, false, 0, 0);
+    edge.set_opp_index(opp_index);
+    edge.set_opp_local_idx(opp_local_idx);
+    edge.set_forwardaccess(kAllAccess);
+    edge.set_reverseaccess(kAllAccess);
+    std::vector<PointLL> shape = {u_ll, v_ll};
+    if (!forward)
+      std::reverse(shape.begin(), shape.end());
+    bool added;
+    edge.set_edgeinfo_offset(tile.AddEdgeInfo(way, forward ? u : v, forward ? v : u, way, shape,
+                                              {"main street"}, added));
+    tile.directededges().emplace_back(std::move(edge));
+  };
+
+  add_edge(node_a, a, node_b, b, 1, true, 0, 0, 1);
+  add_node(a, 0, 1);
+  add_edge(node_b, b, node_a, a, 1, false, 0, 0, 0);
+  add_edge(node_b, b, node_c, c, 2, true, 1, 0, 3);
+  add_node(b, 1, 2);
+  add_edge(node_c, c, node_b, b, 2, false, 0, 1, 2);
+  add_node(c, 3, 1);
+
+  // Profiles on the edges towards c
+  std::vector<uint32_t> speeds(kSpeedBucketCount, kFastSpeed);
+  std::fill(speeds.begin(), speeds.begin() + 6, kSlowSpeed);
+  tile.AddSpeedProfile(SpeedProfile(0, speeds));
+  tile.AddSpeedProfile(SpeedProfile(2, speeds));
+  tile.StoreTileData();
+}
+
+// Seconds to drive from a quarter of the way along a->b to halfway along
+// b->c with the given departure time
+float drive_time(const boost::optional<std::string>& date_time) {
+  boost::property_tree::ptree conf;
+  conf.put("tile_dir", tile_dir);
+  GraphReader reader(conf);
+
+  PathLocation origin(a);
+  origin.edges.emplace_back(GraphId(tile_id().tileid(), tile_id().level(), 0), 0.25f, a, 0.0f);
+  origin.date_time_ = date_time;
+  PathLocation destination(c);
+  destination.edges.emplace_back(GraphId(tile_id().tileid(), tile_id().level(), 2), 0.5f, c, 0.0f);
+
+  auto mode = TravelMode::kDrive;
+  cost_ptr_t costs[static_cast<int>(TravelMode::kMaxTravelMode)];
+  costs[static_cast<int>(mode)] = CreateAutoCost(boost::property_tree::ptree());
+  AStarPathAlgorithm astar;
+  auto path = astar.GetBestPath(origin, destination, reader, costs, mode);
+  if (path.size() != 2)
+    throw std::runtime_error("Expected a path along both edges");
+  return path.back().elapsed_time;
+}
+
+// Seconds to drive the partial edges at a speed
+float expected_time(const uint32_t speed) {
+  return (0.75f * (a.Distance(b) + .5f) + 0.5f * (b.Distance(c) + .5f)) * 3.6f / speed;
+}
+
+void check_time(const float time, const uint32_t speed, const std::string& what) {
+  if (std::abs(time - expected_time(speed)) > 2.0f)
+    throw std::runtime_error(what + " should take " + std::to_string(expected_time(speed)) +
+                             " seconds but took " + std::to_string(time));
+}
+
+void TestTimeInvariant() {
+  make_tile();
+  check_time(drive_time(boost::none), kEdgeSpeed, "Driving without a departure time");
+}
+
+void TestDepartureTime() {
+  make_tile();
+
+  // 2018-06-17 is a Sunday, both partial edges are costed at the same speed
+  check_time(drive_time(std::string("2018-06-17T02:00")), kSlowSpeed, "Driving early Sunday");
+  check_time(drive_time(std::string("2018-06-17T12:00")), kFastSpeed, "Driving Sunday noon");
+  boost::filesystem::remove_all(tile_dir);
+}
+
+}
+
+int main() {
+  test::suite suite("timedependent");
+
+  suite.test(TEST_CASE(TestTimeInvariant));
+
+  suite.test(TEST_CASE(TestDepartureTime));
+
+  return suite.tear_down();
+}
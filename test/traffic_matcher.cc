@@ -71,7 +71,7 @@ namespace {
     //then finish it and you should see partial, then full and the full should not count the length of the partial in it
   };
 
-  void test_matcher() {
+  boost::property_tree::ptree make_conf() {
     //fake config
     std::stringstream conf_json; conf_json << R"({
       "mjolnir":{"tile_dir":"test/traffic_matcher_tiles"},
@@ -82,9 +82,12 @@ namespace {
     })";
     boost::property_tree::ptree conf;
     boost::property_tree::read_json(conf_json, conf);
+    return conf;
+  }
 
+  void test_matcher() {
     //find me a find, catch me a catch
-    testable_matcher matcher(conf);
+    testable_matcher matcher(make_conf());
 
     //some edges should have no matches and most will have no segments
     for(const auto& test_case : test_cases) {
@@ -122,6 +125,21 @@ namespace {
 
   }
 
+  void test_batch_matcher() {
+    meili::TrafficSegmentMatcher matcher(make_conf());
+
+    //matching them all at once should be the same as one at a time
+    std::vector<std::string> traces;
+    for(const auto& test_case : test_cases)
+      traces.push_back(test_case.first);
+    auto batched = matcher.match(traces);
+    if(batched.size() != traces.size())
+      throw std::logic_error("wrong number of batch results");
+    for(size_t i = 0; i < traces.size(); ++i)
+      if(batched[i] != matcher.match(traces[i]))
+        throw std::logic_error("batch match differs from single match");
+  }
+
 }
 
 int main() {
@@ -129,5 +147,7 @@ int main() {
 
   suite.test(TEST_CASE(test_matcher));
 
+  suite.test(TEST_CASE(test_batch_matcher));
+
   return suite.tear_down();
 }
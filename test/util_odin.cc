@@ -1,4 +1,5 @@
 #include <set>
+#include <sstream>
 #include <locale>
 #include <stdexcept>
 #include <boost/regex.hpp>
@@ -201,6 +202,26 @@ namespace {
       }
     }
   }
+
+  void test_narrative_fields() {
+    //all of the narrative unless asked for less
+    boost::property_tree::ptree options;
+    if(GetDirectionsOptions(options).narrative_fields() != 15)
+      throw std::runtime_error("All narrative fields should be formed by default");
+
+    //names match the output fields and unknown ones are ignored
+    std::stringstream json("{\"narrative_fields\":[\"instruction\",\"verbal_post_transition_instruction\",\"nonsense\"]}");
+    boost::property_tree::read_json(json, options);
+    auto fields = GetDirectionsOptions(options).narrative_fields();
+    if(fields != (DirectionsOptions::kInstruction | DirectionsOptions::kVerbalPostTransition))
+      throw std::runtime_error("Wrong narrative fields: " + std::to_string(fields));
+
+    rapidjson::Document document;
+    document.Parse("{\"narrative_fields\":[\"verbal_transition_alert_instruction\"]}");
+    fields = GetDirectionsOptions(document).narrative_fields();
+    if(fields != DirectionsOptions::kVerbalTransitionAlert)
+      throw std::runtime_error("Wrong narrative fields: " + std::to_string(fields));
+  }
 }
 
 int main() {
@@ -210,6 +231,7 @@ int main() {
   suite.test(TEST_CASE(test_get_locales));
   suite.test(TEST_CASE(test_time));
   suite.test(TEST_CASE(test_date));
+  suite.test(TEST_CASE(test_narrative_fields));
 
   return suite.tear_down();
 }
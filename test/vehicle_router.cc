@@ -0,0 +1,153 @@
+#include <cstdint>
+#include "test.h"
+#include <cmath>
+#include <vector>
+#include <algorithm>
+#include "config.h"
+#include "thor/vehicle_router.h"
+
+using namespace std;
+using namespace valhalla::thor;
+
+namespace {
+
+// Locations on a line, one second apart. Location 0 is the depot.
+std::vector<float> LineTimes(const uint32_t count) {
+  std::vector<float> times(count * count);
+  for (uint32_t i = 0; i < count; i++) {
+    for (uint32_t j = 0; j < count; j++) {
+      times[i * count + j] = std::abs(static_cast<float>(i) - static_cast<float>(j));
+    }
+  }
+  return times;
+}
+
+void CheckRoute(const VehicleRoute& route, const std::vector<uint32_t>& expected, const std::string& name) {
+  if (route.stops != expected) {
+    throw runtime_error(name + ": unexpected stop order");
+  }
+}
+
+void TestSingleVehicle() {
+  // One vehicle visits everything in order along the line and comes back
+  std::vector<Stop> stops = { Stop(3), Stop(1), Stop(4), Stop(2) };
+  std::vector<Vehicle> vehicles = { Vehicle(0, 0) };
+  VehicleRouter router;
+  auto solution = router.Solve(5, LineTimes(5), vehicles, stops);
+  if (!solution.unassigned.empty() || solution.travel_time != 8.0f) {
+    throw runtime_error("TestSingleVehicle: expected an 8 second round trip");
+  }
+  // Either direction along the line is as good
+  auto& order = solution.routes.front().stops;
+  if (order != std::vector<uint32_t>{ 1, 3, 0, 2 } && order != std::vector<uint32_t>{ 2, 0, 3, 1 }) {
+    throw runtime_error("TestSingleVehicle: unexpected stop order");
+  }
+}
+
+void TestCapacity() {
+  // Depot in the middle, each vehicle can only carry the stops on one side
+  std::vector<Stop> stops = { Stop(0, 1), Stop(1, 1), Stop(3, 1), Stop(4, 1) };
+  std::vector<Vehicle> vehicles = { Vehicle(2, 2, 2), Vehicle(2, 2, 2) };
+  VehicleRouter router;
+  auto solution = router.Solve(5, LineTimes(5), vehicles, stops);
+  if (!solution.unassigned.empty() || solution.travel_time != 8.0f) {
+    throw runtime_error("TestCapacity: expected two 4 second round trips");
+  }
+  for (const auto& route : solution.routes) {
+    if (route.load != 2.0f) {
+      throw runtime_error("TestCapacity: expected each vehicle to be full");
+    }
+  }
+}
+
+void TestTimeWindows() {
+  // The far stop has to be served first even though it costs more
+  std::vector<Stop> stops = { Stop(1, 0, 0, 0, 10), Stop(4, 0, 0, 0, 4) };
+  std::vector<Vehicle> vehicles = { Vehicle(0, 0) };
+  VehicleRouter router;
+  auto solution = router.Solve(5, LineTimes(5), vehicles, stops);
+  CheckRoute(solution.routes.front(), { 1, 0 }, "TestTimeWindows");
+  const auto& route = solution.routes.front();
+  if (route.arrivals != std::vector<float>{ 4, 7 } || route.arrival != 8.0f) {
+    throw runtime_error("TestTimeWindows: unexpected arrival times");
+  }
+
+  // Waiting for a window to open leaves the depot later
+  stops = { Stop(2, 0, 10, 20, 30) };
+  solution = router.Solve(5, LineTimes(5), vehicles, stops);
+  if (solution.routes.front().departure != 18.0f || solution.routes.front().arrival != 32.0f) {
+    throw runtime_error("TestTimeWindows: expected to leave just in time");
+  }
+}
+
+void TestUnassigned() {
+  // The vehicle has to be back before it could reach the last stop
+  std::vector<Stop> stops = { Stop(1), Stop(4) };
+  std::vector<Vehicle> vehicles = { Vehicle(0, 0, kUnbounded, 0, 5) };
+  VehicleRouter router;
+  auto solution = router.Solve(5, LineTimes(5), vehicles, stops);
+  CheckRoute(solution.routes.front(), { 0 }, "TestUnassigned");
+  if (solution.unassigned != std::vector<uint32_t>{ 1 }) {
+    throw runtime_error("TestUnassigned: expected the far stop to be left out");
+  }
+
+  // Nothing reaches an unconnected location
+  auto times = LineTimes(5);
+  for (uint32_t i = 0; i < 5; i++) {
+    if (i != 3) {
+      times[i * 5 + 3] = times[3 * 5 + i] = INFINITY;
+    }
+  }
+  stops = { Stop(3), Stop(2) };
+  vehicles = { Vehicle(0) };
+  solution = router.Solve(5, times, vehicles, stops);
+  CheckRoute(solution.routes.front(), { 1 }, "TestUnassigned");
+  if (solution.unassigned != std::vector<uint32_t>{ 0 }) {
+    throw runtime_error("TestUnassigned: expected the unconnected stop to be left out");
+  }
+}
+
+void TestOpenRoute() {
+  // Without an end location the vehicle stops at its last stop
+  std::vector<Stop> stops = { Stop(2), Stop(4) };
+  std::vector<Vehicle> vehicles = { Vehicle(0) };
+  VehicleRouter router;
+  auto solution = router.Solve(5, LineTimes(5), vehicles, stops);
+  CheckRoute(solution.routes.front(), { 0, 1 }, "TestOpenRoute");
+  if (solution.travel_time != 4.0f) {
+    throw runtime_error("TestOpenRoute: expected no return trip");
+  }
+}
+
+void TestTimeLimit() {
+  // Out of time before the first stop is placed, but only the improving
+  // moves are cut short so every stop that fits is still served
+  std::vector<Stop> stops = { Stop(1), Stop(2), Stop(4, 0.0f, 0.0f, 0.0f, 1.0f) };
+  std::vector<Vehicle> vehicles = { Vehicle(0) };
+  VehicleRouter router(std::chrono::milliseconds(0));
+  auto solution = router.Solve(5, LineTimes(5), vehicles, stops);
+  CheckRoute(solution.routes.front(), { 0, 1 }, "TestTimeLimit");
+  if (solution.unassigned != std::vector<uint32_t>{ 2 }) {
+    throw runtime_error("TestTimeLimit: only the stop that fits no vehicle should be left out");
+  }
+}
+
+}
+
+int main() {
+  test::suite suite("vehicle_router");
+
+  suite.test(TEST_CASE(TestSingleVehicle));
+
+  suite.test(TEST_CASE(TestCapacity));
+
+  suite.test(TEST_CASE(TestTimeWindows));
+
+  suite.test(TEST_CASE(TestUnassigned));
+
+  suite.test(TEST_CASE(TestOpenRoute));
+
+  suite.test(TEST_CASE(TestTimeLimit));
+
+  return suite.tear_down();
+}
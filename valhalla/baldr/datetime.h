@@ -175,6 +175,13 @@ namespace DateTime {
    */
   uint32_t seconds_from_midnight(const std::string& date_time);
 
+  /**
+   * Get the number of seconds elapsed from midnight on the Sunday before.
+   * @param   date_time in the format of 2015-05-06T08:00
+   * @return  Returns the seconds from the start of the week.
+   */
+  uint32_t seconds_from_week_start(const std::string& date_time);
+
   /**
    * Add x seconds to a date_time and return a ISO date_time string.
    * @param   date_time   in the format of 01:34:15 or 2015-05-06T08:00
@@ -95,6 +95,20 @@ class DirectedEdge {
    */
   void set_laneconnectivity(const bool lc);
 
+  /**
+   * Does this directed edge have a historical speed profile?
+   * @return  Returns true if the tile has a speed profile for this edge.
+   */
+  bool speed_profile() const {
+    return speed_profile_;
+  }
+
+  /**
+   * Sets the speed profile flag.
+   * @param  profile  True if this directed edge has a speed profile.
+   */
+  void set_speed_profile(const bool profile);
+
   /**
    * Gets the length of the edge in meters.
    * @return  Returns the length in meters.
@@ -1027,7 +1041,8 @@ class DirectedEdge {
   uint64_t speed_limit_    : 8;  // Speed limit (kph)
   uint64_t named_          : 1;  // 1 if this edge has names, 0 if unnamed
   uint64_t lane_conn_      : 1;  // 1 if has lane connectivity, 0 otherwise
-  uint64_t spare_          : 10;
+  uint64_t speed_profile_  : 1;  // 1 if has a speed profile, 0 otherwise
+  uint64_t spare_          : 9;
 
   // Geometric attributes: length, weighted grade, curvature factor.
   // Turn types between edges.
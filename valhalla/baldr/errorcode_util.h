@@ -84,6 +84,7 @@ namespace baldr {
     // loki project 1xx
     {100,"Failed to parse json request"},
     {101,"Try a POST or GET request instead"},
+    {102,"Failed to parse protobuf trace"},
     {106,"Try any of"},
     {107,"Not Implemented"},
 
@@ -92,6 +93,7 @@ namespace baldr {
     {112,"Insufficiently specified required parameter 'locations' or 'sources & targets'"},
     {113,"Insufficiently specified required parameter 'contours'"},
     {114,"Insufficiently specified required parameter 'shape' or 'encoded_polyline'"},
+    {115,"Insufficiently specified required parameter 'vehicles'"},
 
     {120,"Insufficient number of locations provided"},
     {121,"Insufficient number of sources provided"},
@@ -105,6 +107,7 @@ namespace baldr {
     {131,"Failed to parse source"},
     {132,"Failed to parse target"},
     {133,"Failed to parse avoid"},
+    {134,"Failed to parse vehicle"},
     
     {140,"Action does not support multimodal costing"},
     {141,"Arrive by for multimodal not implemented yet"},
@@ -119,6 +122,7 @@ namespace baldr {
     {156,"Outside the valid walking distance between stops of a multimodal route"},
     {157,"Exceeded max avoid locations"},
     {158,"Input trace option is out of bounds"},
+    {159,"Exceeded max alternates"},
 
     {160,"Date and time required for origin for date_type of depart at"},
     {161,"Date and time required for destination for date_type of arrive by"},
@@ -3,6 +3,7 @@
 
 #include <cstdint>
 #include <valhalla/baldr/json.h>
+#include <valhalla/baldr/json_writer.h>
 #include <valhalla/midgard/gridded_data.h>
 
 #include <vector>
@@ -12,13 +13,17 @@ namespace baldr {
 namespace json {
 
 /**
- * Turn grid data contours into geojson
+ * Write grid data contours out as geojson
  *
  * @param grid_contours    the contours generated from the grid
+ * @param writer           where the geojson is written
+ * @param polygons         whether to write polygons or linestrings
  * @param colors           the #ABC123 hex string color used in geojson fill color
+ * @param id               an optional id to add to the feature collection
  */
 template <class coord_t>
-MapPtr to_geojson(const typename midgard::GriddedData<coord_t>::contours_t& grid_contours, bool polygons = true, const std::vector<std::string>& colors = {});
+void to_geojson(const typename midgard::GriddedData<coord_t>::contours_t& grid_contours, writer_t& writer, bool polygons = true,
+  const std::vector<std::string>& colors = {}, const boost::optional<std::string>& id = boost::none);
 
 }
 }
@@ -4,6 +4,8 @@
 #include <cstdint>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
+#include <memory>
 #include <mutex>
 
 #include <valhalla/baldr/graphid.h>
@@ -146,17 +148,32 @@ class SynchronizedTileCache : public TileCache {
 };
 
 /**
- * Cache that fowards copies of tiles to other instances.
+ * Cache that fowards copies of tiles to other instances in its group.
  * It is thread-safe.
  */
 class CopyForwardingTileCache final : public SynchronizedTileCache {
  public:
   /**
-  * Constructor.
+   * Caches that forward copies of tiles to each other.
+   */
+  struct group_t {
+    std::mutex mutex;
+    std::unordered_set<CopyForwardingTileCache*> members;
+  };
+
+  /**
+  * Constructor. Joins the process wide group of caches.
   * @param max_size  maximum size of the cache
   */
   CopyForwardingTileCache(size_t max_size);
 
+  /**
+  * Constructor.
+  * @param max_size  maximum size of the cache
+  * @param group     group of caches to join
+  */
+  CopyForwardingTileCache(size_t max_size, const std::shared_ptr<group_t>& group);
+
   /**
   * Destructor.
   */
@@ -171,8 +188,8 @@ class CopyForwardingTileCache final : public SynchronizedTileCache {
   const GraphTile* Put(const GraphId& graphid, const GraphTile& tile, size_t size) override;
 
  private:
-  static std::mutex mutex_;
-  static std::unordered_set<CopyForwardingTileCache*> members_;
+  // The group of caches this one forwards tiles to
+  std::shared_ptr<group_t> group_;
 };
 
 /**
@@ -186,6 +203,15 @@ class TileCacheFactory final {
    * @param pt  Property tree listing the configuration for the cahce configration
    */
   static TileCache* createTileCache(const boost::property_tree::ptree& pt);
+
+  /**
+   * Constructs a copy forwarding tile cache that shares its tiles with the
+   * other caches of a group.
+   * @param pt     Property tree listing the configuration for the cache
+   * @param group  Group of caches to join
+   */
+  static TileCache* createTileCache(const boost::property_tree::ptree& pt,
+      const std::shared_ptr<CopyForwardingTileCache::group_t>& group);
 };
 
 /**
@@ -200,6 +226,13 @@ class GraphReader {
    */
   GraphReader(const boost::property_tree::ptree& pt);
 
+  /**
+   * Constructor using tiles as separate files and the given tile cache.
+   * @param pt     Property tree listing the configuration for the tile storage.
+   * @param cache  Tile cache to use instead of the configured one.
+   */
+  GraphReader(const boost::property_tree::ptree& pt, std::unique_ptr<TileCache>&& cache);
+
   /**
    * Test if tile exists
    * @param  graphid  GraphId of the tile to test (tile id and level).
@@ -8,6 +8,7 @@
 #include <valhalla/baldr/complexrestriction.h>
 #include <valhalla/baldr/directededge.h>
 #include <valhalla/baldr/edge_elevation.h>
+#include <valhalla/baldr/speedprofile.h>
 #include <valhalla/baldr/laneconnectivity.h>
 #include <valhalla/baldr/nodeinfo.h>
 #include <valhalla/baldr/trafficassociation.h>
@@ -401,6 +402,23 @@ class GraphTile {
     }
   }
 
+  /**
+   * Get the historical speed profile for a directed edge.
+   * @param  idx  Index of the directed edge within the tile.
+   * @return  Returns a pointer to the speed profile for the edge.
+   *          Returns nullptr if the edge has no speed profile.
+   */
+  const SpeedProfile* speed_profile(const uint32_t idx) const;
+
+  /**
+   * Get the speed along a directed edge at a time of the week. Uses the
+   * historical speed profile of the edge if it has one.
+   * @param  de               Directed edge within this tile.
+   * @param  seconds_of_week  Seconds since midnight Sunday local time.
+   * @return  Returns the speed in kph.
+   */
+  uint32_t GetSpeed(const DirectedEdge* de, const uint32_t seconds_of_week) const;
+
  protected:
 
   // Graph tile memory, this must be shared so that we can put it into cache
@@ -492,6 +510,12 @@ class GraphTile {
   // Edge elevation data
   EdgeElevation* edge_elevation_;
 
+  // Historical speed profiles, sorted by directed edge index
+  SpeedProfile* speed_profiles_;
+
+  // Number of speed profiles
+  std::size_t speed_profile_count_;
+
   // Map of stop one stops in this tile.
   std::unordered_map<std::string, tile_index_pair> stop_one_stops;
 
@@ -0,0 +1,178 @@
+#ifndef VALHALLA_BALDR_JSON_WRITER_H_
+#define VALHALLA_BALDR_JSON_WRITER_H_
+
+#include <cstdio>
+#include <cstring>
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+
+#include <valhalla/baldr/json.h>
+#include <valhalla/baldr/rapidjson_utils.h>
+
+namespace valhalla {
+namespace baldr {
+namespace json {
+
+/**
+ * Writes json straight into a buffer as the values are visited rather than
+ * building up a tree of maps and arrays and printing that afterwards. Keep one
+ * around and clear it between responses so the buffer's memory is reused.
+ *
+ * Values come out byte for byte the way the ostream operators of the tree
+ * print them, escaping included. Members of an object come out in the order
+ * they are written, where the tree printed them in the order of its hash map.
+ *
+ * Values are written with operator(), members with operator()(key, value):
+ *
+ *   writer.start_object();
+ *   writer("units", std::string("km"));
+ *   writer.start_array("locations");
+ *   writer(json::fp_t{40.7, 6});
+ *   writer.end_array();
+ *   writer.end_object();
+ */
+class writer_t {
+ public:
+  //a buffer that grew past this is given back when we clear
+  static constexpr size_t kMaxRetained = 1024 * 1024;
+
+  writer_t() : writer(buffer) { }
+
+  /**
+   * Start over, keeping the memory from before unless there was a lot of it
+   */
+  void clear() {
+    bool shrink = buffer.GetSize() > kMaxRetained;
+    buffer.Clear();
+    if(shrink)
+      buffer.ShrinkToFit();
+    writer.Reset(buffer);
+  }
+
+  /**
+   * Writes text as is, for wrapping the json in a jsonp callback
+   */
+  void raw(const std::string& text) {
+    for(auto c : text)
+      buffer.Put(c);
+  }
+
+  /**
+   * @return a copy of what was written so far
+   */
+  std::string str() const {
+    return std::string(buffer.GetString(), buffer.GetSize());
+  }
+
+  void start_object() { writer.StartObject(); }
+  void start_object(const char* key) { writer.Key(key); writer.StartObject(); }
+  void end_object() { writer.EndObject(); }
+  void start_array() { writer.StartArray(); }
+  void start_array(const char* key) { writer.Key(key); writer.StartArray(); }
+  void end_array() { writer.EndArray(); }
+
+  void operator()(const std::string& value) { string(value.data(), value.size()); }
+  void operator()(const char* value) { string(value, std::strlen(value)); }
+  void operator()(bool value) { writer.Bool(value); }
+  void operator()(std::nullptr_t) { writer.Null(); }
+  void operator()(const fp_t& value) {
+    //same fixed precision formatting that the ostream operator gives
+    char number[64];
+    auto length = std::snprintf(number, sizeof(number), "%.*Lf", static_cast<int>(value.precision), value.value);
+    writer.RawValue(number, std::min<size_t>(length, sizeof(number) - 1), rapidjson::kNumberType);
+  }
+  //a bare double would otherwise quietly become a bool, say how many digits you want with an fp_t
+  template <class T>
+  typename std::enable_if<std::is_floating_point<T>::value>::type operator()(T value) = delete;
+  template <class T>
+  typename std::enable_if<std::is_integral<T>::value && std::is_signed<T>::value>::type operator()(T value) {
+    writer.Int64(value);
+  }
+  template <class T>
+  typename std::enable_if<std::is_integral<T>::value && std::is_unsigned<T>::value && !std::is_same<T, bool>::value>::type operator()(T value) {
+    writer.Uint64(value);
+  }
+  //for the bits that still come as a tree, like the verbose graph objects
+  void operator()(const MapPtr& value) {
+    writer.StartObject();
+    for(const auto& member : *value) {
+      writer.Key(member.first.c_str(), member.first.size());
+      boost::apply_visitor(visitor_t{*this}, member.second);
+    }
+    writer.EndObject();
+  }
+  void operator()(const Value& value) {
+    boost::apply_visitor(visitor_t{*this}, value);
+  }
+  void operator()(const ArrayPtr& value) {
+    writer.StartArray();
+    for(const auto& element : *value)
+      boost::apply_visitor(visitor_t{*this}, element);
+    writer.EndArray();
+  }
+
+  template <class T>
+  void operator()(const char* key, const T& value) {
+    writer.Key(key);
+    (*this)(value);
+  }
+  template <class T>
+  void operator()(const std::string& key, const T& value) {
+    writer.Key(key.c_str(), key.size());
+    (*this)(value);
+  }
+
+ protected:
+  //rapidjson escapes everything the tree does except '/' so only strings
+  //with one in them are escaped here
+  void string(const char* value, size_t length) {
+    if(std::find(value, value + length, '/') == value + length) {
+      writer.String(value, length);
+      return;
+    }
+    static const char hex[] = "0123456789ABCDEF";
+    escaped.assign(1, '"');
+    for(const auto* c = value; c < value + length; ++c) {
+      switch(*c) {
+        case '\\': escaped.append("\\\\"); break;
+        case '"': escaped.append("\\\""); break;
+        case '/': escaped.append("\\/"); break;
+        case '\b': escaped.append("\\b"); break;
+        case '\f': escaped.append("\\f"); break;
+        case '\n': escaped.append("\\n"); break;
+        case '\r': escaped.append("\\r"); break;
+        case '\t': escaped.append("\\t"); break;
+        default:
+          if(*c >= 0 && *c < 32) {
+            escaped.append("\\u00");
+            escaped.push_back(hex[*c >> 4]);
+            escaped.push_back(hex[*c & 15]);
+          }
+          else
+            escaped.push_back(*c);
+          break;
+      }
+    }
+    escaped.push_back('"');
+    writer.RawValue(escaped.data(), escaped.size(), rapidjson::kStringType);
+  }
+
+  struct visitor_t : public boost::static_visitor<> {
+    writer_t& writer;
+    visitor_t(writer_t& writer) : writer(writer) { }
+    template <class T>
+    void operator()(const T& value) const { writer(value); }
+  };
+
+  rapidjson::StringBuffer buffer;
+  rapidjson::Writer<rapidjson::StringBuffer> writer;
+  std::string escaped;
+};
+
+}
+}
+}
+
+#endif //VALHALLA_BALDR_JSON_WRITER_H_
@@ -77,6 +77,12 @@ struct PathLocation : public Location {
    * @return PathLocation
    */
   static PathLocation FromPtree(const std::vector<Location>& locations, const boost::property_tree::ptree& path_location);
+
+  /**
+   * Serializes one of these objects from rapidjson and a list of locations
+   * @return PathLocation
+   */
+  static PathLocation FromRapidJson(const std::vector<Location>& locations, const rapidjson::Value& path_location);
 };
 
 }
@@ -6,6 +6,7 @@
 
 #include <boost/optional.hpp>
 #include <boost/lexical_cast.hpp>
+#include <boost/property_tree/ptree.hpp>
 
 //rapidjson loves to assert and crash programs, its more useful to throw and catch
 #define RAPIDJSON_ASSERT(x) if (!(x)) throw std::logic_error(RAPIDJSON_STRINGIFY(x))
@@ -28,6 +29,49 @@ inline std::string to_string(const T& document_or_value) {
   return std::string(buffer.GetString(), buffer.GetSize());
 }
 
+//gives the same tree that read_json would give for the serialized value but
+//without writing it out and parsing it back in. like read_json every value
+//ends up as a string and array elements are children with empty keys
+inline void to_ptree(const rapidjson::Value& value, boost::property_tree::ptree& tree) {
+  switch(value.GetType()) {
+    case rapidjson::kObjectType:
+      for(auto member = value.MemberBegin(); member != value.MemberEnd(); ++member) {
+        auto child = tree.push_back(std::make_pair(std::string(member->name.GetString(),
+          member->name.GetStringLength()), boost::property_tree::ptree()));
+        to_ptree(member->value, child->second);
+      }
+      break;
+    case rapidjson::kArrayType:
+      for(auto element = value.Begin(); element != value.End(); ++element) {
+        auto child = tree.push_back(std::make_pair(std::string(), boost::property_tree::ptree()));
+        to_ptree(*element, child->second);
+      }
+      break;
+    case rapidjson::kStringType:
+      tree.data().assign(value.GetString(), value.GetStringLength());
+      break;
+    case rapidjson::kNullType:
+      tree.data() = "null";
+      break;
+    case rapidjson::kTrueType:
+      tree.data() = "true";
+      break;
+    case rapidjson::kFalseType:
+      tree.data() = "false";
+      break;
+    //write numbers exactly as they would have been serialized
+    case rapidjson::kNumberType:
+      tree.data() = to_string(value);
+      break;
+  }
+}
+
+inline boost::property_tree::ptree to_ptree(const rapidjson::Value& value) {
+  boost::property_tree::ptree tree;
+  to_ptree(value, tree);
+  return tree;
+}
+
 }
 
 namespace valhalla{
@@ -86,6 +130,15 @@ inline T GetFromRapidJson(V&& v, const char* source, const T& t){
   return t;
 }
 
+//for when the value is required, throws if its missing or cant be converted
+template<typename T, typename V>
+inline T GetFromRapidJson(V&& v, const char* source){
+  auto value = GetOptionalFromRapidJson<T>(v, source);
+  if(!value)
+    throw std::runtime_error(std::string("Missing or invalid value for ") + source);
+  return *value;
+}
+
 }
 
 #endif /* VALHALLA_BALDR_RAPIDJSON_UTILS_H_ */
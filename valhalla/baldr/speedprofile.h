@@ -0,0 +1,78 @@
+#ifndef VALHALLA_BALDR_SPEEDPROFILE_H_
+#define VALHALLA_BALDR_SPEEDPROFILE_H_
+
+#include <cstdint>
+#include <vector>
+
+namespace valhalla {
+namespace baldr {
+
+// Speed profiles hold the average speed for each hour of the week, starting
+// at midnight on Sunday local time.
+constexpr uint32_t kSpeedBucketSeconds = 3600;
+constexpr uint32_t kSpeedBucketCount = 7 * 24;
+constexpr uint32_t kSecondsPerWeek = kSpeedBucketCount * kSpeedBucketSeconds;
+
+/**
+ * Historical speeds over the week for a directed edge. Used to estimate
+ * the speed along an edge at a given time of the week without a live
+ * traffic feed.
+ */
+class SpeedProfile {
+ public:
+  /**
+   * Constructor with arguments.
+   * @param  edgeindex  Directed edge index within the tile.
+   * @param  speeds     Speed (kph) for each hour of the week. Speeds above
+   *                    the maximum stored speed are clamped.
+   */
+  SpeedProfile(const uint32_t edgeindex, const std::vector<uint32_t>& speeds);
+
+  /**
+   * Get the internal edge index to which this speed profile applies.
+   * @return  Returns the directed edge index within the tile.
+   */
+  uint32_t edgeindex() const;
+
+  /**
+   * Set the directed edge index to which this speed profile applies.
+   * @param edgeindex   Edge index.
+   */
+  void set_edgeindex(const uint32_t edgeindex);
+
+  /**
+   * Get the average speed for an hour of the week.
+   * @param  bucket  Hour of the week (0 is the hour after midnight Sunday).
+   * @return  Returns the speed in kph.
+   */
+  uint32_t bucket_speed(const uint32_t bucket) const;
+
+  /**
+   * Get the speed at a time of the week. Interpolates between the
+   * averages of the hours on either side of the time so that the speed
+   * does not jump at the top of the hour.
+   * @param  seconds_of_week  Seconds since midnight Sunday local time.
+   * @return  Returns the speed in kph.
+   */
+  uint32_t speed(const uint32_t seconds_of_week) const;
+
+  /**
+   * operator < - for sorting. Sort by edge index.
+   * @param  other  Other speed profile to compare to.
+   * @return  Returns true if edgeindex < other edgeindex.
+   */
+  bool operator < (const SpeedProfile& other) const;
+
+ protected:
+  uint32_t edgeindex_ : 22;  // Directed edge index. Max index is:
+                             // kMaxTileEdgeCount in nodeinfo.h: 22 bits.
+  uint32_t spare_     : 10;
+
+  uint8_t speeds_[kSpeedBucketCount];  // Speed (kph) for each hour of the week
+  uint8_t spare2_[4];                  // Keeps the size a multiple of 8 bytes
+};
+
+}
+}
+
+#endif  // VALHALLA_BALDR_SPEEDPROFILE_H_
@@ -16,6 +16,8 @@
 #include <valhalla/baldr/errorcode_util.h>
 #include <valhalla/sif/costfactory.h>
 #include <valhalla/baldr/rapidjson_utils.h>
+#include <valhalla/baldr/json_writer.h>
+#include <valhalla/proto/trace.pb.h>
 
 namespace valhalla {
   namespace loki {
@@ -24,11 +26,24 @@ namespace valhalla {
     class loki_worker_t {
      public:
       enum ACTION_TYPE {ROUTE = 0, VIAROUTE = 1, LOCATE = 2, ONE_TO_MANY = 3, MANY_TO_ONE = 4, MANY_TO_MANY = 5,
-                        SOURCES_TO_TARGETS = 6, OPTIMIZED_ROUTE = 7, ISOCHRONE = 8, TRACE_ROUTE = 9, TRACE_ATTRIBUTES = 10};
+                        SOURCES_TO_TARGETS = 6, OPTIMIZED_ROUTE = 7, ISOCHRONE = 8, TRACE_ROUTE = 9, TRACE_ATTRIBUTES = 10,
+                        OPTIMIZED_FLEET = 11};
       loki_worker_t(const boost::property_tree::ptree& config);
       prime_server::worker_t::result_t work(const std::list<zmq::message_t>& job, void* request_info, const prime_server::worker_t::interrupt_function_t&);
       void cleanup();
 
+      /**
+       * Does loki's part of the request without serializing anything for the next stage.
+       * Throws valhalla_exception_t on failure.
+       * @param request        the http request to act on
+       * @param request_info   info about the request, do not track is set here
+       * @param request_rj     filled with the parsed request annotated with correlated locations for thor
+       * @param request_trace  filled with the binary trace for the trace actions
+       * @return the json response when loki answers the request itself (locate) otherwise none
+       */
+      boost::optional<std::string> act(const prime_server::http_request_t& request, prime_server::http_request_info_t& request_info,
+        rapidjson::Document& request_rj, odin::Trace& request_trace);
+
      protected:
 
       prime_server::worker_t::result_t jsonify_error(const baldr::valhalla_exception_t& exception, prime_server::http_request_info_t& request_info) const;
@@ -44,18 +59,20 @@ namespace valhalla {
       void init_isochrones(rapidjson::Document& request);
       void init_trace(rapidjson::Document& request);
 
-      prime_server::worker_t::result_t locate(rapidjson::Document& request, prime_server::http_request_info_t& request_info);
-      prime_server::worker_t::result_t route(rapidjson::Document& request, prime_server::http_request_info_t& request_info);
-      prime_server::worker_t::result_t matrix(ACTION_TYPE action,rapidjson::Document& request, prime_server::http_request_info_t& request_info);
-      prime_server::worker_t::result_t isochrones(rapidjson::Document& request, prime_server::http_request_info_t& request_info);
-      prime_server::worker_t::result_t trace_route(ACTION_TYPE action,rapidjson::Document& request, prime_server::http_request_info_t& request_info);
+      std::string locate(rapidjson::Document& request);
+      void route(rapidjson::Document& request);
+      void matrix(ACTION_TYPE action,rapidjson::Document& request);
+      void isochrones(rapidjson::Document& request);
+      void trace_route(ACTION_TYPE action,rapidjson::Document& request);
 
       boost::property_tree::ptree config;
       boost::optional<std::string> jsonp;
+      baldr::json::writer_t writer;
       std::vector<baldr::Location> locations;
       std::vector<baldr::Location> sources;
       std::vector<baldr::Location> targets;
       std::vector<midgard::PointLL> shape;
+      odin::Trace trace;
       sif::CostFactory<sif::DynamicCost> factory;
       sif::EdgeFilter edge_filter;
       sif::NodeFilter node_filter;
@@ -70,6 +87,7 @@ namespace valhalla {
       unsigned int default_reachability;
       unsigned long max_radius;
       unsigned long default_radius;
+      unsigned int max_alternates;
       float long_request;
       // Minimum and maximum walking distances (to validate input).
       size_t min_transit_walking_dis;
@@ -6,6 +6,7 @@
 #include <vector>
 #include <list>
 #include <sstream>
+#include <unordered_map>
 #include <boost/property_tree/ptree.hpp>
 
 #include "baldr/graphreader.h"
@@ -37,6 +38,27 @@ struct traffic_segment_t {
   bool internal;               // Is the set of edges making up this segment internal edge types
 };
 
+// Everything the matcher needs to know about the edges and nodes of one tile
+// flattened into arrays so that repeated lookups don't go back to the graph
+struct tile_associations_t {
+  struct edge_t {
+    baldr::GraphId begin_node;   // node the edge leaves from
+    baldr::GraphId end_node;     // node the edge arrives at
+    float length;                // length of the edge in meters
+    bool internal;               // can the edge be ignored for the purposes of ots's
+    uint32_t segments_begin;     // range of this edges ots's within segments
+    uint32_t segments_end;
+  };
+  struct node_t {
+    uint32_t transitions_begin;  // range of nodes reachable by transition edges
+    uint32_t transitions_end;
+  };
+  std::vector<edge_t> edges;                    // indexed by the edge id within the tile
+  std::vector<node_t> nodes;                    // indexed by the node id within the tile
+  std::vector<baldr::TrafficSegment> segments;
+  std::vector<baldr::GraphId> transitions;
+};
+
 /**
  * Traffic segment matcher. Allows matching GPS traces to Valhalla edges and
  * then forms the traffic segments associated to those edges.
@@ -64,6 +86,15 @@ class TrafficSegmentMatcher {
    */
   virtual std::string match(const std::string& json);
 
+  /**
+   * Matches many GPS traces at once reusing the same map matcher, graph tiles
+   * and cached segment associations for all of them.
+   * @param   jsons  GPS traces as JSON.
+   * @return  Returns the traffic segments for each trace in the same order as
+   *          the input.
+   */
+  virtual std::vector<std::string> match(const std::vector<std::string>& jsons);
+
   /**
    * Parses the input to the traffic matcher, mainly the trace array
    * @param  json string of gps data {"trace":[{"lat":0,"lon":0,time:0},...]}
@@ -103,7 +134,51 @@ class TrafficSegmentMatcher {
   virtual std::vector<traffic_segment_t> form_segments(const std::list<std::vector<interpolation_t> >& interpolations,
     baldr::GraphReader& reader) const;
 
+  /**
+   * Creates a matcher for matching traces to the graph.
+   * @return the matcher along with the default accuracy and search radius
+   */
+  std::shared_ptr<MapMatcher> create_matcher(float& default_accuracy, float& default_search_radius);
+
+  /**
+   * Matches a single trace with the provided matcher
+   * @param  the matcher to use
+   * @param  the json trace
+   * @param  the default gps accuracy for trace points that don't specify one
+   * @param  the default search radius
+   * @return the traffic segments as json
+   */
+  std::string match(const std::shared_ptr<MapMatcher>& matcher, const std::string& json,
+    float default_accuracy, float default_search_radius);
+
+  /**
+   * Gets the flattened associations for the tile containing the given edge or node,
+   * building and caching them the first time they are asked for
+   * @param  the edge or node id
+   * @param  the graph reader with which we can get the tile if its not cached
+   * @return the associations for the tile or nullptr if the tile isn't available
+   */
+  const tile_associations_t* associations(const baldr::GraphId& id, baldr::GraphReader& reader) const;
+
+  /**
+   * Is edge b reachable directly from the end of edge a, ignoring transitions
+   * @param  the first edge
+   * @param  the second edge
+   * @param  the graph reader with which we can get the tiles if they arent cached
+   * @return true if they are connected
+   */
+  bool is_connected(const baldr::GraphId& a, const baldr::GraphId& b, baldr::GraphReader& reader) const;
+
+  /**
+   * Drops the cached associations if the graph reader is over its memory limit
+   */
+  void trim_cache();
+
   valhalla::meili::MapMatcherFactory matcher_factory;
+
+  // Segment associations per tile, keyed by the tile base id. Lookups fill this in
+  // as they go which is why its mutable
+  mutable std::unordered_map<uint64_t, tile_associations_t> association_cache;
 };
 
 }
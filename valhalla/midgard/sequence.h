@@ -19,6 +19,10 @@
 #include <cstring>
 #include <cstdint>
 #include <cstdlib>
+#include <cstdio>
+#include <queue>
+#include <future>
+#include <thread>
 #include <cerrno>
 #include <stdexcept>
 #include <iostream>
@@ -172,16 +176,68 @@ class sequence {
     return npos;
   }
 
-  //sort the file based on the predicate
-  void sort(const std::function<bool (const T&, const T&)>& predicate, size_t buffer_size = 1024 * 1024 * 512 / sizeof(T)) {
-    using queue_t = std::map<T, std::list<std::fstream>::iterator, std::function<bool (const T&, const T&)> >;
-
+  //sort the file based on the predicate. runs of at most buffer_size elements are copied
+  //into memory and sorted there across threads. if there is more than one run they are
+  //spilled to a temporary file and then k-way merged back so that all io is sequential
+  void sort(const std::function<bool (const T&, const T&)>& predicate, size_t buffer_size = 1024 * 1024 * 512 / sizeof(T),
+            size_t threads = std::thread::hardware_concurrency()) {
     flush();
     //if no elements we are done
     if(memmap.size() == 0)
       return;
-    std::sort(static_cast<T*>(memmap), static_cast<T*>(memmap) + memmap.size(), predicate);
-    return;
+    buffer_size = std::max(buffer_size, static_cast<size_t>(1));
+    threads = std::max(threads, static_cast<size_t>(1));
+
+    //its small enough to sort in memory in one go
+    T* data = memmap;
+    std::vector<T> run;
+    run.reserve(std::min(buffer_size, memmap.size()));
+    if(memmap.size() <= buffer_size) {
+      run.assign(data, data + memmap.size());
+      sort_run(run, predicate, threads);
+      std::copy(run.cbegin(), run.cend(), data);
+      return;
+    }
+
+    //sort each run and write it to the temporary file
+    std::string runs_file_name = file_name + ".runs";
+    std::vector<std::pair<size_t, size_t> > runs;
+    {
+      std::ofstream runs_file(runs_file_name, std::ios_base::binary | std::ios_base::trunc);
+      if(!runs_file)
+        throw std::runtime_error(runs_file_name + ": " + strerror(errno));
+      for(size_t start = 0; start < memmap.size(); start += buffer_size) {
+        size_t end = std::min(start + buffer_size, memmap.size());
+        run.assign(data + start, data + end);
+        sort_run(run, predicate, threads);
+        runs_file.write(static_cast<const char*>(static_cast<const void*>(run.data())), run.size() * sizeof(T));
+        if(!runs_file)
+          throw std::runtime_error(runs_file_name + "(write): " + strerror(errno));
+        runs.emplace_back(start, end);
+      }
+    }
+    run.clear();
+    run.shrink_to_fit();
+
+    //merge the runs back into our file, smallest of the heads first
+    {
+      mem_map<T> runs_map(runs_file_name, memmap.size());
+      const T* sorted = runs_map;
+      using head_t = std::pair<T, size_t>;
+      auto greater = [&predicate](const head_t& a, const head_t& b) { return predicate(b.first, a.first); };
+      std::priority_queue<head_t, std::vector<head_t>, decltype(greater)> heads(greater);
+      for(size_t i = 0; i < runs.size(); ++i)
+        heads.emplace(sorted[runs[i].first++], i);
+      for(size_t i = 0; !heads.empty(); ++i) {
+        auto head = heads.top();
+        heads.pop();
+        data[i] = head.first;
+        auto& next = runs[head.second];
+        if(next.first < next.second)
+          heads.emplace(sorted[next.first++], head.second);
+      }
+    }
+    std::remove(runs_file_name.c_str());
   }
 
   //perform an volatile operation on all the items of this sequence
@@ -357,6 +413,33 @@ class sequence {
 
  protected:
 
+  //sorts a run in memory by sorting a slice of it per thread and then merging neighbouring
+  //slices in parallel until there is only one left
+  static void sort_run(std::vector<T>& run, const std::function<bool (const T&, const T&)>& predicate, size_t threads) {
+    if(threads == 1) {
+      std::sort(run.begin(), run.end(), predicate);
+      return;
+    }
+    size_t slice = std::max(static_cast<size_t>(1), (run.size() + threads - 1) / threads);
+    std::list<std::future<void> > results;
+    for(size_t start = 0; start < run.size(); start += slice) {
+      auto first = run.begin() + start, last = run.begin() + std::min(start + slice, run.size());
+      results.emplace_back(std::async(std::launch::async, [first, last, &predicate]() { std::sort(first, last, predicate); }));
+    }
+    for(auto& result : results)
+      result.get();
+
+    for(; slice < run.size(); slice *= 2) {
+      results.clear();
+      for(size_t start = 0; start + slice < run.size(); start += slice * 2) {
+        auto first = run.begin() + start, middle = first + slice, last = run.begin() + std::min(start + slice * 2, run.size());
+        results.emplace_back(std::async(std::launch::async, [first, middle, last, &predicate]() { std::inplace_merge(first, middle, last, predicate); }));
+      }
+      for(auto& result : results)
+        result.get();
+    }
+  }
+
   std::shared_ptr<std::fstream> file;
   std::string file_name;
   std::vector<T> write_buffer;
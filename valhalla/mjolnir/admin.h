@@ -10,9 +10,12 @@
 #include <boost/geometry/geometries/polygon.hpp>
 #include <boost/geometry/multi/geometries/multi_polygon.hpp>
 #include <boost/geometry/io/wkt/wkt.hpp>
+#include <boost/geometry/index/rtree.hpp>
 #include <sqlite3.h>
 #include <spatialite.h>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "mjolnir/graphtilebuilder.h"
 
@@ -26,6 +29,65 @@ namespace mjolnir {
 typedef boost::geometry::model::d2::point_xy<double> point_type;
 typedef boost::geometry::model::polygon<point_type> polygon_type;
 typedef boost::geometry::model::multi_polygon<polygon_type> multi_polygon_type;
+typedef boost::geometry::model::box<point_type> box_type;
+
+// Polygons found for a tile along with their admin or time zone index
+typedef std::vector<std::pair<uint32_t, const multi_polygon_type*> > tile_polygons_type;
+
+/**
+ * Admin or time zone polygons kept in memory with a packed r-tree over
+ * their bounding boxes. Nothing changes once the polygons are packed so
+ * the tile building threads can share one index instead of each of them
+ * querying sqlite and parsing the polygons again for every tile.
+ */
+class PolygonIndex {
+ public:
+  /**
+   * Add a polygon. Pack must be called after the last one is added.
+   * @param  id       admin or time zone index of the polygon
+   * @param  polygon  the polygon
+   */
+  void Add(const uint32_t id, multi_polygon_type&& polygon);
+
+  /**
+   * Build the r-tree over all of the polygons in one go.
+   */
+  void Pack();
+
+  /**
+   * Get the polygons that intersect a bounding box.
+   * @param  aabb  the box
+   * @return the polygons in the order they were added
+   */
+  tile_polygons_type Intersecting(const AABB2<PointLL>& aabb) const;
+
+  /**
+   * @return the number of polygons
+   */
+  size_t size() const;
+
+ private:
+  typedef std::pair<box_type, size_t> value_type;
+  std::vector<std::pair<uint32_t, multi_polygon_type> > polygons_;
+  boost::geometry::index::rtree<value_type, boost::geometry::index::quadratic<16> > rtree_;
+};
+
+// Names and codes of an admin area
+struct AdminArea {
+  std::string country_name;
+  std::string state_name;
+  std::string country_iso;
+  std::string state_iso;
+  bool drive_on_right;
+};
+
+// All of the admin areas, the states (admin level 4) and the countries
+// (admin level 2) are indexed separately. Polygon ids index into admins
+struct AdminIndex {
+  std::vector<AdminArea> admins;
+  PolygonIndex states;
+  PolygonIndex countries;
+};
 
 /**
  * Get the dbhandle of a sqlite db.  Used for timezones and admins DBs.
@@ -41,6 +103,45 @@ sqlite3 * GetDBHandle(const std::string& database);
 uint32_t GetMultiPolyId(const std::unordered_map<uint32_t,multi_polygon_type>& polys,
                         const PointLL& ll);
 
+/**
+ * Get the polygon index.  Used by tz and admin areas.  Checks if the pointLL is covered_by the poly.
+ * @param  polys   polys found for a tile.
+ * @param  ll      point that needs to be checked.
+ */
+uint32_t GetMultiPolyId(const tile_polygons_type& polys, const PointLL& ll);
+
+/**
+ * Read all of the timezone polys from the db into an index
+ * @param  db_handle    sqlite3 db handle
+ */
+PolygonIndex LoadTimeZones(sqlite3 *db_handle);
+
+/**
+ * Get the timezone polys that intersect with the tile bounding box.
+ * @param  index        timezone polys loaded with LoadTimeZones
+ * @param  aabb         bb of the tile
+ */
+tile_polygons_type GetTimeZones(const PolygonIndex& index, const AABB2<PointLL>& aabb);
+
+/**
+ * Read all of the state and country polys from the db into an index
+ * @param  db_handle    sqlite3 db handle
+ */
+AdminIndex LoadAdmins(sqlite3 *db_handle);
+
+/**
+ * Get the admin polys that intersect with the tile bounding box. Like the
+ * db query these are the states if any intersect, otherwise the countries.
+ * @param  index            admin polys loaded with LoadAdmins
+ * @param  drive_on_right   unordered map that indicates if a country drives on right side of the road
+ * @param  aabb             bb of the tile
+ * @param  tilebuilder      Graph tile builder
+ */
+tile_polygons_type GetAdminInfo(const AdminIndex& index,
+                                std::unordered_map<uint32_t, bool>& drive_on_right,
+                                const AABB2<PointLL>& aabb,
+                                GraphTileBuilder& tilebuilder);
+
 /**
  * Get the timezone polys from the db
  * @param  db_handle    sqlite3 db handle
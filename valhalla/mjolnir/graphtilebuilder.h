@@ -135,6 +135,14 @@ class GraphTileBuilder : public baldr::GraphTile {
    * @param  lc  Lane connectivity information.
    */
   void AddLaneConnectivity(const std::vector<baldr::LaneConnectivity>& lc);
+
+  /**
+   * Add a historical speed profile for a directed edge. Replaces the
+   * profile the edge already has and sets the speed profile flag on it.
+   * @param  profile  Speed profile, including the directed edge index.
+   */
+  void AddSpeedProfile(const baldr::SpeedProfile& profile);
+
   /**
    * Update all of the complex restrictions.
    * @param  complex_restriction_builder  list of complex restrictions.
@@ -489,6 +497,9 @@ class GraphTileBuilder : public baldr::GraphTile {
   // List of edge elevation records. Index with directed edge Id.
   std::vector<EdgeElevation> edge_elevation_builder_;
 
+  // List of speed profiles.
+  std::vector<SpeedProfile> speed_profile_builder_;
+
   // lane connectivity list offset
   uint32_t lane_connectivity_offset_ = 0;
 };
@@ -10,8 +10,15 @@ namespace mjolnir {
 
 /**
  * A method for marking OSM Ids that are used by ways/nodes/relations.
- * Uses a vector where 1 bit is used for each possible Id.
- * So for a maximum OSM Id of 4 billion this uses 500MB memory
+ * The Ids are split into chunks of 65536 by their upper bits. A chunk only
+ * takes memory once one of its Ids is set and keeps the lower 16 bits of
+ * its Ids in a sorted array while it is sparse. Past 4096 Ids the array
+ * would be larger than a bitset over the chunk (8KB) so it becomes one.
+ * This never takes more memory than 1 bit per possible Id and far less
+ * when the Ids are sparse.
+ *
+ * Each set Id also has a rank, the number of set Ids smaller than it, so
+ * the set Ids can be numbered densely from 0 and used to index arrays.
  */
 class IdTable {
  public:
@@ -39,9 +46,42 @@ class IdTable {
    */
   const bool IsUsed(const uint64_t id) const;
 
+  /**
+   * Number of set OSM Ids smaller than the given one. For a set Id this is
+   * its index among all of the set Ids. The ranks are worked out again on
+   * the first call after an Id was set, so set all the Ids before sharing
+   * the table with threads that ask for ranks.
+   * @param  id  OSM Id
+   * @return the number of set OSM Ids less than id
+   */
+  uint64_t rank(const uint64_t id) const;
+
+  /**
+   * @return the number of OSM Ids that are set
+   */
+  uint64_t size() const;
+
+  /**
+   * @return the number of bytes used to hold the Ids
+   */
+  size_t memory() const;
+
  private:
+  // Ids sharing their upper bits
+  struct Chunk {
+    std::vector<uint16_t> ids;          // sorted lower bits while sparse
+    std::vector<uint64_t> bits;         // bitset over the lower bits once dense
+    mutable std::vector<uint16_t> block_ranks; // set bits before each block of the bitset
+  };
+
+  void UpdateRanks() const;
+
   const uint64_t maxosmid_;
-  std::vector<uint64_t> bitmarkers_;
+  std::vector<uint32_t> chunk_index_;   // 1 based index into chunks_, 0 if none
+  std::vector<Chunk> chunks_;
+  uint64_t count_;
+  mutable std::vector<uint64_t> chunk_ranks_; // set Ids in the chunks before each one
+  mutable bool ranked_;
 };
 }
 }
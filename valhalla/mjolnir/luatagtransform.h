@@ -8,18 +8,17 @@ extern "C" {
 }
 
 #include <valhalla/mjolnir/osmdata.h>
+#include <valhalla/mjolnir/tagtransform.h>
 
 #include <string>
-#include <unordered_map>
 
 namespace valhalla {
 namespace mjolnir {
 
-using Tags = std::unordered_map<std::string, std::string>;
-
 /**
+ * Transforms tags by calling the functions of a lua script.
  */
-class LuaTagTransform {
+class LuaTagTransform : public TagTransform {
  public:
 
   /**
@@ -30,7 +29,7 @@ class LuaTagTransform {
 
   ~LuaTagTransform();
 
-  Tags Transform(OSMType type, const Tags &tags);
+  Tags Transform(OSMType type, const Tags &tags) override;
 
  protected:
 
@@ -0,0 +1,82 @@
+#ifndef VALHALLA_MJOLNIR_NATIVETAGTRANSFORM_H
+#define VALHALLA_MJOLNIR_NATIVETAGTRANSFORM_H
+
+#include <valhalla/mjolnir/osmdata.h>
+#include <valhalla/mjolnir/tagtransform.h>
+
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace valhalla {
+namespace mjolnir {
+
+/**
+ * Transforms tags the same way the functions of lua/graph.lua do but without
+ * calling into lua. The lookup tables (highway, access, foot etc.) are read
+ * out of the lua script once so changes to them carry over, the functions of
+ * the script are not used.
+ */
+class NativeTagTransform : public TagTransform {
+ public:
+
+  /**
+   * Constructor
+   * @param lua   the string containing the lua code to read the tables from
+   */
+  NativeTagTransform(const std::string& lua);
+
+  Tags Transform(OSMType type, const Tags &tags) override;
+
+ protected:
+
+  using Table = std::unordered_map<std::string, std::string>;
+  using NumberTable = std::unordered_map<std::string, double>;
+
+  // Each returns true if the object should be filtered out
+  bool FilterNode(Tags& kv) const;
+  bool FilterWay(Tags& kv) const;
+  bool FilterRelation(Tags& kv) const;
+
+  // Tables of the lua script
+  std::unordered_map<std::string, std::vector<std::pair<std::string, std::string> > > highway_;
+  NumberTable road_class_;
+  NumberTable restriction_;
+  NumberTable dow_;
+  NumberTable default_speed_;
+  Table access_;
+  Table private_;
+  Table no_thru_traffic_;
+  NumberTable use_;
+  Table motor_vehicle_;
+  Table foot_;
+  Table wheelchair_;
+  Table bus_;
+  Table psv_;
+  Table truck_;
+  Table hazmat_;
+  Table bicycle_;
+  Table cycleway_;
+  Table bike_reverse_;
+  Table bus_reverse_;
+  NumberTable shared_;
+  NumberTable dedicated_;
+  NumberTable separated_;
+  Table oneway_;
+  Table bridge_;
+  Table tunnel_;
+  Table toll_;
+  NumberTable motor_vehicle_node_;
+  NumberTable bicycle_node_;
+  NumberTable foot_node_;
+  NumberTable wheelchair_node_;
+  NumberTable bus_node_;
+  NumberTable truck_node_;
+  NumberTable psv_node_;
+};
+
+}
+}
+
+#endif  // VALHALLA_MJOLNIR_NATIVETAGTRANSFORM_H
@@ -71,8 +71,11 @@ struct Callback {
 class Parser {
  public:
   Parser() = delete;
-  //parse the pbf file for the things you are interested in
-  static void parse(std::ifstream& file, const Interest interest, Callback& callback);
+  //parse the pbf file for the things you are interested in. with more than one thread
+  //the file is read on its own thread, blobs are inflated and decoded by the rest
+  //and the callbacks are still called in file order on the calling thread
+  static void parse(std::ifstream& file, const Interest interest, Callback& callback,
+                    const unsigned int threads = 1);
   //clean up (mainly pbf memory)
   static void free();
 };
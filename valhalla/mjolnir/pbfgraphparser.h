@@ -18,7 +18,9 @@ class PBFGraphParser {
  public:
 
   /**
-   * Loads given input files
+   * Loads given input files. When the single_pass property is set the input is read
+   * once, relying on it being sorted by type, instead of once each for ways, relations
+   * and nodes. All of its nodes are then kept on disk until the ways are known
    * @param  pt                         properties file
    * @param  input_files                the protobuf files to parse
    * @param  ways_file                  where to store the ways so they are not in memory
@@ -0,0 +1,34 @@
+#ifndef VALHALLA_MJOLNIR_TAGTRANSFORM_H
+#define VALHALLA_MJOLNIR_TAGTRANSFORM_H
+
+#include <valhalla/mjolnir/osmdata.h>
+
+#include <string>
+#include <unordered_map>
+
+namespace valhalla {
+namespace mjolnir {
+
+using Tags = std::unordered_map<std::string, std::string>;
+
+/**
+ * Turns the tags of an OSM node, way or relation into the tags the graph
+ * is built from.
+ */
+class TagTransform {
+ public:
+  virtual ~TagTransform() {}
+
+  /**
+   * Transform the tags of an OSM object
+   * @param  type  whether the tags are of a node, way or relation
+   * @param  tags  the OSM tags
+   * @return the transformed tags, empty if the object is not wanted
+   */
+  virtual Tags Transform(OSMType type, const Tags& tags) = 0;
+};
+
+}
+}
+
+#endif  // VALHALLA_MJOLNIR_TAGTRANSFORM_H
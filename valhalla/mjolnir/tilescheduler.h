@@ -0,0 +1,100 @@
+#ifndef VALHALLA_MJOLNIR_TILESCHEDULER_H
+#define VALHALLA_MJOLNIR_TILESCHEDULER_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <valhalla/baldr/graphid.h>
+
+namespace valhalla {
+namespace mjolnir {
+
+/**
+ * Hands out the work items (usually tiles) of a build stage to its threads.
+ * Items are handed out largest first so the slow, dense tiles do not end up
+ * last. Each thread has its own queue and steals from the others once it
+ * runs dry so no thread sits idle while there is work left. Progress and an
+ * estimate of the time left are logged as items are finished.
+ */
+class TileScheduler {
+ public:
+  /**
+   * Constructor
+   * @param  stage    name of the build stage, used when logging progress
+   * @param  weights  how much work each item is, items are identified by
+   *                  their index in this list
+   * @param  threads  how many threads will work on the items
+   */
+  TileScheduler(const std::string& stage, const std::vector<size_t>& weights,
+                unsigned int threads);
+
+  /**
+   * Get the next item for a thread to work on. Asking for the next item
+   * marks the item the thread had before as finished.
+   * @param  worker  index of the thread asking
+   * @param  item    the index of the item to work on
+   * @return false when there are no items left
+   */
+  bool next(size_t worker, size_t& item);
+
+  /**
+   * Run the work on each of the threads and wait for them to finish. The
+   * work is passed the index of the thread it is running on. If the work
+   * throws on any thread the other threads are handed no more items and the
+   * first exception is rethrown here once they are done with the ones they had.
+   * @param  work  the work each thread does, usually a loop over next()
+   */
+  void run(const std::function<void (size_t worker)>& work);
+
+  /**
+   * @return the number of threads
+   */
+  size_t threads() const;
+
+  /**
+   * @return the number of items
+   */
+  size_t size() const;
+
+  /**
+   * Use the size of the tiles on disk as their weights.
+   * @param  tile_dir  where the tiles are
+   * @param  tiles     the tiles
+   * @return the weight of each tile
+   */
+  static std::vector<size_t> TileSizes(const std::string& tile_dir,
+                                       const std::vector<baldr::GraphId>& tiles);
+
+ protected:
+  // Mark the item the thread was working on as finished
+  void finish(size_t worker);
+
+  struct worker_queue {
+    std::mutex lock;
+    std::deque<size_t> items;
+    size_t working = -1;
+  };
+
+  std::string stage_;
+  std::vector<size_t> weights_;
+  std::vector<std::unique_ptr<worker_queue> > queues_;
+  size_t total_weight_;
+  std::atomic<bool> stopped_;     // a thread failed, hand out nothing else
+  std::atomic<size_t> finished_weight_;
+  std::atomic<size_t> finished_count_;
+  std::mutex progress_lock_;
+  size_t next_report_;
+  std::chrono::steady_clock::time_point start_;
+};
+
+}
+}
+
+#endif  // VALHALLA_MJOLNIR_TILESCHEDULER_H
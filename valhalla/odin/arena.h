@@ -0,0 +1,58 @@
+#ifndef VALHALLA_ODIN_ARENA_H_
+#define VALHALLA_ODIN_ARENA_H_
+
+#include <cstddef>
+#include <vector>
+
+#include <google/protobuf/arena.h>
+
+namespace valhalla {
+namespace odin {
+
+/**
+ * Holds the protobuf messages (trip paths, trip directions) of one request.
+ * Everything created on it is freed at once when it is reset between
+ * requests. The first block belongs to us rather than to the arena so that
+ * a reset keeps it around for the next request instead of handing it back
+ * to the heap.
+ */
+class arena_t {
+ public:
+  //enough for the trip path of a fairly long route
+  static constexpr size_t kInitialBlockSize = 1024 * 1024;
+
+  arena_t(size_t initial_block_size = kInitialBlockSize)
+    : block(initial_block_size), arena(options(block)) { }
+
+  /**
+   * Creates a message that lives until the next reset
+   * @return the message, owned by the arena
+   */
+  template <class message_t>
+  message_t* create() {
+    return google::protobuf::Arena::CreateMessage<message_t>(&arena);
+  }
+
+  /**
+   * Frees every message created since the last reset
+   */
+  void reset() {
+    arena.Reset();
+  }
+
+ protected:
+  static google::protobuf::ArenaOptions options(std::vector<char>& block) {
+    google::protobuf::ArenaOptions options;
+    options.initial_block = block.data();
+    options.initial_block_size = block.size();
+    return options;
+  }
+
+  std::vector<char> block;
+  google::protobuf::Arena arena;
+};
+
+}
+}
+
+#endif  // VALHALLA_ODIN_ARENA_H_
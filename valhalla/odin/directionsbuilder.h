@@ -25,15 +25,28 @@ class DirectionsBuilder {
    * and trip path. This method calls ManeuversBuilder::Build and
    * NarrativeBuilder::Build to form the maneuver list. This method
    * calls PopulateTripDirections to transform the maneuver list into the
-   * trip directions.
+   * trip directions. Only the narrative fields requested in the directions
+   * options are formed.
    *
-   * @param directions_options The directions options such as: units and
-   *                           language.
+   * @param directions_options The directions options such as: units,
+   *                           language and narrative fields.
    * @param trip_path The trip path - list of nodes, edges, attributes and shape.
    */
   TripDirections Build(const DirectionsOptions& directions_options,
                        TripPath& trip_path);
 
+  /**
+   * Same as above but fills in trip directions supplied by the caller, for
+   * example ones allocated on a protobuf arena.
+   *
+   * @param directions_options The directions options such as: units,
+   *                           language and narrative fields.
+   * @param trip_path The trip path - list of nodes, edges, attributes and shape.
+   * @param trip_directions Empty trip directions to fill in.
+   */
+  void Build(const DirectionsOptions& directions_options, TripPath& trip_path,
+             TripDirections& trip_directions);
+
  protected:
 
   /**
@@ -44,18 +57,18 @@ class DirectionsBuilder {
   void UpdateHeading(EnhancedTripPath* etp);
 
   /**
-   * Returns the trip directions based on the specified directions options,
+   * Populates the trip directions based on the specified directions options,
    * trip path, and maneuver list.
    * @param directions_options The directions options such as: units and
    *                           language.
    * @param etp The enhanced trip path - list of nodes, edges, attributes and shape.
    * @param maneuvers the maneuver list that contains the information required
    *                  to populate the trip directions.
-   * @returns the trip directions.
+   * @param trip_directions the trip directions to populate.
    */
-  TripDirections PopulateTripDirections(
+  void PopulateTripDirections(
       const DirectionsOptions& directions_options, EnhancedTripPath* etp,
-      std::list<Maneuver>& maneuvers);
+      std::list<Maneuver>& maneuvers, TripDirections& trip_directions);
 
 };
 
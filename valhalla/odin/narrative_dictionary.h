@@ -1,8 +1,11 @@
 #ifndef VALHALLA_ODIN_NARRATIVE_DICTIONARY_H_
 #define VALHALLA_ODIN_NARRATIVE_DICTIONARY_H_
 
+#include <cstdint>
 #include <vector>
 #include <string>
+#include <utility>
+#include <initializer_list>
 #include <unordered_map>
 #include <locale>
 
@@ -143,13 +146,97 @@ constexpr auto kTransitHeadSignTag = "<TRANSIT_HEADSIGN>";
 constexpr auto kTransitStopCountTag = "<TRANSIT_STOP_COUNT>";
 constexpr auto kTransitStopCountLabelTag = "<TRANSIT_STOP_COUNT_LABEL>";
 
+// Phrase tags indexed by valhalla::odin::PhraseTag
+constexpr const char* kPhraseTags[] = {
+  kCardinalDirectionTag, kRelativeDirectionTag, kOrdinalValueTag,
+  kStreetNamesTag, kPreviousStreetNamesTag, kBeginStreetNamesTag,
+  kCrossStreetNamesTag, kLengthTag, kDestinationTag, kCurrentVerbalCueTag,
+  kNextVerbalCueTag, kKilometersTag, kMetersTag, kMilesTag, kTenthsOfMilesTag,
+  kFeetTag, kNumberSignTag, kBranchSignTag, kTowardSignTag, kNameSignTag,
+  kFerryLabelTag, kTransitStopTag, kStationLabelTag, kTimeTag, kTransitNameTag,
+  kTransitHeadSignTag, kTransitStopCountTag, kTransitStopCountLabelTag
+};
+
 }
 
 namespace valhalla {
 namespace odin {
 
+// The phrase tags, in the same order as kPhraseTags
+enum class PhraseTag : uint8_t {
+  kCardinalDirection, kRelativeDirection, kOrdinalValue,
+  kStreetNames, kPreviousStreetNames, kBeginStreetNames,
+  kCrossStreetNames, kLength, kDestination, kCurrentVerbalCue,
+  kNextVerbalCue, kKilometers, kMeters, kMiles, kTenthsOfMiles,
+  kFeet, kNumberSign, kBranchSign, kTowardSign, kNameSign,
+  kFerryLabel, kTransitStop, kStationLabel, kTime, kTransitName,
+  kTransitHeadSign, kTransitStopCount, kTransitStopCountLabel
+};
+constexpr size_t kPhraseTagCount = sizeof(kPhraseTags) / sizeof(kPhraseTags[0]);
+static_assert(static_cast<size_t>(PhraseTag::kTransitStopCountLabel) + 1 == kPhraseTagCount,
+              "PhraseTag and kPhraseTags are out of sync");
+
+/**
+ * A phrase split up front into its literal text and its tags so that it can
+ * be filled in with a single pass over it rather than a search and replace
+ * per tag.
+ */
+class PhraseTemplate {
+ public:
+  // A tag and what to put in its place. The value is only referred to so it
+  // has to outlive the call to Render, which rules out converting a literal
+  struct Value {
+    Value(PhraseTag tag, const std::string& value) : tag(tag), value(value) {}
+    Value(PhraseTag tag, const char* value) = delete;
+    PhraseTag tag;
+    const std::string& value;
+  };
+  using Values = std::initializer_list<Value>;
+
+  PhraseTemplate() = default;
+
+  /**
+   * Finds the tags in the specified phrase.
+   *
+   * @param  phrase  The tagged phrase, for example "Turn <RELATIVE_DIRECTION>."
+   */
+  explicit PhraseTemplate(const std::string& phrase);
+
+  /**
+   * Replaces the contents of the specified instruction with this phrase,
+   * substituting each tag with its value. Tags without a value are kept as is.
+   * Throws if there is no phrase at this template's id in the narrative.
+   *
+   * @param  instruction  The string to fill in, its capacity is reused.
+   * @param  values  The tags and the values to replace them with.
+   */
+  void Render(std::string& instruction, Values values) const;
+
+  /**
+   * Returns the phrase this template was made from.
+   *
+   * @return the tagged phrase.
+   */
+  const std::string& phrase() const;
+
+ protected:
+  // A run of literal text or a tag, tag is kPhraseTagCount for literal text
+  struct Segment {
+    uint32_t offset;
+    uint32_t length;
+    uint8_t tag;
+  };
+
+  std::string phrase_;
+  std::vector<Segment> segments_;
+  // False for the gaps between phrase ids, which have nothing to render
+  bool compiled_ = false;
+};
+
 struct PhraseSet {
   std::unordered_map<std::string, std::string> phrases;
+  // The phrases compiled at load time, indexed by phrase id
+  std::vector<PhraseTemplate> templates;
 };
 
 struct StartSubset : PhraseSet {
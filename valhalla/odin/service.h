@@ -2,9 +2,15 @@
 #define __VALHALLA_ODIN_SERVICE_H__
 
 #include <cstdint>
+#include <list>
 #include <boost/property_tree/ptree.hpp>
 #include <prime_server/prime_server.hpp>
 
+#include <valhalla/baldr/rapidjson_utils.h>
+#include <valhalla/proto/trippath.pb.h>
+#include <valhalla/proto/tripdirections.pb.h>
+#include <valhalla/odin/arena.h>
+
 
 namespace valhalla {
   namespace odin {
@@ -18,10 +24,21 @@ namespace valhalla {
       prime_server::worker_t::result_t work(const std::list<zmq::message_t>& job, void* request_info, const prime_server::worker_t::interrupt_function_t&);
       void cleanup();
 
+      /**
+       * Builds the maneuvers and narrative for each leg without serializing anything.
+       * Throws valhalla_exception_t on failure.
+       * @param request  the request, its language is set to the default if it is missing or unsupported
+       * @param legs     the path of each leg of the trip
+       * @return the directions for each leg, they live until cleanup
+       */
+      std::list<odin::TripDirections*> narrate(rapidjson::Document& request, std::list<odin::TripPath*>& legs);
+
      protected:
 
       boost::property_tree::ptree config;
       boost::optional<std::string> jsonp;
+      //the trip paths and directions of the current request
+      odin::arena_t arena;
     };
   }
 }
@@ -9,6 +9,7 @@
 
 #include <boost/property_tree/ptree.hpp>
 
+#include <valhalla/baldr/rapidjson_utils.h>
 #include <valhalla/proto/directions_options.pb.h>
 #include <valhalla/odin/narrative_dictionary.h>
 
@@ -27,6 +28,7 @@ bool IsSimilarTurnDegree(uint32_t path_turn_degree,
                          uint32_t turn_degree_threshold = 30);
 
 DirectionsOptions GetDirectionsOptions(const boost::property_tree::ptree& pt);
+DirectionsOptions GetDirectionsOptions(const rapidjson::Value& options);
 
 /**
  * Get the time from the inputed date.
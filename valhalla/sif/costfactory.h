@@ -60,13 +60,7 @@ class CostFactory {
                     const rapidjson::Value& config) const {
     if (config.IsNull())
       return Create(name, boost::property_tree::ptree{});
-    rapidjson::StringBuffer buffer;
-    rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
-    config.Accept(writer);
-    boost::property_tree::ptree pt;
-    std::istringstream is(buffer.GetString());;
-    boost::property_tree::read_json(is, pt);
-    return Create(name, pt);
+    return Create(name, rapidjson::to_ptree(config));
   }
  private:
   std::map<std::string, factory_function_t> factory_funcs_;
@@ -69,6 +69,13 @@ class DynamicCost {
    */
   virtual bool AllowMultiPass() const;
 
+  /**
+   * Does the costing method use the historical speed profiles in the tiles
+   * when an edge is costed at a time of the week.
+   * @return  Returns true if the costing model uses speed profiles.
+   */
+  virtual bool UsesSpeedProfiles() const;
+
   /**
    * Returns the maximum transfer distance between stops that you are willing
    * to travel for this mode.  It is the max distance you are willing to
@@ -161,6 +168,21 @@ class DynamicCost {
                         const baldr::TransitDeparture* departure,
                         const uint32_t curr_time) const;
 
+  /**
+   * Get the cost to traverse the specified directed edge at a time of the
+   * week. Cost includes the time (seconds) to traverse the edge. Defaults
+   * to the cost at any time. Costing models that use the historical speed
+   * profiles in the tiles must override this method.
+   * @param   edge             Pointer to a directed edge.
+   * @param   tile             Tile that holds the directed edge.
+   * @param   seconds_of_week  Local time the edge is entered (seconds
+   *                           since midnight Sunday).
+   * @return  Returns the cost and time (seconds)
+   */
+  virtual Cost EdgeCost(const baldr::DirectedEdge* edge,
+                        const baldr::GraphTile* tile,
+                        const uint32_t seconds_of_week) const;
+
   /**
    * Returns the cost to make the transition from the predecessor edge.
    * Defaults to 0. Costing models that wish to include edge transition
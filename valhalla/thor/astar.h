@@ -89,6 +89,14 @@ class AStarPathAlgorithm : public PathAlgorithm {
   // Destinations, id and cost
   std::map<uint64_t, sif::Cost> destinations_;
 
+  // Destinations, id and the fraction of the edge past the destination
+  std::map<uint64_t, float> destination_remainders_;
+
+  // Is the path time dependent and if so its departure time (seconds from
+  // the start of the week)
+  bool time_dependent_;
+  uint32_t start_time_;
+
   /**
    * Initializes the hierarchy limits, A* heuristic, and adjacency list.
    * @param  origll  Lat,lng of the origin.
@@ -141,6 +149,21 @@ class AStarPathAlgorithm : public PathAlgorithm {
                           const baldr::PathLocation& dest,
                           const std::shared_ptr<sif::DynamicCost>& costing);
 
+  /**
+   * Get the cost of the part of a destination edge past the destination.
+   * A time dependent path costs it at the speed the rest of the edge got
+   * when the path entered it.
+   * @param  edgeid    Destination edge Id.
+   * @param  edge      Destination directed edge.
+   * @param  edgecost  Cost of the whole edge along the path.
+   * @param  costing   Dynamic costing.
+   * @return Returns the cost to subtract from the path at the end of the edge.
+   */
+  sif::Cost RemainderCost(const baldr::GraphId& edgeid,
+                          const baldr::DirectedEdge* edge,
+                          const sif::Cost& edgecost,
+                          const std::shared_ptr<sif::DynamicCost>& costing) const;
+
   /**
    * Test if the completed path is trivial (on the same edge in a forward
    * direction from the origin to the destination.
@@ -101,6 +101,7 @@ const std::string kMatchedDistanceFromTracePoint = "matched.distance_from_trace_
 
 // Categories
 const std::string kNodeCategory = "node.";
+const std::string kNodeIntersectingEdgeCategory = "node.intersecting_edge.";
 const std::string kAdminCategory = "admin.";
 const std::string kMatchedCategory = "matched.";
 
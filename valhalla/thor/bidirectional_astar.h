@@ -18,6 +18,17 @@
 namespace valhalla {
 namespace thor {
 
+// Alternate routes may cost at most this much more than the best route
+constexpr float kAlternateMaxStretch = 1.25f;
+
+// Alternate routes may share at most this fraction of their length with the
+// routes found before them
+constexpr float kAlternateMaxSharing = 0.75f;
+
+// Factor by which the search is extended past the first connection when
+// alternate routes are wanted so that more connections are found
+constexpr int kAlternateThresholdFactor = 4;
+
 /**
  * Candidate connections - a directed edge and its opposing directed edge
  * are both temporarily labeled. Store the edge Ids and its cost.
@@ -59,6 +70,27 @@ class BidirectionalAStar : public PathAlgorithm {
            const std::shared_ptr<sif::DynamicCost>* mode_costing,
            const sif::TravelMode mode);
 
+  /**
+   * Form the best path and alternate paths between an origin and destination
+   * from a single search. The forward and reverse searches meet at many
+   * edges, each of which is the via edge of a path. Alternates are taken
+   * from the cheapest of these that cost at most kAlternateMaxStretch times
+   * the best path, have no loops and share at most kAlternateMaxSharing of
+   * their length with the paths taken before them.
+   * @param  origin  Origin location
+   * @param  dest    Destination location
+   * @param  graphreader  Graph reader for accessing routing graph.
+   * @param  mode_costing  An array of costing methods, one per TravelMode.
+   * @param  mode     Travel mode from the origin.
+   * @param  alternates  Maximum number of alternate paths.
+   * @return  Returns the best path followed by the alternate paths. Empty
+   *          if no path is found.
+   */
+  std::vector<std::vector<PathInfo>> GetAlternatePaths(baldr::PathLocation& origin,
+           baldr::PathLocation& dest, baldr::GraphReader& graphreader,
+           const std::shared_ptr<sif::DynamicCost>* mode_costing,
+           const sif::TravelMode mode, const uint32_t alternates);
+
   /**
    * Clear the temporary information generated during path construction.
    */
@@ -102,6 +134,11 @@ class BidirectionalAStar : public PathAlgorithm {
   uint32_t threshold_;
   CandidateConnection best_connection_;
 
+  // Number of alternate paths wanted and all connections found (only kept
+  // when alternates are wanted).
+  uint32_t alternates_;
+  std::vector<CandidateConnection> connections_;
+
   /**
    * Initialize the A* heuristic and adjacency lists for both the forward
    * and reverse search.
@@ -165,11 +202,20 @@ class BidirectionalAStar : public PathAlgorithm {
     * The path from where the paths meet to the destination is then appended
     * using the opposing edges (so the path is traversed forward).
     * @param   graphreader  Graph tile reader (for getting opposing edges).
+    * @param   connection   Edge where the forward and reverse paths meet.
     * @return  Returns the path info, a list of GraphIds representing the
     *          directed edges along the path - ordered from origin to
     *          destination - along with travel modes and elapsed time.
     */
-  std::vector<PathInfo> FormPath(baldr::GraphReader& graphreader);
+  std::vector<PathInfo> FormPath(baldr::GraphReader& graphreader,
+                                 const CandidateConnection& connection);
+
+   /**
+    * Form the best path and, if wanted, the alternate paths.
+    * @param   graphreader  Graph tile reader (for getting opposing edges).
+    * @return  Returns the best path followed by the alternate paths.
+    */
+  std::vector<std::vector<PathInfo>> FormPaths(baldr::GraphReader& graphreader);
 };
 
 }
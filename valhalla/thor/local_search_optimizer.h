@@ -0,0 +1,81 @@
+#ifndef VALHALLA_THOR_LOCAL_SEARCH_OPTIMIZER_H_
+#define VALHALLA_THOR_LOCAL_SEARCH_OPTIMIZER_H_
+
+#include <cstdint>
+#include <vector>
+#include <chrono>
+
+namespace valhalla {
+namespace thor {
+
+// Default time budget for a single solve. Most tours have settled well before
+// this, it bounds the large ones.
+constexpr std::chrono::milliseconds kDefaultOptimizerTimeLimit{100};
+
+// Number of cheapest successors (and predecessors) of each location that are
+// considered when looking for improving moves.
+constexpr uint32_t kOptimizerNeighbors = 10;
+
+/**
+ * Optimizes the order of locations using local search - keeping the first
+ * location (origin) and last location (destination) fixed. The tour is seeded
+ * with nearest neighbor and improved with 2-opt and Or-opt moves restricted to
+ * each location's cheapest neighbors. Costs need not be symmetric. Once no
+ * move improves the tour it is perturbed and searched again (iterated local
+ * search) until either it stops getting better or the time limit is reached.
+ * With more than one thread each thread runs its own search from a different
+ * starting tour and the best result wins.
+ */
+class LocalSearchOptimizer {
+public:
+
+  /**
+   * Constructor.
+   * @param  threads     Number of independent searches to run in parallel.
+   * @param  time_limit  Time after which the best tour so far is returned.
+   */
+  LocalSearchOptimizer(const uint32_t threads = 1,
+                       const std::chrono::milliseconds& time_limit =
+                           kDefaultOptimizerTimeLimit);
+
+  /**
+   * Optimize the tour through a set of locations given the cost matrix
+   * among all locations. The first location (origin) and last location
+   * (destination) remain fixed in the tour.
+   * @param  count  Number of locations.
+   * @param  costs  2-D cost matrix, costs[from * count + to].
+   * @return Returns the tour as an updated order of locations visited to
+   *         complete the tour.
+   */
+  std::vector<uint32_t> Solve(const uint32_t count,
+                              const std::vector<float>& costs) const;
+
+  /**
+   * Seed the random number generators used to perturb tours. Together with
+   * a single thread this gives tests a repeatable result.
+   * @param  seed  Seed to use for the random number generators.
+   */
+  void Seed(const uint32_t seed) {
+    seed_ = seed;
+  }
+
+  /**
+   * Get the cost for the specified tour (order of locations).
+   * @param  count  Number of locations.
+   * @param  costs  2-D cost array between locations.
+   * @param  tour   Order that locations are traversed.
+   * @return Returns the total cost for the tour.
+   */
+  static float TourCost(const uint32_t count, const std::vector<float>& costs,
+                        const std::vector<uint32_t>& tour);
+
+protected:
+  uint32_t threads_;                       // # of parallel searches
+  std::chrono::milliseconds time_limit_;   // Time budget per solve
+  uint32_t seed_;                          // Seed for the perturbations
+};
+
+}
+}
+
+#endif  // VALHALLA_THOR_LOCAL_SEARCH_OPTIMIZER_H_
@@ -4,12 +4,15 @@
 #include <cstdint>
 #include <vector>
 #include <utility>
+#include <memory>
 
 #include <boost/property_tree/ptree.hpp>
 
 #include <prime_server/prime_server.hpp>
 #include <prime_server/http_protocol.hpp>
 
+#include <valhalla/baldr/rapidjson_utils.h>
+#include <valhalla/baldr/json_writer.h>
 #include <valhalla/baldr/pathlocation.h>
 #include <valhalla/baldr/graphreader.h>
 #include <valhalla/baldr/location.h>
@@ -20,13 +23,18 @@
 #include <valhalla/sif/costfactory.h>
 #include <valhalla/sif/edgelabel.h>
 #include <valhalla/thor/bidirectional_astar.h>
+#include <valhalla/thor/costmatrix.h>
 #include <valhalla/thor/astar.h>
 #include <valhalla/thor/match_result.h>
 #include <valhalla/thor/multimodal.h>
 #include <valhalla/thor/trippathbuilder.h>
 #include <valhalla/thor/attributes_controller.h>
 #include <valhalla/thor/isochrone.h>
+#include <valhalla/thor/local_search_optimizer.h>
+#include <valhalla/thor/vehicle_router.h>
 #include <valhalla/meili/map_matcher_factory.h>
+#include <valhalla/odin/arena.h>
+#include <valhalla/proto/trace.pb.h>
 
 
 namespace valhalla {
@@ -47,7 +55,8 @@ class thor_worker_t {
     OPTIMIZED_ROUTE = 7,
     ISOCHRONE = 8,
     TRACE_ROUTE = 9,
-    TRACE_ATTRIBUTES = 10
+    TRACE_ATTRIBUTES = 10,
+    OPTIMIZED_FLEET = 11
   };
   enum SHAPE_MATCH {
     EDGE_WALK = 0,
@@ -65,6 +74,20 @@ class thor_worker_t {
   prime_server::worker_t::result_t work(const std::list<zmq::message_t>& job, void* request_info, const prime_server::worker_t::interrupt_function_t&);
   void cleanup();
 
+  /**
+   * Does thor's part of the request without serializing anything for the next stage.
+   * Throws valhalla_exception_t on failure.
+   * @param request        the request as annotated by loki, parsed once and only read from here on
+   * @param request_trace  the binary trace for the trace actions, it is consumed
+   * @param request_info   info about the request
+   * @param interrupt      lets the request be aborted part way through
+   * @param trip_paths     filled with the paths for odin to narrate, they live until cleanup
+   * @return the json response when thor answers the request itself otherwise none
+   */
+  boost::optional<std::string> act(const rapidjson::Document& request, odin::Trace& request_trace,
+      prime_server::http_request_info_t& request_info, const prime_server::worker_t::interrupt_function_t& interrupt,
+      std::list<odin::TripPath*>& trip_paths);
+
  protected:
 
   prime_server::worker_t::result_t jsonify_error(
@@ -74,53 +97,61 @@ class thor_worker_t {
                 baldr::PathLocation& destination);
   void log_admin(odin::TripPath&);
   valhalla::sif::cost_ptr_t get_costing(
-      const boost::property_tree::ptree& request, const std::string& costing);
+      const rapidjson::Document& request, const std::string& costing);
   thor::PathAlgorithm* get_path_algorithm(
       const std::string& routetype, const baldr::PathLocation& origin,
       const baldr::PathLocation& destination);
-  valhalla::odin::TripPath route_match(const AttributesController& controller);
-  std::pair<valhalla::odin::TripPath, std::vector<thor::MatchResult>> map_match(
+  valhalla::odin::TripPath* route_match(const AttributesController& controller);
+  std::pair<valhalla::odin::TripPath*, std::vector<thor::MatchResult>> map_match(
       const AttributesController& controller, bool trace_attributes_action = false);
 
-  std::list<valhalla::odin::TripPath> path_arrive_by(
-      std::vector<baldr::PathLocation>& correlated, const std::string &costing,
-      const std::string &request_str);
-  std::list<valhalla::odin::TripPath> path_depart_at(
+  std::vector<std::vector<thor::PathInfo> > leg_paths(
+      const rapidjson::Document& request,
+      const std::vector<baldr::PathLocation>& correlated, const std::string &costing);
+  std::list<valhalla::odin::TripPath*> path_arrive_by(
+      const rapidjson::Document& request, const AttributesController& controller,
+      std::vector<baldr::PathLocation>& correlated, const std::string &costing);
+  std::list<valhalla::odin::TripPath*> path_depart_at(
+      const rapidjson::Document& request, const AttributesController& controller,
       std::vector<baldr::PathLocation>& correlated, const std::string &costing,
-      const boost::optional<int> &date_time_type,
-      const std::string &request_str);
-
-  void parse_locations(const boost::property_tree::ptree& request);
-  void parse_shape(const boost::property_tree::ptree& request);
-  void parse_trace_config(const boost::property_tree::ptree& request);
-  std::string parse_costing(const boost::property_tree::ptree& request);
-  void filter_attributes(const boost::property_tree::ptree& request, AttributesController& controller);
-
-  prime_server::worker_t::result_t route(
-      const boost::property_tree::ptree& request,
-      const std::string &request_str,
+      const boost::optional<int> &date_time_type);
+  std::list<valhalla::odin::TripPath*> path_alternates(
+      const AttributesController& controller,
+      std::vector<baldr::PathLocation>& correlated, const uint32_t alternates);
+
+  void parse_locations(const rapidjson::Document& request);
+  void parse_shape(const rapidjson::Document& request);
+  void parse_trace_config(const rapidjson::Document& request);
+  std::string parse_costing(const rapidjson::Document& request);
+  void filter_attributes(const rapidjson::Document& request, AttributesController& controller);
+  std::vector<thor::TimeDistance> source_to_target();
+
+  std::list<valhalla::odin::TripPath*> route(
+      const rapidjson::Document& request,
       const boost::optional<int> &date_time_type, const bool header_dnt);
-  prime_server::worker_t::result_t matrix(
-      ACTION_TYPE matrix_type, const boost::property_tree::ptree &request,
-      prime_server::http_request_info_t& request_info);
-  prime_server::worker_t::result_t optimized_route(
-      const boost::property_tree::ptree& request,
-      const std::string &request_str, const bool header_dnt);
-  prime_server::worker_t::result_t isochrone(
-      const boost::property_tree::ptree &request,
-      prime_server::http_request_info_t& request_info);
-  prime_server::worker_t::result_t trace_route(
-      const boost::property_tree::ptree &request,
-      const std::string &request_str, const bool header_dnt);
-  prime_server::worker_t::result_t trace_attributes(
-      const boost::property_tree::ptree &request,
-      const std::string &request_str, prime_server::http_request_info_t& request_info);
+  std::string matrix(
+      ACTION_TYPE matrix_type, const rapidjson::Document& request,
+      const bool header_dnt);
+  std::list<valhalla::odin::TripPath*> optimized_route(
+      const rapidjson::Document& request, const bool header_dnt);
+  std::string optimized_fleet(
+      const rapidjson::Document& request, const bool header_dnt);
+  std::string isochrone(
+      const rapidjson::Document& request, const bool header_dnt);
+  std::list<valhalla::odin::TripPath*> trace_route(
+      const rapidjson::Document& request, const bool header_dnt);
+  std::string trace_attributes(
+      const rapidjson::Document& request, const bool header_dnt);
 
   valhalla::sif::TravelMode mode;
   boost::property_tree::ptree config;
   boost::optional<std::string> jsonp;
+  baldr::json::writer_t writer;
   std::vector<baldr::Location> locations;
   std::vector<midgard::PointLL> shape;
+  odin::Trace trace;
+  //the trip paths of the current request
+  odin::arena_t arena;
   std::vector<baldr::PathLocation> correlated;
   std::vector<baldr::PathLocation> correlated_s;
   std::vector<baldr::PathLocation> correlated_t;
@@ -131,6 +162,20 @@ class thor_worker_t {
   BidirectionalAStar bidir_astar;
   MultiModalPathAlgorithm multi_modal_astar;
   Isochrone isochrone_gen;
+  // Path algorithms for the extra threads that search the legs of a route
+  struct leg_searcher_t {
+    leg_searcher_t(const boost::property_tree::ptree& config,
+                   const std::shared_ptr<baldr::CopyForwardingTileCache::group_t>& caches);
+    valhalla::baldr::GraphReader reader;
+    AStarPathAlgorithm astar;
+    BidirectionalAStar bidir_astar;
+  };
+  std::vector<std::unique_ptr<leg_searcher_t> > leg_searchers;
+  // Reader this thread searches legs with, it shares tiles with the searchers'
+  std::unique_ptr<valhalla::baldr::GraphReader> leg_reader;
+  size_t min_parallel_legs;
+  LocalSearchOptimizer optimizer;
+  VehicleRouter vehicle_router;
   float long_request;
   SOURCE_TO_TARGET_ALGORITHM source_to_target_algorithm;
   boost::optional<int> date_time_type;
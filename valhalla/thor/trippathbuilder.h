@@ -50,6 +50,23 @@ class TripPathBuilder {
       std::unordered_map<size_t, std::pair<RouteDiscontinuity, RouteDiscontinuity>>*
         route_discontinuities = nullptr);
 
+  /**
+   * Format the trip path output given the edges on the path into a trip path
+   * supplied by the caller, for example one allocated on a protobuf arena so
+   * that its nodes and edges are allocated there as well.
+   * @param  trip_path  Empty trip path to fill in.
+   */
+  static void Build(
+      odin::TripPath& trip_path,
+      const AttributesController& controller, baldr::GraphReader& graphreader,
+      const std::shared_ptr<sif::DynamicCost>* mode_costing,
+      const std::vector<PathInfo>& path, baldr::PathLocation& origin,
+      baldr::PathLocation& dest,
+      const std::list<baldr::PathLocation>& through_loc,
+      const std::function<void ()>* interrupt_callback = nullptr,
+      std::unordered_map<size_t, std::pair<RouteDiscontinuity, RouteDiscontinuity>>*
+        route_discontinuities = nullptr);
+
   /**
    * Add trip edge. (TODO more comments)
    * @param  controller    Controller to determine which attributes to set.
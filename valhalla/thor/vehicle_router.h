@@ -0,0 +1,118 @@
+#ifndef VALHALLA_THOR_VEHICLE_ROUTER_H_
+#define VALHALLA_THOR_VEHICLE_ROUTER_H_
+
+#include <cstdint>
+#include <vector>
+#include <limits>
+#include <chrono>
+
+namespace valhalla {
+namespace thor {
+
+// Marks a vehicle whose route ends at its last stop rather than returning
+// to a depot.
+constexpr uint32_t kOpenRoute = std::numeric_limits<uint32_t>::max();
+
+// Stands in for a missing capacity or time window bound.
+constexpr float kUnbounded = std::numeric_limits<float>::infinity();
+
+/**
+ * A location that has to be visited by one of the vehicles.
+ */
+struct Stop {
+  uint32_t location;        // Index of the location in the time matrix
+  float demand;             // Capacity it takes up on the vehicle
+  float service_time;       // Seconds spent at the location
+  float earliest;           // Earliest time service may begin
+  float latest;             // Latest time service may begin
+
+  Stop(const uint32_t location, const float demand = 0.0f,
+       const float service_time = 0.0f, const float earliest = 0.0f,
+       const float latest = kUnbounded)
+    : location(location), demand(demand), service_time(service_time),
+      earliest(earliest), latest(latest) {
+  }
+};
+
+/**
+ * A vehicle of the fleet. It leaves its start location no earlier than
+ * earliest and has to be back at its end location by latest.
+ */
+struct Vehicle {
+  uint32_t start;           // Index of the start location in the time matrix
+  uint32_t end;             // Index of the end location or kOpenRoute
+  float capacity;           // Total demand it can serve
+  float earliest;           // Earliest time it may leave the start location
+  float latest;             // Latest time it may arrive at the end location
+
+  Vehicle(const uint32_t start, const uint32_t end = kOpenRoute,
+          const float capacity = kUnbounded, const float earliest = 0.0f,
+          const float latest = kUnbounded)
+    : start(start), end(end), capacity(capacity), earliest(earliest),
+      latest(latest) {
+  }
+};
+
+/**
+ * The route of one vehicle.
+ */
+struct VehicleRoute {
+  uint32_t vehicle;              // Index of the vehicle
+  std::vector<uint32_t> stops;   // Indexes of the stops in the order visited
+  std::vector<float> arrivals;   // Arrival time at each of the stops
+  std::vector<float> starts;     // Time service begins at each of the stops
+  float departure;               // Time the vehicle leaves its start location
+  float arrival;                 // Time it reaches its end (or last stop)
+  float travel_time;             // Seconds spent driving
+  float load;                    // Total demand served
+};
+
+/**
+ * Assigns stops to the vehicles of a fleet and orders each vehicle's stops
+ * so that the total travel time is as small as possible while keeping to
+ * vehicle capacities and the time windows of both stops and vehicles.
+ * Routes are built by regret insertion - placing first the stops that would
+ * cost the most to put anywhere but their best spot - and then improved by
+ * moving stops within and between routes and swapping stops between routes.
+ * Stops that fit no vehicle are left unassigned.
+ */
+class VehicleRouter {
+public:
+  /**
+   * Result of a solve.
+   */
+  struct Solution {
+    std::vector<VehicleRoute> routes;    // One per vehicle, same order
+    std::vector<uint32_t> unassigned;    // Indexes of stops not visited
+    float travel_time;                   // Total over all routes
+  };
+
+  /**
+   * Constructor.
+   * @param  time_limit  Time after which the routes are no longer improved.
+   *                     Every stop that fits is still placed first.
+   */
+  VehicleRouter(const std::chrono::milliseconds& time_limit = std::chrono::milliseconds(100));
+
+  /**
+   * Route the fleet.
+   * @param  count     Number of locations in the time matrix.
+   * @param  times     2-D matrix of travel times between locations,
+   *                   times[from * count + to]. Pairs with no connection
+   *                   should be infinite.
+   * @param  vehicles  The fleet.
+   * @param  stops     Locations to visit.
+   * @return Returns the route of each vehicle and the stops left out.
+   */
+  Solution Solve(const uint32_t count, const std::vector<float>& times,
+                 const std::vector<Vehicle>& vehicles,
+                 const std::vector<Stop>& stops) const;
+
+protected:
+  std::chrono::milliseconds time_limit_;
+};
+
+}
+}
+
+#endif  // VALHALLA_THOR_VEHICLE_ROUTER_H_
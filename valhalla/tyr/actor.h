@@ -0,0 +1,63 @@
+#ifndef __VALHALLA_TYR_ACTOR_H__
+#define __VALHALLA_TYR_ACTOR_H__
+
+#include <string>
+#include <list>
+#include <memory>
+#include <functional>
+#include <boost/property_tree/ptree.hpp>
+
+#include <prime_server/prime_server.hpp>
+
+namespace valhalla {
+  namespace tyr {
+
+    /**
+     * Runs every stage of a request, loki through tyr, in the calling thread. Rather
+     * than serializing the request and the paths between stages, as happens when the
+     * stages are separate workers behind proxies, each stage hands the next one its
+     * in memory results. Each actor keeps its own tile caches so use one per thread.
+     */
+    class actor_t {
+     public:
+      actor_t(const boost::property_tree::ptree& config);
+
+      /**
+       * Gets the json response to a request, failures are thrown as valhalla_exception_t
+       * @param path         the action to perform, eg. /route
+       * @param request_str  the json request
+       * @param interrupt    optionally lets the request be aborted part way through by throwing
+       * @return the json response
+       */
+      std::string act(const std::string& path, const std::string& request_str, const std::function<void ()>* interrupt = nullptr);
+
+      std::string route(const std::string& request_str, const std::function<void ()>* interrupt = nullptr);
+      std::string locate(const std::string& request_str, const std::function<void ()>* interrupt = nullptr);
+      std::string matrix(const std::string& request_str, const std::function<void ()>* interrupt = nullptr);
+      std::string optimized_route(const std::string& request_str, const std::function<void ()>* interrupt = nullptr);
+      std::string optimized_fleet(const std::string& request_str, const std::function<void ()>* interrupt = nullptr);
+      std::string isochrone(const std::string& request_str, const std::function<void ()>* interrupt = nullptr);
+      std::string trace_route(const std::string& request_str, const std::function<void ()>* interrupt = nullptr);
+      std::string trace_attributes(const std::string& request_str, const std::function<void ()>* interrupt = nullptr);
+
+      /**
+       * Lets the actor sit behind the http server as the only worker, it takes the http
+       * request and gives back the http response including any error
+       */
+      prime_server::worker_t::result_t work(const std::list<zmq::message_t>& job, void* request_info, const prime_server::worker_t::interrupt_function_t& interrupt);
+      void cleanup();
+
+     protected:
+      struct pimpl_t;
+      std::shared_ptr<pimpl_t> pimpl;
+    };
+
+    /**
+     * Serves requests from the http server with actors instead of a worker per stage
+     */
+    void run_actor_service(const boost::property_tree::ptree& config);
+
+  }
+}
+
+#endif //__VALHALLA_TYR_ACTOR_H__
@@ -2,15 +2,34 @@
 #define __VALHALLA_TYR_SERVICE_H__
 
 #include <cstdint>
+#include <list>
+#include <boost/optional.hpp>
 #include <boost/property_tree/ptree.hpp>
 
 #include <prime_server/prime_server.hpp>
+#include <prime_server/http_protocol.hpp>
+
+#include <valhalla/baldr/errorcode_util.h>
+#include <valhalla/baldr/rapidjson_utils.h>
+#include <valhalla/baldr/json_writer.h>
+#include <valhalla/proto/tripdirections.pb.h>
+#include <valhalla/odin/arena.h>
 
 namespace valhalla {
   namespace tyr {
 
     void run_service(const boost::property_tree::ptree& config);
 
+    /**
+     * Turns an exception into the json error response that goes back to the client
+     * @param exception     what went wrong
+     * @param request_info  info about the request being answered
+     * @param jsonp         the callback to wrap the json in, if the request had one
+     * @return the response to send
+     */
+    prime_server::worker_t::result_t jsonify_error(const baldr::valhalla_exception_t& exception,
+      prime_server::http_request_info_t& request_info, const boost::optional<std::string>& jsonp);
+
     class tyr_worker_t {
      public:
       tyr_worker_t(const boost::property_tree::ptree& config);
@@ -18,10 +37,24 @@ namespace valhalla {
       prime_server::worker_t::result_t work(const std::list<zmq::message_t>& job, void* request_info, const prime_server::worker_t::interrupt_function_t&);
       void cleanup();
 
+      /**
+       * Serializes the directions for the request without them having to be parsed first.
+       * Throws on failure.
+       * @param request       the request as forwarded by odin
+       * @param legs          the directions for each leg of the trip
+       * @param request_info  info about the request
+       * @return the json response
+       */
+      std::string serialize(const rapidjson::Document& request, const std::list<odin::TripDirections*>& legs,
+        prime_server::http_request_info_t& request_info);
+
      protected:
 
       boost::property_tree::ptree config;
       boost::optional<std::string> jsonp;
+      baldr::json::writer_t writer;
+      //the trip directions of the current request
+      odin::arena_t arena;
       float long_request;
       bool healthcheck;
     };